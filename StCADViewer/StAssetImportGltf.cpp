@@ -12,8 +12,9 @@
 
 #include "StImageOcct.h"
 
+#include <StStrings/StBase64.h>
 #include <StStrings/StLogger.h>
-#include <StTemplates/StArrayStreamBuffer.h>
+#include <StThreads/StTaskPool.h>
 
 #include <Graphic3d_Mat4d.hxx>
 #include <Graphic3d_Vec.hxx>
@@ -30,63 +31,77 @@ namespace
     const char THE_KHR_materials_common[] = "KHR_materials_common";
     const char THE_KHR_binary_glTF[]      = "KHR_binary_glTF";
 
-    //! Look-up table for decoding base64 stream.
-    static const stUByte_t THE_BASE64_FROM[128] = {
-        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255,  62, 255,  63,
-         52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255,   0, 255, 255, 255,
-        255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
-         15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255,  63,
-        255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
-         41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255
-    };
-
     /**
      * Function decoding base64 stream.
+     * @param theError error description
      */
-    Handle(NCollection_Buffer) decodeBase64(const stUByte_t* theStr,
-                                            const size_t theLen) {
+    Handle(NCollection_Buffer) decodeBase64(const char*  theStr,
+                                            const size_t theLen,
+                                            StString&    theError) {
+        const size_t aSize = StBase64::getDecodedSize(theStr, theLen);
         Handle(NCollection_Buffer) aData = new NCollection_Buffer(NCollection_BaseAllocator::CommonBaseAllocator());
-        if(!aData->Allocate (3 * theLen / 4)) {
-            ST_ERROR_LOG("Fail to allocate memory.");
+        if(aSize == 0) {
+            theError = "defines empty base64 data";
+            return Handle(NCollection_Buffer)();
+        } else if(!aData->Allocate(aSize)) {
+            theError = "can not be allocated";
             return Handle(NCollection_Buffer)();
         }
 
-        stUByte_t* aDataPtr = aData->ChangeData();
-        const stUByte_t* anEnd = theStr + theLen;
-        for(const stUByte_t* aByteIter = theStr; aByteIter < anEnd; aByteIter += 4) {
-            // get values for each group of four base 64 characters
-            const stUByte_t b4[4] = {
-                aByteIter + 0 < anEnd && aByteIter[0] <= 'z' ? THE_BASE64_FROM[aByteIter[0]] : stUByte_t(0xFF),
-                aByteIter + 1 < anEnd && aByteIter[1] <= 'z' ? THE_BASE64_FROM[aByteIter[1]] : stUByte_t(0xFF),
-                aByteIter + 2 < anEnd && aByteIter[2] <= 'z' ? THE_BASE64_FROM[aByteIter[2]] : stUByte_t(0xFF),
-                aByteIter + 3 < anEnd && aByteIter[3] <= 'z' ? THE_BASE64_FROM[aByteIter[3]] : stUByte_t(0xFF)
-            };
-
-            // transform into a group of three bytes
-            const stUByte_t b3[3] = {
-                stUByte_t(((b4[0] & 0x3F) << 2) + ((b4[1] & 0x30) >> 4)),
-                stUByte_t(((b4[1] & 0x0F) << 4) + ((b4[2] & 0x3C) >> 2)),
-                stUByte_t(((b4[2] & 0x03) << 6) + ((b4[3] & 0x3F) >> 0))
-            };
-
-            // add the byte to the return value if it isn't part of an '=' character (indicated by 0xFF)
-            if(b4[1] != 0xFF) {
-                *aDataPtr = b3[0];
-                ++aDataPtr;
-            }
-            if(b4[2] != 0xFF) {
-                *aDataPtr = b3[1];
-                ++aDataPtr;
-            }
-            if(b4[3] != 0xFF) {
-                *aDataPtr = b3[2];
-                ++aDataPtr;
+        size_t anErrorPos = 0;
+        if(!StBase64::decodeParallel(aData->ChangeData(), theStr, theLen, anErrorPos)) {
+            theError = StString("defines invalid base64 data at position ") + anErrorPos;
+            return Handle(NCollection_Buffer)();
+        }
+        return aData;
+    }
+
+    /**
+     * Copy strided elements into tightly packed array.
+     * Tightly packed data is copied at once.
+     */
+    template<typename Type>
+    static void copyStrided(Type*            theDst,
+                            const stUByte_t* theSrc,
+                            const size_t     theCount,
+                            const size_t     theStride) {
+        if(theStride == sizeof(Type)) {
+            std::memcpy(theDst, theSrc, theCount * sizeof(Type));
+            return;
+        }
+
+        for(size_t anIter = 0; anIter < theCount; ++anIter, theSrc += theStride) {
+            std::memcpy(theDst + anIter, theSrc, sizeof(Type));
+        }
+    }
+
+    /**
+     * Copy indices and compute maximum index for range validation.
+     * The loop over tightly packed indices has no branches, so that it is vectorized by compiler.
+     */
+    template<typename Type>
+    static GLuint copyIndices(GLuint*          theDst,
+                              const stUByte_t* theSrc,
+                              const size_t     theCount,
+                              const size_t     theStride) {
+        GLuint aMax = 0;
+        if(theStride == sizeof(Type)) {
+            for(size_t anIter = 0; anIter < theCount; ++anIter) {
+                Type anIndex;
+                std::memcpy(&anIndex, theSrc + anIter * sizeof(Type), sizeof(Type));
+                theDst[anIter] = GLuint(anIndex);
+                aMax = stMax(aMax, GLuint(anIndex));
             }
+            return aMax;
         }
 
-        return aData;
+        for(size_t anIter = 0; anIter < theCount; ++anIter, theSrc += theStride) {
+            Type anIndex;
+            std::memcpy(&anIndex, theSrc, sizeof(Type));
+            theDst[anIter] = GLuint(anIndex);
+            aMax = stMax(aMax, GLuint(anIndex));
+        }
+        return aMax;
     }
 
     /**
@@ -270,6 +285,7 @@ StAssetImportGltf::StAssetImportGltf()
 
 bool StAssetImportGltf::load(const Handle(StDocNode)& theParentNode,
                              const StString& theFile) {
+    myLoadTimer.restart();
     myFileName = theFile;
     StString aName;
     StFileNode::getFolderAndFile(theFile, myFolder, aName);
@@ -731,13 +747,17 @@ bool StAssetImportGltf::gltfParseTexture(StGLMaterial& theMat,
     const char* anUriData = anUriVal->GetString();
     if(::strncmp(anUriData, "data:", 5) == 0) { // data:image/png;base64,DATA
         const char* aDataStart = anUriData + 5;
-        for(const char* aDataIter = aDataStart; aDataIter != '\0'; ++aDataIter) {
+        for(const char* aDataIter = aDataStart; *aDataIter != '\0'; ++aDataIter) {
             if(stAreEqual(aDataIter, ";base64,", 8)) {
                 const char* aBase64End  = anUriData + anUriVal->GetStringLength();
                 const char* aBase64Data = aDataIter + 8;
-                const int aBase64Len = int(aBase64End - aBase64Data);
                 const StString aMime(aDataStart, aDataIter - aDataStart);
-                Handle(NCollection_Buffer) aData = decodeBase64((const stUByte_t* )aBase64Data, aBase64Len);
+                StString anError;
+                Handle(NCollection_Buffer) aData = decodeBase64(aBase64Data, size_t(aBase64End - aBase64Data), anError);
+                if(aData.IsNull()) {
+                    signals.onError(formatSyntaxError(myFileName, StString("Image '") + getKeyString(*aSrcVal).ToCString() + "' " + anError + "."));
+                    return false;
+                }
                 theMat.Texture = new StGltfBinTexture(myFileName + "@" + aSrcVal->GetString(), aMime, aData);
                 return true;
             }
@@ -1020,8 +1040,11 @@ bool StAssetImportGltf::gltfParsePrimArray(const Handle(StDocMeshNode)& theMeshN
         return true;
     }
 
+    // primitive array is put into the mesh after decoding
     Handle(StPrimArray) aPrimArray = new StPrimArray();
-    theMeshNode->ChangePrimitiveArrays().Append(aPrimArray);
+    myPrimJobs.push_back(GltfPrimArrayJob());
+    myPrimJobs.back().MeshNode  = theMeshNode;
+    myPrimJobs.back().PrimArray = aPrimArray;
     if(aMaterial != NULL) {
         // assign material
         myMaterials.Find(getKeyString(*aMaterial), aPrimArray->Material);
@@ -1208,6 +1231,81 @@ bool StAssetImportGltf::gltfParseBufferView(const Handle(StPrimArray)& thePrimAr
     return gltfParseBuffer(thePrimArray, getKeyString(*aBufferName), *aBuffer, theAccessor, aBuffView, theType, theMode);
 }
 
+Handle(NCollection_Buffer) StAssetImportGltf::gltfLoadBuffer(const TCollection_AsciiString& theName,
+                                                             const GenericValue&            theBuffer) {
+    Handle(NCollection_Buffer) aData;
+    if(myBuffersData.Find(theName, aData)) {
+        return aData;
+    }
+
+    const GenericValue* anUriVal = findObjectMember(theBuffer, "uri");
+    const bool isBinary = myIsBinary
+                      && (theName.IsEqual("binary_glTF") // glTF 1.0
+                       || anUriVal == NULL);             // glTF 2.0
+    if(!isBinary
+    && (anUriVal == NULL || !anUriVal->IsString())) {
+        signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' does not define uri."));
+        return Handle(NCollection_Buffer)();
+    }
+
+    const char* anUriData = !isBinary ? anUriVal->GetString() : "";
+    if(!isBinary
+    && ::strncmp(anUriData, "data:application/octet-stream;base64,", 37) == 0) {
+        StString anError;
+        aData = decodeBase64(anUriData + 37, anUriVal->GetStringLength() - 37, anError);
+        if(aData.IsNull()) {
+            signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' " + anError + "."));
+            return aData;
+        }
+        myBuffersData.Bind(theName, aData);
+        return aData;
+    }
+
+    // read the whole binary chunk or external file at once
+    const StString aPath = isBinary ? myFileName : (myFolder + anUriData);
+    if(!isBinary && StString(anUriData).isEmpty()) {
+        signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' does not define uri."));
+        return Handle(NCollection_Buffer)();
+    }
+
+    std::ifstream aFile;
+    OSD_OpenStream(aFile, aPath.toCString(), std::ios::in | std::ios::binary);
+    if(!aFile.is_open() || !aFile.good()) {
+        signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to non-existing file '" + aPath + "'."));
+        return Handle(NCollection_Buffer)();
+    }
+
+    int64_t anOffset = 0;
+    int64_t aLength  = 0;
+    if(isBinary) {
+        anOffset = myBinBodyOffset;
+        aLength  = myBinBodyLen;
+    } else {
+        aFile.seekg(0, std::ios_base::end);
+        aLength = int64_t(aFile.tellg());
+    }
+    aFile.seekg(anOffset, std::ios_base::beg);
+    if(!aFile.good()
+    || aLength < 0
+    || uint64_t(aLength) > uint64_t(size_t(-1))) {
+        signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to invalid location."));
+        return Handle(NCollection_Buffer)();
+    }
+
+    aData = new NCollection_Buffer(NCollection_BaseAllocator::CommonBaseAllocator());
+    if(!aData->Allocate(size_t(aLength))) {
+        signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' can not be allocated."));
+        return Handle(NCollection_Buffer)();
+    }
+    aFile.read((char* )aData->ChangeData(), std::streamsize(aLength));
+    if(aFile.gcount() != std::streamsize(aLength)) {
+        signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to invalid location."));
+        return Handle(NCollection_Buffer)();
+    }
+    myBuffersData.Bind(theName, aData);
+    return aData;
+}
+
 bool StAssetImportGltf::gltfParseBuffer(const Handle(StPrimArray)& thePrimArray,
                                         const TCollection_AsciiString& theName,
                                         const GenericValue&     theBuffer,
@@ -1215,215 +1313,190 @@ bool StAssetImportGltf::gltfParseBuffer(const Handle(StPrimArray)& thePrimArray,
                                         const GltfBufferView&   theView,
                                         const GltfArrayType     theType,
                                         const GltfPrimitiveMode theMode) {
-    //const GenericValue* aType       = findObjectMember(theBuffer, "type");
-    //const GenericValue* aByteLength = findObjectMember(theBuffer, "byteLength");
-    const GenericValue* anUriVal      = findObjectMember(theBuffer, "uri");
-
-    int64_t anOffset = theView.ByteOffset + theAccessor.ByteOffset;
-    bool isBinary = false;
-    if(myIsBinary) {
-        isBinary = theName.IsEqual("binary_glTF") // glTF 1.0
-                || anUriVal == NULL;              // glTF 2.0
+    if(theMode != GltfPrimitiveMode_Triangles) {
+        ST_DEBUG_LOG("Buffer '" + theName.ToCString() + "' skipped unsupported primitive array.");
+        return true;
     }
 
-    if(isBinary) {
-        std::ifstream aFile;
-        OSD_OpenStream(aFile, myFileName.toCString(), std::ios::in | std::ios::binary);
-        if(!aFile.is_open() || !aFile.good()) {
-            signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to non-existing file '" + myFileName + "'."));
-            return false;
-        }
-
-        anOffset += myBinBodyOffset;
-        aFile.seekg(anOffset, std::ios_base::beg);
-        if(!aFile.good()) {
-            aFile.close();
-            signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to non-existing location."));
-            return false;
-        }
+    Handle(NCollection_Buffer) aData = gltfLoadBuffer(theName, theBuffer);
+    if(aData.IsNull()) {
+        return false;
+    }
 
-        return gltfReadBuffer(thePrimArray, theName, theAccessor, aFile, theType, theMode);
+    // limit the accessor by buffer view
+    const int64_t anOffset = theView.ByteOffset + theAccessor.ByteOffset;
+    int64_t anAvailable = int64_t(aData->Size()) - anOffset;
+    if(theView.ByteLength > 0) {
+        anAvailable = stMin(anAvailable, theView.ByteLength - theAccessor.ByteOffset);
+    }
+    if(anAvailable <= 0) {
+        signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to invalid location."));
+        return false;
     }
 
-    if(anUriVal == NULL || !anUriVal->IsString()) {
-        signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' does not define uri."));
+    // buffer remains in myBuffersData until primitive arrays are decoded
+    if(myPrimJobs.empty()
+    || myPrimJobs.back().PrimArray != thePrimArray) {
         return false;
     }
+    GltfAccessorJob anAccessorJob;
+    anAccessorJob.Name     = theName;
+    anAccessorJob.Accessor = theAccessor;
+    anAccessorJob.Data     = aData->Data() + anOffset;
+    anAccessorJob.DataSize = size_t(anAvailable);
+    anAccessorJob.Type     = theType;
+    myPrimJobs.back().Accessors.push_back(anAccessorJob);
+    return true;
+}
 
-    const char* anUriData = anUriVal->GetString();
-    if(::strncmp(anUriData, "data:application/octet-stream;base64,", 37) == 0) {
-        Handle(NCollection_Buffer) aData = decodeBase64((const stUByte_t* )anUriData + 37, anUriVal->GetStringLength() - 37);
-        StArrayStreamBuffer aStreamBuffer((const char* )aData->Data(), aData->Size());
-        std::istream aStream(&aStreamBuffer);
-        aStream.seekg(anOffset, std::ios_base::beg);
-        return gltfReadBuffer(thePrimArray, theName, theAccessor, aStream, theType, theMode);
-    } else {
-        StString anUri = anUriData;
-        if(anUri.isEmpty()) {
-            signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' does not define uri."));
-            return false;
+namespace {
+
+    /**
+     * Functor decoding primitive arrays.
+     */
+    class StGltfDecodeFunctor {
+
+            public:
+
+        StGltfDecodeFunctor(const StAssetImportGltf&       theReader,
+                            std::vector<GltfPrimArrayJob>& theJobs)
+        : myReader(theReader),
+          myJobs(theJobs) {}
+
+        void operator()(const size_t theIndex) const {
+            myReader.gltfDecodePrimArray(myJobs[theIndex]);
         }
 
-        std::ifstream aFile;
-        StString aPath = myFolder + anUri;
-        OSD_OpenStream(aFile, aPath.toCString(), std::ios::in | std::ios::binary);
-        if(!aFile.is_open() || !aFile.good()) {
-            signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to non-existing file '" + anUri + "'."));
-            return false;
+            private:
+
+        const StAssetImportGltf&       myReader;
+        std::vector<GltfPrimArrayJob>& myJobs;
+
+    };
+
+}
+
+bool StAssetImportGltf::gltfDecodePrimArrays() {
+    const double aParseTime = myLoadTimer.getElapsedTimeInMilliSec();
+    StTimer aTimer(true);
+    size_t aNbNodes = 0;
+    for(size_t aJobIter = 0; aJobIter < myPrimJobs.size(); ++aJobIter) {
+        const GltfPrimArrayJob& aJob = myPrimJobs[aJobIter];
+        for(size_t anAccIter = 0; anAccIter < aJob.Accessors.size(); ++anAccIter) {
+            if(aJob.Accessors[anAccIter].Type == GltfArrayType_Position) {
+                aNbNodes += size_t(aJob.Accessors[anAccIter].Accessor.Count);
+            }
         }
+    }
 
-        aFile.seekg(anOffset, std::ios_base::beg);
-        if(!aFile.good()) {
-            aFile.close();
-            signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to invalid location."));
+    // primitive arrays are independent from each other
+    StTaskPool::GetDefault().parallelFor(0, myPrimJobs.size(), StGltfDecodeFunctor(*this, myPrimJobs),
+                                         StTaskPool::Priority_Interactive, 1);
+    const double aDecodeTime = aTimer.getElapsedTimeInMilliSec();
+
+    // report the first error and assemble the document within the calling thread
+    for(size_t aJobIter = 0; aJobIter < myPrimJobs.size(); ++aJobIter) {
+        const GltfPrimArrayJob& aJob = myPrimJobs[aJobIter];
+        if(!aJob.Error.isEmpty()) {
+            signals.onError(aJob.Error);
             return false;
         }
+    }
+    for(size_t aJobIter = 0; aJobIter < myPrimJobs.size(); ++aJobIter) {
+        const GltfPrimArrayJob& aJob = myPrimJobs[aJobIter];
+        aJob.MeshNode->ChangePrimitiveArrays().Append(aJob.PrimArray);
+    }
+
+    ST_DEBUG_LOG(StString("glTF reader, document parsed in ") + aParseTime + " ms, "
+               + myPrimJobs.size() + " primitive arrays (" + aNbNodes + " nodes) decoded in "
+               + aDecodeTime + " ms, assembled in " + (aTimer.getElapsedTimeInMilliSec() - aDecodeTime) + " ms");
+    return true;
+}
+
+void StAssetImportGltf::gltfDecodePrimArray(GltfPrimArrayJob& theJob) const {
+    const Handle(StPrimArray)& aPrimArray = theJob.PrimArray;
+    for(size_t anAccIter = 0; anAccIter < theJob.Accessors.size(); ++anAccIter) {
+        const GltfAccessorJob& anAccessor = theJob.Accessors[anAccIter];
+        if(!gltfReadBuffer(aPrimArray, anAccessor.Name, anAccessor.Accessor,
+                           anAccessor.Data, anAccessor.DataSize, anAccessor.Type, theJob.Error)) {
+            return;
+        }
+    }
 
-        return gltfReadBuffer(thePrimArray, theName, theAccessor, aFile, theType, theMode);
+    if(aPrimArray->Normals.size() != aPrimArray->Positions.size()) {
+        // normals are optional in glTF
+        aPrimArray->Normals.clear();
+        aPrimArray->reconstructNormals();
     }
+    aPrimArray->computeBounds();
 }
 
 bool StAssetImportGltf::gltfReadBuffer(const Handle(StPrimArray)& thePrimArray,
                                        const TCollection_AsciiString& theName,
                                        const GltfAccessor&     theAccessor,
-                                       std::istream&           theStream,
+                                       const stUByte_t*        theData,
+                                       const size_t            theDataSize,
                                        const GltfArrayType     theType,
-                                       const GltfPrimitiveMode theMode) {
-    if(theMode != GltfPrimitiveMode_Triangles) {
-        ST_DEBUG_LOG("Buffer '" + theName.ToCString() + "' skipped unsupported primitive array.");
-        return true;
-    }
-
+                                       StString&               theError) const {
     switch(theType) {
         case GltfArrayType_Indices: {
             if(theAccessor.Type != GltfAccessorLayout_Scalar
             || theAccessor.Count <= 0) {
                 break;
             } else if((theAccessor.Count / 3) > std::numeric_limits<int>::max()) {
-                signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' defines too big array."));
+                theError = formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' defines too big array.");
                 return false;
             }
 
-            const size_t aNbTris = size_t(theAccessor.Count / 3);
+            size_t anElemSize = 0;
             if(theAccessor.ComponentType == GltfAccessorCompType_UInt16) {
-                StVec3<uint16_t> aVec3_16u;
-                const int aNbSkipBytes = theAccessor.ByteStride != 0
-                                       ? (theAccessor.ByteStride - sizeof(uint16_t))
-                                       : 0;
-                thePrimArray->Indices.resize(aNbTris * 3);
-                for(size_t aTriIter = 0; aTriIter < aNbTris; ++aTriIter) {
-                    theStream.read((char* )&aVec3_16u[0], sizeof(uint16_t));
-                    if(aNbSkipBytes != 0) {
-                        theStream.seekg(aNbSkipBytes, std::ios_base::cur);
-                    }
-
-                    theStream.read((char* )&aVec3_16u[1], sizeof(uint16_t));
-                    if(aNbSkipBytes != 0) {
-                        theStream.seekg(aNbSkipBytes, std::ios_base::cur);
-                    }
-
-                    theStream.read((char* )&aVec3_16u[2], sizeof(uint16_t));
-                    if(aNbSkipBytes != 0) {
-                        theStream.seekg(aNbSkipBytes, std::ios_base::cur);
-                    }
-
-                    if((size_t )aVec3_16u[0] >= thePrimArray->Positions.size()
-                    || (size_t )aVec3_16u[1] >= thePrimArray->Positions.size()
-                    || (size_t )aVec3_16u[2] >= thePrimArray->Positions.size()) {
-                        signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to invalid indices."));
-                        return false;
-                    }
-
-                    thePrimArray->Indices[aTriIter * 3 + 0] = aVec3_16u[0];
-                    thePrimArray->Indices[aTriIter * 3 + 1] = aVec3_16u[1];
-                    thePrimArray->Indices[aTriIter * 3 + 2] = aVec3_16u[2];
-                }
+                anElemSize = sizeof(uint16_t);
             } else if(theAccessor.ComponentType == GltfAccessorCompType_UInt32) {
-                StVec3<uint32_t> aVec3_32u;
-                const int aNbSkipBytes = theAccessor.ByteStride != 0
-                                       ? (theAccessor.ByteStride - sizeof(uint32_t))
-                                       : 0;
-                thePrimArray->Indices.resize(aNbTris * 3);
-                for(size_t aTriIter = 0; aTriIter < aNbTris; ++aTriIter) {
-                    theStream.read((char* )&aVec3_32u[0], sizeof(uint32_t));
-                    if(aNbSkipBytes != 0) {
-                        theStream.seekg(aNbSkipBytes, std::ios_base::cur);
-                    }
-
-                    theStream.read((char* )&aVec3_32u[1], sizeof(uint32_t));
-                    if(aNbSkipBytes != 0) {
-                        theStream.seekg(aNbSkipBytes, std::ios_base::cur);
-                    }
-
-                    theStream.read((char* )&aVec3_32u[2], sizeof(uint32_t));
-                    if(aNbSkipBytes != 0) {
-                        theStream.seekg(aNbSkipBytes, std::ios_base::cur);
-                    }
-
-                    if((size_t )aVec3_32u[0] >= thePrimArray->Positions.size()
-                    || (size_t )aVec3_32u[1] >= thePrimArray->Positions.size()
-                    || (size_t )aVec3_32u[2] >= thePrimArray->Positions.size()) {
-                        signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to invalid indices."));
-                        return false;
-                    }
-
-                    thePrimArray->Indices[aTriIter * 3 + 0] = aVec3_32u[0];
-                    thePrimArray->Indices[aTriIter * 3 + 1] = aVec3_32u[1];
-                    thePrimArray->Indices[aTriIter * 3 + 2] = aVec3_32u[2];
-                }
+                anElemSize = sizeof(uint32_t);
             } else {
                 break;
             }
-            break;
-        }
-        case GltfArrayType_Position: {
-            if(theAccessor.ComponentType != GltfAccessorCompType_Float32
-            || theAccessor.Type != GltfAccessorLayout_Vec3) {
-                break;
-            } else if(theAccessor.Count > std::numeric_limits<int>::max()) {
-                signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' defines too big array."));
+
+            const size_t aNbIndices = size_t(theAccessor.Count / 3) * 3;
+            const size_t aStride    = theAccessor.ByteStride != 0 ? size_t(theAccessor.ByteStride) : anElemSize;
+            if(!checkAccessorRange(theName, aNbIndices, aStride, anElemSize, theDataSize, theError)) {
                 return false;
+            } else if(aNbIndices == 0) {
+                break;
             }
 
-            const size_t aNbNodes = size_t(theAccessor.Count);
-            StGLVec4 aVec4(0.0f, 0.0f, 0.0f, 1.0f);
-            const int aNbSkipBytes = theAccessor.ByteStride != 0
-                                   ? (theAccessor.ByteStride - sizeof(StGLVec3))
-                                   : 0;
-            thePrimArray->Positions.resize(aNbNodes);
-            for(size_t aVertIter = 0; aVertIter < aNbNodes; ++aVertIter) {
-                theStream.read((char* )aVec4.getData(), sizeof(StGLVec3));
-                thePrimArray->Positions[aVertIter] = aVec4.xyz();
-                if(aNbSkipBytes != 0) {
-                    theStream.seekg(aNbSkipBytes, std::ios_base::cur);
-                }
+            thePrimArray->Indices.resize(aNbIndices);
+            const GLuint aMaxIndex = anElemSize == sizeof(uint16_t)
+                                   ? copyIndices<uint16_t>(&thePrimArray->Indices.front(), theData, aNbIndices, aStride)
+                                   : copyIndices<uint32_t>(&thePrimArray->Indices.front(), theData, aNbIndices, aStride);
+            if(size_t(aMaxIndex) >= thePrimArray->Positions.size()) {
+                thePrimArray->Indices.clear();
+                theError = formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to invalid indices.");
+                return false;
             }
-
             break;
         }
+        case GltfArrayType_Position:
         case GltfArrayType_Normal: {
             if(theAccessor.ComponentType != GltfAccessorCompType_Float32
             || theAccessor.Type != GltfAccessorLayout_Vec3) {
                 break;
             } else if(theAccessor.Count > std::numeric_limits<int>::max()) {
-                signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' defines too big array."));
+                theError = formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' defines too big array.");
                 return false;
             }
 
             const size_t aNbNodes = size_t(theAccessor.Count);
-            StGLVec4 aVec4(0.0f, 0.0f, 0.0f, 0.0f);
-            const int aNbSkipBytes = theAccessor.ByteStride != 0
-                                   ? (theAccessor.ByteStride - sizeof(StGLVec3))
-                                   : 0;
-            thePrimArray->Normals.resize(aNbNodes);
-            for(size_t aVertIter = 0; aVertIter < aNbNodes; ++aVertIter) {
-                theStream.read((char* )aVec4.getData(), sizeof(StGLVec3));
-                thePrimArray->Normals[aVertIter] = aVec4.xyz();
-                if(aNbSkipBytes != 0) {
-                    theStream.seekg(aNbSkipBytes, std::ios_base::cur);
-                }
+            const size_t aStride  = theAccessor.ByteStride != 0 ? size_t(theAccessor.ByteStride) : sizeof(StGLVec3);
+            if(!checkAccessorRange(theName, aNbNodes, aStride, sizeof(StGLVec3), theDataSize, theError)) {
+                return false;
             }
 
+            std::vector<StGLVec3>& anArray = theType == GltfArrayType_Position
+                                           ? thePrimArray->Positions
+                                           : thePrimArray->Normals;
+            anArray.resize(aNbNodes);
+            copyStrided(&anArray.front(), theData, aNbNodes, aStride);
             break;
         }
         case GltfArrayType_TCoord0: {
@@ -1431,24 +1504,18 @@ bool StAssetImportGltf::gltfReadBuffer(const Handle(StPrimArray)& thePrimArray,
             || theAccessor.Type != GltfAccessorLayout_Vec2) {
                 break;
             } else if(theAccessor.Count > std::numeric_limits<int>::max()) {
-                signals.onError(formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' defines too big array."));
+                theError = formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' defines too big array.");
                 return false;
             }
 
             const size_t aNbNodes = size_t(theAccessor.Count);
-            StGLVec2 aVec2(0.0f, 0.0f);
-            const int aNbSkipBytes = theAccessor.ByteStride != 0
-                                   ? (theAccessor.ByteStride - sizeof(StGLVec2))
-                                   : 0;
-            thePrimArray->TexCoords0.resize(aNbNodes);
-            for(size_t aVertIter = 0; aVertIter < aNbNodes; ++aVertIter) {
-                theStream.read((char* )aVec2.getData(), sizeof(StGLVec2));
-
-                thePrimArray->TexCoords0[aVertIter] = aVec2;
-                if(aNbSkipBytes != 0) {
-                    theStream.seekg(aNbSkipBytes, std::ios_base::cur);
-                }
+            const size_t aStride  = theAccessor.ByteStride != 0 ? size_t(theAccessor.ByteStride) : sizeof(StGLVec2);
+            if(!checkAccessorRange(theName, aNbNodes, aStride, sizeof(StGLVec2), theDataSize, theError)) {
+                return false;
             }
+
+            thePrimArray->TexCoords0.resize(aNbNodes);
+            copyStrided(&thePrimArray->TexCoords0.front(), theData, aNbNodes, aStride);
             break;
         }
         case GltfArrayType_Color:
@@ -1463,3 +1530,20 @@ bool StAssetImportGltf::gltfReadBuffer(const Handle(StPrimArray)& thePrimArray,
     }
     return true;
 }
+
+bool StAssetImportGltf::checkAccessorRange(const TCollection_AsciiString& theName,
+                                           const size_t theCount,
+                                           const size_t theStride,
+                                           const size_t theElemSize,
+                                           const size_t theDataSize,
+                                           StString&    theError) const {
+    if(theStride < theElemSize) {
+        theError = formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' defines invalid byteStride.");
+        return false;
+    } else if(theCount != 0
+           && (uint64_t(theCount - 1) * uint64_t(theStride) + uint64_t(theElemSize)) > uint64_t(theDataSize)) {
+        theError = formatSyntaxError(myFileName, StString("Buffer '") + theName.ToCString() + "' refers to data out of buffer range.");
+        return false;
+    }
+    return true;
+}
@@ -16,7 +16,9 @@
 #include <StStrings/StString.h>
 #include <StFile/StFileNode.h>
 #include <StSlots/StSignal.h>
+#include <StThreads/StTimer.h>
 
+#include <NCollection_Buffer.hxx>
 #include <NCollection_DataMap.hxx>
 #include <TCollection_AsciiString.hxx>
 
@@ -152,6 +154,29 @@ struct GltfBufferView {
     GltfBufferView() : ByteOffset(0), ByteLength(0), Target(GltfBufferViewTarget_UNKNOWN) {}
 };
 
+/**
+ * Accessor data located within loaded buffer, to be decoded.
+ */
+struct GltfAccessorJob {
+    TCollection_AsciiString Name;     //!< buffer name (for error messages)
+    GltfAccessor            Accessor; //!< accessor definition
+    const stUByte_t*        Data;     //!< pointer to the first element within buffer
+    size_t                  DataSize; //!< number of bytes available starting from Data
+    GltfArrayType           Type;     //!< array type
+
+    GltfAccessorJob() : Data(NULL), DataSize(0), Type(GltfArrayType_UNKNOWN) {}
+};
+
+/**
+ * Primitive array collected while parsing the document, to be decoded by worker thread.
+ */
+struct GltfPrimArrayJob {
+    Handle(StDocMeshNode)        MeshNode;  //!< mesh to put primitive array into
+    Handle(StPrimArray)          PrimArray; //!< primitive array to fill
+    std::vector<GltfAccessorJob> Accessors; //!< attributes followed by indices
+    StString                     Error;     //!< error message filled by worker thread
+};
+
 /**
  * Tool for importing asset from GLTF file.
  */
@@ -193,9 +218,19 @@ class StAssetImportGltf : public rapidjson::Document {
 
         gltfParseAsset();
         gltfParseMaterials();
-        return gltfParseScene(theParentNode);
+        const bool isDone = gltfParseScene(theParentNode)
+                         && gltfDecodePrimArrays();
+        myPrimJobs.clear();
+        myBuffersData.Clear();
+        return isDone;
     }
 
+    /**
+     * Decode primitive array job: read accessors, reconstruct missing normals and compute bounds.
+     * Can be called from worker thread.
+     */
+    ST_LOCAL void gltfDecodePrimArray(GltfPrimArrayJob& theJob) const;
+
         protected:
 
     /**
@@ -213,6 +248,13 @@ class StAssetImportGltf : public rapidjson::Document {
      */
     void gltfParseAsset();
 
+    /**
+     * Decode primitive arrays collected by gltfParseScene() in parallel
+     * (including normals reconstruction and bounding boxes),
+     * and put them into mesh nodes within the calling thread.
+     */
+    bool gltfDecodePrimArrays();
+
         protected:
 
     /**
@@ -343,7 +385,7 @@ class StAssetImportGltf : public rapidjson::Document {
                              const GltfPrimitiveMode theMode);
 
     /**
-     * Parse buffer.
+     * Parse buffer and put the accessor into primitive array job.
      */
     bool gltfParseBuffer(const Handle(StPrimArray)& thePrimArray,
                          const TCollection_AsciiString& theName,
@@ -354,14 +396,37 @@ class StAssetImportGltf : public rapidjson::Document {
                          const GltfPrimitiveMode theMode);
 
     /**
-     * Read buffer.
+     * Load the whole buffer into memory (once per document).
+     * @param theName   buffer name
+     * @param theBuffer buffer definition
+     * @return buffer data or NULL on error
+     */
+    Handle(NCollection_Buffer) gltfLoadBuffer(const TCollection_AsciiString& theName,
+                                              const GenericValue&            theBuffer);
+
+    /**
+     * Decode accessor data (can be called from worker thread).
+     * @param theData     pointer to the first element of accessor
+     * @param theDataSize number of bytes available starting from theData
+     * @param theError    error message
      */
     bool gltfReadBuffer(const Handle(StPrimArray)& thePrimArray,
                         const TCollection_AsciiString& theName,
                         const GltfAccessor&     theAccessor,
-                        std::istream&           theStream,
+                        const stUByte_t*        theData,
+                        const size_t            theDataSize,
                         const GltfArrayType     theType,
-                        const GltfPrimitiveMode theMode);
+                        StString&               theError) const;
+
+    /**
+     * Check that accessor elements fit into available data.
+     */
+    bool checkAccessorRange(const TCollection_AsciiString& theName,
+                            const size_t theCount,
+                            const size_t theStride,
+                            const size_t theElemSize,
+                            const size_t theDataSize,
+                            StString&    theError) const;
 
 protected:
 
@@ -540,6 +605,9 @@ protected:
     NCollection_DataMap<TCollection_AsciiString, Handle(StDocObjectNode)> mySceneNodeMap;
     NCollection_DataMap<TCollection_AsciiString, Handle(StDocMeshNode)>   myMeshMap;
     NCollection_DataMap<TCollection_AsciiString, Handle(StGLMaterial)>    myMaterials;
+    NCollection_DataMap<TCollection_AsciiString, Handle(NCollection_Buffer)> myBuffersData; //!< buffers loaded into memory
+    std::vector<GltfPrimArrayJob> myPrimJobs; //!< primitive arrays to be decoded
+    StTimer                       myLoadTimer; //!< timer measuring import phases
 
     int64_t  myBinBodyOffset;  //!< offset to binary body
     int64_t  myBinBodyLen;     //!< binary body length
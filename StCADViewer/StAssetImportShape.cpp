@@ -5,8 +5,11 @@
  */
 
 #include "StAssetImportShape.h"
+#include "StAssetMeshCache.h"
 
 #include <StStrings/StLogger.h>
+#include <StThreads/StTaskPool.h>
+#include <StThreads/StTimer.h>
 
 #include <BRep_Builder.hxx>
 #include <BRepLProp_SLProps.hxx>
@@ -116,8 +119,9 @@ StAssetImportShape::FileFormat StAssetImportShape::probeFormatFromExtension(cons
     return FileFormat_UNKNOWN;
 }
 
-StAssetImportShape::StAssetImportShape()
-: myXCAFApp(new TDocStd_Application()) {
+StAssetImportShape::StAssetImportShape(const StString& theCacheFolder)
+: myCacheFolder(theCacheFolder),
+  myXCAFApp(new TDocStd_Application()) {
     BinXCAFDrivers::DefineFormat(myXCAFApp);
     //StdLDrivers::DefineFormat(myXCAFApp);
     //BinLDrivers::DefineFormat(myXCAFApp);
@@ -169,6 +173,19 @@ void StAssetImportShape::clearSession(const Handle(XSControl_WorkSession)& theWo
 bool StAssetImportShape::load(const Handle(StDocNode)& theParentNode,
                               const StString& theFile,
                               const FileFormat theFormat) {
+    Handle(Prs3d_Drawer) aDrawer = new Prs3d_Drawer();
+
+    // translation and meshing of STEP and IGES files is expensive - reuse the result of previous import
+    const bool toUseCache = theFormat == FileFormat_STEP
+                         || theFormat == FileFormat_IGES;
+    StAssetMeshCache aCache(toUseCache ? myCacheFolder : StString());
+    if(aCache.init(theFile, theFormat, aDrawer->DeviationCoefficient(), aDrawer->HLRAngle())
+    && aCache.read(theParentNode)) {
+        return true;
+    }
+    const int aFirstChild = theParentNode->Children().Size() + 1;
+    StTimer aTimer(true);
+
     switch(theFormat) {
         case FileFormat_STEP: {
             if(!loadSTEP(theFile)) {
@@ -238,7 +255,7 @@ bool StAssetImportShape::load(const Handle(StDocNode)& theParentNode,
         }
     }
 
-    Handle(Prs3d_Drawer) aDrawer = new Prs3d_Drawer();
+    const double aReadTime = aTimer.getElapsedTimeInMilliSec();
     Standard_Real aDeflection = Prs3d::GetDeflection(aCompound, aDrawer);
     if(!BRepTools::Triangulation(aCompound, aDeflection)) {
         BRepMesh_IncrementalMesh anAlgo;
@@ -248,6 +265,7 @@ bool StAssetImportShape::load(const Handle(StDocNode)& theParentNode,
         anAlgo.SetShape(aCompound);
         anAlgo.Perform();
     }
+    const double aMeshTime = aTimer.getElapsedTimeInMilliSec();
 
     XCAFPrs_Style aDefStyle;
     aDefStyle.SetColorSurf(Quantity_NOC_GRAY65);
@@ -257,6 +275,22 @@ bool StAssetImportShape::load(const Handle(StDocNode)& theParentNode,
         TopLoc_Location aTrsf = XCAFDoc_ShapeTool::GetLocation(aLabel);
         addNodeRecursive(theParentNode, *aColorTool, aLabel, aTrsf, aDefStyle);
     }
+    const double aTreeTime = aTimer.getElapsedTimeInMilliSec();
+
+    size_t aNbNodes = 0, aNbTris = 0;
+    for(size_t aJobIter = 0; aJobIter < myFaceJobs.size(); ++aJobIter) {
+        const ShapeFaceJob& aJob = myFaceJobs[aJobIter];
+        aNbNodes += aJob.PrimArray->Positions.size();
+        aNbTris  += aJob.PrimArray->Indices.size() / 3;
+    }
+    fillPrimArrays();
+    ST_DEBUG_LOG(StString("Shape reader, model translated in ") + aReadTime + " ms, meshed in "
+               + (aMeshTime - aReadTime) + " ms, " + myFaceJobs.size() + " faces (" + aNbNodes + " nodes, "
+               + aNbTris + " triangles) collected in " + (aTreeTime - aMeshTime) + " ms and filled in "
+               + (aTimer.getElapsedTimeInMilliSec() - aTreeTime) + " ms");
+    myFaceJobs.clear();
+
+    aCache.write(theParentNode, aFirstChild);
     return true;
 }
 
@@ -345,8 +379,6 @@ bool StAssetImportShape::addMeshNode(const Handle(StDocNode)& theParentTreeItem,
     TopLoc_Location aFaceLoc;
     Handle(StDocMeshNode) aMeshNode = new StDocMeshNode();
     theParentTreeItem->ChangeChildren().Append(aMeshNode);
-    BRepLProp_SLProps anSLProps(1, 1e-12);
-    BRepAdaptor_Surface aFaceAdaptor;
     for(int aTypeIter = 0; aTypeIter < 2; ++aTypeIter) {
         const bool isClosed = aTypeIter == 0;
         const TopoDS_Compound& aComp = isClosed ? aClosed : anOpened;
@@ -358,100 +390,13 @@ bool StAssetImportShape::addMeshNode(const Handle(StDocNode)& theParentTreeItem,
                 continue;
             }
 
+            // pre-size arrays, they will be filled by fillPrimArrays()
             Handle(StPrimArray) aPrimAttribs = new StPrimArray();
-            const TColgp_Array1OfPnt& aNodes = aPolyTri->Nodes();
-            const int aNbNodes = aNodes.Size();
+            const int aNbNodes = aPolyTri->NbNodes();
             aPrimAttribs->Trsf = aFaceLoc.Transformation();
             aPrimAttribs->Positions.resize(aNbNodes);
             aPrimAttribs->Normals  .resize(aNbNodes);
             aPrimAttribs->Indices  .resize(aPolyTri->NbTriangles() * 3);
-            {
-                const int aNodeLower = aNodes.Lower();
-                const int aNodeUpper = aNodes.Upper();
-                for(int aNodeIter = aNodeLower; aNodeIter <= aNodeUpper; ++aNodeIter) {
-                    const gp_Pnt& aSrcPos = aNodes.Value(aNodeIter);
-                    StGLVec3& aPos = aPrimAttribs->Positions[aNodeIter - aNodeLower];
-                    aPos.x() = (float )aSrcPos.X();
-                    aPos.y() = (float )aSrcPos.Y();
-                    aPos.z() = (float )aSrcPos.Z();
-                }
-            }
-
-            const bool isMirrored = aPrimAttribs->Trsf.Form() != gp_Identity
-                                 && aPrimAttribs->Trsf.VectorialPart().Determinant() < 0.0;
-            const bool isReversed = aFace.Orientation() == TopAbs_REVERSED;
-            const bool toSwapIndices = isReversed ^ isMirrored;
-            {
-                const Poly_Array1OfTriangle& aTriangles = aPolyTri->Triangles();
-                const int aNodeLower = aNodes.Lower();
-                const int aTriLower = aTriangles.Lower();
-                const int aTriUpper = aTriangles.Upper();
-                int aTriIndices[3] = {0, 0, 0};
-                int anIndexIter = 0;
-                for(int aTriIter = aTriLower; aTriIter <= aTriUpper; ++aTriIter, anIndexIter += 3) {
-                    aTriangles.Value(aTriIter).Get(aTriIndices[0], aTriIndices[1], aTriIndices[2]);
-                    if(toSwapIndices) {
-                        std::swap(aTriIndices[1], aTriIndices[2]);
-                    }
-                    aPrimAttribs->Indices[anIndexIter + 0] = aTriIndices[0] - aNodeLower;
-                    aPrimAttribs->Indices[anIndexIter + 1] = aTriIndices[1] - aNodeLower;
-                    aPrimAttribs->Indices[anIndexIter + 2] = aTriIndices[2] - aNodeLower;
-                }
-            }
-
-            if(aPolyTri->HasNormals()
-            && (aPolyTri->Normals().Size() / 3) == aPolyTri->Nodes().Size()) {
-                const TShort_Array1OfShortReal& aNormals = aPolyTri->Normals();
-                const int aNormLower = aNormals.Lower();
-                const int aNormUpper = aNormals.Upper();
-                for(int aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter) {
-                    StGLVec3& aNorm = aPrimAttribs->Normals[aNodeIter];
-                    aNorm.x() = aNormals.Value(aNormLower + aNodeIter * 3);
-                    aNorm.y() = aNormals.Value(aNormLower + aNodeIter * 3 + 1);
-                    aNorm.z() = aNormals.Value(aNormLower + aNodeIter * 3 + 2);
-                    if(aNorm.modulus() != 0.0f) {
-                        aNorm.normalize();
-                        if(isReversed) {
-                            aNorm = -aNorm;
-                        }
-                    } else {
-                        aNorm.x() = 0.0f;
-                        aNorm.y() = 0.0f;
-                        aNorm.z() = 1.0f;
-                    }
-                }
-            } else if(aPolyTri->HasUVNodes()
-                   && aPolyTri->UVNodes().Size() == aPolyTri->Nodes().Size()) {
-                TopoDS_Face aFaceFwd = TopoDS::Face(aFace.Oriented(TopAbs_FORWARD));
-                aFaceFwd.Location(TopLoc_Location());
-                aFaceAdaptor.Initialize(aFaceFwd, false);
-                anSLProps.SetSurface(aFaceAdaptor);
-
-                const TColgp_Array1OfPnt2d& anUVNodes = aPolyTri->UVNodes();
-                const int aNodeLower = anUVNodes.Lower();
-                const int aNodeUpper = anUVNodes.Upper();
-                for(int aNodeIter = aNodeLower; aNodeIter <= aNodeUpper; ++aNodeIter) {
-                    StGLVec3& aNorm = aPrimAttribs->Normals[aNodeIter - aNodeLower];
-                    const gp_Pnt2d& anUV = anUVNodes.Value(aNodeIter);
-                    anSLProps.SetParameters(anUV.X(), anUV.Y());
-                    if(anSLProps.IsNormalDefined()) {
-                        gp_Dir aSurfNorm = anSLProps.Normal();
-                        if(isReversed) {
-                            aSurfNorm.Reverse();
-                        }
-                        aNorm.x() = (float )aSurfNorm.X();
-                        aNorm.y() = (float )aSurfNorm.Y();
-                        aNorm.z() = (float )aSurfNorm.Z();
-                    } else {
-                        aNorm.x() = 0.0f;
-                        aNorm.y() = 0.0f;
-                        aNorm.z() = 1.0f;
-                    }
-                }
-            } else {
-                // reconstruct missing normals
-                aPrimAttribs->reconstructNormals();
-            }
 
             XCAFPrs_Style aStyle = theParentStyle;
             if(!aStyles1.Find(aFace, aStyle)) {
@@ -472,12 +417,150 @@ bool StAssetImportShape::addMeshNode(const Handle(StDocNode)& theParentTreeItem,
             aPrimAttribs->Material->SetCullBackFaces(isClosed);
 
             aMeshNode->ChangePrimitiveArrays().Append(aPrimAttribs);
+
+            ShapeFaceJob aJob;
+            aJob.Face          = aFace;
+            aJob.Triangulation = aPolyTri;
+            aJob.PrimArray     = aPrimAttribs;
+            myFaceJobs.push_back(aJob);
         }
     }
 
     return true;
 }
 
+namespace {
+
+    /**
+     * Functor filling primitive arrays of faces.
+     */
+    class StShapeFillFunctor {
+
+            public:
+
+        StShapeFillFunctor(const StAssetImportShape&  theReader,
+                           std::vector<ShapeFaceJob>& theJobs)
+        : myReader(theReader),
+          myJobs(theJobs) {}
+
+        void operator()(const size_t theIndex) const {
+            myReader.fillPrimArray(myJobs[theIndex]);
+        }
+
+            private:
+
+        const StAssetImportShape&  myReader;
+        std::vector<ShapeFaceJob>& myJobs;
+
+    };
+
+}
+
+void StAssetImportShape::fillPrimArrays() {
+    // faces are independent from each other and arrays have been already allocated
+    StTaskPool::GetDefault().parallelFor(0, myFaceJobs.size(), StShapeFillFunctor(*this, myFaceJobs),
+                                         StTaskPool::Priority_Interactive, 1);
+}
+
+void StAssetImportShape::fillPrimArray(ShapeFaceJob& theJob) const {
+    const TopoDS_Face& aFace = theJob.Face;
+    const Handle(Poly_Triangulation)& aPolyTri = theJob.Triangulation;
+    const Handle(StPrimArray)& aPrimAttribs = theJob.PrimArray;
+    const TColgp_Array1OfPnt& aNodes = aPolyTri->Nodes();
+    const int aNbNodes = aNodes.Size();
+
+    {
+        const int aNodeLower = aNodes.Lower();
+        const int aNodeUpper = aNodes.Upper();
+        for(int aNodeIter = aNodeLower; aNodeIter <= aNodeUpper; ++aNodeIter) {
+            const gp_Pnt& aSrcPos = aNodes.Value(aNodeIter);
+            StGLVec3& aPos = aPrimAttribs->Positions[aNodeIter - aNodeLower];
+            aPos.x() = (float )aSrcPos.X();
+            aPos.y() = (float )aSrcPos.Y();
+            aPos.z() = (float )aSrcPos.Z();
+        }
+    }
+    aPrimAttribs->computeBounds();
+
+    const bool isMirrored = aPrimAttribs->Trsf.Form() != gp_Identity
+                         && aPrimAttribs->Trsf.VectorialPart().Determinant() < 0.0;
+    const bool isReversed = aFace.Orientation() == TopAbs_REVERSED;
+    const bool toSwapIndices = isReversed ^ isMirrored;
+    {
+        const Poly_Array1OfTriangle& aTriangles = aPolyTri->Triangles();
+        const int aNodeLower = aNodes.Lower();
+        const int aTriLower = aTriangles.Lower();
+        const int aTriUpper = aTriangles.Upper();
+        int aTriIndices[3] = {0, 0, 0};
+        int anIndexIter = 0;
+        for(int aTriIter = aTriLower; aTriIter <= aTriUpper; ++aTriIter, anIndexIter += 3) {
+            aTriangles.Value(aTriIter).Get(aTriIndices[0], aTriIndices[1], aTriIndices[2]);
+            if(toSwapIndices) {
+                std::swap(aTriIndices[1], aTriIndices[2]);
+            }
+            aPrimAttribs->Indices[anIndexIter + 0] = aTriIndices[0] - aNodeLower;
+            aPrimAttribs->Indices[anIndexIter + 1] = aTriIndices[1] - aNodeLower;
+            aPrimAttribs->Indices[anIndexIter + 2] = aTriIndices[2] - aNodeLower;
+        }
+    }
+
+    if(aPolyTri->HasNormals()
+    && (aPolyTri->Normals().Size() / 3) == aPolyTri->Nodes().Size()) {
+        const TShort_Array1OfShortReal& aNormals = aPolyTri->Normals();
+        const int aNormLower = aNormals.Lower();
+        const int aNormUpper = aNormals.Upper();
+        for(int aNodeIter = 0; aNodeIter < aNbNodes; ++aNodeIter) {
+            StGLVec3& aNorm = aPrimAttribs->Normals[aNodeIter];
+            aNorm.x() = aNormals.Value(aNormLower + aNodeIter * 3);
+            aNorm.y() = aNormals.Value(aNormLower + aNodeIter * 3 + 1);
+            aNorm.z() = aNormals.Value(aNormLower + aNodeIter * 3 + 2);
+            if(aNorm.modulus() != 0.0f) {
+                aNorm.normalize();
+                if(isReversed) {
+                    aNorm = -aNorm;
+                }
+            } else {
+                aNorm.x() = 0.0f;
+                aNorm.y() = 0.0f;
+                aNorm.z() = 1.0f;
+            }
+        }
+    } else if(aPolyTri->HasUVNodes()
+           && aPolyTri->UVNodes().Size() == aPolyTri->Nodes().Size()) {
+        BRepLProp_SLProps anSLProps(1, 1e-12);
+        BRepAdaptor_Surface aFaceAdaptor;
+        TopoDS_Face aFaceFwd = TopoDS::Face(aFace.Oriented(TopAbs_FORWARD));
+        aFaceFwd.Location(TopLoc_Location());
+        aFaceAdaptor.Initialize(aFaceFwd, false);
+        anSLProps.SetSurface(aFaceAdaptor);
+
+        const TColgp_Array1OfPnt2d& anUVNodes = aPolyTri->UVNodes();
+        const int aNodeLower = anUVNodes.Lower();
+        const int aNodeUpper = anUVNodes.Upper();
+        for(int aNodeIter = aNodeLower; aNodeIter <= aNodeUpper; ++aNodeIter) {
+            StGLVec3& aNorm = aPrimAttribs->Normals[aNodeIter - aNodeLower];
+            const gp_Pnt2d& anUV = anUVNodes.Value(aNodeIter);
+            anSLProps.SetParameters(anUV.X(), anUV.Y());
+            if(anSLProps.IsNormalDefined()) {
+                gp_Dir aSurfNorm = anSLProps.Normal();
+                if(isReversed) {
+                    aSurfNorm.Reverse();
+                }
+                aNorm.x() = (float )aSurfNorm.X();
+                aNorm.y() = (float )aSurfNorm.Y();
+                aNorm.z() = (float )aSurfNorm.Z();
+            } else {
+                aNorm.x() = 0.0f;
+                aNorm.y() = 0.0f;
+                aNorm.z() = 1.0f;
+            }
+        }
+    } else {
+        // reconstruct missing normals
+        aPrimAttribs->reconstructNormals();
+    }
+}
+
 bool StAssetImportShape::loadIGES(const StString& theFileToLoadPath) {
     IGESCAFControl_Reader aReader;
     Handle(XSControl_WorkSession) aWS = aReader.WS();
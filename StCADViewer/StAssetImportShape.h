@@ -11,10 +11,14 @@
 #include <StFile/StFileNode.h>
 #include <StSlots/StSignal.h>
 
+#include <Poly_Triangulation.hxx>
 #include <Standard_Type.hxx>
+#include <TopoDS_Face.hxx>
 
 #include "StAssetDocument.h"
 
+#include <vector>
+
 class TDF_Label;
 class TDocStd_Document;
 class TopLoc_Location;
@@ -24,6 +28,15 @@ class XCAFDoc_ColorTool;
 class XCAFPrs_Style;
 class XSControl_WorkSession;
 
+/**
+ * Face collected while building the document tree, to be converted into primitive array by worker thread.
+ */
+struct ShapeFaceJob {
+    TopoDS_Face                Face;          //!< face to convert
+    Handle(Poly_Triangulation) Triangulation; //!< face triangulation
+    Handle(StPrimArray)        PrimArray;     //!< primitive array with pre-sized attributes
+};
+
 /**
  * Tool for importing asset from BRep shape.
  */
@@ -64,9 +77,10 @@ class StAssetImportShape {
         public:
 
     /**
-     * Empty constructor.
+     * Main constructor.
+     * @param theCacheFolder folder for mesh cache of STEP and IGES files (empty to disable cache)
      */
-    ST_LOCAL StAssetImportShape();
+    ST_LOCAL StAssetImportShape(const StString& theCacheFolder = StString());
 
     /**
      * Perform the import.
@@ -75,8 +89,19 @@ class StAssetImportShape {
                        const StString& theFile,
                        const FileFormat theFormat);
 
+    /**
+     * Fill in primitive array from face triangulation: positions, indices and normals.
+     * Can be called from worker thread.
+     */
+    ST_LOCAL void fillPrimArray(ShapeFaceJob& theJob) const;
+
         protected:
 
+    /**
+     * Fill in primitive arrays of collected faces in parallel.
+     */
+    ST_LOCAL void fillPrimArrays();
+
     /**
      * Fill in XDE document from IGES file.
      */
@@ -98,6 +123,7 @@ class StAssetImportShape {
 
     /**
      * Add the BRep shape into Asset document.
+     * Primitive arrays are allocated for each triangulated face, but filled later by fillPrimArrays().
      */
     ST_LOCAL bool addMeshNode(const Handle(StDocNode)& theParentTreeItem,
                               const TDF_Label&         theShapeLabel,
@@ -125,8 +151,10 @@ class StAssetImportShape {
 
         protected:
 
+    StString                    myCacheFolder; //!< folder for mesh cache
     Handle(TDocStd_Application) myXCAFApp;
     Handle(TDocStd_Document)    myXCAFDoc;
+    std::vector<ShapeFaceJob>   myFaceJobs;    //!< faces to be converted into primitive arrays
 
 };
 
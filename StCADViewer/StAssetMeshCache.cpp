@@ -0,0 +1,569 @@
+/**
+ * This source is a part of sView program.
+ *
+ * Copyright © Kirill Gavrilov, 2026
+ */
+
+#include "StAssetMeshCache.h"
+
+#include <StFile/StFolder.h>
+#include <StFile/StRawFile.h>
+#include <StStrings/StLogger.h>
+#include <StThreads/StTimer.h>
+
+#include <Standard_Failure.hxx>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace {
+
+    static const char     THE_MAGIC[8] = { 'S', 'V', 'M', 'E', 'S', 'H', '\0', '\0' };
+    static const uint32_t THE_VERSION  = 1;
+    static const uint32_t THE_ENDIAN   = 0x01020304;
+
+    /**
+     * Read-only view of the file content.
+     * The file is memory-mapped when possible and read into memory otherwise.
+     */
+    class StMappedFile {
+
+            public:
+
+        StMappedFile()
+        : myData(NULL),
+          mySize(0),
+          myIsMapped(false) {
+        #if defined(_WIN32)
+            myMapping = NULL;
+        #endif
+        }
+
+        ~StMappedFile() {
+            close();
+        }
+
+        const stUByte_t* getData() const { return myData; }
+
+        size_t getSize() const { return mySize; }
+
+        bool open(const StString& thePath) {
+            close();
+        #if defined(_WIN32)
+            StStringUtfWide aPathW;
+            aPathW.fromUnicode(thePath);
+            HANDLE aFile = ::CreateFileW(aPathW.toCString(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                         OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+            if(aFile == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+            LARGE_INTEGER aSize;
+            if(::GetFileSizeEx(aFile, &aSize)
+            && aSize.QuadPart > 0
+            && uint64_t(aSize.QuadPart) <= uint64_t(size_t(-1))) {
+                myMapping = ::CreateFileMappingW(aFile, NULL, PAGE_READONLY, 0, 0, NULL);
+                if(myMapping != NULL) {
+                    myData = (const stUByte_t* )::MapViewOfFile(myMapping, FILE_MAP_READ, 0, 0, 0);
+                    if(myData != NULL) {
+                        mySize     = size_t(aSize.QuadPart);
+                        myIsMapped = true;
+                    } else {
+                        ::CloseHandle(myMapping);
+                        myMapping = NULL;
+                    }
+                }
+            }
+            ::CloseHandle(aFile);
+        #else
+            const int aFile = ::open(thePath.toCString(), O_RDONLY);
+            if(aFile == -1) {
+                return false;
+            }
+            struct stat aStat;
+            if(::fstat(aFile, &aStat) == 0
+            && aStat.st_size > 0
+            && uint64_t(aStat.st_size) <= uint64_t(size_t(-1))) {
+                void* aData = ::mmap(NULL, size_t(aStat.st_size), PROT_READ, MAP_PRIVATE, aFile, 0);
+                if(aData != MAP_FAILED) {
+                    myData     = (const stUByte_t* )aData;
+                    mySize     = size_t(aStat.st_size);
+                    myIsMapped = true;
+                }
+            }
+            ::close(aFile);
+        #endif
+            if(myIsMapped) {
+                return true;
+            }
+
+            // fallback to reading the whole file
+            if(!myRawFile.readFile(thePath)) {
+                return false;
+            }
+            myData = myRawFile.getBuffer();
+            mySize = myRawFile.getSize();
+            return true;
+        }
+
+        void close() {
+            if(myIsMapped) {
+            #if defined(_WIN32)
+                ::UnmapViewOfFile(myData);
+                ::CloseHandle(myMapping);
+                myMapping = NULL;
+            #else
+                ::munmap((void* )myData, mySize);
+            #endif
+                myIsMapped = false;
+            }
+            myRawFile.freeBuffer();
+            myData = NULL;
+            mySize = 0;
+        }
+
+            private:
+
+        StRawFile        myRawFile;  //!< buffer for reading the file when mapping fails
+        const stUByte_t* myData;     //!< file content
+        size_t           mySize;     //!< file size
+        bool             myIsMapped; //!< flag indicating that file is memory-mapped
+    #if defined(_WIN32)
+        HANDLE           myMapping;  //!< file mapping object
+    #endif
+
+    };
+
+    /**
+     * Compute 64-bit hash of the data (not cryptographic).
+     */
+    static uint64_t hashData(const stUByte_t* theData,
+                             const size_t     theSize) {
+        const uint64_t aMul1 = 0x87C37B91114253D5ULL;
+        const uint64_t aMul2 = 0x4CF5AD432745937FULL;
+        uint64_t aHash = 0x9E3779B97F4A7C15ULL ^ uint64_t(theSize);
+        const size_t aNbWords = theSize / 8;
+        for(size_t aWordIter = 0; aWordIter < aNbWords; ++aWordIter) {
+            uint64_t aWord = 0;
+            std::memcpy(&aWord, theData + aWordIter * 8, 8);
+            aWord *= aMul1;
+            aWord  = (aWord << 31) | (aWord >> 33);
+            aWord *= aMul2;
+            aHash ^= aWord;
+            aHash  = ((aHash << 27) | (aHash >> 37)) * 5 + 0x52DCE729;
+        }
+
+        uint64_t aTail = 0;
+        for(size_t aByteIter = aNbWords * 8; aByteIter < theSize; ++aByteIter) {
+            aTail = (aTail << 8) | theData[aByteIter];
+        }
+        aHash ^= aTail * aMul1;
+        aHash ^= aHash >> 33;
+        aHash *= aMul2;
+        aHash ^= aHash >> 33;
+        return aHash;
+    }
+
+    /**
+     * Format the number as 16 hexadecimal digits.
+     */
+    static StString formatHex(const uint64_t theValue) {
+        static const char THE_DIGITS[] = "0123456789abcdef";
+        char aBuffer[17];
+        for(int aDigitIter = 0; aDigitIter < 16; ++aDigitIter) {
+            aBuffer[aDigitIter] = THE_DIGITS[(theValue >> (60 - aDigitIter * 4)) & 0xF];
+        }
+        aBuffer[16] = '\0';
+        return StString(aBuffer);
+    }
+
+    /**
+     * Serializer of the document tree.
+     */
+    class StMeshCacheWriter {
+
+            public:
+
+        const std::vector<char>& getData() const { return myData; }
+
+        void add(const void*  theData,
+                 const size_t theSize) {
+            if(theSize != 0) {
+                const char* aData = (const char* )theData;
+                myData.insert(myData.end(), aData, aData + theSize);
+            }
+        }
+
+        void addUInt(const uint32_t theValue) {
+            add(&theValue, sizeof(theValue));
+        }
+
+        /**
+         * Write NULL-terminated string padded to 4 bytes.
+         */
+        void addString(const StString& theString) {
+            const uint32_t aSize = uint32_t(theString.getSize() + 1);
+            const uint32_t aPadded = (aSize + 3) & ~uint32_t(3);
+            addUInt(aPadded);
+            add(theString.toCString(), aSize - 1);
+            myData.insert(myData.end(), aPadded - aSize + 1, '\0');
+        }
+
+        void addTrsf(const gp_Trsf& theTrsf) {
+            for(int aRow = 1; aRow <= 3; ++aRow) {
+                for(int aCol = 1; aCol <= 4; ++aCol) {
+                    const double aValue = theTrsf.Value(aRow, aCol);
+                    add(&aValue, sizeof(aValue));
+                }
+            }
+        }
+
+        template<typename T>
+        void addArray(const std::vector<T>& theArray) {
+            addUInt(uint32_t(theArray.size()));
+            if(!theArray.empty()) {
+                add(&theArray.front(), theArray.size() * sizeof(T));
+            }
+        }
+
+        void addNode(const Handle(StDocNode)& theNode) {
+            const Handle(StDocMeshNode) aMeshNode = Handle(StDocMeshNode)::DownCast(theNode);
+            addUInt(aMeshNode.IsNull() ? StDocNodeType_Object : StDocNodeType_Mesh);
+            addString(theNode->nodeName());
+            addTrsf(theNode->nodeTransformation());
+            if(!aMeshNode.IsNull()) {
+                addUInt(uint32_t(aMeshNode->PrimitiveArrays().Size()));
+                for(NCollection_Sequence<Handle(StPrimArray)>::Iterator anArrayIter(aMeshNode->PrimitiveArrays());
+                    anArrayIter.More(); anArrayIter.Next()) {
+                    addPrimArray(*anArrayIter.Value());
+                }
+            }
+
+            addUInt(uint32_t(theNode->Children().Size()));
+            for(NCollection_Sequence<Handle(StDocNode)>::Iterator aChildIter(theNode->Children());
+                aChildIter.More(); aChildIter.Next()) {
+                addNode(aChildIter.Value());
+            }
+        }
+
+        void addPrimArray(const StPrimArray& theArray) {
+            addTrsf(theArray.Trsf);
+            const StGLMaterial aDefMat;
+            const StGLMaterial& aMat = !theArray.Material.IsNull() ? *theArray.Material : aDefMat;
+            add(&aMat.DiffuseColor,  sizeof(StGLVec4));
+            add(&aMat.AmbientColor,  sizeof(StGLVec4));
+            add(&aMat.SpecularColor, sizeof(StGLVec4));
+            add(&aMat.EmissiveColor, sizeof(StGLVec4));
+            add(&aMat.Params,        sizeof(StGLVec4));
+            addArray(theArray.Positions);
+            addArray(theArray.Normals);
+            addArray(theArray.TexCoords0);
+            addArray(theArray.Indices);
+        }
+
+            private:
+
+        std::vector<char> myData;
+
+    };
+
+    /**
+     * Parser of the document tree.
+     * All reads are checked against the end of the buffer.
+     */
+    class StMeshCacheReader {
+
+            public:
+
+        StMeshCacheReader(const stUByte_t* theData,
+                          const size_t     theSize)
+        : myIter(theData),
+          myEnd (theData + theSize) {}
+
+        bool read(void*        theData,
+                  const size_t theSize) {
+            if(size_t(myEnd - myIter) < theSize) {
+                return false;
+            }
+            std::memcpy(theData, myIter, theSize);
+            myIter += theSize;
+            return true;
+        }
+
+        bool readUInt(uint32_t& theValue) {
+            return read(&theValue, sizeof(theValue));
+        }
+
+        bool readString(StString& theString) {
+            uint32_t aSize = 0;
+            if(!readUInt(aSize)
+            || aSize == 0
+            || size_t(myEnd - myIter) < aSize
+            || myIter[aSize - 1] != '\0') {
+                return false;
+            }
+            theString = StString((const char* )myIter);
+            myIter += aSize;
+            return true;
+        }
+
+        bool readTrsf(gp_Trsf& theTrsf) {
+            double aVals[12];
+            if(!read(aVals, sizeof(aVals))) {
+                return false;
+            }
+
+            static const double THE_IDENTITY[12] = { 1.0, 0.0, 0.0, 0.0,
+                                                     0.0, 1.0, 0.0, 0.0,
+                                                     0.0, 0.0, 1.0, 0.0 };
+            if(std::memcmp(aVals, THE_IDENTITY, sizeof(aVals)) == 0) {
+                theTrsf = gp_Trsf();
+                return true;
+            }
+
+            try {
+                theTrsf.SetValues(aVals[0], aVals[1], aVals[2],  aVals[3],
+                                  aVals[4], aVals[5], aVals[6],  aVals[7],
+                                  aVals[8], aVals[9], aVals[10], aVals[11]);
+            } catch(Standard_Failure ) {
+                return false;
+            }
+            return true;
+        }
+
+        template<typename T>
+        bool readArray(std::vector<T>& theArray) {
+            uint32_t aSize = 0;
+            if(!readUInt(aSize)
+            || size_t(myEnd - myIter) / sizeof(T) < aSize) {
+                return false;
+            }
+            theArray.resize(aSize);
+            return aSize == 0
+                || read(&theArray.front(), aSize * sizeof(T));
+        }
+
+        bool readNode(Handle(StDocNode)& theNode,
+                      const int          theDepth) {
+            uint32_t aType = 0;
+            StString aName;
+            gp_Trsf  aTrsf;
+            if(theDepth > 1024
+            || !readUInt(aType)
+            || !readString(aName)
+            || !readTrsf(aTrsf)) {
+                return false;
+            }
+
+            if(aType == StDocNodeType_Mesh) {
+                Handle(StDocMeshNode) aMeshNode = new StDocMeshNode();
+                uint32_t aNbArrays = 0;
+                if(!readUInt(aNbArrays)) {
+                    return false;
+                }
+                for(uint32_t anArrayIter = 0; anArrayIter < aNbArrays; ++anArrayIter) {
+                    Handle(StPrimArray) anArray = new StPrimArray();
+                    if(!readPrimArray(*anArray)) {
+                        return false;
+                    }
+                    aMeshNode->ChangePrimitiveArrays().Append(anArray);
+                }
+                theNode = aMeshNode;
+            } else if(aType == StDocNodeType_Object) {
+                theNode = new StDocObjectNode();
+            } else {
+                return false;
+            }
+            theNode->setNodeName(aName);
+            theNode->setNodeTransformation(aTrsf);
+
+            uint32_t aNbChildren = 0;
+            if(!readUInt(aNbChildren)) {
+                return false;
+            }
+            for(uint32_t aChildIter = 0; aChildIter < aNbChildren; ++aChildIter) {
+                Handle(StDocNode) aChild;
+                if(!readNode(aChild, theDepth + 1)) {
+                    return false;
+                }
+                theNode->ChangeChildren().Append(aChild);
+            }
+            return true;
+        }
+
+        bool readPrimArray(StPrimArray& theArray) {
+            theArray.Material = new StGLMaterial();
+            if(!readTrsf(theArray.Trsf)
+            || !read(&theArray.Material->DiffuseColor,  sizeof(StGLVec4))
+            || !read(&theArray.Material->AmbientColor,  sizeof(StGLVec4))
+            || !read(&theArray.Material->SpecularColor, sizeof(StGLVec4))
+            || !read(&theArray.Material->EmissiveColor, sizeof(StGLVec4))
+            || !read(&theArray.Material->Params,        sizeof(StGLVec4))
+            || !readArray(theArray.Positions)
+            || !readArray(theArray.Normals)
+            || !readArray(theArray.TexCoords0)
+            || !readArray(theArray.Indices)) {
+                return false;
+            }
+
+            // protect renderer from corrupted file
+            const size_t aNbNodes = theArray.Positions.size();
+            if((!theArray.Normals.empty()    && theArray.Normals.size()    != aNbNodes)
+            || (!theArray.TexCoords0.empty() && theArray.TexCoords0.size() != aNbNodes)
+            || theArray.Indices.size() % 3 != 0) {
+                return false;
+            }
+            for(size_t anIndexIter = 0; anIndexIter < theArray.Indices.size(); ++anIndexIter) {
+                if(theArray.Indices[anIndexIter] >= aNbNodes) {
+                    return false;
+                }
+            }
+            theArray.computeBounds();
+            return true;
+        }
+
+            private:
+
+        const stUByte_t* myIter;
+        const stUByte_t* myEnd;
+
+    };
+
+}
+
+StAssetMeshCache::StAssetMeshCache(const StString& theCacheFolder)
+: myCacheFolder(theCacheFolder) {
+    stMemZero(&myHeader, sizeof(myHeader));
+}
+
+bool StAssetMeshCache::init(const StString& theFile,
+                            const int       theFormat,
+                            const double    theDeviation,
+                            const double    theAngle) {
+    myCachePath.clear();
+    if(myCacheFolder.isEmpty()) {
+        return false;
+    }
+
+    const int64_t aFileTime = StFileNode::getModificationTime(theFile);
+    StMappedFile aFile;
+    if(aFileTime < 0
+    || !aFile.open(theFile)) {
+        return false;
+    }
+
+    StTimer aTimer(true);
+    stMemZero(&myHeader, sizeof(myHeader));
+    std::memcpy(myHeader.Magic, THE_MAGIC, sizeof(THE_MAGIC));
+    myHeader.Version   = THE_VERSION;
+    myHeader.Endian    = THE_ENDIAN;
+    myHeader.FileSize  = aFile.getSize();
+    myHeader.FileTime  = aFileTime;
+    myHeader.FileHash  = hashData(aFile.getData(), aFile.getSize());
+    myHeader.Deviation = theDeviation;
+    myHeader.Angle     = theAngle;
+    myHeader.Format    = uint32_t(theFormat);
+    aFile.close();
+
+    const StString aFolder = myCacheFolder + "cad";
+    if(!StFolder::isFolder(aFolder)
+    && !StFolder::createFolder(aFolder)) {
+        return false;
+    }
+
+    const uint64_t aPathHash = hashData((const stUByte_t* )theFile.toCString(), theFile.getSize());
+    myCachePath = aFolder + "/" + formatHex(aPathHash) + ".svmesh";
+    ST_DEBUG_LOG("StAssetMeshCache, hash of \"" + theFile + "\" computed in " + aTimer.getElapsedTimeInMilliSec() + " ms");
+    return true;
+}
+
+bool StAssetMeshCache::read(const Handle(StDocNode)& theParentNode) {
+    if(myCachePath.isEmpty()) {
+        return false;
+    }
+
+    StMappedFile aFile;
+    if(!aFile.open(myCachePath)) {
+        return false;
+    }
+
+    StTimer aTimer(true);
+    Header aHeader;
+    StMeshCacheReader aReader(aFile.getData(), aFile.getSize());
+    if(!aReader.read(&aHeader, sizeof(aHeader))
+    || std::memcmp(aHeader.Magic, myHeader.Magic, sizeof(aHeader.Magic)) != 0
+    || aHeader.Version   != myHeader.Version
+    || aHeader.Endian    != myHeader.Endian
+    || aHeader.FileSize  != myHeader.FileSize
+    || aHeader.FileTime  != myHeader.FileTime
+    || aHeader.FileHash  != myHeader.FileHash
+    || aHeader.Deviation != myHeader.Deviation
+    || aHeader.Angle     != myHeader.Angle
+    || aHeader.Format    != myHeader.Format) {
+        ST_DEBUG_LOG("StAssetMeshCache, outdated cache file \"" + myCachePath + "\"");
+        return false;
+    }
+
+    NCollection_Sequence<Handle(StDocNode)> aNodes;
+    for(uint32_t aNodeIter = 0; aNodeIter < aHeader.NbNodes; ++aNodeIter) {
+        Handle(StDocNode) aNode;
+        if(!aReader.readNode(aNode, 0)) {
+            ST_ERROR_LOG("StAssetMeshCache, corrupted cache file \"" + myCachePath + "\"");
+            return false;
+        }
+        aNodes.Append(aNode);
+    }
+
+    theParentNode->ChangeChildren().Append(aNodes);
+    ST_DEBUG_LOG(StString("StAssetMeshCache, ") + aFile.getSize() + " bytes read from \"" + myCachePath
+               + "\" in " + aTimer.getElapsedTimeInMilliSec() + " ms");
+    return true;
+}
+
+bool StAssetMeshCache::write(const Handle(StDocNode)& theParentNode,
+                             const int                theFirstChild) {
+    if(myCachePath.isEmpty()) {
+        return false;
+    }
+
+    const NCollection_Sequence<Handle(StDocNode)>& aNodes = theParentNode->Children();
+    Header aHeader = myHeader;
+    aHeader.NbNodes = uint32_t(stMax(aNodes.Size() - theFirstChild + 1, 0));
+
+    StMeshCacheWriter aWriter;
+    aWriter.add(&aHeader, sizeof(aHeader));
+    for(int aNodeIter = theFirstChild; aNodeIter <= aNodes.Size(); ++aNodeIter) {
+        aWriter.addNode(aNodes.Value(aNodeIter));
+    }
+
+    // write into temporary file first so that concurrent reader never sees incomplete file
+    const std::vector<char>& aData = aWriter.getData();
+    const StString aTmpPath = myCachePath + ".tmp";
+    StRawFile aFile;
+    if(!aFile.openFile(StRawFile::WRITE, aTmpPath)) {
+        ST_ERROR_LOG("StAssetMeshCache, can not create file \"" + aTmpPath + "\"");
+        return false;
+    }
+    const bool isWritten = aFile.write(&aData.front(), aData.size()) == aData.size();
+    aFile.closeFile();
+    if(!isWritten) {
+        ST_ERROR_LOG("StAssetMeshCache, can not write file \"" + aTmpPath + "\"");
+        StFileNode::removeFile(aTmpPath);
+        return false;
+    }
+
+    StFileNode::removeFile(myCachePath);
+    if(!StFileNode::moveFile(aTmpPath, myCachePath)) {
+        StFileNode::removeFile(aTmpPath);
+        return false;
+    }
+    ST_DEBUG_LOG(StString("StAssetMeshCache, ") + aData.size() + " bytes written into \"" + myCachePath + "\"");
+    return true;
+}
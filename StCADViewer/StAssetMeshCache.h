@@ -0,0 +1,93 @@
+/**
+ * This source is a part of sView program.
+ *
+ * Copyright © Kirill Gavrilov, 2026
+ */
+
+#ifndef __StAssetMeshCache_h_
+#define __StAssetMeshCache_h_
+
+#include "StAssetDocument.h"
+
+/**
+ * Binary cache of the document tree imported from CAD file (STEP, IGES).
+ * The cache stores node names, transformations, materials and triangulation
+ * so that reopening the same file skips data exchange translation and meshing.
+ *
+ * Cache entry is identified by the path to the source file
+ * and validated by source file size, modification time, content hash and meshing parameters.
+ * Cache file is memory-mapped on reading.
+ */
+class StAssetMeshCache {
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theCacheFolder folder to store cache files (should end with separator)
+     */
+    ST_LOCAL StAssetMeshCache(const StString& theCacheFolder);
+
+    /**
+     * Compute the key of the source file.
+     * @param theFile      source file path
+     * @param theFormat    source file format
+     * @param theDeviation mesh deviation coefficient
+     * @param theAngle     mesh angular deflection
+     * @return false if cache can not be used
+     */
+    ST_LOCAL bool init(const StString& theFile,
+                       const int       theFormat,
+                       const double    theDeviation,
+                       const double    theAngle);
+
+    /**
+     * @return path to the cache file
+     */
+    ST_LOCAL const StString& getCachePath() const {
+        return myCachePath;
+    }
+
+    /**
+     * Read cached nodes and append them to the parent node.
+     * @param theParentNode node to fill in
+     * @return false if cache entry does not exist or is outdated
+     */
+    ST_LOCAL bool read(const Handle(StDocNode)& theParentNode);
+
+    /**
+     * Store child nodes of the parent node.
+     * @param theParentNode node to store
+     * @param theFirstChild index of the first child to store (1-based)
+     * @return false on write error
+     */
+    ST_LOCAL bool write(const Handle(StDocNode)& theParentNode,
+                        const int                theFirstChild = 1);
+
+        private:
+
+    /**
+     * Cache file header.
+     */
+    struct Header {
+        char     Magic[8];   //!< file identifier
+        uint32_t Version;    //!< format version
+        uint32_t Endian;     //!< byte order marker
+        uint64_t FileSize;   //!< size of the source file
+        int64_t  FileTime;   //!< modification time of the source file
+        uint64_t FileHash;   //!< hash of the source file content
+        double   Deviation;  //!< mesh deviation coefficient
+        double   Angle;      //!< mesh angular deflection
+        uint32_t Format;     //!< source file format
+        uint32_t NbNodes;    //!< number of root nodes
+    };
+
+        private:
+
+    StString myCacheFolder; //!< folder to store cache files
+    StString myCachePath;   //!< path to the cache file
+    Header   myHeader;      //!< expected header of the cache file
+
+};
+
+#endif // __StAssetMeshCache_h_
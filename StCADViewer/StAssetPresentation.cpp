@@ -6,6 +6,7 @@
 
 #include "StAssetPresentation.h"
 
+#include <Bnd_Box.hxx>
 #include <Graphic3d_ArrayOfTriangles.hxx>
 #include <NCollection_IndexedDataMap.hxx>
 
@@ -33,6 +34,31 @@ struct StPrsPart {
     StPrsPart() : NbNodes(0), NbTris(0), HasTexCoord0(false) {}
 };
 
+/**
+ * Extend the box by bounds of primitive array transformed into presentation space.
+ * @return false if primitive array does not define bounds
+ */
+static bool addTransformedBounds(Bnd_Box&           theBox,
+                                 const StPrimArray& thePrims,
+                                 const gp_Trsf&     theTrsf) {
+    if(thePrims.Bounds.isVoid()) {
+        return thePrims.Positions.empty();
+    }
+
+    const StGLVec3& aMin = thePrims.Bounds.getMin();
+    const StGLVec3& aMax = thePrims.Bounds.getMax();
+    for(int aCornerIter = 0; aCornerIter < 8; ++aCornerIter) {
+        gp_Pnt aCorner((aCornerIter & 1) != 0 ? aMax.x() : aMin.x(),
+                       (aCornerIter & 2) != 0 ? aMax.y() : aMin.y(),
+                       (aCornerIter & 4) != 0 ? aMax.z() : aMin.z());
+        if(theTrsf.Form() != gp_Identity) {
+            aCorner.Transform(theTrsf);
+        }
+        theBox.Add(aCorner);
+    }
+    return true;
+}
+
 void StAssetPresentation::Compute (const Handle(PrsMgr_PresentationManager3d)& thePrsMgr,
                                    const Handle(Prs3d_Presentation)& thePrs,
                                    const int theMode) {
@@ -61,6 +87,8 @@ void StAssetPresentation::Compute (const Handle(PrsMgr_PresentationManager3d)& t
     for(NCollection_IndexedDataMap<Handle(StGLMaterial), StPrsPart, StGLMaterial>::Iterator aStyleIter(aStyleMap); aStyleIter.More(); aStyleIter.Next()) {
         const StPrsPart& aPrsPart = aStyleIter.Value();
         Handle(Graphic3d_ArrayOfTriangles) aTris = new Graphic3d_ArrayOfTriangles(int(aPrsPart.NbNodes), int(aPrsPart.NbTris * 3), true, false, aPrsPart.HasTexCoord0);
+        Bnd_Box aPartBox;
+        bool hasPartBounds = true;
         for(NCollection_Sequence<StLocatedPrimArray>::Iterator aPrimIter(aPrsPart.PrimArrays); aPrimIter.More(); aPrimIter.Next()) {
             const Handle(StPrimArray)& aPrims = aPrimIter.Value().PrimArray;
             const gp_Trsf& aMeshTrsf = aPrimIter.Value().NodeTrsf;
@@ -69,6 +97,7 @@ void StAssetPresentation::Compute (const Handle(PrsMgr_PresentationManager3d)& t
 
             const size_t aNbPrimNodes = aPrims->Positions.size();
             const gp_Trsf aTrsf = aMeshTrsf * aPrims->Trsf;
+            hasPartBounds = addTransformedBounds(aPartBox, *aPrims, aTrsf) && hasPartBounds;
             if(aTrsf.Form() != gp_Identity) {
                 for(size_t aNodeIter = 0; aNodeIter < aNbPrimNodes; ++aNodeIter) {
                     const StGLVec3& aPos = aPrims->Positions[aNodeIter];
@@ -144,7 +173,15 @@ void StAssetPresentation::Compute (const Handle(PrsMgr_PresentationManager3d)& t
         }
 
         aGroup->SetGroupPrimitivesAspect(anAspect);
-        aGroup->AddPrimitiveArray(aTris);
+        if(hasPartBounds && !aPartBox.IsVoid()) {
+            // use bounds computed by importer instead of another pass over all vertices
+            Standard_Real aXMin = 0.0, aYMin = 0.0, aZMin = 0.0, aXMax = 0.0, aYMax = 0.0, aZMax = 0.0;
+            aPartBox.Get(aXMin, aYMin, aZMin, aXMax, aYMax, aZMax);
+            aGroup->AddPrimitiveArray(aTris, Standard_False);
+            aGroup->SetMinMaxValues(aXMin, aYMin, aZMin, aXMax, aYMax, aZMax);
+        } else {
+            aGroup->AddPrimitiveArray(aTris);
+        }
     }
 }
 
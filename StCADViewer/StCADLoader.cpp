@@ -25,9 +25,11 @@ const StArrayList<StString> StCADLoader::ST_CAD_EXTENSIONS_LIST(StCADLoader::ST_
 
 StCADLoader::StCADLoader(const StHandle<StLangMap>&  theLangMap,
                          const StHandle<StPlayList>& thePlayList,
+                         const StString&             theCacheFolder,
                          const bool                  theToStartThread)
 : myLangMap(theLangMap),
   myPlayList(thePlayList),
+  myCacheFolder(theCacheFolder),
   myEvLoadNext(false),
   myDefaultMat(Graphic3d_NOM_SILVER),
   myIsLoaded(false),
@@ -67,7 +69,7 @@ bool StCADLoader::loadModel(const StHandle<StFileNode>& theSource) {
         aReader.signals.onError.connect(this, &StCADLoader::doOnErrorRedirect);
         isRead = aReader.load(myDoc, aFileToLoadPath);
     } else {
-        StAssetImportShape aReader;
+        StAssetImportShape aReader(myCacheFolder);
         aReader.signals.onError.connect(this, &StCADLoader::doOnErrorRedirect);
         isRead = aReader.load(myDoc, aFileToLoadPath, aShapeFormat);
     }
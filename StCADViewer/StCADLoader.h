@@ -36,6 +36,7 @@ class StCADLoader {
 
     ST_LOCAL StCADLoader(const StHandle<StLangMap>&  theLangMap,
                          const StHandle<StPlayList>& thePlayList,
+                         const StString&             theCacheFolder = StString(),
                          const bool                  theToStartThread = true);
     ST_LOCAL virtual ~StCADLoader();
 
@@ -80,6 +81,7 @@ class StCADLoader {
     StHandle<StThread>   myThread;
     StHandle<StLangMap>  myLangMap;
     StHandle<StPlayList> myPlayList;
+    StString             myCacheFolder; //!< folder for mesh cache
     StCondition          myEvLoadNext;
     Handle(StAssetDocument) myDoc;
     NCollection_Sequence<Handle(AIS_InteractiveObject)> myPrsList;
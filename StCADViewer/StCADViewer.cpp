@@ -432,7 +432,7 @@ bool StCADViewer::init() {
 
     // create working threads
     if(!isReset) {
-        myCADLoader = new StCADLoader(myLangMap, myPlayList);
+        myCADLoader = new StCADLoader(myLangMap, myPlayList, myResMgr->getCacheFolder());
         myCADLoader->signals.onError = stSlot(myMsgQueue.access(), &StMsgQueue::doPushError);
     }
 
@@ -9,6 +9,8 @@
 
 #include "StGLMaterial.h"
 
+#include <StGLMesh/StBndBox.h>
+
 #include <gp_Trsf.hxx>
 
 #include <vector>
@@ -28,6 +30,7 @@ class StPrimArray : public Standard_Transient {
     std::vector<GLuint>   Indices;
     Handle(StGLMaterial)  Material;
     gp_Trsf               Trsf;
+    StBndBox              Bounds;   //!< bounding box of positions (without transformation), used as presentation bounds
 
         public:
 
@@ -35,6 +38,32 @@ class StPrimArray : public Standard_Transient {
 
         public:
 
+    /**
+     * Compute bounding box of positions.
+     */
+    void computeBounds() {
+        Bounds.reset();
+        const size_t aNbNodes = Positions.size();
+        if(aNbNodes == 0) {
+            return;
+        }
+
+        StGLVec3 aMin = Positions[0];
+        StGLVec3 aMax = Positions[0];
+        for(size_t aNodeIter = 1; aNodeIter < aNbNodes; ++aNodeIter) {
+            const StGLVec3& aNode = Positions[aNodeIter];
+            aMin.x() = stMin(aMin.x(), aNode.x());
+            aMin.y() = stMin(aMin.y(), aNode.y());
+            aMin.z() = stMin(aMin.z(), aNode.z());
+            aMax.x() = stMax(aMax.x(), aNode.x());
+            aMax.y() = stMax(aMax.y(), aNode.y());
+            aMax.z() = stMax(aMax.z(), aNode.z());
+        }
+        Bounds = StBndBox(aMin, aMax);
+    }
+
+        public:
+
     /**
      * Generate normals from triangles.
      * Considers the normals are initialized by ZEROs.
@@ -16,6 +16,7 @@
 #include <StGL/StGLContext.h>
 #include <StGLStereo/StFormatEnum.h>
 #include <StFile/StFileNode.h>
+#include <StThreads/StMutexProfiler.h>
 #include <StVersion.h>
 
 #include "StEventsBuffer.h"
@@ -151,7 +152,11 @@ void StApplication::stApplicationInit(const StHandle<StOpenInfo>& theOpenInfo) {
 }
 
 StApplication::~StApplication() {
-    //
+    StMutexProfiler::dump();
+    if(myOpenFileOtherApp.isNull()) {
+        // stop logging thread explicitly - not within static destruction
+        StLogger::GetDefault().shutdown();
+    }
 }
 
 StString StApplication::getAboutString() const {
@@ -434,6 +439,10 @@ void StApplication::invokeAction(const int    theActionId,
     anEvent.Action.ActionId = theActionId;
     anEvent.Action.Progress = theProgress;
     myEventsBuffer->append(anEvent);
+    if(!myWindow.isNull()) {
+        // action might be invoked from another thread - wake up main loop
+        myWindow->invalidate();
+    }
 }
 
 void StApplication::doAction(const StActionEvent& theEvent) {
@@ -495,10 +504,24 @@ void StApplication::processEvents() {
             doAction(anEvent.Action);
         }
     }
+    if(myEventsBuffer->getSize() != 0) {
+        myWindow->invalidate();
+    }
 
     // draw iteration
     beforeDraw();
-    myWindow->stglDraw();
+    if(!myMsgQueue.isNull()
+    && !myMsgQueue->isEmpty()) {
+        // pending messages should be displayed
+        myWindow->invalidate();
+    }
+    if(myWindow->toRedraw()) {
+        myWindow->stglDraw();
+    } else {
+        // nothing has been changed - block until window events or redraw request
+        // instead of redrawing the same frame
+        myWindow->waitRedraw(-1.0);
+    }
 
     const StString aDevice = myWindow->getDeviceId();
     const int32_t  aDevNum = params.ActiveDevice->getValue();
@@ -95,6 +95,7 @@ typedef NSUInteger NSEventPhase;
         [theNsWin makeFirstResponder: self];
 
         [self setAcceptsTouchEvents: YES];
+        [theNsWin setAcceptsMouseMovedEvents: YES];
         return self;
     }
 
@@ -104,6 +105,20 @@ typedef NSUInteger NSEventPhase;
         [super dealloc];
     }
 
+    /**
+     * Mouse moved - wake up main loop to track the cursor.
+     */
+    - (void ) mouseMoved: (NSEvent* ) theEvent {
+        myStWin->wakeUp();
+    }
+
+    /**
+     * Mouse moved with pressed button - wake up main loop to track the cursor.
+     */
+    - (void ) mouseDragged: (NSEvent* ) theEvent {
+        myStWin->wakeUp();
+    }
+
     /**
      * Left mouse button - down.
      */
@@ -11,6 +11,7 @@
 #define __StEventsBuffer_h_
 
 #include <StCore/StEvent.h>
+#include <StThreads/StCondition.h>
 
 /**
  * Double buffer for StWindow callback events.
@@ -36,10 +37,19 @@ class StEventsBuffer {
     : myEventsRead (new StEvent[BUFFER_SIZE]),
       myEventsWrite(new StEvent[BUFFER_SIZE]),
       mySizeRead (0),
-      mySizeWrite(0) {
+      mySizeWrite(0),
+      myWakeEvent(NULL) {
         //
     }
 
+    /**
+     * Setup event to be signaled on each appended event
+     * (to wake up the thread waiting for new events).
+     */
+    ST_LOCAL void setWakeEvent(StCondition* theEvent) {
+        myWakeEvent = theEvent;
+    }
+
     /**
      * Destructor.
      */
@@ -88,6 +98,9 @@ class StEventsBuffer {
      */
     ST_LOCAL void append(const StEvent& theEvent) {
         StMutexAuto aLock(myMutex);
+        if(myWakeEvent != NULL) {
+            myWakeEvent->set();
+        }
         if(mySizeWrite >= BUFFER_SIZE) {
             return;
         }
@@ -149,11 +162,12 @@ class StEventsBuffer {
 
         private: //! @name private fields
 
-    StMutex  myMutex;       //!< mutex for thread-safe access
-    StEvent* myEventsRead;  //!< read-only  events buffer, could be accessed by StWindow thread without lock
-    StEvent* myEventsWrite; //!< write-only events buffer, each insertion operation is protected with mutex
-    size_t   mySizeRead;    //!< number of events in read-only  buffer
-    size_t   mySizeWrite;   //!< number of events in write-only buffer
+    StMutex      myMutex;       //!< mutex for thread-safe access
+    StEvent*     myEventsRead;  //!< read-only  events buffer, could be accessed by StWindow thread without lock
+    StEvent*     myEventsWrite; //!< write-only events buffer, each insertion operation is protected with mutex
+    size_t       mySizeRead;    //!< number of events in read-only  buffer
+    size_t       mySizeWrite;   //!< number of events in write-only buffer
+    StCondition* myWakeEvent;   //!< optional event signaled on append
 
 };
 
@@ -406,6 +406,47 @@ const StString& StWindow::getStatistics() const {
     return myWin->myStatistics;
 }
 
+bool StWindow::isRedrawOnDemand() const {
+    return myWin->myIsRedrawOnDemand;
+}
+
+void StWindow::setRedrawOnDemand(const bool theToEnable) {
+    if(myWin->myIsRedrawOnDemand == theToEnable) {
+        return;
+    }
+
+    myWin->myIsRedrawOnDemand = theToEnable;
+    myWin->invalidate(0.0);
+}
+
+bool StWindow::isContinuousRedraw() const {
+    return toTrackOrientation();
+}
+
+void StWindow::invalidate() {
+    myWin->invalidate(0.0);
+}
+
+void StWindow::invalidateAfter(const double theDelaySec) {
+    myWin->invalidate(theDelaySec);
+}
+
+bool StWindow::toRedraw() {
+    const bool toDraw = myWin->toRedraw();
+    return toDraw
+        || isContinuousRedraw();
+}
+
+void StWindow::waitRedraw(const double theMaxSec) {
+    myWin->waitRedraw(theMaxSec);
+}
+
+double StWindow::getIdleRatio() const {
+    return myWin->myIsRedrawOnDemand
+         ? myWin->myIdleRatio
+         : -1.0;
+}
+
 void StWindow::setHardwareStereoOn(const bool theToEnable) {
     myWin->myToEnableStereoHW = theToEnable;
 }
@@ -19,6 +19,10 @@
     #include <sys/sysctl.h>
 #elif defined(__ANDROID__)
     #include <StCore/StAndroidGlue.h>
+#elif defined(__linux__)
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <unistd.h>
 #endif
 
 namespace {
@@ -94,7 +98,25 @@ StWindowImpl::StWindowImpl(const StHandle<StResourceManager>& theResMgr,
   myAlignDB(0),
   myLastEventsTime(0.0),
   myEventsThreaded(false),
-  myIsMouseMoved(false) {
+  myIsMouseMoved(false),
+  myRedrawEvent(true),
+  myRedrawTimer(true),
+  myRedrawDeadline(-1.0),
+  myIdleFrom(0.0),
+  myIdleTime(0.0),
+  myIdleRatio(0.0),
+  myToRedraw(true),
+  myIsRedrawOnDemand(false) {
+    myEventsBuffer.setWakeEvent(&myRedrawEvent);
+#if defined(__linux__) && !defined(__ANDROID__)
+    if(::pipe(myWakePipe) == 0) {
+        ::fcntl(myWakePipe[0], F_SETFL, O_NONBLOCK);
+        ::fcntl(myWakePipe[1], F_SETFL, O_NONBLOCK);
+    } else {
+        myWakePipe[0] = -1;
+        myWakePipe[1] = -1;
+    }
+#endif
     stMemZero(&attribs, sizeof(attribs));
     stMemZero(&signals, sizeof(signals));
     myStEvent   .Type = stEvent_None;
@@ -243,6 +265,11 @@ StWindowImpl::~StWindowImpl() {
     }
     stMemFree(myTmpTouches);
     myTmpTouches = NULL;
+#elif defined(__linux__) && !defined(__ANDROID__)
+    if(myWakePipe[0] != -1) {
+        ::close(myWakePipe[0]);
+        ::close(myWakePipe[1]);
+    }
 #endif
 
 #ifdef __APPLE__
@@ -1435,6 +1462,10 @@ void StWindowImpl::doTouch(const StTouchEvent& theTouches) {
 
 void StWindowImpl::swapEventsBuffers() {
     myEventsBuffer.swapBuffers();
+    if(myEventsBuffer.getSize() != 0
+    || myIsMouseMoved) {
+        invalidate(0.0);
+    }
     for(size_t anEventIter = 0; anEventIter < myEventsBuffer.getSize(); ++anEventIter) {
         StEvent& anEvent = myEventsBuffer.changeEvent(anEventIter);
         switch(anEvent.Type) {
@@ -1548,6 +1579,7 @@ void StWindowImpl::swapEventsBuffers() {
             if(aHoldEvent.Progress > 1.e-7) {
                 signals.onKeyHold->emit(aHoldEvent);
             }
+            invalidate(0.0);
         }
     }
     myLastEventsTime = aCurrTime;
@@ -1647,4 +1679,135 @@ void StWindowImpl::post(StEvent& theEvent) {
         case stEvent_KeyUp:   postKeyUp  (theEvent);           break;
         default:              myEventsBuffer.append(theEvent); break;
     }
+    wakeUp();
+}
+
+void StWindowImpl::invalidate(const double theDelaySec) {
+    myRedrawMutex.lock();
+    if(theDelaySec <= 0.0) {
+        myToRedraw = true;
+    } else {
+        const double aDeadline = myRedrawTimer.getElapsedTime() + theDelaySec;
+        if(myRedrawDeadline < 0.0
+        || myRedrawDeadline > aDeadline) {
+            myRedrawDeadline = aDeadline;
+        }
+    }
+    myRedrawMutex.unlock();
+
+    // wake up waiting thread to redraw or to recompute waiting time
+    wakeUp();
+}
+
+bool StWindowImpl::toRedraw() {
+    const double aTime = myRedrawTimer.getElapsedTime();
+    if(aTime - myIdleFrom >= 1.0) {
+        myIdleRatio = myIdleTime / (aTime - myIdleFrom);
+        myIdleTime  = 0.0;
+        myIdleFrom  = aTime;
+    }
+    if(!myIsRedrawOnDemand) {
+        return true;
+    }
+
+    // reset the request under the same lock as invalidate() sets it, so that no request is lost
+    StMutexAuto aLock(myRedrawMutex);
+    if(myRedrawDeadline >= 0.0
+    && myRedrawDeadline <= aTime) {
+        myRedrawDeadline = -1.0;
+        myToRedraw = true;
+    }
+    const bool toRedraw = myToRedraw;
+    myToRedraw = false;
+    return toRedraw;
+}
+
+void StWindowImpl::wakeUp() {
+    myRedrawEvent.set();
+#if defined(__ANDROID__)
+    if(myParentWin != NULL) {
+        ALooper_wake(myParentWin->getLooper());
+    }
+#elif defined(__linux__)
+    if(myWakePipe[1] != -1) {
+        const char aByte = 1;
+        if(::write(myWakePipe[1], &aByte, 1) < 0) {
+            // pipe is full - waiting thread will be woken up anyway
+        }
+    }
+#endif
+}
+
+void StWindowImpl::waitRedraw(const double theMaxSec) {
+    const double aStart = myRedrawTimer.getElapsedTime();
+    double aWaitSec = theMaxSec;
+    myRedrawMutex.lock();
+    if(myToRedraw) {
+        myRedrawMutex.unlock();
+        return;
+    }
+    if(myRedrawDeadline >= 0.0) {
+        const double aDeadlineSec = stMax(myRedrawDeadline - aStart, 0.0);
+        aWaitSec = aWaitSec < 0.0 ? aDeadlineSec : stMin(aWaitSec, aDeadlineSec);
+    }
+    // reset the wake up event while holding the lock, so that any later request wakes up this thread
+    myRedrawEvent.reset();
+    myRedrawMutex.unlock();
+
+#if defined(__APPLE__)
+    if(!myEventsThreaded) {
+        // Cocoa events are dispatched by this thread - wait in short slices
+        aWaitSec = aWaitSec < 0.0 ? 0.01 : stMin(aWaitSec, 0.01);
+    }
+#endif
+    if(aWaitSec == 0.0) {
+        return;
+    }
+
+    const int aTimeoutMs = aWaitSec < 0.0 ? -1 : int(aWaitSec * 1000.0 + 0.5);
+#if defined(__ANDROID__)
+    // input and command sources are level-triggered and will be processed by processEvents()
+    int aNbEvents = 0;
+    void* aSource = NULL;
+    ALooper_pollAll(aTimeoutMs, NULL, &aNbEvents, &aSource);
+#elif defined(__linux__)
+    // wait for X11 events or for wake up by another thread
+    const StXDisplayH& aDisplay = myMaster.stXDisplay;
+    if(!aDisplay.isNull()
+    && XEventsQueued(aDisplay->hDisplay, QueuedAfterFlush) > 0) {
+        return;
+    }
+
+    struct pollfd aFds[2];
+    int aNbFds = 0;
+    if(myWakePipe[0] != -1) {
+        aFds[aNbFds].fd      = myWakePipe[0];
+        aFds[aNbFds].events  = POLLIN;
+        aFds[aNbFds].revents = 0;
+        ++aNbFds;
+    }
+    if(!aDisplay.isNull()) {
+        aFds[aNbFds].fd      = ConnectionNumber(aDisplay->hDisplay);
+        aFds[aNbFds].events  = POLLIN;
+        aFds[aNbFds].revents = 0;
+        ++aNbFds;
+    }
+    if(aNbFds != 0) {
+        ::poll(aFds, nfds_t(aNbFds), aTimeoutMs);
+    } else {
+        myRedrawEvent.wait(size_t(stMax(aTimeoutMs, 10)));
+    }
+
+    // drain the pipe
+    char aBuffer[64];
+    while(myWakePipe[0] != -1
+       && ::read(myWakePipe[0], aBuffer, sizeof(aBuffer)) > 0) {}
+#else
+    if(aTimeoutMs < 0) {
+        myRedrawEvent.wait();
+    } else {
+        myRedrawEvent.wait(size_t(aTimeoutMs));
+    }
+#endif
+    myIdleTime += myRedrawTimer.getElapsedTime() - aStart;
 }
@@ -13,6 +13,8 @@
 #include <StCore/StWindow.h>
 #include <StCore/StSearchMonitors.h>
 #include <StCore/StKeysState.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
 
 #include "StWinHandles.h"
 #include "StEventsBuffer.h"
@@ -129,6 +131,31 @@ class StWindowImpl {
      */
     ST_LOCAL void swapEventsBuffers();
 
+    /**
+     * Request window content to be redrawn.
+     * Can be called from any thread.
+     * @param theDelaySec delay in seconds before redraw
+     */
+    ST_LOCAL void invalidate(const double theDelaySec);
+
+    /**
+     * Return true if window content should be redrawn and reset the request.
+     * Always returns true when redraw on demand is disabled.
+     */
+    ST_LOCAL bool toRedraw();
+
+    /**
+     * Block calling thread until redraw request, delayed redraw deadline, window events or timeout.
+     * @param theMaxSec maximum waiting time in seconds, negative to wait without timeout
+     */
+    ST_LOCAL void waitRedraw(const double theMaxSec);
+
+    /**
+     * Wake up the thread blocked within waitRedraw() to process new window events.
+     * Can be called from any thread.
+     */
+    ST_LOCAL void wakeUp();
+
     /**
      * @return uptime in seconds for event
      */
@@ -489,6 +516,19 @@ class StWindowImpl {
     bool           myEventsThreaded;
     bool           myIsMouseMoved;
 
+    StCondition    myRedrawEvent;      //!< event waking up the thread waiting for redraw request or window events
+    StMutex        myRedrawMutex;      //!< lock for redraw request and deadline
+    StTimer        myRedrawTimer;      //!< timer for redraw deadline and idle statistics
+    double         myRedrawDeadline;   //!< time of delayed redraw request, negative if not requested
+    double         myIdleFrom;         //!< start of current idle statistics interval
+    double         myIdleTime;         //!< time spent waiting for redraw within current interval
+    double         myIdleRatio;        //!< ratio of waiting time within last complete interval
+    bool           myToRedraw;         //!< pending redraw request
+    bool           myIsRedrawOnDemand; //!< redraw window content only on request
+#if defined(__linux__) && !defined(__ANDROID__)
+    int            myWakePipe[2];      //!< pipe waking up the thread waiting for X11 events
+#endif
+
 };
 
 #endif // __StWindowImpl_h_
@@ -66,11 +66,12 @@ namespace {
         aWinAttribsX.event_mask =  KeyPressMask   | KeyReleaseMask    // receive keyboard events
                                 | ButtonPressMask | ButtonReleaseMask // receive mouse events
                                 | StructureNotifyMask                 // receive ConfigureNotify event on resize and move
-                                | FocusChangeMask;
+                                | FocusChangeMask
+                                | PointerMotionMask | PointerMotionHintMask; // wake up idle loop on mouse motion (single event until XQueryPointer())
                               //| ResizeRedirectMask                  // receive ResizeRequest event on resize (instead of common ConfigureNotify)
                               //| ExposureMask
                               //| EnterWindowMask|LeaveWindowMask
-                              //| PointerMotionMask|PointerMotionHintMask|Button1MotionMask|Button2MotionMask|Button3MotionMask|Button4MotionMask|Button5MotionMask|ButtonMotionMask
+                              //| Button1MotionMask|Button2MotionMask|Button3MotionMask|Button4MotionMask|Button5MotionMask|ButtonMotionMask
                               //| KeymapStateMask|ExposureMask|VisibilityChangeMask
                               //| SubstructureNotifyMask|SubstructureRedirectMask
                               //| PropertyChangeMask|ColormapChangeMask|OwnerGrabButtonMask
@@ -826,6 +827,9 @@ void StWindowImpl::processEvents() {
     }
 
     int anEventsNb = XPending(aDisplay->hDisplay);
+    if(anEventsNb > 0) {
+        invalidate(0.0);
+    }
     for(int anIter = 0; anIter < anEventsNb && XPending(aDisplay->hDisplay) > 0; ++anIter) {
         XNextEvent(aDisplay->hDisplay, &myXEvent);
         switch(myXEvent.type) {
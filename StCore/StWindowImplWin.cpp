@@ -366,6 +366,9 @@ bool StWindowImpl::wndCreateWindows() {
                     DispatchMessageW(&myEvent);
                 }
 
+                // wake up main loop to process new events and mouse movements
+                wakeUp();
+
                 // well bad place for polling since it should be rarely changed
                 const bool areGlobalMKeysNew = attribs.AreGlobalMediaKeys;
                 if(areGlobalHotKeys != areGlobalMKeysNew) {
@@ -12,6 +12,7 @@
 
 #include <StGL/StGLContext.h>
 #include <StGLCore/StGLCore20.h>
+#include <StThreads/StTelemetry.h>
 
 StGLFpsLabel::StGLFpsLabel(StGLWidget* theParent)
 : StGLTextArea(theParent,
@@ -24,7 +25,8 @@ StGLFpsLabel::StGLFpsLabel(StGLWidget* theParent)
   myPlayQueued(0),
   myPlayQueueLen(0),
   myTimer(true),
-  myCounter(0) {
+  myCounter(0),
+  myToShowTelemetry(false) {
     StGLWidget::signals.onMouseUnclick.connect(this, &StGLFpsLabel::doMouseUnclick);
 
     setupAlignment(StGLTextFormatter::ST_ALIGN_X_CENTER,
@@ -44,11 +46,14 @@ void StGLFpsLabel::doMouseUnclick(const int ) {
 
 void StGLFpsLabel::update(const bool      theIsStereo,
                           const double    theTargetFps,
-                          const StString& theExtraInfo) {
+                          const StString& theExtraInfo,
+                          const double    theIdleRatio) {
     char aBuffer[128];
     const double aTime = myTimer.getElapsedTimeInSec();
     if(aTime < 1.0) {
         ++myCounter;
+        // ensure the label is refreshed when scene is redrawn on demand
+        invalidate(1.0 - aTime);
         return;
     }
 
@@ -63,10 +68,22 @@ void StGLFpsLabel::update(const bool      theIsStereo,
                   myPlayQueued, myPlayQueueLen, myPlayFps);
     }
     StString aText(aBuffer);
+    if(theIdleRatio >= 0.0) {
+        stsprintf(aBuffer, 128, "\nidle %3.0f%%", theIdleRatio * 100.0);
+        aText += aBuffer;
+    }
     if(!theExtraInfo.isEmpty()) {
         aText += "\n";
         aText += theExtraInfo;
     }
+    if(myToShowTelemetry) {
+        const StString aTelemetry = StTelemetry::GetDefault().toText(myTelemetryPrev);
+        if(!aTelemetry.isEmpty()) {
+            aText += "\n";
+            aText += aTelemetry;
+        }
+    }
     setText(aText);
     myCounter = 1;
+    invalidate(1.0);
 }
@@ -439,6 +439,13 @@ void StGLImageRegion::stglUpdate(const StPointD_t& thePointZo,
         } else if(!myHasVideoStream) {
             myFadeTimer.stop();
         }
+
+        // keep redrawing while textures are being uploaded or animation is in progress
+        if(!myTextureQueue->isEmpty()
+        ||  myFadeTimer.isOn()
+        || (myClickTimer.isOn() && isClicked(ST_MOUSE_LEFT))) {
+            invalidate();
+        }
     }
 }
 
@@ -345,6 +345,10 @@ void StGLPlayList::stglUpdate(const StPointD_t& theCursorZo,
             }
         }
     }
+    if(myFlingTimer.isOn()) {
+        // inertial scrolling is in progress
+        invalidate();
+    }
 
     StGLWidget::stglUpdate(theCursorZo, theIsPreciseInput);
 }
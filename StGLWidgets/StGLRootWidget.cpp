@@ -65,6 +65,7 @@ StGLRootWidget::StGLRootWidget(const StHandle<StResourceManager>& theResMgr)
   myFocusWidget(NULL),
   myModalDialog(NULL),
   myIsMenuPressed(false),
+  myRedrawDelay(0.0),
   myMenuIconSize(IconSize_16),
   myClickThreshold(3) {
     myRectPxFull = getRectPx();
@@ -80,7 +81,7 @@ StGLRootWidget::StGLRootWidget(const StHandle<StResourceManager>& theResMgr)
     for(size_t aResId = 0; aResId < myShareSize; ++aResId) {
         myShareArray[aResId] = new StGLSharePointer();
     }
-    myGlFontMgr = new StGLFontManager(myResolution);
+    myGlFontMgr = new StGLFontManager(myResolution, !myResMgr.isNull() ? myResMgr->getCacheFolder() : StString());
 
     myColors[Color_Menu]            = StGLVec4(0.855f, 0.855f, 0.855f, 1.0f);
     myColors[Color_MenuHighlighted] = StGLVec4(0.765f, 0.765f, 0.765f, 1.0f);
@@ -314,6 +315,20 @@ void StGLRootWidget::stglUpdate(const StPointD_t& theCursorZo,
     StGLWidget::stglUpdate(theCursorZo, theIsPreciseInput);
 }
 
+void StGLRootWidget::requestRedraw(const double theDelaySec) {
+    const double aDelay = stMax(theDelaySec, 0.0);
+    if(myRedrawDelay < 0.0
+    || myRedrawDelay > aDelay) {
+        myRedrawDelay = aDelay;
+    }
+}
+
+bool StGLRootWidget::popRedrawRequest(double& theDelaySec) {
+    theDelaySec   = myRedrawDelay;
+    myRedrawDelay = -1.0;
+    return theDelaySec >= 0.0;
+}
+
 void StGLRootWidget::stglScissorRect(const StRectI_t& theRect,
                                      StGLBoxPx&       theScissorRect) const {
     const GLint aVPortWidth  = myViewport[2];
@@ -479,6 +494,7 @@ void StGLRootWidget::destroyWithDelay(StGLWidget* theWidget) {
         return;
     }
 
+    requestRedraw(0.0);
     for(size_t anIter = 0; anIter < myDestroyList.size(); ++anIter) {
         if(theWidget == myDestroyList[anIter]) {
             return; // already appended
@@ -500,6 +516,7 @@ StGLWidget* StGLRootWidget::setFocus(StGLWidget* theWidget) {
         return myFocusWidget;
     }
 
+    requestRedraw(0.0);
     StGLWidget* aPrevWidget = myFocusWidget;
     if(aPrevWidget != NULL) {
         aPrevWidget->myHasFocus = false;
@@ -530,6 +547,7 @@ void StGLRootWidget::setModalDialog(StGLMessageBox* theWidget,
         return;
     }
 
+    requestRedraw(0.0);
     if(theToReleaseOld && myModalDialog != NULL) {
         destroyWithDelay(myModalDialog);
     }
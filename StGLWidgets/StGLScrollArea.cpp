@@ -153,6 +153,10 @@ void StGLScrollArea::stglUpdate(const StPointD_t& theCursorZo,
             doScroll(aDeltaY, true);
         }
     }
+    if(myFlingTimer.isOn()) {
+        // inertial scrolling is in progress
+        invalidate();
+    }
 
     StGLWidget::stglUpdate(theCursorZo, theIsPreciseInput);
 }
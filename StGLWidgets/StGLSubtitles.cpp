@@ -93,58 +93,35 @@ StGLSubtitles::StSubShowItems::StSubShowItems()
     //
 }
 
-bool StGLSubtitles::StSubShowItems::pop(const double thePTS) {
-    bool isChanged = false;
-    for(size_t anId = size() - 1; anId < size_t(-1); --anId) {
-        // filter outdated and forward items
-        const StHandle<StSubItem>& anItem = getValue(anId);
-        if(anItem->TimeEnd < thePTS || anItem->TimeStart > thePTS) {
-            remove(anId);
-            isChanged = true;
-        }
+bool StGLSubtitles::StSubShowItems::update(const std::vector< StHandle<StSubItem> >& theItems) {
+    bool isChanged = size() != theItems.size();
+    for(size_t anId = 0; anId < theItems.size() && !isChanged; ++anId) {
+        isChanged = getValue(anId) != theItems[anId];
     }
     if(!isChanged) {
         return false;
-    } else if(isEmpty()) {
-        Text.clear();
-        Image.nullify();
-        return true;
     }
 
-    // update active text
-    Text = getFirst()->Text;
-    for(size_t anId = 1; anId < size(); ++anId) {
-        const StHandle<StSubItem>& anItem = getValue(anId);
-        Text += StString('\n');
+    clear();
+    Text.clear();
+    Image.nullify();
+    Scale = 1.0f;
+    for(size_t anId = 0; anId < theItems.size(); ++anId) {
+        const StHandle<StSubItem>& anItem = theItems[anId];
+        if(!Text.isEmpty()) {
+            Text += StString('\n');
+        }
         Text += anItem->Text;
-    }
-
-    // update active image
-    const StImagePlane& anImage = getFirst()->Image;
-    if(!anImage.isNull()) {
-        Image.initCopy(anImage, false);
-        Scale = getFirst()->Scale;
-    } else {
-        Image.nullify();
-        Scale = 1.0f;
-    }
-
-    return isChanged;
-}
 
-void StGLSubtitles::StSubShowItems::add(const StHandle<StSubItem>& theItem) {
-    if(!Text.isEmpty()) {
-        Text += StString('\n');
-    }
-    Text += theItem->Text;
-
-    const StImagePlane& anImage = theItem->Image;
-    if(!anImage.isNull()) {
-        Image.initCopy(anImage, false);
-        Scale = theItem->Scale;
+        // only the first image is displayed
+        if(Image.isNull()
+        && !anItem->Image.isNull()) {
+            Image.initCopy(anItem->Image, false);
+            Scale = anItem->Scale;
+        }
+        StArrayList<StHandle <StSubItem> >::add(anItem);
     }
-
-    StArrayList<StHandle <StSubItem> >::add(theItem);
+    return true;
 }
 
 StGLSubtitles::StGLSubtitles(StGLImageRegion* theParent,
@@ -225,11 +202,15 @@ bool StGLSubtitles::stglInit() {
 
 void StGLSubtitles::stglUpdate(const StPointD_t& ,
                                bool ) {
-    bool isChanged = myShowItems.pop(myPTS);
-    for(StHandle<StSubItem> aNewSubItem = myQueue->pop(myPTS); !aNewSubItem.isNull(); aNewSubItem = myQueue->pop(myPTS)) {
-        isChanged = true;
-        myShowItems.add(aNewSubItem);
+    StGLContext& aCtx = getContext();
+    if(myQueue->popPendingText(myPendingText)) {
+        // rasterize glyphs of upcoming items within working thread
+        myFont->prefetchText(myPendingText, myFormatter.getDefaultStyle());
     }
+    myFont->stglUploadPrefetched(aCtx);
+
+    myQueue->getActive(myPTS, myActiveItems);
+    const bool isChanged = myShowItems.update(myActiveItems);
 
     const StGLVCorner aCorner = parseCorner(params.Place->getValue());
     bool toResize = myCorner.v != aCorner;
@@ -269,7 +250,6 @@ void StGLSubtitles::stglUpdate(const StPointD_t& ,
         stglResize();
     }
 
-    StGLContext& aCtx = getContext();
     if(isChanged) {
         setText(myShowItems.Text);
 
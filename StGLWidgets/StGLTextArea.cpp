@@ -60,6 +60,7 @@ bool StGLTextArea::setText(const StString& theText) {
     if(myText != theText) {
         myText = theText;
         myToRecompute = true;
+        invalidate();
         return true;
     }
     return false;
@@ -221,9 +222,9 @@ void StGLTextArea::recomputeBorder(StGLContext& theCtx) {
 
 void StGLTextArea::formatText(StGLContext& theCtx) {
     if(myToRecompute) {
-        myFormatter.reset();
-        myFormatter.append(theCtx, myText, *myFont);
-        myFormatter.format(myTextWidth, GLfloat(getRectPx().height()));
+        myFormatter.formatCached(theCtx, myText, *myFont, myTextWidth, GLfloat(getRectPx().height()),
+                                 myRoot->getFontManager()->getLayoutCache());
+        myFont->stglFlush(theCtx);
         myFormatter.getResult(theCtx, myTexturesList, myTextVertBuf, myTextTCrdBuf);
         myFormatter.getBndBox(myTextBndBox);
         if(myToShowBorder) {
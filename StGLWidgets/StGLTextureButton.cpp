@@ -488,6 +488,10 @@ void StGLTextureButton::stglUpdate(const StPointD_t& theCursorZo,
             myAnimTime = 0.0f;
         }
     }
+    if(myHoldTimer.isOn()
+    || myWaveTimer.isOn()) {
+        invalidate();
+    }
     StGLWidget::stglUpdate(theCursorZo, theIsPreciseInput);
 }
 
@@ -390,7 +390,16 @@ bool StGLContainer::tryUnClick(const StClickEvent& theEvent,
     return false;
 }
 
+void StGLWidget::invalidate(const double theDelaySec) {
+    if(myRoot != NULL) {
+        myRoot->requestRedraw(theDelaySec);
+    }
+}
+
 void StGLWidget::setOpacity(const float theOpacity, bool theToSetChildren) {
+    if(myOpacity != theOpacity) {
+        invalidate();
+    }
     myOpacity = theOpacity;
     if(!theToSetChildren) {
         return;
@@ -9,69 +9,244 @@
 
 #include <StGLWidgets/StSubQueue.h>
 
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    /**
+     * Tolerance for comparing time of subtitle items.
+     */
+    static const double THE_TIME_TOLERANCE = 0.001;
+
+    /**
+     * Maximum size of stored bitmap subtitles (further limited by memory budget).
+     */
+    static const size_t THE_IMAGE_BYTES_MAX = 64 * 1024 * 1024;
+
+    /**
+     * Value of empty tree node.
+     */
+    static const double THE_EMPTY_END = -1.0e100;
+
+    static bool isStartLess(const StHandle<StSubItem>& theItem,
+                            const double               theTime) {
+        return theItem->TimeStart < theTime;
+    }
+
+    static bool isLessStart(const double               theTime,
+                            const StHandle<StSubItem>& theItem) {
+        return theTime < theItem->TimeStart;
+    }
+
+    /**
+     * Return true if items have the same content and time interval.
+     */
+    static bool isSameItem(const StSubItem& theItem1,
+                           const StSubItem& theItem2) {
+        return std::abs(theItem1.TimeStart - theItem2.TimeStart) < THE_TIME_TOLERANCE
+            && std::abs(theItem1.TimeEnd   - theItem2.TimeEnd)   < THE_TIME_TOLERANCE
+            && theItem1.Image.getSizeX() == theItem2.Image.getSizeX()
+            && theItem1.Image.getSizeY() == theItem2.Image.getSizeY()
+            && theItem1.Text == theItem2.Text;
+    }
+
+}
+
 StSubQueue::StSubQueue()
-: myFront(NULL),
-  myBack(NULL),
+: myTreeLeaves(0),
+  myIsTreeValid(false),
+  myImageBytes(0),
+  myLastPts(0.0),
+  myMemClient("subtitles.images", StMemoryClient::Role_Cache, 1),
   myMutex() {
     //
 }
 
 StSubQueue::~StSubQueue() {
-    for(QueueItem* anItem = myFront; anItem != NULL; anItem = myFront) {
-        myFront = myFront->myNext;
-        delete anItem;
-    }
+    //
 }
 
 bool StSubQueue::isEmpty() {
     myMutex.lock();
-    bool aResult = myFront == NULL;
+    bool aResult = myItems.empty();
     myMutex.unlock();
     return aResult;
 }
 
+size_t StSubQueue::getSize() {
+    StMutexAuto aLock(myMutex);
+    return myItems.size();
+}
+
 void StSubQueue::clear() {
     myMutex.lock();
-    for(QueueItem* anItem = myFront; anItem != NULL; anItem = myFront) {
-        myFront = myFront->myNext;
-        delete anItem;
-    }
+    myItems.clear();
+    myTreeEnd.clear();
+    myTreeLeaves  = 0;
+    myIsTreeValid = false;
+    myImageBytes  = 0;
+    myMemClient.setBytes(0);
+    myPendingText.clear();
     myMutex.unlock();
 }
 
-StHandle<StSubItem> StSubQueue::pop(const double thePTS) {
+void StSubQueue::rebuildTree() {
+    myTreeLeaves = 1;
+    while(myTreeLeaves < myItems.size()) {
+        myTreeLeaves *= 2;
+    }
+    myTreeEnd.assign(myTreeLeaves * 2, THE_EMPTY_END);
+    for(size_t anIter = 0; anIter < myItems.size(); ++anIter) {
+        myTreeEnd[myTreeLeaves + anIter] = myItems[anIter]->TimeEnd;
+    }
+    for(size_t aNode = myTreeLeaves - 1; aNode > 0; --aNode) {
+        myTreeEnd[aNode] = stMax(myTreeEnd[aNode * 2], myTreeEnd[aNode * 2 + 1]);
+    }
+    myIsTreeValid = true;
+}
+
+void StSubQueue::updateTree(const size_t theIndex) {
+    size_t aNode = myTreeLeaves + theIndex;
+    myTreeEnd[aNode] = myItems[theIndex]->TimeEnd;
+    for(aNode /= 2; aNode > 0; aNode /= 2) {
+        myTreeEnd[aNode] = stMax(myTreeEnd[aNode * 2], myTreeEnd[aNode * 2 + 1]);
+    }
+}
+
+void StSubQueue::findActive(const size_t theNode,
+                            const size_t theNodeFrom,
+                            const size_t theNodeTo,
+                            const size_t theIndexTo,
+                            const double thePTS,
+                            std::vector< StHandle<StSubItem> >& theItems) const {
+    if(theNodeFrom >= theIndexTo
+    || myTreeEnd[theNode] < thePTS) {
+        return;
+    } else if(theNode >= myTreeLeaves) {
+        theItems.push_back(myItems[theNode - myTreeLeaves]);
+        return;
+    }
+
+    const size_t aMid = (theNodeFrom + theNodeTo) / 2;
+    findActive(theNode * 2,     theNodeFrom, aMid,      theIndexTo, thePTS, theItems);
+    findActive(theNode * 2 + 1, aMid,        theNodeTo, theIndexTo, thePTS, theItems);
+}
+
+bool StSubQueue::getActive(const double thePTS,
+                           std::vector< StHandle<StSubItem> >& theItems) {
+    theItems.clear();
+    StMutexAuto aLock(myMutex);
+    myLastPts = thePTS;
+    if(myItems.empty()) {
+        return false;
+    }
+
+    // the limit is reduced under memory pressure
+    if(myImageBytes > getImageBytesLimit()) {
+        evictImages();
+    }
+
+    if(!myIsTreeValid) {
+        rebuildTree();
+    }
+
+    // items starting after PTS are not active
+    const size_t anIndexTo = std::upper_bound(myItems.begin(), myItems.end(), thePTS, isLessStart) - myItems.begin();
+    findActive(1, 0, myTreeLeaves, anIndexTo, thePTS, theItems);
+    return !theItems.empty();
+}
+
+void StSubQueue::push(const StHandle<StSubItem>& theSubItem) {
+    if(theSubItem.isNull()) {
+        return;
+    }
+
     myMutex.lock();
-    for(QueueItem* anItem = myFront; anItem != NULL;) {
-        if(anItem->myItem->TimeEnd < thePTS) {
-            // remove outdated items
-            myFront = myFront->myNext;
-            delete anItem;
-            anItem = myFront;
-        } else if(anItem->myItem->TimeStart <= thePTS) {
-            // pop the item
-            StHandle<StSubItem> aSubItem = anItem->myItem;
-            myFront = myFront->myNext;
-            delete anItem;
+    std::vector< StHandle<StSubItem> >::iterator anIter = std::lower_bound(myItems.begin(), myItems.end(),
+                                                                           theSubItem->TimeStart - THE_TIME_TOLERANCE, isStartLess);
+    for(; anIter != myItems.end() && (*anIter)->TimeStart <= theSubItem->TimeStart + THE_TIME_TOLERANCE; ++anIter) {
+        if(isSameItem(**anIter, *theSubItem)) {
+            // already decoded before seeking
             myMutex.unlock();
-            return aSubItem;
+            return;
+        }
+    }
+
+    // most items come in order - just update the tree in this case
+    std::vector< StHandle<StSubItem> >::iterator aPos = std::upper_bound(myItems.begin(), myItems.end(),
+                                                                         theSubItem->TimeStart, isLessStart);
+    if(aPos == myItems.end()) {
+        myItems.push_back(theSubItem);
+        if(myIsTreeValid
+        && myItems.size() <= myTreeLeaves) {
+            updateTree(myItems.size() - 1);
         } else {
-            // no more items to show
-            myMutex.unlock();
-            return StHandle<StSubItem>();
+            myIsTreeValid = false;
+        }
+    } else {
+        myItems.insert(aPos, theSubItem);
+        myIsTreeValid = false;
+    }
+
+    if(!theSubItem->Image.isNull()) {
+        myImageBytes += theSubItem->Image.getSizeBytes();
+        if(myImageBytes > getImageBytesLimit()) {
+            evictImages();
+        }
+        myMemClient.setBytes(myImageBytes);
+    }
+
+    if(!theSubItem->Text.isEmpty()
+    &&  myPendingText.Size < 65536) { // the text is only a hint - do not let it grow unbounded
+        if(!myPendingText.isEmpty()) {
+            myPendingText += StString('\n');
         }
+        myPendingText += theSubItem->Text;
     }
     myMutex.unlock();
-    return StHandle<StSubItem>();
 }
 
-void StSubQueue::push(const StHandle<StSubItem>& theSubItem) {
-    myMutex.lock();
-    QueueItem* anItem = new QueueItem(theSubItem);
-    if(myFront == NULL) {
-        myFront = myBack = anItem;
-    } else {
-        myBack->myNext = anItem;
-        myBack = anItem;
+size_t StSubQueue::getImageBytesLimit() const {
+    return stMin(THE_IMAGE_BYTES_MAX, myMemClient.getLimit());
+}
+
+void StSubQueue::evictImages() {
+    const size_t aLimit = getImageBytesLimit();
+    while(myImageBytes > aLimit) {
+        size_t aFarIndex = size_t(-1);
+        double aFarDist  = -1.0;
+        for(size_t anIter = 0; anIter < myItems.size(); ++anIter) {
+            const StSubItem& anItem = *myItems[anIter];
+            if(anItem.Image.isNull()) {
+                continue;
+            }
+
+            const double aDist = anItem.TimeStart > myLastPts
+                               ? anItem.TimeStart - myLastPts
+                               : stMax(myLastPts - anItem.TimeEnd, 0.0);
+            if(aDist > aFarDist) {
+                aFarDist  = aDist;
+                aFarIndex = anIter;
+            }
+        }
+        if(aFarIndex == size_t(-1)) {
+            myImageBytes = 0;
+            break;
+        }
+
+        // evicted item will be decoded once again when needed
+        myImageBytes -= stMin(myImageBytes, myItems[aFarIndex]->Image.getSizeBytes());
+        myItems.erase(myItems.begin() + aFarIndex);
+        myIsTreeValid = false;
     }
+    myMemClient.setBytes(myImageBytes);
+}
+
+bool StSubQueue::popPendingText(StString& theText) {
+    myMutex.lock();
+    theText = myPendingText;
+    myPendingText.clear();
     myMutex.unlock();
+    return !theText.isEmpty();
 }
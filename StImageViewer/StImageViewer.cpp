@@ -130,6 +130,7 @@ StImageViewer::StImageViewer(const StHandle<StResourceManager>& theResMgr,
   myPlayList(new StPlayList(1, false)),
   myAppName(!theAppName.isEmpty() ? theAppName : ST_DRAWER_PLUGIN_NAME),
   myEventLoaded(false),
+  myEventNewFrame(false),
   //
   mySlideShowTimer(false),
   //
@@ -543,6 +544,7 @@ bool StImageViewer::init() {
     myLoader = new StImageLoader(params.imageLib, myResMgr, myMsgQueue, myLangMap, myPlayList,
                                  myGUI->myImage->getTextureQueue(), myContext->getMaxTextureSize());
     myLoader->signals.onLoaded.connect(this, &StImageViewer::doLoaded);
+    myGUI->myImage->getTextureQueue()->signals.onNewFrame.connect(this, &StImageViewer::doNewFrame);
     myLoader->setCompressMemory(myWindow->isMobile());
     myLoader->setSwapJPS(params.ToSwapJPS->getValue());
     myLoader->setStickPano360(params.ToStickPanorama->getValue());
@@ -1077,6 +1079,10 @@ void StImageViewer::beforeDraw() {
 
     if(myEventLoaded.checkReset()) {
         doUpdateStateLoaded();
+        myWindow->invalidate();
+    }
+    if(myEventNewFrame.checkReset()) {
+        myWindow->invalidate();
     }
 
     if(myToCheckUpdates && !myUpdates.isNull() && myUpdates->isInitialized()) {
@@ -1093,6 +1099,19 @@ void StImageViewer::beforeDraw() {
 
     // for image viewer it is OK to make longer smoothed uploads
     myGUI->myImage->getTextureQueue()->getUploadParams().MaxUploadIterations = 10;
+
+    // still image does not need to be redrawn until something is changed;
+    // paused window is handled by continuous loop to track inactivity
+    myWindow->setRedrawOnDemand(!myWindow->isPaused());
+    invalidateFromGui();
+}
+
+void StImageViewer::invalidateFromGui() {
+    double aDelay = 0.0;
+    if(!myGUI.isNull()
+    &&  myGUI->popRedrawRequest(aDelay)) {
+        myWindow->invalidateAfter(aDelay);
+    }
 }
 
 void StImageViewer::stglDraw(unsigned int theView) {
@@ -1149,6 +1168,7 @@ void StImageViewer::stglDraw(unsigned int theView) {
 
     // draw GUI
     myGUI->stglDraw(theView);
+    invalidateFromGui();
 }
 
 void StImageViewer::doScaleGui(const int32_t ) {
@@ -1415,6 +1435,10 @@ void StImageViewer::doLoaded() {
     myEventLoaded.set();
 }
 
+void StImageViewer::doNewFrame() {
+    myEventNewFrame.set();
+}
+
 void StImageViewer::doShowPlayList(const bool theToShow) {
     if(myGUI.isNull()
     || myGUI->myPlayList == NULL) {
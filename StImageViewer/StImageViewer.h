@@ -119,6 +119,11 @@ class StImageViewer : public StApplication {
      */
     ST_LOCAL void doLoaded();
 
+    /**
+     * Handler for new frame pushed into textures queue (called from loader thread).
+     */
+    ST_LOCAL void doNewFrame();
+
         public: //! @name Properties
 
     struct {
@@ -255,6 +260,11 @@ class StImageViewer : public StApplication {
      */
     ST_LOCAL void releaseDevice();
 
+    /**
+     * Pass pending redraw requests of GUI widgets to the window.
+     */
+    ST_LOCAL void invalidateFromGui();
+
         private: //! @name private fields
 
     StHandle<StGLContext>       myContext;
@@ -269,6 +279,7 @@ class StImageViewer : public StApplication {
     StString                    myAppName;         //!< name of customized application
 
     StCondition                 myEventLoaded;     //!< indicate that new file was open
+    StCondition                 myEventNewFrame;   //!< indicate that new frame has been pushed into textures queue
     StTimer                     myInactivityTimer; //!< timer initialized when application goes into paused state
     StTimer                     mySlideShowTimer;  //!< slideshow timer
 
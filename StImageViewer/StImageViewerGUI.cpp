@@ -1418,6 +1418,19 @@ void StImageViewerGUI::setVisibility(const StPointD_t& theCursor,
     if(isMouseActive) {
         myVisibilityTimer.restart();
     }
+
+    // schedule redraw for pending visibility changes
+    const double anIdleLeft = THE_VISIBILITY_IDLE_TIME - myVisibilityTimer.getElapsedTime();
+    if(anIdleLeft > 0.0) {
+        invalidate(anIdleLeft);
+    }
+    if(myEmptyTimer.isOn()) {
+        invalidate(2.5 - myEmptyTimer.getElapsedTime());
+    }
+    if(myTapTimer.isOn()) {
+        invalidate(0.5 - myTapTimer.getElapsedTime());
+    }
+
     const bool  toShowAll = !myIsMinimalGUI && myIsVisibleGUI && !theToForceHide;
     const float anOpacity = (float )myVisLerp.perform(toShowAll, theToForceHide || theToForceShow);
 
@@ -1601,7 +1614,8 @@ void StImageViewerGUI::stglDraw(unsigned int theView) {
     && myFpsWidget != NULL) {
         myFpsWidget->update(myPlugin->getMainWindow()->isStereoOutput(),
                             myPlugin->getMainWindow()->getTargetFps(),
-                            myPlugin->getMainWindow()->getStatistics());
+                            myPlugin->getMainWindow()->getStatistics(),
+                            myPlugin->getMainWindow()->getIdleRatio());
     }
     StGLRootWidget::stglDraw(theView);
 }
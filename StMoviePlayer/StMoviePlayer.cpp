@@ -23,12 +23,15 @@
 #include "StMoviePlayerGUI.h"
 #include "StMoviePlayerStrings.h"
 #include "StVideo/StVideo.h"
+#include "StVideo/StSnapshotEncoder.h"
 #include "StTimeBox.h"
 
 #include <StImage/StImageFile.h>
 #include <StSocket/StCheckUpdates.h>
 #include <StSettings/StSettings.h>
 #include <StStrings/StStringStream.h>
+#include <StThreads/StAtomicOp.h>
+#include <StThreads/StTracer.h>
 #include <StCore/StSearchMonitors.h>
 
 #include <StGL/StGLContext.h>
@@ -80,6 +83,12 @@ namespace {
     static const char ST_ARGUMENT_WINTOP[]     = "windowTop";
     static const char ST_ARGUMENT_WINWIDTH[]   = "windowWidth";
     static const char ST_ARGUMENT_WINHEIGHT[]  = "windowHeight";
+    static const char ST_ARGUMENT_TRACE_FILE[] = "traceFile";
+
+    static const double THE_WEB_POLL_TIMEOUT  = 20.0; //!< maximum duration of long-poll /status request (within mongoose request timeout)
+    static const double THE_WEB_PING_INTERVAL = 15.0; //!< interval for keep-alive comments within /events stream
+    static const int    THE_WEB_THREADS_NB    = 50;   //!< number of working threads of Web UI server
+    static const int    THE_WEB_EVENTS_MAX    = 16;   //!< maximum number of /events subscribers, leaving other threads for control requests
 
 }
 
@@ -152,6 +161,7 @@ void StMoviePlayer::updateStrings() {
     params.ToTrackHeadAudio->setName(tr(MENU_VIEW_TRACK_HEAD_AUDIO));
     params.ToForceBFormat->setName(stCString("Force B-Format"));
     params.ToShowFps->setName(tr(MENU_FPS_METER));
+    params.ToShowTelemetry->setName(stCString("Show pipeline telemetry"));
     params.ToShowMenu->setName(stCString("Show main menu"));
     params.ToShowTopbar->setName(stCString("Show top toolbar"));
     params.ToShowBottom->setName(stCString("Show seekbar"));
@@ -202,11 +212,18 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
 : StApplication(theResMgr, theParentWin, theOpenInfo),
   myPlayList(new StPlayList(4, true)),
   myEventLoaded(false),
+  myEventNewFrame(false),
   mySeekOnLoad(-1.0),
   myAudioOnLoad(-1),
   mySubsOnLoad(-1),
   //
   myWebCtx(NULL),
+  myWebStatusEvent(new StCondition(false)),
+  myWebStatusVer(0),
+  myWebToStop(false),
+  myWebToSwapLR(false),
+  myWebNbEvents(0),
+  myTelDraw(StTelemetry::GetDefault().getHistogram("render.draw")),
   //
   myToUpdateALList(false),
   myToCheckUpdates(true),
@@ -286,6 +303,7 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     params.ToTrackHeadAudio = new StBoolParamNamed(true,  stCString("toTrackHeadAudio"));
     params.ToForceBFormat   = new StBoolParamNamed(false, stCString("toForceBFormat"));
     params.ToShowFps   = new StBoolParamNamed(false, stCString("toShowFps"));
+    params.ToShowTelemetry = new StBoolParamNamed(false, stCString("toShowTelemetry"));
     params.ToShowMenu  = new StBoolParamNamed(true,  stCString("toShowMenu"));
     params.ToShowTopbar= new StBoolParamNamed(true,  stCString("toShowTopbar"));
     params.ToShowBottom= new StBoolParamNamed(true,  stCString("toShowBottom"));
@@ -365,6 +383,7 @@ StMoviePlayer::StMoviePlayer(const StHandle<StResourceManager>& theResMgr,
     mySettings->loadParam (params.ToForceBFormat);
     mySettings->loadParam (params.AudioAlHrtf);
     mySettings->loadParam (params.ToShowFps);
+    mySettings->loadParam (params.ToShowTelemetry);
     mySettings->loadParam (params.SlideShowDelay);
     mySettings->loadParam (params.ToMixImagesVideos);
     mySettings->loadParam (params.IsMobileUI);
@@ -623,6 +642,7 @@ void StMoviePlayer::saveAllParams() {
         mySettings->saveParam (params.ToTrackHeadAudio);
         mySettings->saveParam (params.ToForceBFormat);
         mySettings->saveParam (params.ToShowFps);
+        mySettings->saveParam (params.ToShowTelemetry);
         mySettings->saveParam (params.SlideShowDelay);
         mySettings->saveParam (params.ToMixImagesVideos);
         mySettings->saveParam (params.IsMobileUI);
@@ -675,6 +695,15 @@ StMoviePlayer::~StMoviePlayer() {
     releaseDevice();
     // wait video playback thread to quit and release resources
     myVideo.nullify();
+
+    StTracer& aTracer = StTracer::GetDefault();
+    if(aTracer.isEnabled()
+    && !aTracer.getFilePath().isEmpty()) {
+        aTracer.setEnabled(false);
+        if(aTracer.save()) {
+            ST_DEBUG_LOG("StMoviePlayer, trace has been saved into '" + aTracer.getFilePath() + "'");
+        }
+    }
 }
 
 bool StMoviePlayer::createGui(StHandle<StGLTextureQueue>& theTextureQueue,
@@ -781,8 +810,17 @@ void StMoviePlayer::doDeleteFileEnd(const size_t ) {
 void StMoviePlayer::doStopWebUI() {
 #ifdef ST_HAVE_MONGOOSE
     if(myWebCtx != NULL) {
+        // release clients waiting for status change - mg_stop() waits for all working threads
+        myWebStatusMutex.lock();
+        myWebToStop = true;
+        myWebStatusEvent->set();
+        myWebStatusEvent = new StCondition(false);
+        myWebStatusMutex.unlock();
+
         mg_stop(myWebCtx);
-        myWebCtx = NULL;
+        myWebCtx    = NULL;
+        myWebToStop = false;
+        myWebSnapshots.nullify();
     }
 #endif
 }
@@ -803,9 +841,16 @@ void StMoviePlayer::doStartWebUI() {
     if(params.IsLocalWebUI->getValue()) {
         aControlList = "-0.0.0.0/0,+127.0.0.0/16";
     }
+    // each client subscribed to /events occupies one working thread
+    const StString aNbThreads = StString(THE_WEB_THREADS_NB);
     const char* anOptions[] = { "listening_ports",     aPort.toCString(),
                                 "access_control_list", aControlList.toCString(),
+                                "num_threads",         aNbThreads.toCString(),
                                 NULL };
+    myWebState = WebStatus(); // force status update
+    if(!myVideo.isNull()) {
+        myWebSnapshots = new StSnapshotEncoder(myVideo->getTextureQueue());
+    }
     myWebCtx = mg_start(&aCallbacks, this, anOptions);
     if(myWebCtx == NULL
     && params.ToPrintWebErrors->getValue()) {
@@ -888,6 +933,7 @@ bool StMoviePlayer::init() {
                               myResMgr, myLangMap, myPlayList, aTextureQueue, aSubQueue);
         myVideo->signals.onError  = stSlot(myMsgQueue.access(), &StMsgQueue::doPushError);
         myVideo->signals.onLoaded = stSlot(this,                &StMoviePlayer::doLoaded);
+        aTextureQueue->signals.onNewFrame.connect(this, &StMoviePlayer::doNewFrame);
         myVideo->params.UseGpu       = params.UseGpu;
         myVideo->params.UseOpenJpeg  = params.UseOpenJpeg;
         myVideo->params.ToSearchSubs = params.ToSearchSubs;
@@ -955,6 +1001,13 @@ void StMoviePlayer::parseArguments(const StArgumentsMap& theArguments) {
     StArgument anArgWinTop     = theArguments[ST_ARGUMENT_WINTOP];
     StArgument anArgWinWidth   = theArguments[ST_ARGUMENT_WINWIDTH];
     StArgument anArgWinHeight  = theArguments[ST_ARGUMENT_WINHEIGHT];
+    StArgument anArgTraceFile  = theArguments[ST_ARGUMENT_TRACE_FILE];
+    if(anArgTraceFile.isValid()) {
+        // record playback threads activity and save it on exit
+        StTracer::GetDefault().setFilePath(anArgTraceFile.getValue());
+        StTracer::GetDefault().setEnabled(true);
+    }
+
     StRect<int32_t> aRect = myWindow->getWindowedPlacement();
     bool toSetRect = false;
     if(anArgMonitor.isValid()) {
@@ -1512,6 +1565,10 @@ void StMoviePlayer::beforeDraw() {
 
     if(myEventLoaded.checkReset()) {
         doUpdateStateLoaded();
+        myWindow->invalidate();
+    }
+    if(myEventNewFrame.checkReset()) {
+        myWindow->invalidate();
     }
 
     if(myToCheckUpdates && !myUpdates.isNull() && myUpdates->isInitialized()) {
@@ -1538,6 +1595,7 @@ void StMoviePlayer::beforeDraw() {
     if(myGUI->mySeekBar != NULL) {
         myGUI->mySeekBar->setProgress(GLfloat(aPosition));
     }
+    updateWebStatus(aPts, aDuration, isPlaying);
     myGUI->stglUpdate(myWindow->getMousePos(), myWindow->isPreciseCursor());
 
     // prevent display going to sleep
@@ -1582,6 +1640,9 @@ void StMoviePlayer::beforeDraw() {
     // check for mono state
     bool hasStereoSource = false;
     StHandle<StStereoParams> aParams = myGUI->myImage->getSource();
+    myWebStatusMutex.lock();
+    myWebToSwapLR = !aParams.isNull() && aParams->ToSwapLR;
+    myWebStatusMutex.unlock();
     if(!aParams.isNull()) {
         StGLQuaternion aHeadOrient;
         const bool toTrackHead = params.ToTrackHeadAudio->getValue()
@@ -1637,6 +1698,20 @@ void StMoviePlayer::beforeDraw() {
         aMaxUploadFrames = 1;
     }
     myVideo->getTextureQueue()->getUploadParams().MaxUploadIterations = stMax(stMin(aMaxUploadFrames, 3), 1);
+
+    // playback requires continuous redraw, while paused video can be redrawn on demand
+    myWindow->setRedrawOnDemand(!isPlaying
+                             && !myWindow->isPaused()
+                             && !params.Benchmark->getValue());
+    invalidateFromGui();
+}
+
+void StMoviePlayer::invalidateFromGui() {
+    double aDelay = 0.0;
+    if(!myGUI.isNull()
+    &&  myGUI->popRedrawRequest(aDelay)) {
+        myWindow->invalidateAfter(aDelay);
+    }
 }
 
 void StMoviePlayer::doUpdateOpenALDeviceList(const size_t ) {
@@ -1686,7 +1761,12 @@ void StMoviePlayer::stglDraw(unsigned int theView) {
     }
 
     myGUI->changeCamera()->setView(theView);
-    myGUI->stglDraw(theView);
+    {
+        StTelemetryTimer aTelTimer(myTelDraw);
+        ST_TRACE_SCOPE("stglDraw");
+        myGUI->stglDraw(theView);
+    }
+    invalidateFromGui();
 }
 
 void StMoviePlayer::doShowPlayList(const bool theToShow) {
@@ -1914,6 +1994,10 @@ void StMoviePlayer::doLoaded() {
     myEventLoaded.set();
 }
 
+void StMoviePlayer::doNewFrame() {
+    myEventNewFrame.set();
+}
+
 void StMoviePlayer::doListFirst(const size_t ) {
     if(myPlayList->walkToFirst()) {
         myVideo->doLoadNext();
@@ -2122,6 +2206,141 @@ void StMoviePlayer::getRecentList(StArrayList<StString>& theList) {
     myPlayList->getRecentList(theList);
 }
 
+void StMoviePlayer::updateWebStatus(const double thePts,
+                                    const double theDuration,
+                                    const bool   theIsPlaying) {
+    if(myWebCtx == NULL) {
+        return;
+    }
+
+    WebStatus aState;
+    aState.Serial    = myPlayList->getSerial();
+    aState.ItemsNb   = myPlayList->getItemsCount();
+    aState.ItemId    = myPlayList->getCurrentId();
+    aState.Volume    = int(gainToVolume(params.AudioGain) * 100.0f);
+    aState.Position  = int(thePts);
+    aState.Duration  = int(theDuration);
+    aState.IsPlaying = theIsPlaying;
+    if(!(aState != myWebState)) {
+        return;
+    }
+
+    myWebState = aState;
+    const StString aStatus = StString("serial:") + aState.Serial
+                           + "\ncount:"    + aState.ItemsNb
+                           + "\nitem:"     + aState.ItemId
+                           + "\nvolume:"   + aState.Volume
+                           + "\nplaying:"  + (aState.IsPlaying ? 1 : 0)
+                           + "\nposition:" + aState.Position
+                           + "\nduration:" + aState.Duration
+                           + "\ntitle:"    + myPlayList->getCurrentTitle();
+
+    // wake up all waiting clients and prepare new event for the next change
+    myWebStatusMutex.lock();
+    myWebStatus = aStatus;
+    ++myWebStatusVer;
+    myWebStatusEvent->set();
+    myWebStatusEvent = new StCondition(false);
+    myWebStatusMutex.unlock();
+}
+
+size_t StMoviePlayer::waitWebStatus(const size_t theVersion,
+                                    const double theTimeoutSec,
+                                    StString&    theStatus) {
+    myWebStatusMutex.lock();
+    if(myWebStatusVer == theVersion
+    && !myWebToStop) {
+        StHandle<StCondition> anEvent = myWebStatusEvent;
+        myWebStatusMutex.unlock();
+        anEvent->wait(size_t(theTimeoutSec * 1000.0));
+        myWebStatusMutex.lock();
+    }
+    theStatus = myWebStatus;
+    const size_t aVersion = myWebStatusVer;
+    myWebStatusMutex.unlock();
+    return aVersion;
+}
+
+void StMoviePlayer::sendWebEvents(mg_connection* theConnection) {
+#ifdef ST_HAVE_MONGOOSE
+    const StString aHeader = "HTTP/1.1 200 OK\r\n"
+                             "Content-Type: text/event-stream; charset=utf-8\r\n"
+                             "Cache-Control: no-cache\r\n"
+                             "Connection: close\r\n"
+                             "\r\n"
+                             "retry: 2000\n\n";
+    if(mg_write(theConnection, aHeader.toCString(), aHeader.getSize()) <= 0) {
+        return;
+    }
+
+    const StString aLineBreak = "\n";
+    const StString aDataBreak = "\ndata: ";
+    size_t aVersion = 0;
+    for(;;) {
+        StString aStatus;
+        const size_t aNewVersion = waitWebStatus(aVersion, THE_WEB_PING_INTERVAL, aStatus);
+        if(myWebToStop) {
+            return;
+        }
+
+        StString anEvent;
+        if(aNewVersion == aVersion) {
+            // comment line keeps connection alive and detects disconnected clients
+            anEvent = ": ping\n\n";
+        } else {
+            aVersion = aNewVersion;
+            anEvent  = StString("id: ") + aVersion + "\ndata: " + aStatus.replace(aLineBreak, aDataBreak) + "\n\n";
+        }
+        if(mg_write(theConnection, anEvent.toCString(), anEvent.getSize()) <= 0) {
+            return;
+        }
+    }
+#else
+    (void )theConnection;
+#endif
+}
+
+void StMoviePlayer::sendWebSnapshot(mg_connection*  theConnection,
+                                    const StString& theQuery) {
+#ifdef ST_HAVE_MONGOOSE
+    StSnapshotEncoder::View aView = StSnapshotEncoder::View_Left;
+    if(theQuery.isEquals(stCString("right"))) {
+        aView = StSnapshotEncoder::View_Right;
+    } else if(theQuery.isEquals(stCString("sbs"))) {
+        aView = StSnapshotEncoder::View_SideBySide;
+    }
+
+    myWebStatusMutex.lock();
+    const bool toSwapLR = myWebToSwapLR;
+    myWebStatusMutex.unlock();
+
+    StHandle<StSnapshotJpeg> aJpeg;
+    if(!myWebSnapshots.isNull()) {
+        aJpeg = myWebSnapshots->getJpeg(aView, toSwapLR);
+    }
+    if(aJpeg.isNull()) {
+        // nothing is displayed (yet)
+        const StString anAnswer = "HTTP/1.1 503 Service Unavailable\r\n"
+                                  "Retry-After: 1\r\n"
+                                  "Content-Length: 0\r\n"
+                                  "\r\n";
+        mg_write(theConnection, anAnswer.toCString(), anAnswer.getSize());
+        return;
+    }
+
+    const StString aHeader = StString("HTTP/1.1 200 OK\r\n"
+                                      "Content-Type: image/jpeg\r\n"
+                                      "Cache-Control: no-cache\r\n"
+                                      "Content-Length: ") + aJpeg->DataSize + "\r\n"
+                           + "\r\n";
+    mg_write(theConnection, aHeader.toCString(), aHeader.getSize());
+    mg_write(theConnection, aJpeg->Buffer.getBuffer(), aJpeg->DataSize);
+#else
+    (void )theConnection;
+    (void )theQuery;
+#endif
+}
+
 int StMoviePlayer::beginRequest(mg_connection*         theConnection,
                                 const mg_request_info& theRequestInfo) {
 #ifdef ST_HAVE_MONGOOSE
@@ -2150,6 +2369,7 @@ int StMoviePlayer::beginRequest(mg_connection*         theConnection,
 
     // process AJAX requests
     StString aContent;
+    StString aHeaders;
     if(anURI.isEquals(stCString("/prev"))) {
         invokeAction(Action_ListPrev);
         aContent = "open previous item in playlist...";
@@ -2173,6 +2393,32 @@ int StMoviePlayer::beginRequest(mg_connection*         theConnection,
     } else if(anURI.isEquals(stCString("/fullscr_win"))) {
         invokeAction(Action_Fullscreen);
         aContent = "switch fullscreen/windowed...";
+    } else if(anURI.isEquals(stCString("/snapshot"))) {
+        // downscaled JPEG of displayed frame
+        sendWebSnapshot(theConnection, aQuery);
+        return 1;
+    } else if(anURI.isEquals(stCString("/events"))) {
+        // push status changes as Server-Sent Events;
+        // the number of subscribers is limited so that some working threads are always left for control requests
+        if(StAtomicOp::Increment(myWebNbEvents) <= THE_WEB_EVENTS_MAX) {
+            sendWebEvents(theConnection);
+        } else {
+            const StString anAnswer = "HTTP/1.1 503 Service Unavailable\r\n"
+                                      "Retry-After: 10\r\n"
+                                      "Content-Length: 0\r\n"
+                                      "\r\n";
+            mg_write(theConnection, anAnswer.toCString(), anAnswer.getSize());
+        }
+        StAtomicOp::Decrement(myWebNbEvents);
+        return 1;
+    } else if(anURI.isEquals(stCString("/status"))) {
+        // long-poll - reply as soon as status differs from the version known by the client
+        StCLocale aCLocale;
+        const size_t aKnownVer = (size_t )stStringToLong(aQuery.toCString(), 10, aCLocale);
+        StString aStatus;
+        const size_t aVersion = waitWebStatus(aKnownVer, THE_WEB_POLL_TIMEOUT, aStatus);
+        aContent = StString("version:") + aVersion + "\n" + aStatus;
+        aHeaders = "Cache-Control: no-cache\r\n";
     } else if(anURI.isEquals(stCString("/current"))) {
         if(aQuery.isEquals(stCString("id"))) {
             aContent = StString(myPlayList->getSerial())
@@ -2190,10 +2436,61 @@ int StMoviePlayer::beginRequest(mg_connection*         theConnection,
         aContent = "open item...";
     } else if(anURI.isEquals(stCString("/version"))) {
         aContent = StVersionInfo::getSDKVersionString();
+    } else if(anURI.isEquals(stCString("/telemetry"))) {
+        // pipeline counters and latency histograms
+        const StString aJson = StTelemetry::GetDefault().toJson();
+        const StString anAnswer = StString("HTTP/1.1 200 OK\r\n"
+                                           "Content-Type: application/json; charset=utf-8\r\n"
+                                           "Cache-Control: no-cache\r\n"
+                                           "Content-Length: ") + aJson.getSize() + "\r\n"
+                                + "\r\n" + aJson;
+        mg_write(theConnection, anAnswer.toCString(), anAnswer.getSize());
+        return 1;
+    } else if(anURI.isEquals(stCString("/trace"))) {
+        // Chrome trace-event JSON recorded so far (empty when tracing is disabled)
+        std::string aJson;
+        StTracer::GetDefault().toJson(aJson);
+        const StString aHeader = StString("HTTP/1.1 200 OK\r\n"
+                                          "Content-Type: application/json; charset=utf-8\r\n"
+                                          "Content-Disposition: attachment; filename=\"sview_trace.json\"\r\n"
+                                          "Cache-Control: no-cache\r\n"
+                                          "Content-Length: ") + aJson.size() + "\r\n"
+                               + "\r\n";
+        mg_write(theConnection, aHeader.toCString(), aHeader.getSize());
+        mg_write(theConnection, aJson.c_str(), aJson.size());
+        return 1;
     } else if(anURI.isEquals(stCString("/playlist"))) {
-        // return current playlist
+        // return current playlist or its page (?from=N&count=M);
+        // playlist content is identified by serial and size, so that unchanged list is not transferred again
+        StCLocale aCLocale;
+        size_t aFrom  = 0;
+        size_t aCount = size_t(-1);
+        char aBuff[32];
+        if(mg_get_var(aQuery.toCString(), aQuery.getSize(), "from", aBuff, sizeof(aBuff)) > 0) {
+            aFrom = (size_t )stMax(stStringToLong(aBuff, 10, aCLocale), 0L);
+        }
+        if(mg_get_var(aQuery.toCString(), aQuery.getSize(), "count", aBuff, sizeof(aBuff)) > 0) {
+            aCount = (size_t )stMax(stStringToLong(aBuff, 10, aCLocale), 0L);
+        }
+
+        const size_t   anItemsNb = myPlayList->getItemsCount();
+        const StString anETag    = StString("\"") + myPlayList->getSerial() + "-" + anItemsNb
+                                 + "-" + aFrom + "-" + (aCount != size_t(-1) ? StString(aCount) : StString("all")) + "\"";
+        const char* aClientTag = mg_get_header(theConnection, "If-None-Match");
+        if(aClientTag != NULL
+        && anETag.isEquals(StString(aClientTag))) {
+            const StString anAnswer = StString("HTTP/1.1 304 Not Modified\r\n"
+                                               "ETag: ") + anETag + "\r\n"
+                                               "\r\n";
+            mg_write(theConnection, anAnswer.toCString(), anAnswer.getSize());
+            return 1;
+        }
+        aHeaders = StString("ETag: ") + anETag + "\r\n"
+                 + "Cache-Control: no-cache\r\n"
+                 + "X-Playlist-Size: " + anItemsNb + "\r\n";
+
         StArrayList<StString> aList;
-        myPlayList->getSubList(aList, 0, size_t(-1));
+        myPlayList->getSubList(aList, aFrom, aCount != size_t(-1) ? aFrom + aCount : size_t(-1));
         if(!aList.isEmpty()) {
             for(size_t anIter = 0;;) {
                 aContent += aList[anIter++];
@@ -2224,9 +2521,10 @@ int StMoviePlayer::beginRequest(mg_connection*         theConnection,
 
     const StString anAnswer = StString("HTTP/1.1 200 OK\r\n"
                                        //"Content-Type: text/html; charset=utf-8\r\n"
-                                       "Content-Type: text/plain; charset=utf-8\r\n"
-                                       "Content-Length: ") + aContent.getSize() + "\r\n"
-                                        "\r\n" + aContent;
+                                       "Content-Type: text/plain; charset=utf-8\r\n")
+                            + aHeaders
+                            + "Content-Length: " + aContent.getSize() + "\r\n"
+                            + "\r\n" + aContent;
 
     // send HTTP reply to the client
     mg_write(theConnection, anAnswer.toCString(), anAnswer.getSize());
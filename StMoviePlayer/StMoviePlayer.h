@@ -24,6 +24,8 @@
 #include <StSettings/StFloat32Param.h>
 #include <StGLStereo/StFormatEnum.h>
 #include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StTelemetry.h>
 #include <StThreads/StThread.h>
 
 #include <StGLWidgets/StGLImageRegion.h>
@@ -39,6 +41,7 @@ class StMovieOpenDialog;
 class StMoviePlayerGUI;
 class StPlayList;
 class StSettings;
+class StSnapshotEncoder;
 class StStereoParams;
 class StSubQueue;
 class StVideo;
@@ -112,6 +115,11 @@ class StMoviePlayer : public StApplication {
      */
     ST_LOCAL void doLoaded();
 
+    /**
+     * Handler for new frame pushed into textures queue (called from video thread).
+     */
+    ST_LOCAL void doNewFrame();
+
     ST_LOCAL void doPlayListReverse(const size_t dummy = 0);
     ST_LOCAL void doListFirst(const size_t dummy = 0);
     ST_LOCAL void doListPrev(const size_t dummy = 0);
@@ -212,6 +220,7 @@ class StMoviePlayer : public StApplication {
         StHandle<StBoolParamNamed>    ToShowPlayList;    //!< display playlist
         StHandle<StBoolParamNamed>    ToShowAdjustImage; //!< display image adjustment overlay
         StHandle<StBoolParamNamed>    ToShowFps;         //!< display FPS meter
+        StHandle<StBoolParamNamed>    ToShowTelemetry;   //!< display pipeline telemetry within FPS meter
         StHandle<StBoolParamNamed>    ToShowMenu;        //!< show main menu
         StHandle<StBoolParamNamed>    ToShowTopbar;      //!< show topbar
         StHandle<StBoolParamNamed>    ToShowBottom;      //!< show bottom (seekbar)
@@ -280,6 +289,11 @@ class StMoviePlayer : public StApplication {
      */
     ST_LOCAL void releaseDevice();
 
+    /**
+     * Pass pending redraw requests of GUI widgets to the window.
+     */
+    ST_LOCAL void invalidateFromGui();
+
     ST_LOCAL static GLfloat gainToVolume(const StHandle<StFloat32Param>& theGain) {
         return (theGain->getMinValue() - theGain->getValue()) / theGain->getMinValue();
     }
@@ -381,6 +395,65 @@ class StMoviePlayer : public StApplication {
     ST_LOCAL void doStartWebUI();
     ST_LOCAL void doSwitchWebUI(const int32_t theValue);
 
+    /**
+     * Update status snapshot for Web UI clients and wake up those waiting for changes.
+     * Should be called from the main thread.
+     */
+    ST_LOCAL void updateWebStatus(const double thePts,
+                                  const double theDuration,
+                                  const bool   theIsPlaying);
+
+    /**
+     * Wait until status snapshot becomes different from specified version.
+     * @param theVersion    version known by the client
+     * @param theTimeoutSec maximum waiting time
+     * @param theStatus     current status snapshot
+     * @return version of returned snapshot
+     */
+    ST_LOCAL size_t waitWebStatus(const size_t theVersion,
+                                  const double theTimeoutSec,
+                                  StString&    theStatus);
+
+    /**
+     * Stream status changes to the client as Server-Sent Events
+     * until connection is closed or Web UI is stopped.
+     */
+    ST_LOCAL void sendWebEvents(mg_connection* theConnection);
+
+    /**
+     * Reply with JPEG preview of displayed frame.
+     * @param theQuery view to send - "left", "right" or "sbs"
+     */
+    ST_LOCAL void sendWebSnapshot(mg_connection*  theConnection,
+                                  const StString& theQuery);
+
+        private:
+
+    /**
+     * Values composing the status of Web UI.
+     */
+    struct WebStatus {
+        int32_t Serial;    //!< playlist serial
+        size_t  ItemsNb;   //!< playlist size
+        size_t  ItemId;    //!< current item in playlist
+        int     Volume;    //!< audio volume in percents
+        int     Position;  //!< playback position in seconds
+        int     Duration;  //!< duration in seconds
+        bool    IsPlaying; //!< playback state
+
+        ST_LOCAL WebStatus() : Serial(-1), ItemsNb(0), ItemId(size_t(-1)), Volume(-1), Position(-1), Duration(-1), IsPlaying(false) {}
+
+        ST_LOCAL bool operator!=(const WebStatus& theOther) const {
+            return Serial    != theOther.Serial
+                || ItemsNb   != theOther.ItemsNb
+                || ItemId    != theOther.ItemId
+                || Volume    != theOther.Volume
+                || Position  != theOther.Position
+                || Duration  != theOther.Duration
+                || IsPlaying != theOther.IsPlaying;
+        }
+    };
+
         private: //! @name private fields
 
     StHandle<StGLContext>       myContext;
@@ -394,12 +467,23 @@ class StMoviePlayer : public StApplication {
     StHandle<StMovieOpenDialog> myOpenDialog;      //!< file open dialog
 
     StCondition                 myEventLoaded;     //!< indicate that new file was open
+    StCondition                 myEventNewFrame;   //!< indicate that new frame has been pushed into textures queue
     StTimer                     myInactivityTimer; //!< timer initialized when application goes into paused state
     double                      mySeekOnLoad;      //!< seeking target
     int32_t                     myAudioOnLoad;     //!< audio     track on load
     int32_t                     mySubsOnLoad;      //!< subtitles track on load
 
     mg_context*                 myWebCtx;          //!< web UI context
+    WebStatus                   myWebState;        //!< values of the last status snapshot (main thread)
+    StMutex                     myWebStatusMutex;  //!< lock for status snapshot and displayed views swap flag
+    StHandle<StCondition>       myWebStatusEvent;  //!< event signaled (and replaced) on status change
+    StString                    myWebStatus;       //!< status snapshot for Web UI clients
+    size_t                      myWebStatusVer;    //!< status snapshot version
+    volatile bool               myWebToStop;       //!< flag to release Web UI clients waiting for status change
+    bool                        myWebToSwapLR;     //!< flag indicating that displayed views are swapped (guarded by myWebStatusMutex)
+    volatile int32_t            myWebNbEvents;     //!< number of clients subscribed to /events
+    StHandle<StSnapshotEncoder> myWebSnapshots;    //!< encoder of frame previews for Web UI
+    StTelemetryHistogram*       myTelDraw;         //!< telemetry - time to draw the view
 
     bool                        myToUpdateALList;
     bool                        myToCheckUpdates;
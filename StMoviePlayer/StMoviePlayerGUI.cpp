@@ -904,6 +904,7 @@ StGLMenu* StMoviePlayerGUI::createFpsMenu() {
     StGLMenu* aMenu = new StGLMenu(this, 0, 0, StGLMenu::MENU_VERTICAL);
     aMenu->addItem(myPlugin->params.IsVSyncOn);
     aMenu->addItem(myPlugin->params.ToShowFps);
+    aMenu->addItem(myPlugin->params.ToShowTelemetry);
     aMenu->addItem(myPlugin->params.ToLimitFps);
     return aMenu;
 }
@@ -1956,6 +1957,18 @@ void StMoviePlayerGUI::setVisibility(const StPointD_t& theCursor,
         myVisibilityTimer.restart();
     }
 
+    // schedule redraw for pending visibility changes
+    const double anIdleLeft = THE_VISIBILITY_IDLE_TIME - myVisibilityTimer.getElapsedTime();
+    if(anIdleLeft > 0.0) {
+        invalidate(anIdleLeft);
+    }
+    if(myEmptyTimer.isOn()) {
+        invalidate(2.5 - myEmptyTimer.getElapsedTime());
+    }
+    if(myTapTimer.isOn()) {
+        invalidate(0.5 - myTapTimer.getElapsedTime());
+    }
+
     if(myMenuRoot != NULL) {
         myMenuRoot->setOpacity(hasMainMenu ? anOpacity : 0.0f, false);
     }
@@ -2258,9 +2271,11 @@ void StMoviePlayerGUI::stglDraw(unsigned int theView) {
         myImage->getTextureQueue()->getQueueInfo(myFpsWidget->changePlayQueued(),
                                                  myFpsWidget->changePlayQueueLength(),
                                                  myFpsWidget->changePlayFps());
+        myFpsWidget->setShowTelemetry(myPlugin->params.ToShowTelemetry->getValue());
         myFpsWidget->update(myPlugin->getMainWindow()->isStereoOutput(),
                             myPlugin->getMainWindow()->getTargetFps(),
-                            myPlugin->getMainWindow()->getStatistics());
+                            myPlugin->getMainWindow()->getStatistics(),
+                            myPlugin->getMainWindow()->getIdleRatio());
     }
     StGLRootWidget::stglDraw(theView);
 }
@@ -39,7 +39,9 @@ struct StAVPacketQueue::QueueItem {
 
 };
 
-StAVPacketQueue::StAVPacketQueue(const size_t theSizeLimit)
+StAVPacketQueue::StAVPacketQueue(const size_t    theSizeLimit,
+                                 const StString& theMemName,
+                                 const size_t    theMemWeight)
 : myFormatCtx(NULL),
   myStream(NULL),
   myCodecCtx(NULL),
@@ -65,8 +67,12 @@ StAVPacketQueue::StAVPacketQueue(const size_t theSizeLimit)
   mySize(0),
   mySizeLimit(theSizeLimit),
   mySizeSeconds(0.0),
+  mySizeBytes(0),
+  myMemClient(theMemName, StMemoryClient::Role_Queue, theMemWeight),
   myMutex() {
-    //
+    myEventMutex.setName("StAVPacketQueue::myEventMutex");
+    myMutex     .setName("StAVPacketQueue::myMutex");
+    myMutexInfo .setName("StAVPacketQueue::myMutexInfo");
 }
 
 StAVPacketQueue::~StAVPacketQueue() {
@@ -82,6 +88,8 @@ void StAVPacketQueue::clear() {
         pop();
     }
     mySizeSeconds = 0.0;
+    mySizeBytes   = 0;
+    myMemClient.setBytes(0);
     myMutex.unlock();
 }
 
@@ -228,6 +236,8 @@ StHandle<StAVPacket> StAVPacketQueue::pop() {
         delete anItem;
         --mySize;
         mySizeSeconds -= aPacket->getDurationSeconds();
+        mySizeBytes   -= stMin(mySizeBytes, size_t(stMax(aPacket->getSize(), 0)));
+        myMemClient.setBytes(mySizeBytes);
     myMutex.unlock();
     return aPacket;
 }
@@ -243,6 +253,8 @@ void StAVPacketQueue::push(const StAVPacket& thePacket) {
         }
         ++mySize;
         mySizeSeconds += thePacket.getDurationSeconds();
+        mySizeBytes   += size_t(stMax(thePacket.getSize(), 0));
+        myMemClient.setBytes(mySizeBytes);
     myMutex.unlock();
 }
 
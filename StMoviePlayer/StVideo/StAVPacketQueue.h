@@ -19,6 +19,7 @@
 #ifndef __StAVPacketQueue_h_
 #define __StAVPacketQueue_h_
 
+#include <StThreads/StMemoryBudget.h>
 #include <StThreads/StMutex.h>
 #include <StTemplates/StHandle.h>
 #include <StSlots/StSignal.h>
@@ -48,8 +49,12 @@ class StAVPacketQueue {
 
     /**
      * @param theSizeLimit (const size_t& ) - queue size limit.
+     * @param theMemName   name of the queue within memory budget
+     * @param theMemWeight share of memory budget
      */
-    ST_LOCAL StAVPacketQueue(const size_t theSizeLimit);
+    ST_LOCAL StAVPacketQueue(const size_t    theSizeLimit,
+                             const StString& theMemName,
+                             const size_t    theMemWeight);
 
     ST_LOCAL virtual ~StAVPacketQueue();
 
@@ -80,8 +85,8 @@ class StAVPacketQueue {
     ST_LOCAL void push(const StAVPacket& thePacket);
 
     ST_LOCAL void pushStart();
-    ST_LOCAL void pushEnd();
-    ST_LOCAL void pushQuit();
+    ST_LOCAL virtual void pushEnd();
+    ST_LOCAL virtual void pushQuit();
     ST_LOCAL void pushFlush();
 
     /**
@@ -96,10 +101,14 @@ class StAVPacketQueue {
 
     /**
      * Returns true if queue is full.
+     * Besides packets number, the queue is limited by duration
+     * and by memory budget (so that queue depth is adapted to bitrate).
      */
     ST_LOCAL bool isFull() const {
         myMutex.lock();
-            bool aResult = (mySize >= mySizeLimit) || (mySizeSeconds >= 5.0);
+            bool aResult = (mySize >= mySizeLimit)
+                        || (mySizeSeconds >= 10.0)
+                        || (mySizeBytes >= myMemClient.getLimit() && mySizeSeconds >= 0.5);
             //if(mySize >= mySizeLimit) { ST_DEBUG_LOG("stream" + streamId + " sizeSeconds= " + sizeSeconds + "; mySize= " + mySize); }
         myMutex.unlock();
         return aResult;
@@ -274,6 +283,8 @@ class StAVPacketQueue {
     size_t           mySize;           //!< packets number in queue
     size_t           mySizeLimit;      //!< packets limit
     double           mySizeSeconds;    //!< cumulative packets length in seconds
+    size_t           mySizeBytes;      //!< cumulative packets size in bytes
+    StMemoryClient   myMemClient;      //!< memory budget client
     mutable StMutex  myMutex;          //!< lock for thread-safety
 
         protected:
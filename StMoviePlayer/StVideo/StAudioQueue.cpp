@@ -20,6 +20,7 @@
 
 #include <StGL/StGLVec.h>
 #include <StThreads/StThread.h>
+#include <StThreads/StTracer.h>
 
 namespace {
 
@@ -312,7 +313,7 @@ static SV_THREAD_FUNCTION threadFunction(void* audioQueue) {
 
 StAudioQueue::StAudioQueue(const std::string& theAlDeviceName,
                            StAudioQueue::StAlHrtfRequest theAlHrtf)
-: StAVPacketQueue(512),
+: StAVPacketQueue(512, "packets.audio", 1),
   myPlaybackTimer(false),
   myDowntimeEvent(true),
   myAvSrcFormat(-1),
@@ -338,7 +339,10 @@ StAudioQueue::StAudioQueue(const std::string& theAlDeviceName,
   myAlHrtf(theAlHrtf),
   myAlHrtfPrev(theAlHrtf),
   myDbgPrevQueued(-1),
-  myDbgPrevSrcState(-1) {
+  myDbgPrevSrcState(-1),
+  myTelDecode   (StTelemetry::GetDefault().getHistogram("audio.decode")),
+  myTelAlQueued (StTelemetry::GetDefault().getGauge    ("audio.alQueued")),
+  myTelUnderruns(StTelemetry::GetDefault().getCounter  ("audio.underruns")) {
     stMemSet(myAlSources, 0, sizeof(myAlSources));
 
     // launch thread parse incoming packets from queue
@@ -908,6 +912,7 @@ bool StAudioQueue::stalQueue(const double thePts) {
     ALenum aState = stalGetSourceState();
     alGetSourcei(myAlSources[0], AL_BUFFERS_PROCESSED, &aProcessed);
     alGetSourcei(myAlSources[0], AL_BUFFERS_QUEUED,    &aQueued);
+    myTelAlQueued->setValue(aQueued - aProcessed);
 
 #ifdef ST_DEBUG
     if(myDbgPrevQueued != aQueued) {
@@ -928,6 +933,11 @@ bool StAudioQueue::stalQueue(const double thePts) {
         return false; // wait until tail of previous stream played
     }
 
+    if(aState  == AL_STOPPED
+    && aQueued == THE_NUM_AL_BUFFERS) {
+        // all buffers have been played before new data arrived
+        myTelUnderruns->increment();
+    }
     if(myPrevFormat    != myAlFormat
     || myPrevFrequency != myBufferOut.getFreq()
     || (aState  == AL_STOPPED
@@ -1049,6 +1059,7 @@ bool StAudioQueue::stalCheckConnected() {
 
 void StAudioQueue::stalFillBuffers(const double thePts,
                                    const bool   toIgnoreEvents) {
+    ST_TRACE_SCOPE("stalFillBuffers");
     if(!toIgnoreEvents) {
         parseEvents();
     }
@@ -1112,6 +1123,7 @@ void StAudioQueue::decodePacket(const StHandle<StAVPacket>& thePacket,
     for(;;) {
         while(anAudioPktSize > 0) {
             int aDataSize = (int )myBufferSrc.getBufferSizeWhole();
+            StTimer aDecodeTimer(true);
 
         #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 106, 102))
             (void )aDataSize;
@@ -1158,6 +1170,7 @@ void StAudioQueue::decodePacket(const StHandle<StAVPacket>& thePacket,
                 anAudioPktSize = 0;
                 break;
             }
+            myTelDecode->addSeconds(aDecodeTimer.getElapsedTimeInSec());
 
             anAudioPktData += aLen1;
             anAudioPktSize -= aLen1;
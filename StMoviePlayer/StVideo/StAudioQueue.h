@@ -22,6 +22,7 @@
 #include <StStrings/StString.h>
 #include <StSettings/StFloat32Param.h>
 #include <StThreads/StCondition.h>
+#include <StThreads/StTelemetry.h>
 #include <StThreads/StTimer.h>
 
 #include <StAV/StAVFrame.h>
@@ -386,6 +387,12 @@ class StAudioQueue : public StAVPacketQueue {
     ALint              myDbgPrevQueued;
     ALenum             myDbgPrevSrcState;
 
+        private: //! @name telemetry items
+
+    StTelemetryHistogram* myTelDecode;    //!< time to decode the frame
+    StTelemetryGauge*     myTelAlQueued;  //!< number of OpenAL buffers waiting for playback
+    StTelemetryCounter*   myTelUnderruns; //!< number of times OpenAL source has been stopped due to lack of data
+
 };
 
 #endif //__StAudioQueue_h_
@@ -0,0 +1,197 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StSnapshotEncoder.h"
+
+#include <StAV/StAVImage.h>
+#include <StStrings/StLogger.h>
+
+namespace {
+
+    static const double THE_UPDATE_INTERVAL = 0.5;  //!< minimal interval between updates of the same view in seconds
+    static const double THE_FIRST_TIMEOUT   = 2.0;  //!< maximum time to wait for the first image in seconds
+    static const size_t THE_MAX_SIZE_X      = 1280; //!< maximum width  of the preview
+    static const size_t THE_MAX_SIZE_Y      = 720;  //!< maximum height of the preview
+    static const int    THE_JPEG_QUALITY    = 8;    //!< JPEG quantizer, lesser is better
+
+}
+
+SV_THREAD_FUNCTION StSnapshotEncoder::threadFunction(void* theEncoder) {
+    StSnapshotEncoder* anEncoder = (StSnapshotEncoder* )theEncoder;
+    anEncoder->mainLoop();
+    return SV_THREAD_RETURN 0;
+}
+
+StSnapshotEncoder::StSnapshotEncoder(const StHandle<StGLTextureQueue>& theTextureQueue)
+: myTextureQueue(theTextureQueue),
+  myEvent(false),
+  myDoneEvent(false),
+  myRequested(0),
+  myTimer(true),
+  myFrameGen(0),
+  myToQuit(false) {
+    myThread = new StThread(threadFunction, (void* )this, "StSnapshotEncoder");
+}
+
+StSnapshotEncoder::~StSnapshotEncoder() {
+    myToQuit = true;
+    myEvent.set();
+    myDoneEvent.set();
+    myThread->wait();
+    myThread.nullify();
+}
+
+StHandle<StSnapshotJpeg> StSnapshotEncoder::getJpeg(const View theView,
+                                                    const bool theToSwap) {
+    int aView = theView;
+    if(theToSwap) {
+        if(theView == View_Left) {
+            aView = View_Right;
+        } else if(theView == View_Right) {
+            aView = View_Left;
+        }
+    }
+    if(aView < 0 || aView >= View_NB) {
+        return StHandle<StSnapshotJpeg>();
+    }
+
+    myMutex.lock();
+    Cached& aCache = myCache[aView];
+    const double aTime = myTimer.getElapsedTimeInSec();
+    if(aCache.RequestTime < 0.0
+    || aTime - aCache.RequestTime >= THE_UPDATE_INTERVAL) {
+        aCache.RequestTime = aTime;
+        myRequested |= (1 << aView);
+        myEvent.set();
+    }
+
+    // wait for the first image, but only when there is a displayed frame to encode
+    const bool toWait = aCache.Jpeg.isNull()
+                     && myTextureQueue->hasSnapshot();
+    for(StTimer aWaitTimer(true); toWait && aCache.Jpeg.isNull() && !myToQuit;) {
+        const double aTimeLeft = THE_FIRST_TIMEOUT - aWaitTimer.getElapsedTimeInSec();
+        if(aTimeLeft <= 0.0) {
+            break;
+        }
+        myMutex.unlock();
+        myDoneEvent.wait(stMax(size_t(aTimeLeft * 1000.0), size_t(1)));
+        myMutex.lock();
+    }
+    StHandle<StSnapshotJpeg> aJpeg = aCache.Jpeg;
+    myMutex.unlock();
+    return aJpeg;
+}
+
+void StSnapshotEncoder::mainLoop() {
+    for(;;) {
+        myEvent.wait();
+        if(myToQuit) {
+            return;
+        }
+
+        myMutex.lock();
+        myEvent.reset();
+        myDoneEvent.reset();
+        const int aRequested = myRequested;
+        myRequested = 0;
+        myMutex.unlock();
+
+        // copy the frame only when it has been changed;
+        // this is the only place touching the queue
+        if(myTextureQueue->getSnapshot(&myFrameL, &myFrameR, myFrameL.isNull()) == StGLTextureQueue::SNAPSHOT_SUCCESS) {
+            ++myFrameGen;
+        }
+        if(myFrameL.isNull()) {
+            continue;
+        }
+
+        for(int aView = 0; aView < View_NB && !myToQuit; ++aView) {
+            if((aRequested & (1 << aView)) == 0) {
+                continue;
+            }
+
+            myMutex.lock();
+            const bool isUpToDate = !myCache[aView].Jpeg.isNull()
+                                 && myCache[aView].FrameGen == myFrameGen;
+            myMutex.unlock();
+            if(isUpToDate) {
+                continue;
+            }
+
+            StHandle<StSnapshotJpeg> aJpeg = encodeView(aView);
+            if(aJpeg.isNull()) {
+                continue;
+            }
+
+            myMutex.lock();
+            myCache[aView].Jpeg     = aJpeg;
+            myCache[aView].FrameGen = myFrameGen;
+            myDoneEvent.set();
+            myMutex.unlock();
+        }
+    }
+}
+
+StHandle<StSnapshotJpeg> StSnapshotEncoder::encodeView(const int theView) const {
+    const StImage* aSources[2] = { &myFrameL, NULL };
+    size_t aViewsNb = 1;
+    const StImage& aFrameR = !myFrameR.isNull() ? myFrameR : myFrameL;
+    if(theView == View_Right) {
+        aSources[0] = &aFrameR;
+    } else if(theView == View_SideBySide) {
+        aSources[1] = &aFrameR;
+        aViewsNb    = 2;
+    }
+
+    // compute downscaled dimensions preserving aspect ratio;
+    // view width is multiple of 16 to keep the second view aligned
+    const StImage& aSrc   = *aSources[0];
+    const double anAspect = double(aSrc.getPixelRatio()) * double(aSrc.getSizeX()) / double(stMax(aSrc.getSizeY(), size_t(1)));
+    size_t aSizeX = stMin(aSrc.getSizeX(), THE_MAX_SIZE_X / aViewsNb);
+    size_t aSizeY = size_t(double(aSizeX) / anAspect);
+    if(aSizeY > THE_MAX_SIZE_Y) {
+        aSizeY = THE_MAX_SIZE_Y;
+        aSizeX = size_t(double(aSizeY) * anAspect);
+    }
+    aSizeX = stMax(aSizeX & ~size_t(15), size_t(16));
+    aSizeY = stMax(aSizeY & ~size_t(1),  size_t(2));
+
+    // scale and convert all views into the single RGB image
+    StAVImage anImage;
+    anImage.setColorModel(StImage::ImgColor_RGB);
+    if(!anImage.changePlane(0).initTrash(StImagePlane::ImgRGB, aSizeX * aViewsNb, aSizeY, getAligned(aSizeX * aViewsNb * 3))) {
+        return StHandle<StSnapshotJpeg>();
+    }
+    for(size_t aViewIter = 0; aViewIter < aViewsNb; ++aViewIter) {
+        StImage aPart;
+        aPart.setColorModel(StImage::ImgColor_RGB);
+        aPart.changePlane(0).initWrapper(StImagePlane::ImgRGB, anImage.changePlane(0).changeData(0, aViewIter * aSizeX),
+                                         aSizeX, aSizeY, anImage.getPlane(0).getSizeRowBytes());
+        if(!StAVImage::resize(*aSources[aViewIter], aPart)) {
+            ST_DEBUG_LOG("StSnapshotEncoder, unable to scale the frame");
+            return StHandle<StSnapshotJpeg>();
+        }
+    }
+
+    StHandle<StSnapshotJpeg> aJpeg = new StSnapshotJpeg();
+    if(!anImage.encode(aJpeg->Buffer, aJpeg->DataSize, StImageFile::ST_TYPE_JPEG, StFormat_AUTO, THE_JPEG_QUALITY)) {
+        ST_DEBUG_LOG("StSnapshotEncoder, " + anImage.getState());
+        return StHandle<StSnapshotJpeg>();
+    }
+    return aJpeg;
+}
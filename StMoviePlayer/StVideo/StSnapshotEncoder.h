@@ -0,0 +1,131 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StSnapshotEncoder_h_
+#define __StSnapshotEncoder_h_
+
+#include <StFile/StRawFile.h>
+#include <StGLStereo/StGLTextureQueue.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThread.h>
+#include <StThreads/StTimer.h>
+
+/**
+ * Encoded snapshot.
+ */
+struct StSnapshotJpeg {
+
+    StRawFile Buffer;   //!< buffer holding encoded data
+    size_t    DataSize; //!< encoded data size
+
+    ST_LOCAL StSnapshotJpeg() : DataSize(0) {}
+
+};
+
+/**
+ * Auxiliary class producing downscaled JPEG previews of the currently displayed frame
+ * within dedicated working thread.
+ * Encoded images are cached and refreshed not more often than specified interval,
+ * so that many clients requesting preview will not load neither decoding nor rendering threads.
+ */
+class StSnapshotEncoder {
+
+        public:
+
+    /**
+     * Snapshot view.
+     */
+    enum View {
+        View_Left = 0,   //!< left  view
+        View_Right,      //!< right view (left one for mono sources)
+        View_SideBySide, //!< both views side by side
+        View_NB
+    };
+
+        public:
+
+    /**
+     * Main constructor, starts the working thread.
+     * @param theTextureQueue queue to take frames from
+     */
+    ST_LOCAL StSnapshotEncoder(const StHandle<StGLTextureQueue>& theTextureQueue);
+
+    /**
+     * Destructor, stops the working thread.
+     */
+    ST_LOCAL ~StSnapshotEncoder();
+
+    /**
+     * Return the last encoded image of specified view and request its update when outdated.
+     * The call waits for the encoding only when there is no image yet and some frame has been displayed.
+     * @param theView   view to retrieve
+     * @param theToSwap swap left and right views
+     * @return encoded image or NULL if nothing is displayed
+     */
+    ST_LOCAL StHandle<StSnapshotJpeg> getJpeg(const View theView,
+                                              const bool theToSwap);
+
+        private:
+
+    /**
+     * Thread function.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION threadFunction(void* theEncoder);
+
+    /**
+     * Main loop of the working thread.
+     */
+    ST_LOCAL void mainLoop();
+
+    /**
+     * Encode specified view of the last fetched frame.
+     */
+    ST_LOCAL StHandle<StSnapshotJpeg> encodeView(const int theView) const;
+
+        private:
+
+    /**
+     * Cached result for one view.
+     */
+    struct Cached {
+        StHandle<StSnapshotJpeg> Jpeg;        //!< last encoded image
+        double                   RequestTime; //!< time of last update request in seconds
+        size_t                   FrameGen;    //!< generation of frame used for encoding
+
+        ST_LOCAL Cached() : RequestTime(-1.0), FrameGen(0) {}
+    };
+
+        private:
+
+    StHandle<StGLTextureQueue> myTextureQueue;   //!< source of frames
+    StHandle<StThread>         myThread;         //!< working thread
+    StCondition                myEvent;          //!< event to wake up working thread
+    StCondition                myDoneEvent;      //!< event signaled when new images have been encoded
+    StMutex                    myMutex;          //!< lock for fields below
+    Cached                     myCache[View_NB]; //!< cached images
+    int                        myRequested;      //!< bitmask of views to be encoded
+    StTimer                    myTimer;          //!< timer to limit update rate
+    StImage                    myFrameL;         //!< copy of last fetched frame (working thread)
+    StImage                    myFrameR;         //!< copy of last fetched frame (working thread)
+    size_t                     myFrameGen;       //!< generation of last fetched frame (working thread)
+    volatile bool              myToQuit;         //!< flag to stop working thread
+
+};
+
+#endif // __StSnapshotEncoder_h_
@@ -22,10 +22,145 @@
 #include <StThreads/StThread.h>
 
 #include <StAV/StAVImage.h>
+#include <StStrings/StLogger.h>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+    #define ST_SUBS_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define ST_SUBS_TARGET(theIsa)
+    #else
+        #define ST_SUBS_TARGET(theIsa) __attribute__((target(theIsa)))
+    #endif
+#endif
 
 namespace {
     static const StString ST_CRLF_REDUNDANT   = "\x0D\x0A";
     static const StString ST_CRLF_REPLACEMENT = " \x0A";
+
+    /**
+     * Detect AVX2 support (CPU and OS saving YMM state).
+     */
+    static bool detectAvx2() {
+    #if defined(ST_SUBS_X86)
+      #if defined(_MSC_VER)
+        int aRegs[4] = { 0, 0, 0, 0 };
+        __cpuid(aRegs, 0);
+        const int aMaxLeaf = aRegs[0];
+        __cpuid(aRegs, 1);
+        const bool hasOsAvx = (aRegs[2] & (1 << 27)) != 0  // OSXSAVE
+                           && (aRegs[2] & (1 << 28)) != 0  // AVX
+                           && (_xgetbv(0) & 0x6) == 0x6;   // XMM and YMM state saved by OS
+        if(aMaxLeaf < 7 || !hasOsAvx) {
+            return false;
+        }
+        __cpuidex(aRegs, 7, 0);
+        return (aRegs[1] & (1 << 5)) != 0;
+      #else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+      #endif
+    #else
+        return false;
+    #endif
+    }
+
+    /**
+     * @return true if AVX2 path can be used (detected once)
+     */
+    static bool hasAvx2() {
+        static const bool THE_HAS_AVX2 = detectAvx2();
+        return THE_HAS_AVX2;
+    }
+
+    /**
+     * Expand the row using look-up table, 4 pixels per iteration.
+     */
+    static void expandRowScalar(uint32_t*       theDst,
+                                const uint8_t*  theSrc,
+                                const size_t    theFrom,
+                                const size_t    theSizeX,
+                                const uint32_t* theLut) {
+        size_t aCol = theFrom;
+        for(; aCol + 4 <= theSizeX; aCol += 4) {
+            theDst[aCol    ] = theLut[theSrc[aCol    ]];
+            theDst[aCol + 1] = theLut[theSrc[aCol + 1]];
+            theDst[aCol + 2] = theLut[theSrc[aCol + 2]];
+            theDst[aCol + 3] = theLut[theSrc[aCol + 3]];
+        }
+        for(; aCol < theSizeX; ++aCol) {
+            theDst[aCol] = theLut[theSrc[aCol]];
+        }
+    }
+
+#if defined(ST_SUBS_X86)
+    /**
+     * Expand the row using AVX2 gather, 8 pixels per iteration.
+     * @return number of expanded pixels
+     */
+    ST_SUBS_TARGET("avx2")
+    static size_t expandRowAvx2(uint32_t*       theDst,
+                                const uint8_t*  theSrc,
+                                const size_t    theSizeX,
+                                const uint32_t* theLut) {
+        size_t aCol = 0;
+        for(; aCol + 8 <= theSizeX; aCol += 8) {
+            const __m128i anIdx8  = _mm_loadl_epi64((const __m128i* )(theSrc + aCol));
+            const __m256i anIdx32 = _mm256_cvtepu8_epi32(anIdx8);
+            const __m256i aPixels = _mm256_i32gather_epi32((const int* )theLut, anIdx32, 4);
+            _mm256_storeu_si256((__m256i* )(theDst + aCol), aPixels);
+        }
+        return aCol;
+    }
+#endif
+
+    /**
+     * Expand PAL8 image into RGBA using the palette as lookup table.
+     * This is much cheaper than setting up swscale context for each subtitle rectangle.
+     * Rows are expanded with AVX2 gather when CPU supports it;
+     * other targets (including NEON, which has no gather) use unrolled scalar loop.
+     * @param theSrc        indices of colors
+     * @param theSrcRowSize source row size in bytes
+     * @param thePalette    palette in native-endian 0xAARRGGBB form
+     * @param theNbColors   number of colors in the palette, missing ones are transparent
+     * @param theDst        destination RGBA image of the same dimensions
+     */
+    static void expandPal8ToRgba(const uint8_t*  theSrc,
+                                 const int       theSrcRowSize,
+                                 const uint32_t* thePalette,
+                                 const int       theNbColors,
+                                 StImagePlane&   theDst) {
+        // convert the palette into destination byte order once
+        uint32_t aLut[256];
+        stMemZero(aLut, sizeof(aLut));
+        for(int aColorIter = 0; aColorIter < stMin(theNbColors, 256); ++aColorIter) {
+            const uint32_t anArgb = thePalette[aColorIter];
+            const uint8_t  aRgba[4] = {
+                uint8_t((anArgb >> 16) & 0xFF),
+                uint8_t((anArgb >>  8) & 0xFF),
+                uint8_t( anArgb        & 0xFF),
+                uint8_t((anArgb >> 24) & 0xFF)
+            };
+            stMemCpy(&aLut[aColorIter], aRgba, 4);
+        }
+
+        const size_t aSizeX   = theDst.getSizeX();
+    #if defined(ST_SUBS_X86)
+        const bool   toUseAvx = hasAvx2();
+    #endif
+        for(size_t aRow = 0; aRow < theDst.getSizeY(); ++aRow) {
+            const uint8_t* aSrcRow = theSrc + ptrdiff_t(aRow) * theSrcRowSize;
+            uint32_t*      aDstRow = (uint32_t* )theDst.changeData(aRow, 0);
+            size_t aCol = 0;
+        #if defined(ST_SUBS_X86)
+            if(toUseAvx) {
+                aCol = expandRowAvx2(aDstRow, aSrcRow, aSizeX, aLut);
+            }
+        #endif
+            expandRowScalar(aDstRow, aSrcRow, aCol, aSizeX, aLut);
+        }
+    }
 };
 
 /**
@@ -38,11 +173,14 @@ static SV_THREAD_FUNCTION threadFunction(void* theSubtitleQueue) {
 }
 
 StSubtitleQueue::StSubtitleQueue(const StHandle<StSubQueue>& theSubtitlesQueue)
-: StAVPacketQueue(512),
+: StAVPacketQueue(512, "packets.subtitles", 1),
   myOutQueue(theSubtitlesQueue),
+  myImagePool(new StGLTextureBufferPool("subtitles.pool")),
   myThread(NULL),
   evDowntime(true),
   myImageScale(1.0f),
+  myToPreload(false),
+  myToAbortPreload(false),
   toQuit(false) {
     myThread = new StThread(threadFunction, (void* )this, "StSubtitleQueue");
 }
@@ -60,7 +198,9 @@ StSubtitleQueue::~StSubtitleQueue() {
 bool StSubtitleQueue::init(AVFormatContext*   theFormatCtx,
                            const unsigned int theStreamId,
                            const StString&    theFileName) {
-    myImageScale = 1.0f;
+    myImageScale     = 1.0f;
+    myToPreload      = false;
+    myToAbortPreload = false;
     if(!StAVPacketQueue::init(theFormatCtx, theStreamId, theFileName)) {
         signals.onError(stCString("FFmpeg: invalid stream"));
         deinit();
@@ -91,20 +231,148 @@ bool StSubtitleQueue::init(AVFormatContext*   theFormatCtx,
         myImageScale = 0.5f;
     }
     fillCodecInfo(myCodec);
+
+    // external text subtitles are small enough to be decoded at once,
+    // which makes seeking within them unnecessary
+    bool isTextCodec = myCodecAutoId == AV_CODEC_ID_TEXT;
+#ifdef AV_CODEC_PROP_TEXT_SUB
+    const AVCodecDescriptor* aCodecDesc = avcodec_descriptor_get(myCodecAutoId);
+    isTextCodec = isTextCodec
+              || (aCodecDesc != NULL && (aCodecDesc->props & AV_CODEC_PROP_TEXT_SUB) != 0);
+#endif
+    myToPreload = isTextCodec;
+    for(unsigned int aStreamId = 0; aStreamId < theFormatCtx->nb_streams && myToPreload; ++aStreamId) {
+        myToPreload = stAV::getCodecType(theFormatCtx->streams[aStreamId]) == AVMEDIA_TYPE_SUBTITLE;
+    }
     return true;
 }
 
 void StSubtitleQueue::deinit() {
     StAVPacketQueue::deinit();
     myASS.init(NULL, 0);
+    myToPreload = false;
 }
 
-void StSubtitleQueue::decodeLoop() {
+void StSubtitleQueue::preloadStream() {
+    if(av_seek_frame(myFormatCtx, myStreamId, 0, AVSEEK_FLAG_BACKWARD) < 0) {
+        ST_DEBUG_LOG("StSubtitleQueue, unable to seek to the beginning of '" + myFileName + "'");
+    }
+
+    StAVPacket aPacket;
+    while(!myToAbortPreload
+       && av_read_frame(myFormatCtx, aPacket.getAVpkt()) >= 0) {
+        if(aPacket.getStreamId() == myStreamId) {
+            decodePacket(aPacket);
+        }
+        aPacket.free();
+    }
+}
+
+void StSubtitleQueue::decodePacket(StAVPacket& thePacket) {
     int isFrameFinished = 0;
-    double aPts = 0.0;
-    double aDuration = 0.0;
     AVSubtitle aSubtitle;
+    const double aPts = unitsToSeconds(thePacket.getPts()) - myPtsStartBase;
+    double aDuration  = unitsToSeconds(thePacket.getConvergenceDuration());
+    if(myCodec != NULL) {
+        // decode subtitle item
+    #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(52, 23, 0))
+        avcodec_decode_subtitle2(myCodecCtx, &aSubtitle,
+                                 &isFrameFinished, thePacket.getAVpkt());
+    #else
+        avcodec_decode_subtitle(myCodecCtx, &aSubtitle,
+                                &isFrameFinished,
+                                thePacket.getData(), thePacket.getSize());
+    #endif
 
+        if(isFrameFinished != 0 && thePacket.getPts() != stAV::NOPTS_VALUE) {
+            for(unsigned aRectId = 0; aRectId < aSubtitle.num_rects; ++aRectId) {
+                AVSubtitleRect* aRect = aSubtitle.rects[aRectId];
+                if(aRect == NULL) {
+                    // should not happens
+                    continue;
+                }
+
+                switch(aRect->type) {
+                    case SUBTITLE_BITMAP: {
+                        if(aDuration < 0.001) {
+                            aDuration = 3.0; // duration is always zero here...
+                        }
+
+                        StHandle<StSubItem> aNewSubItem = new StSubItem(aPts, aPts + aDuration);
+                        if(!aNewSubItem->initImage(myImagePool, StImagePlane::ImgRGBA, aRect->w, aRect->h)) {
+                            break;
+                        }
+                        aNewSubItem->Scale = myImageScale;
+
+                    #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 9, 100))
+                        uint8_t** anImgData = aRect->data;
+                        int* anImgLineSizes = aRect->linesize;
+                    #else
+                        uint8_t** anImgData = aRect->pict.data;
+                        int* anImgLineSizes = aRect->pict.linesize;
+                    #endif
+
+                        if(anImgData[0] == NULL
+                        || anImgData[1] == NULL) {
+                            break;
+                        }
+                        expandPal8ToRgba(anImgData[0], anImgLineSizes[0],
+                                         (const uint32_t* )anImgData[1], aRect->nb_colors,
+                                         aNewSubItem->Image);
+
+                        /*ST_DEBUG_LOG("  |" + aRectId + "/" + aSubtitle.num_rects + "| " //+ aRect->x + "x" + aRect->y + " WH= "
+                                        + aRect->w + "x" + aRect->h + " c= " + aRect->nb_colors
+                                        + " pts= " + aPts
+                                        + " dur= " + aDuration);*/
+                        myOutQueue->push(aNewSubItem);
+                        break;
+                    }
+                    case SUBTITLE_TEXT: {
+                        StHandle<StSubItem> aNewSubItem = new StSubItem(aPts, aPts + aDuration);
+                        aNewSubItem->Text = aRect->text;
+                        aNewSubItem->Text.replaceFast(ST_CRLF_REDUNDANT, ST_CRLF_REPLACEMENT); // remove redundant CR symbols
+                        myOutQueue->push(aNewSubItem);
+                        break;
+                    }
+                    case SUBTITLE_ASS: {
+                        StString aTextData = aRect->ass;
+                        StHandle<StSubItem> aNewSubItem = myASS.parseEvent(aTextData, aPts, aDuration);
+                        if(!aNewSubItem.isNull()) {
+                            myOutQueue->push(aNewSubItem);
+                        }
+                        break;
+                    }
+                    case SUBTITLE_NONE:
+                    default:
+                        break;
+                }
+            }
+        }
+    #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(52, 82, 0))
+        avsubtitle_free(&aSubtitle);
+    #else
+        for(unsigned aRectId = 0; aRectId < aSubtitle.num_rects; ++aRectId) {
+            av_freep(&aSubtitle.rects[aRectId]->pict.data[0]);
+            av_freep(&aSubtitle.rects[aRectId]->pict.data[1]);
+            av_freep(&aSubtitle.rects[aRectId]->pict.data[2]);
+            av_freep(&aSubtitle.rects[aRectId]->pict.data[3]);
+            av_freep(&aSubtitle.rects[aRectId]->text);
+            av_freep(&aSubtitle.rects[aRectId]->ass);
+            av_freep(&aSubtitle.rects[aRectId]);
+        }
+        av_freep(&aSubtitle.rects);
+        stMemSet(&aSubtitle, 0, sizeof(AVSubtitle));
+    #endif
+    } else {
+        // just plain text
+        StHandle<StSubItem> aNewSubItem = new StSubItem(aPts, aPts + aDuration);
+        aNewSubItem->Text = (const char* )thePacket.getData();
+        aNewSubItem->Text.replaceFast(ST_CRLF_REDUNDANT, ST_CRLF_REPLACEMENT); // remove redundant CR symbols
+        myOutQueue->push(aNewSubItem);
+    }
+}
+
+void StSubtitleQueue::decodeLoop() {
     for(;;) {
         if(isEmpty()) {
             evDowntime.set();
@@ -120,14 +388,17 @@ void StSubtitleQueue::decodeLoop() {
         switch(aPacket->getType()) {
             case StAVPacket::FLUSH_PACKET: {
                 // got the special FLUSH packet - flush FFmpeg codec buffers
+                // decoded items are kept since seeking will not change them
                 if(myCodecCtx != NULL && myCodec != NULL) {
                     avcodec_flush_buffers(myCodecCtx);
                 }
-                myOutQueue->clear();
                 continue;
             }
             case StAVPacket::START_PACKET: {
                 myOutQueue->clear();
+                if(myToPreload) {
+                    preloadStream();
+                }
                 continue;
             }
             case StAVPacket::DATA_PACKET: {
@@ -147,115 +418,7 @@ void StSubtitleQueue::decodeLoop() {
             }
         }
 
-        aPts      = unitsToSeconds(aPacket->getPts()) - myPtsStartBase;
-        aDuration = unitsToSeconds(aPacket->getConvergenceDuration());
-        if(myCodec != NULL) {
-            // decode subtitle item
-        #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(52, 23, 0))
-            avcodec_decode_subtitle2(myCodecCtx, &aSubtitle,
-                                     &isFrameFinished, aPacket->getAVpkt());
-        #else
-            avcodec_decode_subtitle(myCodecCtx, &aSubtitle,
-                                    &isFrameFinished,
-                                    aPacket->getData(), aPacket->getSize());
-        #endif
-
-            if(isFrameFinished != 0 && aPacket->getPts() != stAV::NOPTS_VALUE) {
-                for(unsigned aRectId = 0; aRectId < aSubtitle.num_rects; ++aRectId) {
-                    AVSubtitleRect* aRect = aSubtitle.rects[aRectId];
-                    if(aRect == NULL) {
-                        // should not happens
-                        continue;
-                    }
-
-                    switch(aRect->type) {
-                        case SUBTITLE_BITMAP: {
-                            if(aDuration < 0.001) {
-                                aDuration = 3.0; // duration is always zero here...
-                            }
-
-                            StHandle<StSubItem> aNewSubItem = new StSubItem(aPts, aPts + aDuration);
-                            aNewSubItem->Image.initTrash(StImagePlane::ImgRGBA, aRect->w, aRect->h);
-                            aNewSubItem->Scale = myImageScale;
-
-                        #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 9, 100))
-                            uint8_t** anImgData = aRect->data;
-                            int* anImgLineSizes = aRect->linesize;
-                        #else
-                            uint8_t** anImgData = aRect->pict.data;
-                            int* anImgLineSizes = aRect->pict.linesize;
-                        #endif
-
-                            SwsContext* aCtxToRgb = sws_getContext(aRect->w, aRect->h, stAV::PIX_FMT::PAL8,
-                                                                   aRect->w, aRect->h, stAV::PIX_FMT::RGBA32,
-                                                                   SWS_BICUBIC, NULL, NULL, NULL);
-                            if(aCtxToRgb == NULL) {
-                                break;
-                            }
-
-                            uint8_t* aDstData[4] = {
-                                (uint8_t* )aNewSubItem->Image.getData(), NULL, NULL, NULL
-                            };
-                            /*const*/ int aDstLinesize[4] = {
-                                (int )aNewSubItem->Image.getSizeRowBytes(), 0, 0, 0
-                            };
-
-                            sws_scale(aCtxToRgb,
-                                      anImgData, anImgLineSizes,
-                                      0, aRect->h,
-                                      aDstData, aDstLinesize);
-                            sws_freeContext(aCtxToRgb);
-
-                            /*ST_DEBUG_LOG("  |" + aRectId + "/" + aSubtitle.num_rects + "| " //+ aRect->x + "x" + aRect->y + " WH= "
-                                            + aRect->w + "x" + aRect->h + " c= " + aRect->nb_colors
-                                            + " pts= " + aPts
-                                            + " dur= " + aDuration);*/
-                            myOutQueue->push(aNewSubItem);
-                            break;
-                        }
-                        case SUBTITLE_TEXT: {
-                            StHandle<StSubItem> aNewSubItem = new StSubItem(aPts, aPts + aDuration);
-                            aNewSubItem->Text = aRect->text;
-                            aNewSubItem->Text.replaceFast(ST_CRLF_REDUNDANT, ST_CRLF_REPLACEMENT); // remove redundant CR symbols
-                            myOutQueue->push(aNewSubItem);
-                            break;
-                        }
-                        case SUBTITLE_ASS: {
-                            StString aTextData = aRect->ass;
-                            StHandle<StSubItem> aNewSubItem = myASS.parseEvent(aTextData, aPts, aDuration);
-                            if(!aNewSubItem.isNull()) {
-                                myOutQueue->push(aNewSubItem);
-                            }
-                            break;
-                        }
-                        case SUBTITLE_NONE:
-                        default:
-                            break;
-                    }
-                }
-            }
-        #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(52, 82, 0))
-            avsubtitle_free(&aSubtitle);
-        #else
-            for(unsigned aRectId = 0; aRectId < aSubtitle.num_rects; ++aRectId) {
-                av_freep(&aSubtitle.rects[aRectId]->pict.data[0]);
-                av_freep(&aSubtitle.rects[aRectId]->pict.data[1]);
-                av_freep(&aSubtitle.rects[aRectId]->pict.data[2]);
-                av_freep(&aSubtitle.rects[aRectId]->pict.data[3]);
-                av_freep(&aSubtitle.rects[aRectId]->text);
-                av_freep(&aSubtitle.rects[aRectId]->ass);
-                av_freep(&aSubtitle.rects[aRectId]);
-            }
-            av_freep(&aSubtitle.rects);
-            stMemSet(&aSubtitle, 0, sizeof(AVSubtitle));
-        #endif
-        } else {
-            // just plain text
-            StHandle<StSubItem> aNewSubItem = new StSubItem(aPts, aPts + aDuration);
-            aNewSubItem->Text = (const char* )aPacket->getData();
-            aNewSubItem->Text.replaceFast(ST_CRLF_REDUNDANT, ST_CRLF_REPLACEMENT); // remove redundant CR symbols
-            myOutQueue->push(aNewSubItem);
-        }
+        decodePacket(*aPacket);
 
         // and now packet finished
         aPacket.nullify();
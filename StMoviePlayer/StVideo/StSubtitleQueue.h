@@ -70,6 +70,31 @@ class StSubtitleQueue : public StAVPacketQueue {
      */
     ST_LOCAL virtual void deinit() ST_ATTR_OVERRIDE;
 
+    /**
+     * Return true if the whole stream is decoded at once by this thread,
+     * so that format context should be neither demuxed nor seeked by the caller.
+     * This is the case for external text subtitles files.
+     */
+    ST_LOCAL bool isPreloaded() const {
+        return myToPreload;
+    }
+
+    /**
+     * Push END packet and abort preloading.
+     */
+    ST_LOCAL virtual void pushEnd() ST_ATTR_OVERRIDE {
+        myToAbortPreload = true;
+        StAVPacketQueue::pushEnd();
+    }
+
+    /**
+     * Push QUIT packet and abort preloading.
+     */
+    ST_LOCAL virtual void pushQuit() ST_ATTR_OVERRIDE {
+        myToAbortPreload = true;
+        StAVPacketQueue::pushQuit();
+    }
+
     /**
      * Main decoding loop.
      */
@@ -77,11 +102,27 @@ class StSubtitleQueue : public StAVPacketQueue {
 
         private:
 
+    /**
+     * Decode the packet and put new items into subtitles store.
+     */
+    ST_LOCAL void decodePacket(StAVPacket& thePacket);
+
+    /**
+     * Read and decode all packets of the stream.
+     */
+    ST_LOCAL void preloadStream();
+
+        private:
+
     StHandle<StSubQueue> myOutQueue;
+    StHandle<StGLTextureBufferPool>
+                         myImagePool; //!< recycled RGBA buffers of bitmap subtitles
     StThread*            myThread;   //!< decoding loop thread
     StSubtitlesASS       myASS;      //!< ASS subtitles parser
     StCondition          evDowntime;
     float                myImageScale;
+    bool                 myToPreload;      //!< flag indicating that the whole stream should be decoded at once
+    volatile bool        myToAbortPreload; //!< flag to interrupt preloading
     volatile bool        toQuit;
 
 };
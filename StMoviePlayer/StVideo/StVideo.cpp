@@ -128,7 +128,13 @@ StVideo::StVideo(const std::string&                 theALDeviceName,
   myIsBenchmark(false),
   toSave(StImageFile::ST_TYPE_NONE),
   toQuit(false),
-  myQuitEvent(false) {
+  myQuitEvent(false),
+  myTelDemux     (StTelemetry::GetDefault().getHistogram("demux.read")),
+  myTelPackets   (StTelemetry::GetDefault().getCounter  ("demux.packets")),
+  myTelVideoQueue(StTelemetry::GetDefault().getGauge    ("demux.videoQueue")),
+  myTelAudioQueue(StTelemetry::GetDefault().getGauge    ("demux.audioQueue")) {
+    myEventMutex.setName("StVideo::myEventMutex");
+
     // initialize FFmpeg library if not yet performed
     stAV::init();
 
@@ -934,7 +940,7 @@ void StVideo::packetsLoop() {
         if(!myVideoMaster->isInContext(aFormatCtx)
         && !myVideoSlave->isInContext(aFormatCtx)
         && !myAudio->isInContext(aFormatCtx)
-        && !mySubtitles->isInContext(aFormatCtx)) {
+        && (!mySubtitles->isInContext(aFormatCtx) || mySubtitles->isPreloaded())) {
             continue;
         }
 
@@ -956,7 +962,10 @@ void StVideo::packetsLoop() {
             StAVPacket& aPacket = anAVPackets[aCtxId];
             if(!aQueueIsFull[aCtxId]) {
                 // read next packet
-                if(av_read_frame(aFormatCtx, aPacket.getAVpkt()) < 0) {
+                StTimer aReadTimer(true);
+                const int aReadRes = av_read_frame(aFormatCtx, aPacket.getAVpkt());
+                myTelDemux->addSeconds(aReadTimer.getElapsedTimeInSec());
+                if(aReadRes < 0) {
                     ++anEmptyQueues;
                     if(!aQueueIsEmpty[aCtxId]) {
                         aQueueIsEmpty[aCtxId] = true;
@@ -977,6 +986,7 @@ void StVideo::packetsLoop() {
                     }
                     continue;
                 }
+                myTelPackets->increment();
             }
 
             // push packet to appropriate queue
@@ -1009,6 +1019,10 @@ void StVideo::packetsLoop() {
             }
             aPacket.free();
         }
+        myTelVideoQueue->setValue(int32_t(myVideoMaster->getSize()));
+        myTelAudioQueue->setValue(int32_t(myAudio->getSize()));
+        StMemoryBudget::GetDefault().checkPressure();
+        myTextureQueue->getBufferPool().trim();
 
         // check events
         checkInitVideoStreams();
@@ -1095,7 +1109,7 @@ void StVideo::packetsLoop() {
                 if(!myVideoMaster->isInContext(aFormatCtx)
                 && !myVideoSlave->isInContext(aFormatCtx)
                 && !myAudio->isInContext(aFormatCtx)
-                && !mySubtitles->isInContext(aFormatCtx)) {
+                && (!mySubtitles->isInContext(aFormatCtx) || mySubtitles->isPreloaded())) {
                     continue;
                 }
                 myPlayCtxList.add(aFormatCtx);
@@ -1149,7 +1163,7 @@ void StVideo::packetsLoop() {
                 if(!myVideoMaster->isInContext(aFormatCtx)
                 && !myVideoSlave->isInContext(aFormatCtx)
                 && !myAudio->isInContext(aFormatCtx)
-                && !mySubtitles->isInContext(aFormatCtx)) {
+                && (!mySubtitles->isInContext(aFormatCtx) || mySubtitles->isPreloaded())) {
                     continue;
                 }
                 myPlayCtxList.add(aFormatCtx);
@@ -28,6 +28,7 @@
 #include <StAV/StAVIOFileContext.h>
 #include <StFile/StMIMEList.h>
 #include <StThreads/StProcess.h>
+#include <StThreads/StTelemetry.h>
 #include <StThreads/StThread.h>
 #include <StGL/StPlayList.h>
 #include <StImage/StImageFile.h>
@@ -482,6 +483,11 @@ class StVideo {
     volatile bool                 toQuit;         //!< flag indicating that all working threads should be closed
     StCondition                   myQuitEvent;    //!< condition indicating that working thread has saved playback state to playlist
 
+    StTelemetryHistogram*         myTelDemux;      //!< telemetry - time to read the packet
+    StTelemetryCounter*           myTelPackets;    //!< telemetry - number of read packets
+    StTelemetryGauge*             myTelVideoQueue; //!< telemetry - number of packets in video queue
+    StTelemetryGauge*             myTelAudioQueue; //!< telemetry - number of packets in audio queue
+
 };
 
 #endif // __StVideo_h_
@@ -0,0 +1,243 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StVideoPairRing.h"
+
+#include <cmath>
+
+namespace {
+
+    /**
+     * Slave frames ahead of Master for more than this time are considered outdated (result of seeking).
+     */
+    static const double THE_SEEK_GAP_SEC = 6.0;
+
+}
+
+StVideoPairRing::StVideoPairRing(const size_t theNbFrames)
+: mySlots(stMax(theNbFrames, size_t(1))),
+  myHasFrame(false),
+  myHasSpace(true),
+  myHeld(-1),
+  myIsEnded(false),
+  myTelSkew   (StTelemetry::GetDefault().getHistogram("video.pairSkew")),
+  myTelPaired (StTelemetry::GetDefault().getCounter  ("video.pairs")),
+  myTelDropped(StTelemetry::GetDefault().getCounter  ("video.pairDrops")),
+  myTelMissed (StTelemetry::GetDefault().getCounter  ("video.pairMisses")) {
+    myMutex.setName("StVideoPairRing::myMutex");
+    myOrder.reserve(mySlots.size());
+    myFree .reserve(mySlots.size());
+    for(size_t aSlotIter = mySlots.size(); aSlotIter > 0; --aSlotIter) {
+        myFree.push_back(aSlotIter - 1);
+    }
+    resetStats();
+}
+
+void StVideoPairRing::freeSlot(const size_t theSlot) {
+    Slot& aSlot = mySlots[theSlot];
+    if(!aSlot.Image.getBufferCounter().isNull()) {
+        // return decoded frame to decoder
+        aSlot.Image.nullify();
+    }
+    myFree.push_back(theSlot);
+    myHasSpace.set();
+}
+
+void StVideoPairRing::clear() {
+    StMutexAuto aLock(myMutex);
+    for(size_t anIter = 0; anIter < myOrder.size(); ++anIter) {
+        freeSlot(myOrder[anIter]);
+    }
+    myOrder.clear();
+    myIsEnded = false;
+    myHasFrame.reset();
+}
+
+void StVideoPairRing::resetStats() {
+    StMutexAuto aLock(myMutex);
+    myStats.NbPaired   = 0;
+    myStats.NbDropped  = 0;
+    myStats.NbMissed   = 0;
+    myStats.SkewSumSec = 0.0;
+    myStats.SkewMaxSec = 0.0;
+}
+
+StVideoPairRing::Stats StVideoPairRing::getStats() {
+    StMutexAuto aLock(myMutex);
+    return myStats;
+}
+
+bool StVideoPairRing::isFull() {
+    StMutexAuto aLock(myMutex);
+    return myFree.empty();
+}
+
+bool StVideoPairRing::waitSpace(const size_t theTimeMilliseconds) {
+    myMutex.lock();
+    if(!myFree.empty()) {
+        myMutex.unlock();
+        return true;
+    }
+    myHasSpace.reset();
+    myMutex.unlock();
+    myHasSpace.wait(theTimeMilliseconds);
+    return !isFull();
+}
+
+void StVideoPairRing::dropAt(const size_t thePos) {
+    freeSlot(myOrder[thePos]);
+    myOrder.erase(myOrder.begin() + thePos);
+    ++myStats.NbDropped;
+    myTelDropped->increment();
+}
+
+void StVideoPairRing::dropOldest() {
+    StMutexAuto aLock(myMutex);
+    if(!myOrder.empty()) {
+        dropAt(0);
+    }
+}
+
+bool StVideoPairRing::push(const StImage& theImage,
+                           const double   thePts) {
+    StMutexAuto aLock(myMutex);
+    if(myFree.empty()) {
+        if(myOrder.empty()) {
+            return false; // single slot held by Master
+        }
+        dropAt(0);
+    }
+
+    const size_t aSlotId = myFree.back();
+    Slot& aSlot = mySlots[aSlotId];
+    if(!theImage.getBufferCounter().isNull()) {
+        // keep reference to decoded frame
+        if(!aSlot.Image.initReference(theImage)) {
+            return false;
+        }
+    } else {
+        // converted data should be copied
+        aSlot.Image.setBufferCounter(NULL);
+        if(aSlot.Image.getColorModel() != theImage.getColorModel()
+        || aSlot.Image.getColorScale() != theImage.getColorScale()) {
+            aSlot.Image.nullify();
+        }
+        if(!aSlot.Image.fill(theImage, false)) {
+            return false;
+        }
+        aSlot.Image.setPixelRatio(theImage.getPixelRatio());
+    }
+    aSlot.Pts = thePts;
+    myFree.pop_back();
+
+    // keep list sorted by PTS
+    size_t aPos = myOrder.size();
+    for(; aPos > 0 && mySlots[myOrder[aPos - 1]].Pts > thePts; --aPos) {}
+    myOrder.insert(myOrder.begin() + aPos, aSlotId);
+    myIsEnded = false;
+    myHasFrame.set();
+    return true;
+}
+
+void StVideoPairRing::setEnded() {
+    StMutexAuto aLock(myMutex);
+    myIsEnded = true;
+    myHasFrame.set();
+}
+
+void StVideoPairRing::waitFrame(const size_t theTimeMilliseconds) {
+    myHasFrame.wait(theTimeMilliseconds);
+}
+
+StVideoPairRing::Match StVideoPairRing::acquire(const double     thePts,
+                                                const double     theTolerance,
+                                                const StImage*&  theImage,
+                                                double&          theSlavePts) {
+    theImage = NULL;
+    StMutexAuto aLock(myMutex);
+    if(myHeld >= 0) {
+        freeSlot(size_t(myHeld));
+        myHeld = -1;
+    }
+
+    // drop Slave frames which are too old for this and further Master frames
+    while(!myOrder.empty()
+       && thePts - mySlots[myOrder.front()].Pts > theTolerance) {
+        dropAt(0);
+    }
+    if(myOrder.empty()) {
+        if(myIsEnded) {
+            return Match_Ended;
+        }
+        myHasFrame.reset();
+        return Match_Wait;
+    }
+
+    const double aFrontDiff = mySlots[myOrder.front()].Pts - thePts;
+    if(aFrontDiff > theTolerance) {
+        if(aFrontDiff > THE_SEEK_GAP_SEC) {
+            // result of seeking - outdated frames from old position
+            while(!myOrder.empty()) {
+                dropAt(0);
+            }
+            myHasFrame.reset();
+            return Match_Wait;
+        }
+        ++myStats.NbMissed;
+        myTelMissed->increment();
+        return Match_Missing;
+    }
+
+    // pick the nearest frame within tolerance
+    size_t aBestPos  = 0;
+    double aBestDiff = std::abs(aFrontDiff);
+    for(size_t aPos = 1; aPos < myOrder.size(); ++aPos) {
+        const double aDiff = std::abs(mySlots[myOrder[aPos]].Pts - thePts);
+        if(aDiff > aBestDiff) {
+            break;
+        }
+        aBestPos  = aPos;
+        aBestDiff = aDiff;
+    }
+    for(; aBestPos > 0; --aBestPos) {
+        dropAt(0);
+    }
+
+    myHeld = int(myOrder.front());
+    myOrder.erase(myOrder.begin());
+    const Slot& aSlot = mySlots[myHeld];
+    theImage    = &aSlot.Image;
+    theSlavePts = aSlot.Pts;
+
+    ++myStats.NbPaired;
+    myStats.SkewSumSec += aBestDiff;
+    myStats.SkewMaxSec  = stMax(myStats.SkewMaxSec, aBestDiff);
+    myTelPaired->increment();
+    myTelSkew->addSeconds(aBestDiff);
+    return Match_Found;
+}
+
+void StVideoPairRing::release() {
+    StMutexAuto aLock(myMutex);
+    if(myHeld < 0) {
+        return;
+    }
+
+    freeSlot(size_t(myHeld));
+    myHeld = -1;
+}
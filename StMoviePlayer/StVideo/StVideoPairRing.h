@@ -0,0 +1,178 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StMoviePlayer program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StMoviePlayer program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StVideoPairRing_h_
+#define __StVideoPairRing_h_
+
+#include <StImage/StImage.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StTelemetry.h>
+
+#include <vector>
+
+/**
+ * Small PTS-ordered ring of frames decoded by Slave video stream
+ * waiting to be paired with frames of Master stream (two-stream stereo).
+ * Slave thread puts decoded frames into the ring and Master thread
+ * picks the frame with nearest PTS within tolerance,
+ * so that both decoders can run ahead independently.
+ */
+class StVideoPairRing {
+
+        public:
+
+    /**
+     * Result of pairing.
+     */
+    enum Match {
+        Match_Found,   //!< frame within tolerance has been found
+        Match_Missing, //!< Slave frames are ahead of requested PTS - Master frame has no pair
+        Match_Wait,    //!< the ring is empty, Slave is still decoding
+        Match_Ended,   //!< the ring is empty and Slave has reached end of stream
+    };
+
+    /**
+     * Pairing statistics.
+     */
+    struct Stats {
+        size_t NbPaired;   //!< number of paired frames
+        size_t NbDropped;  //!< number of Slave frames dropped without pair
+        size_t NbMissed;   //!< number of Master frames without pair
+        double SkewSumSec; //!< accumulated absolute PTS difference of paired frames
+        double SkewMaxSec; //!< maximum absolute PTS difference of paired frames
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theNbFrames ring capacity
+     */
+    ST_LOCAL StVideoPairRing(const size_t theNbFrames);
+
+    /**
+     * Drop all frames except the one acquired by Master and reset end-of-stream flag.
+     */
+    ST_LOCAL void clear();
+
+    /**
+     * Reset statistics.
+     */
+    ST_LOCAL void resetStats();
+
+    /**
+     * @return pairing statistics
+     */
+    ST_LOCAL Stats getStats();
+
+    /**
+     * @return true if there is no free slot
+     */
+    ST_LOCAL bool isFull();
+
+    /**
+     * Wait for free slot.
+     * @return true if the ring is not full
+     */
+    ST_LOCAL bool waitSpace(const size_t theTimeMilliseconds);
+
+    /**
+     * Drop the oldest frame (to be used by Slave when Master does not consume frames).
+     */
+    ST_LOCAL void dropOldest();
+
+    /**
+     * Put the frame into the ring (Slave thread).
+     * Reference-counted frames are referenced, other frames are copied.
+     * The oldest frame is dropped when the ring is full.
+     */
+    ST_LOCAL bool push(const StImage& theImage,
+                       const double   thePts);
+
+    /**
+     * Mark end of Slave stream, so that Master does not wait for more frames.
+     */
+    ST_LOCAL void setEnded();
+
+    /**
+     * Wait for new frame.
+     */
+    ST_LOCAL void waitFrame(const size_t theTimeMilliseconds);
+
+    /**
+     * Find the frame for pairing (Master thread).
+     * Frames older than requested PTS out of tolerance are dropped.
+     * Found frame remains valid until release().
+     * @param thePts       Master frame PTS
+     * @param theTolerance maximum PTS difference
+     * @param theImage     found frame
+     * @param theSlavePts  PTS of found frame
+     */
+    ST_LOCAL Match acquire(const double     thePts,
+                           const double     theTolerance,
+                           const StImage*&  theImage,
+                           double&          theSlavePts);
+
+    /**
+     * Release the frame returned by acquire().
+     */
+    ST_LOCAL void release();
+
+        private:
+
+    /**
+     * Return slot into the free list, releasing reference to decoded frame.
+     */
+    ST_LOCAL void freeSlot(const size_t theSlot);
+
+    /**
+     * Drop frame at specified position of sorted list.
+     */
+    ST_LOCAL void dropAt(const size_t thePos);
+
+        private:
+
+    /**
+     * Ring slot.
+     */
+    struct Slot {
+        StImage Image; //!< frame (reference or copy)
+        double  Pts;   //!< frame PTS
+    };
+
+        private:
+
+    std::vector<Slot>     mySlots;    //!< slots
+    std::vector<size_t>   myOrder;    //!< filled slots sorted by PTS
+    std::vector<size_t>   myFree;     //!< free slots
+    StMutex               myMutex;    //!< lock for slots lists
+    StCondition           myHasFrame; //!< event set when new frame has been pushed or stream has ended
+    StCondition           myHasSpace; //!< event set when slot has been freed
+    int                   myHeld;     //!< slot acquired by Master or -1
+    bool                  myIsEnded;  //!< Slave end of stream flag
+    Stats                 myStats;    //!< pairing statistics
+
+    StTelemetryHistogram* myTelSkew;    //!< telemetry - PTS difference of paired frames
+    StTelemetryCounter*   myTelPaired;  //!< telemetry - number of paired frames
+    StTelemetryCounter*   myTelDropped; //!< telemetry - number of dropped Slave frames
+    StTelemetryCounter*   myTelMissed;  //!< telemetry - number of Master frames without pair
+
+};
+
+#endif // __StVideoPairRing_h_
@@ -20,6 +20,7 @@
 
 #include <StStrings/StStringStream.h>
 #include <StThreads/StThread.h>
+#include <StThreads/StTracer.h>
 
 #if (defined(_WIN64) || defined(__WIN64__))\
  || (defined(_LP64)  || defined(__LP64__))
@@ -144,7 +145,7 @@ inline AVCodecID stFindCodecId(const char* theName) {
 
 StVideoQueue::StVideoQueue(const StHandle<StGLTextureQueue>& theTextureQueue,
                            const StHandle<StVideoQueue>&     theMaster)
-: StAVPacketQueue(512),
+: StAVPacketQueue(512, "packets.video", 4),
   CodecIdH264  (stFindCodecId("h264")),
   CodecIdHEVC  (stFindCodecId("hevc")),
   CodecIdMPEG2 (stFindCodecId("mpeg2video")),
@@ -153,7 +154,7 @@ StVideoQueue::StVideoQueue(const StHandle<StGLTextureQueue>& theTextureQueue,
   CodecIdJpeg2K(stFindCodecId("jpeg2000")),
   myDowntimeState(true),
   myTextureQueue(theTextureQueue),
-  myHasDataState(false),
+  myPairRing(4),
   myMaster(theMaster),
 #if defined(__APPLE__)
   myCodecH264HW(avcodec_find_decoder_by_name("h264_vda")),
@@ -187,7 +188,12 @@ StVideoQueue::StVideoQueue(const StHandle<StGLTextureQueue>& theTextureQueue,
   myStFormatByName(StFormat_AUTO),
   myStFormatInStream(StFormat_AUTO),
   myToStickPano360(false),
-  myToSwapJps(false) {
+  myToSwapJps(false),
+  myTelDecode  (StTelemetry::GetDefault().getHistogram("video.decode")),
+  myTelPrepare (StTelemetry::GetDefault().getHistogram("video.prepareFrame")),
+  myTelPushWait(StTelemetry::GetDefault().getHistogram("video.pushWait")),
+  myTelFrames  (StTelemetry::GetDefault().getCounter  ("video.frames")) {
+    myAudioClockMutex.setName("StVideoQueue::myAudioClockMutex");
 #ifdef ST_USE64PTR
     myFrame.Frame->opaque = (void* )stAV::NOPTS_VALUE;
 #else
@@ -496,6 +502,18 @@ void StVideoQueue::deinit() {
         myTextureQueue->setConnectedStream(false);
     }
     mySlave.nullify();
+    if(!myMaster.isNull()) {
+        const StVideoPairRing::Stats aStats = myPairRing.getStats();
+        if(aStats.NbPaired != 0) {
+            ST_DEBUG_LOG(StString("StVideoQueue, stereo pairs: ") + aStats.NbPaired
+                       + ", dropped Slave frames: " + aStats.NbDropped
+                       + ", Master frames without pair: " + aStats.NbMissed
+                       + ", average skew: " + (1000.0 * aStats.SkewSumSec / double(aStats.NbPaired))
+                       + " ms, max skew: " + (1000.0 * aStats.SkewMaxSec) + " ms");
+        }
+    }
+    myPairRing.clear();
+    myPairRing.resetStats();
     myPixelRatio = 1.0f;
     myDataAdp.nullify();
 
@@ -540,6 +558,8 @@ void StVideoQueue::syncVideo(AVFrame* theSrcFrame,
 #endif
 
 void StVideoQueue::prepareFrame(const StFormat theSrcFormat) {
+    StTelemetryTimer aTelTimer(myTelPrepare);
+    ST_TRACE_SCOPE("prepareFrame");
     int           aFrameSizeX = 0;
     int           aFrameSizeY = 0;
     AVPixelFormat aPixFmt     = stAV::PIX_FMT::NONE;
@@ -554,6 +574,8 @@ void StVideoQueue::prepareFrame(const StFormat theSrcFormat) {
         myDataAdp.changePlane(0).initWrapper(StImagePlane::ImgRGB48, myFrame.getPlane(0),
                                              size_t(aFrameSizeX), size_t(aFrameSizeY),
                                              myFrame.getLineSize(0));
+        myFrameBufRef->moveReferenceFrom(myFrame.Frame);
+        myDataAdp.setBufferCounter(myFrameBufRef);
         return;
     } else if(aPixFmt == stAV::PIX_FMT::RGB24
            && myTextureQueue->getDeviceCaps().isSupportedFormat(StImagePlane::ImgRGB)) {
@@ -563,6 +585,8 @@ void StVideoQueue::prepareFrame(const StFormat theSrcFormat) {
         myDataAdp.changePlane(0).initWrapper(StImagePlane::ImgRGB, myFrame.getPlane(0),
                                              size_t(aFrameSizeX), size_t(aFrameSizeY),
                                              myFrame.getLineSize(0));
+        myFrameBufRef->moveReferenceFrom(myFrame.Frame);
+        myDataAdp.setBufferCounter(myFrameBufRef);
         return;
     } else if(aPixFmt == stAV::PIX_FMT::RGBA32
            && myTextureQueue->getDeviceCaps().isSupportedFormat(StImagePlane::ImgRGBA)) {
@@ -572,6 +596,8 @@ void StVideoQueue::prepareFrame(const StFormat theSrcFormat) {
         myDataAdp.changePlane(0).initWrapper(StImagePlane::ImgRGBA, myFrame.getPlane(0),
                                              size_t(aFrameSizeX), size_t(aFrameSizeY),
                                              myFrame.getLineSize(0));
+        myFrameBufRef->moveReferenceFrom(myFrame.Frame);
+        myDataAdp.setBufferCounter(myFrameBufRef);
         return;
 #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(53, 5, 0))
     } else if(stAV::isFormatYUVPlanar(myFrame.Frame,
@@ -718,9 +744,12 @@ void StVideoQueue::pushFrame(const StImage&     theSrcDataLeft,
                              const StFormat     theSrcFormat,
                              const StCubemap    theCubemapFormat,
                              const double       theSrcPTS) {
+    ST_TRACE_SCOPE("pushFrame");
+    StTimer aWaitTimer(true);
     while(!myToFlush && myTextureQueue->isFull()) {
         StThread::sleep(10);
     }
+    myTelPushWait->addSeconds(aWaitTimer.getElapsedTimeInSec());
 
     if(myToFlush) {
         myToFlush = false;
@@ -787,6 +816,8 @@ void StVideoQueue::decodeLoop() {
                 // now we clear our sttextures buffer
                 if(myMaster.isNull()) {
                     myTextureQueue->clear();
+                } else {
+                    myPairRing.clear();
                 }
                 myAudioClock = 0.0;
                 myVideoClock = 0.0;
@@ -797,7 +828,9 @@ void StVideoQueue::decodeLoop() {
             case StAVPacket::START_PACKET: {
                 myAudioClock = 0.0;
                 myVideoClock = 0.0;
-                myHasDataState.reset();
+                if(!myMaster.isNull()) {
+                    myPairRing.clear();
+                }
                 isStarted = true;
                 aPrevPts = 0.0;
                 myWasFlushed = true; // force displaying the first frame
@@ -819,16 +852,9 @@ void StVideoQueue::decodeLoop() {
                 // to recieve last frames.
 
                 if(!myMaster.isNull()) {
-                    while(myHasDataState.check() && !myMaster->isInDowntime()) {
-                        StThread::sleep(10);
-                    }
-                    // wake up Master
-                    myDataAdp.nullify();
-                    myHasDataState.set();
+                    // let Master show remaining frames without pair
+                    myPairRing.setEnded();
                 } else {
-                    if(!mySlave.isNull()) {
-                        mySlave->unlockData();
-                    }
                     StTimer stTimerWaitEmpty(true);
                     double waitTime = anAverageDelaySec * myTextureQueue->getSize() + 0.1;
                     while(!myTextureQueue->isEmpty() && stTimerWaitEmpty.getElapsedTimeInSec() < waitTime && !myToQuit) {
@@ -845,11 +871,6 @@ void StVideoQueue::decodeLoop() {
             }
         }
 
-        // wait master retrieve previous data
-        while(!myMaster.isNull() && myHasDataState.check()) {
-            //
-        }
-
         bool toSendPacket = true;
         for(;;) {
             if(!decodeFrame(aPacket, toSendPacket, isStarted, aTagValue, anAverageDelaySec, aPrevPts)) {
@@ -866,9 +887,11 @@ bool StVideoQueue::decodeFrame(const StHandle<StAVPacket>& thePacket,
                                StString& theTagValue,
                                double& theAverageDelaySec,
                                double& thePrevPts) {
+    ST_TRACE_SCOPE("decodeFrame");
     bool toTryMoreFrames = false;
     (void )theToSendPacket;
     const bool toTryGpu = myUseGpu && !myIsGpuFailed;
+    StTimer aDecodeTimer(true);
 #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 106, 102))
     if(theToSendPacket) {
         theToSendPacket = false;
@@ -926,6 +949,8 @@ bool StVideoQueue::decodeFrame(const StHandle<StAVPacket>& thePacket,
         return false;
     }
 #endif
+    myTelDecode->addSeconds(aDecodeTimer.getElapsedTimeInSec());
+    myTelFrames->increment();
     if(thePacket->isKeyFrame()) { // !theToSentPacket?
         myFramesCounter = 1;
     }
@@ -1073,43 +1098,34 @@ bool StVideoQueue::decodeFrame(const StHandle<StAVPacket>& thePacket,
             theIsStarted = false;
         }
 
-        StImage* aSlaveData = NULL;
+        // pick Slave frame with the nearest PTS
+        StVideoPairRing& aRing = mySlave->myPairRing;
+        const StImage* aSlaveData = NULL;
         double aSlavePts = 0.0;
-        for(;;) {
-            // wait data from Slave
-            if(aSlaveData == NULL) {
-                aSlaveData = mySlave->waitData(aSlavePts);
-            }
-            if(aSlaveData != NULL) {
-                const double aPtsDiff = myFramePts - aSlavePts;
-                if(aPtsDiff > 0.5 * theAverageDelaySec) {
-                    // wait for more recent frame from slave thread
-                    mySlave->unlockData();
-                    aSlaveData = NULL;
-                    StThread::sleep(10);
-                    continue;
-                } else if(aPtsDiff < -0.5 * theAverageDelaySec) {
-                    // too far...
-                    if(aPtsDiff < -6.0) {
-                        // result of seeking?
-                        mySlave->unlockData();
-                        aSlaveData = NULL;
-                    }
-                    break;
-                }
-
-                pushFrame(myDataAdp, *aSlaveData, thePacket->getSource(), StFormat_SeparateFrames, aCubemapFormat, myFramePts);
+        StVideoPairRing::Match aMatch = aRing.acquire(myFramePts, 0.5 * theAverageDelaySec, aSlaveData, aSlavePts);
+        while(aMatch == StVideoPairRing::Match_Wait
+           && !myToQuit
+           && !myToFlush) {
+            aRing.waitFrame(10);
+            aMatch = aRing.acquire(myFramePts, 0.5 * theAverageDelaySec, aSlaveData, aSlavePts);
+        }
 
-                aSlaveData = NULL;
-                mySlave->unlockData();
-            } else {
-                pushFrame(myDataAdp, myEmptyImage, thePacket->getSource(), aSrcFormat, aCubemapFormat, myFramePts);
-            }
-            break;
+        if(aMatch == StVideoPairRing::Match_Found) {
+            pushFrame(myDataAdp, *aSlaveData, thePacket->getSource(), StFormat_SeparateFrames, aCubemapFormat, myFramePts);
+            aRing.release();
+        } else if(aMatch == StVideoPairRing::Match_Ended) {
+            pushFrame(myDataAdp, myEmptyImage, thePacket->getSource(), aSrcFormat, aCubemapFormat, myFramePts);
         }
+        // Match_Missing - Slave is ahead, skip the frame without pair
     } else if(!myMaster.isNull()) {
-        // push data to Master
-        myHasDataState.set();
+        // pass the copy to Master, wait for free slot while Master is consuming frames
+        while(myPairRing.isFull()
+           && !myToQuit
+           && !myToFlush
+           && !myMaster->isInDowntime()) {
+            myPairRing.waitSpace(10);
+        }
+        myPairRing.push(myDataAdp, myFramePts);
     } else {
         if(theIsStarted) {
             StHandle<StStereoParams> aParams = thePacket->getSource();
@@ -1123,7 +1139,18 @@ bool StVideoQueue::decodeFrame(const StHandle<StAVPacket>& thePacket,
         // simple one-stream case
         if(aSrcFormat == StFormat_FrameSequence) {
             if(isOddNumber(myFramesCounter)) {
-                myCachedFrame.fill(myDataAdp, false);
+                // keep reference to decoded frame, copy only converted data
+                // (initReference() releases the buffer, so check the counter first to keep it for reuse)
+                if(!myDataAdp.getBufferCounter().isNull()) {
+                    myCachedFrame.initReference(myDataAdp);
+                } else {
+                    if(!myCachedFrame.getBufferCounter().isNull()) {
+                        // never write into the previously referenced decoder frame
+                        myCachedFrame.nullify();
+                        myCachedFrame.setBufferCounter(NULL);
+                    }
+                    myCachedFrame.fill(myDataAdp, false);
+                }
             } else {
                 pushFrame(myCachedFrame, myDataAdp, thePacket->getSource(), StFormat_FrameSequence, aCubemapFormat, myFramePts);
             }
@@ -22,7 +22,9 @@
 #include <StGLStereo/StGLTextureQueue.h>
 
 #include "StAVPacketQueue.h"
+#include "StVideoPairRing.h"
 #include <StAV/StAVImage.h>
+#include <StThreads/StTelemetry.h>
 
 // forward declarations
 class StVideoQueue;
@@ -138,19 +140,6 @@ class StVideoQueue : public StAVPacketQueue {
         mySlave = theSlave;
     }
 
-    ST_LOCAL StImage* waitData(double& thePts) {
-        myHasDataState.wait();
-        if(myDataAdp.isNull()) {
-            return NULL;
-        }
-        thePts = myFramePts;
-        return &myDataAdp;
-    }
-
-    ST_LOCAL void unlockData() {
-        myHasDataState.reset();
-    }
-
     ST_LOCAL void setAClock(const double thePts) {
         myAudioClockMutex.lock();
         myAudioClock = thePts;
@@ -385,7 +374,7 @@ private:
     StCondition                myDowntimeState;   //!< event to indicate downtime state
     StHandle<StGLTextureQueue> myTextureQueue;    //!< decoded frames queue
 
-    StCondition                myHasDataState;
+    StVideoPairRing            myPairRing;        //!< frames decoded by Slave waiting for pairing with Master frames
     StHandle<StVideoQueue>     myMaster;          //!< handle to Master decoding thread
     StHandle<StVideoQueue>     mySlave;           //!< handle to Slave  decoding thread
 
@@ -433,6 +422,11 @@ private:
     volatile bool              myToStickPano360;  //!< stick to panorama 360 mode
     volatile bool              myToSwapJps;       //!< read JPS as Left/Right instead of Right/Left
 
+    StTelemetryHistogram*      myTelDecode;       //!< telemetry - time to decode the frame
+    StTelemetryHistogram*      myTelPrepare;      //!< telemetry - time to prepare decoded frame for upload
+    StTelemetryHistogram*      myTelPushWait;     //!< telemetry - time waiting for free slot in texture queue
+    StTelemetryCounter*        myTelFrames;       //!< telemetry - number of decoded frames
+
 };
 
 #endif // __StVideoQueue_h_
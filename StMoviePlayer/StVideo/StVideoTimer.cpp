@@ -19,6 +19,7 @@
 #include "StVideoTimer.h"
 
 #include <StThreads/StThread.h>
+#include <StThreads/StTracer.h>
 
 /**
  * Thread just call mainLoop() function.
@@ -54,6 +55,7 @@ StVideoTimer::StVideoTimer(const StHandle<StVideoQueue>& theVideo,
   mySpeedSlowRev(1.0 / mySpeedSlow),
   myIsBenchmark(false) {
     stMemZero(mySpeedDesc, sizeof(mySpeedDesc));
+    myInfoLock.setName("StVideoTimer::myInfoLock");
     myThread = new StThread(refreshThread, (void* )this, "StVideoTimer");
 }
 
@@ -91,11 +93,14 @@ void StVideoTimer::mainLoop() {
 
         if(myTimer.getElapsedTimeInMilliSec() >= myTimerThrNext) {
             // this is time we should show the next frame, call swap Front/Back here
-            while(!myVideo->getTextureQueue()->stglSwapFB(1)) {
-                if(isQuitMessage()) {
-                    return;
+            {
+                ST_TRACE_SCOPE("swapWait");
+                while(!myVideo->getTextureQueue()->stglSwapFB(1)) {
+                    if(isQuitMessage()) {
+                        return;
+                    }
+                    StThread::sleep(1);
                 }
-                StThread::sleep(1);
             }
 
             // store old timer threshold value to check diff at the end
@@ -141,6 +146,7 @@ void StVideoTimer::mainLoop() {
                 } else if(mySpeedFastSkip * myDelayTimer < myDelayVVAver) {
                     //myVideo->getTextureQueue()->drop(2, myVideoPtsNextSec);
                     myVideo->getTextureQueue()->drop(1, myVideoPtsNextSec);
+                    ST_TRACE_INSTANT("dropFrame");
                     myDelayTimer = mySpeedFastRev * myDelayVVAver;
                 } else if(mySpeedFast * myDelayTimer < myDelayVVAver) {
                     myDelayTimer = mySpeedFastRev * myDelayVVAver;
@@ -1015,6 +1015,11 @@ bool StOutPageFlip::isStereoFullscreenOnly() const {
 #endif
 }
 
+bool StOutPageFlip::isContinuousRedraw() const {
+    return StWindow::isContinuousRedraw()
+        || (isStereoOutput() && params.QuadBuffer->getValue() == QUADBUFFER_SOFT);
+}
+
 void StOutPageFlip::stglDraw() {
     myFPSControl.setTargetFPS(StWindow::getTargetFps());
 
@@ -136,6 +136,11 @@ class StOutPageFlip : public StWindow {
      */
     ST_CPPEXPORT virtual bool isStereoFullscreenOnly() const ST_ATTR_OVERRIDE;
 
+    /**
+     * Emulated page-flipping requires frames to be redrawn continuously.
+     */
+    ST_CPPEXPORT virtual bool isContinuousRedraw() const ST_ATTR_OVERRIDE;
+
         protected:
 
     ST_LOCAL void setupDevice();
@@ -551,9 +551,12 @@ bool StAVImage::loadExtra(const StString& theFilePath,
     return true;
 }
 
-bool StAVImage::save(const StString& theFilePath,
-                     ImageType       theImageType,
-                     StFormat        theSrcFormat) {
+bool StAVImage::encode(StRawFile& theBuffer,
+                       size_t&    theDataSize,
+                       ImageType  theImageType,
+                       StFormat   theSrcFormat,
+                       const int  theJpegQuality) {
+    theDataSize = 0;
     close();
     setState();
     if(isNull()) {
@@ -655,7 +658,7 @@ bool StAVImage::save(const StString& theFilePath,
             myCodecCtx->height  = (int )anImage.getSizeY();
             myCodecCtx->time_base.num = 1;
             myCodecCtx->time_base.den = 1;
-            myCodecCtx->qmin = myCodecCtx->qmax = 5; // quality factor - lesser is better
+            myCodecCtx->qmin = myCodecCtx->qmax = theJpegQuality; // quality factor - lesser is better
             break;
         }
         case ST_TYPE_NONE:
@@ -695,13 +698,6 @@ bool StAVImage::save(const StString& theFilePath,
     }
 #endif
 
-    StJpegParser aRawFile(theFilePath);
-    if(!aRawFile.openFile(StRawFile::WRITE)) {
-        setState("Can not open the file for writing");
-        close();
-        return false;
-    }
-
     // encode the image
     StAVPacket aPacket;
 #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 106, 102))
@@ -710,13 +706,14 @@ bool StAVImage::save(const StString& theFilePath,
     && avcodec_receive_packet(myCodecCtx, aPacket.getAVpkt()) == 0
     && aPacket.getAVpkt()->data != NULL) {
         anEncSize = aPacket.getSize();
-        aRawFile.wrapBuffer(aPacket.getAVpkt()->data, anEncSize);
+        theBuffer.initBuffer((size_t )anEncSize);
+        stMemCpy(theBuffer.changeBuffer(), aPacket.getAVpkt()->data, (size_t )anEncSize);
     }
 #else
     // allocate the buffer, large enough (stupid formula copied from ffmpeg.c)
     int aBuffSize = int(getSizeX() * getSizeY() * 10);
-    aRawFile.initBuffer(aBuffSize);
-    aPacket.getAVpkt()->data = (uint8_t* )aRawFile.changeBuffer();
+    theBuffer.initBuffer(aBuffSize);
+    aPacket.getAVpkt()->data = (uint8_t* )theBuffer.changeBuffer();
     aPacket.getAVpkt()->size = aBuffSize;
 #if(LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(54, 2, 100))
     int isGotPacket = 0;
@@ -728,12 +725,24 @@ bool StAVImage::save(const StString& theFilePath,
     int anEncSize = avcodec_encode_video(myCodecCtx, aPacket.changeData(), aPacket.getSize(), myFrame.Frame);
 #endif
 #endif
+    close();
     if(anEncSize <= 0) {
         setState("AVCodec library, fail to encode the image");
-        close();
         return false;
     }
-    aRawFile.setDataSize((size_t )anEncSize);
+    theDataSize = (size_t )anEncSize;
+    return true;
+}
+
+bool StAVImage::save(const StString& theFilePath,
+                     ImageType       theImageType,
+                     StFormat        theSrcFormat) {
+    StJpegParser aRawFile(theFilePath);
+    size_t anEncSize = 0;
+    if(!encode(aRawFile, anEncSize, theImageType, theSrcFormat)) {
+        return false;
+    }
+    aRawFile.setDataSize(anEncSize);
 
     // save metadata when possible
     if(theImageType == ST_TYPE_JPEG
@@ -747,6 +756,11 @@ bool StAVImage::save(const StString& theFilePath,
         }
     }
 
+    if(!aRawFile.openFile(StRawFile::WRITE)) {
+        setState("Can not open the file for writing");
+        return false;
+    }
+
     // store current content
     aRawFile.writeFile();
     // and finally close the file handle
@@ -0,0 +1,496 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StStrings/StBase64.h>
+
+#include <StThreads/StTaskPool.h>
+
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+    #define ST_BASE64_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define ST_BASE64_TARGET(theIsa)
+    #else
+        #define ST_BASE64_TARGET(theIsa) __attribute__((target(theIsa)))
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define ST_BASE64_NEON
+    #include <arm_neon.h>
+#endif
+
+namespace {
+
+    //! Look-up table for decoding base64 stream, 255 means invalid character.
+    static const stUByte_t THE_BASE64_FROM[256] = {
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,  62, 255,  62, 255,  63,
+         52,  53,  54,  55,  56,  57,  58,  59,  60,  61, 255, 255, 255, 255, 255, 255,
+        255,   0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  10,  11,  12,  13,  14,
+         15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25, 255, 255, 255, 255,  63,
+        255,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,
+         41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  51, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+    };
+
+    /**
+     * Number of groups decoded by scalar path between SIMD runs.
+     */
+    static const size_t THE_SCALAR_BLOCK = 16;
+
+    /**
+     * Number of groups within single chunk of parallel decoding (1 MiB of input).
+     */
+    static const size_t THE_CHUNK_QUADS = 256 * 1024;
+
+    /**
+     * SIMD level.
+     */
+    enum SimdLevel {
+        SimdLevel_None,
+        SimdLevel_SSSE3,
+        SimdLevel_AVX2,
+        SimdLevel_NEON,
+    };
+
+    /**
+     * Detect the SIMD level supported by CPU.
+     */
+    static SimdLevel detectSimdLevel() {
+    #if defined(ST_BASE64_X86)
+        bool hasSsse3 = false;
+        bool hasAvx2  = false;
+      #if defined(_MSC_VER)
+        int aRegs[4] = { 0, 0, 0, 0 };
+        __cpuid(aRegs, 0);
+        const int aMaxLeaf = aRegs[0];
+        __cpuid(aRegs, 1);
+        hasSsse3 = (aRegs[2] & (1 << 9)) != 0;
+        const bool hasOsAvx = (aRegs[2] & (1 << 27)) != 0  // OSXSAVE
+                           && (aRegs[2] & (1 << 28)) != 0  // AVX
+                           && (_xgetbv(0) & 0x6) == 0x6;   // XMM and YMM state saved by OS
+        if(aMaxLeaf >= 7 && hasOsAvx) {
+            __cpuidex(aRegs, 7, 0);
+            hasAvx2 = (aRegs[1] & (1 << 5)) != 0;
+        }
+      #else
+        __builtin_cpu_init();
+        hasSsse3 = __builtin_cpu_supports("ssse3") != 0;
+        hasAvx2  = __builtin_cpu_supports("avx2")  != 0;
+      #endif
+        if(hasAvx2) {
+            return SimdLevel_AVX2;
+        }
+        return hasSsse3 ? SimdLevel_SSSE3 : SimdLevel_None;
+    #elif defined(ST_BASE64_NEON)
+        return SimdLevel_NEON;
+    #else
+        return SimdLevel_None;
+    #endif
+    }
+
+    /**
+     * @return SIMD level supported by CPU (detected once)
+     */
+    static SimdLevel getSimdLevel() {
+        static const SimdLevel THE_LEVEL = detectSimdLevel();
+        return THE_LEVEL;
+    }
+
+    /**
+     * Decode complete groups using look-up table.
+     * @return number of decoded groups
+     */
+    static size_t decodeScalar(stUByte_t*       theDst,
+                               const stUByte_t* theSrc,
+                               const size_t     theNbQuads) {
+        for(size_t aQuad = 0; aQuad < theNbQuads; ++aQuad, theSrc += 4, theDst += 3) {
+            const stUByte_t a = THE_BASE64_FROM[theSrc[0]];
+            const stUByte_t b = THE_BASE64_FROM[theSrc[1]];
+            const stUByte_t c = THE_BASE64_FROM[theSrc[2]];
+            const stUByte_t d = THE_BASE64_FROM[theSrc[3]];
+            if(((a | b | c | d) & 0x80) != 0) {
+                return aQuad;
+            }
+
+            const uint32_t aBits = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | uint32_t(d);
+            theDst[0] = stUByte_t(aBits >> 16);
+            theDst[1] = stUByte_t(aBits >> 8);
+            theDst[2] = stUByte_t(aBits);
+        }
+        return theNbQuads;
+    }
+
+#if defined(ST_BASE64_X86)
+
+    /**
+     * Decode groups using SSSE3 (16 characters per iteration).
+     * Characters are validated and translated using nibble look-up tables
+     * (W. Mula, D. Lemire, "Faster Base64 Encoding and Decoding using AVX2 Instructions").
+     * @return number of decoded groups; stops before the block with characters out of standard alphabet
+     */
+    ST_BASE64_TARGET("ssse3")
+    static size_t decodeSsse3(stUByte_t*       theDst,
+                              const stUByte_t* theSrc,
+                              const size_t     theNbQuads) {
+        const __m128i aLutLo   = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                               0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m128i aLutHi   = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                               0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m128i aLutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                               0,  0,  0, 0,   0,   0,   0,   0);
+        const __m128i aMask2F  = _mm_set1_epi8(0x2F);
+        const __m128i aZero    = _mm_setzero_si128();
+        const __m128i aMerge1  = _mm_set1_epi32(0x01400140);
+        const __m128i aMerge2  = _mm_set1_epi32(0x00011000);
+        const __m128i aShuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+        // 16 bytes are written for 12 decoded ones - keep at least two groups after the block
+        size_t aQuad = 0;
+        for(; aQuad + 6 <= theNbQuads; aQuad += 4) {
+            __m128i aStr = _mm_loadu_si128((const __m128i* )(theSrc + aQuad * 4));
+            const __m128i aHiNibbles = _mm_and_si128(_mm_srli_epi32(aStr, 4), aMask2F);
+            const __m128i aLoNibbles = _mm_and_si128(aStr, aMask2F);
+            const __m128i aHi = _mm_shuffle_epi8(aLutHi, aHiNibbles);
+            const __m128i aLo = _mm_shuffle_epi8(aLutLo, aLoNibbles);
+            if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(aLo, aHi), aZero)) != 0xFFFF) {
+                break;
+            }
+
+            const __m128i anEq2F = _mm_cmpeq_epi8(aStr, aMask2F);
+            const __m128i aRoll  = _mm_shuffle_epi8(aLutRoll, _mm_add_epi8(anEq2F, aHiNibbles));
+            aStr = _mm_add_epi8(aStr, aRoll);
+
+            // pack 4x6 bits into 3 bytes
+            __m128i anOut = _mm_madd_epi16(_mm_maddubs_epi16(aStr, aMerge1), aMerge2);
+            anOut = _mm_shuffle_epi8(anOut, aShuffle);
+            _mm_storeu_si128((__m128i* )(theDst + aQuad * 3), anOut);
+        }
+        return aQuad;
+    }
+
+    /**
+     * Decode groups using AVX2 (32 characters per iteration).
+     * @return number of decoded groups; stops before the block with characters out of standard alphabet
+     */
+    ST_BASE64_TARGET("avx2")
+    static size_t decodeAvx2(stUByte_t*       theDst,
+                             const stUByte_t* theSrc,
+                             const size_t     theNbQuads) {
+        const __m256i aLutLo   = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                                  0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                                  0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                                  0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m256i aLutHi   = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                                  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                                  0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                                  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m256i aLutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                                  0,  0,  0, 0,   0,   0,   0,   0,
+                                                  0, 16, 19, 4, -65, -65, -71, -71,
+                                                  0,  0,  0, 0,   0,   0,   0,   0);
+        const __m256i aMask2F  = _mm256_set1_epi8(0x2F);
+        const __m256i aMerge1  = _mm256_set1_epi32(0x01400140);
+        const __m256i aMerge2  = _mm256_set1_epi32(0x00011000);
+        const __m256i aShuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                  2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        const __m256i aPermute = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+        // 32 bytes are written for 24 decoded ones - keep at least three groups after the block
+        size_t aQuad = 0;
+        for(; aQuad + 11 <= theNbQuads; aQuad += 8) {
+            __m256i aStr = _mm256_loadu_si256((const __m256i* )(theSrc + aQuad * 4));
+            const __m256i aHiNibbles = _mm256_and_si256(_mm256_srli_epi32(aStr, 4), aMask2F);
+            const __m256i aLoNibbles = _mm256_and_si256(aStr, aMask2F);
+            const __m256i aHi = _mm256_shuffle_epi8(aLutHi, aHiNibbles);
+            const __m256i aLo = _mm256_shuffle_epi8(aLutLo, aLoNibbles);
+            if(!_mm256_testz_si256(aLo, aHi)) {
+                break;
+            }
+
+            const __m256i anEq2F = _mm256_cmpeq_epi8(aStr, aMask2F);
+            const __m256i aRoll  = _mm256_shuffle_epi8(aLutRoll, _mm256_add_epi8(anEq2F, aHiNibbles));
+            aStr = _mm256_add_epi8(aStr, aRoll);
+
+            __m256i anOut = _mm256_madd_epi16(_mm256_maddubs_epi16(aStr, aMerge1), aMerge2);
+            anOut = _mm256_shuffle_epi8(anOut, aShuffle);
+            anOut = _mm256_permutevar8x32_epi32(anOut, aPermute);
+            _mm256_storeu_si256((__m256i* )(theDst + aQuad * 3), anOut);
+        }
+        return aQuad;
+    }
+
+#elif defined(ST_BASE64_NEON)
+
+    /**
+     * Translate 16 characters into 6-bit values, clear theValid lanes for invalid characters.
+     */
+    inline uint8x16_t decodeNeonLane(const uint8x16_t theStr,
+                                     uint8x16_t&      theValid) {
+        const uint8x16_t anUpper = vsubq_u8(theStr, vdupq_n_u8('A'));
+        const uint8x16_t aLower  = vsubq_u8(theStr, vdupq_n_u8('a'));
+        const uint8x16_t aDigit  = vsubq_u8(theStr, vdupq_n_u8('0'));
+        const uint8x16_t isUpper = vcltq_u8(anUpper, vdupq_n_u8(26));
+        const uint8x16_t isLower = vcltq_u8(aLower,  vdupq_n_u8(26));
+        const uint8x16_t isDigit = vcltq_u8(aDigit,  vdupq_n_u8(10));
+        const uint8x16_t isPlus  = vceqq_u8(theStr,  vdupq_n_u8('+'));
+        const uint8x16_t isSlash = vceqq_u8(theStr,  vdupq_n_u8('/'));
+
+        uint8x16_t aRes = vandq_u8(isUpper, anUpper);
+        aRes = vorrq_u8(aRes, vandq_u8(isLower, vaddq_u8(aLower, vdupq_n_u8(26))));
+        aRes = vorrq_u8(aRes, vandq_u8(isDigit, vaddq_u8(aDigit, vdupq_n_u8(52))));
+        aRes = vorrq_u8(aRes, vandq_u8(isPlus,  vdupq_n_u8(62)));
+        aRes = vorrq_u8(aRes, vandq_u8(isSlash, vdupq_n_u8(63)));
+        theValid = vandq_u8(theValid, vorrq_u8(vorrq_u8(isUpper, isLower),
+                                               vorrq_u8(vorrq_u8(isDigit, isPlus), isSlash)));
+        return aRes;
+    }
+
+    /**
+     * Decode groups using NEON (64 characters per iteration).
+     * @return number of decoded groups; stops before the block with characters out of standard alphabet
+     */
+    static size_t decodeNeon(stUByte_t*       theDst,
+                             const stUByte_t* theSrc,
+                             const size_t     theNbQuads) {
+        size_t aQuad = 0;
+        for(; aQuad + 16 <= theNbQuads; aQuad += 16) {
+            // de-interleave groups, so that each vector holds the same character of 16 groups
+            const uint8x16x4_t aStr = vld4q_u8(theSrc + aQuad * 4);
+            uint8x16_t aValid = vdupq_n_u8(0xFF);
+            const uint8x16_t a = decodeNeonLane(aStr.val[0], aValid);
+            const uint8x16_t b = decodeNeonLane(aStr.val[1], aValid);
+            const uint8x16_t c = decodeNeonLane(aStr.val[2], aValid);
+            const uint8x16_t d = decodeNeonLane(aStr.val[3], aValid);
+            if(vminvq_u8(aValid) == 0) {
+                break;
+            }
+
+            uint8x16x3_t anOut;
+            anOut.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+            anOut.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+            anOut.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+            vst3q_u8(theDst + aQuad * 3, anOut);
+        }
+        return aQuad;
+    }
+
+#endif
+
+    /**
+     * Decode groups using SIMD path.
+     * @return number of decoded groups
+     */
+    static size_t decodeSimd(stUByte_t*       theDst,
+                             const stUByte_t* theSrc,
+                             const size_t     theNbQuads) {
+        switch(getSimdLevel()) {
+        #if defined(ST_BASE64_X86)
+            case SimdLevel_AVX2:  return decodeAvx2 (theDst, theSrc, theNbQuads);
+            case SimdLevel_SSSE3: return decodeSsse3(theDst, theSrc, theNbQuads);
+        #elif defined(ST_BASE64_NEON)
+            case SimdLevel_NEON:  return decodeNeon (theDst, theSrc, theNbQuads);
+        #endif
+            default: return 0;
+        }
+    }
+
+    /**
+     * @return number of padding characters at the end of the stream
+     */
+    static size_t getPadding(const char*  theSrc,
+                             const size_t theSrcLen) {
+        if(theSrcLen == 0
+        || theSrcLen % 4 != 0) {
+            return 0;
+        }
+        size_t aPad = 0;
+        if(theSrc[theSrcLen - 1] == '=') {
+            ++aPad;
+            if(theSrc[theSrcLen - 2] == '=') {
+                ++aPad;
+            }
+        }
+        return aPad;
+    }
+
+    /**
+     * @return position of the first invalid character within the group
+     */
+    static size_t findInvalid(const stUByte_t* theSrc,
+                              const size_t     theLen) {
+        for(size_t aPos = 0; aPos < theLen; ++aPos) {
+            if(THE_BASE64_FROM[theSrc[aPos]] == 255) {
+                return aPos;
+            }
+        }
+        return theLen;
+    }
+
+    /**
+     * Decode the last incomplete group (2 or 3 characters).
+     */
+    static bool decodeTail(stUByte_t*       theDst,
+                           const stUByte_t* theSrc,
+                           const size_t     theLen,
+                           size_t&          theErrorPos) {
+        stUByte_t aQuad[4] = { 'A', 'A', 'A', 'A' };
+        for(size_t aPos = 0; aPos < theLen; ++aPos) {
+            aQuad[aPos] = theSrc[aPos];
+        }
+        stUByte_t aBytes[3] = { 0, 0, 0 };
+        if(theLen < 2
+        || decodeScalar(aBytes, aQuad, 1) != 1) {
+            theErrorPos = theLen < 2 ? 0 : findInvalid(aQuad, theLen);
+            return false;
+        }
+        for(size_t aByte = 0; aByte + 1 < theLen; ++aByte) {
+            theDst[aByte] = aBytes[aByte];
+        }
+        return true;
+    }
+
+    /**
+     * Functor decoding chunks of the stream.
+     */
+    class StBase64ChunkFunctor {
+
+            public:
+
+        StBase64ChunkFunctor(stUByte_t*           theDst,
+                             const stUByte_t*     theSrc,
+                             const size_t         theNbQuads,
+                             std::vector<size_t>& theDone)
+        : myDst(theDst),
+          mySrc(theSrc),
+          myNbQuads(theNbQuads),
+          myDone(&theDone) {}
+
+        void operator()(const size_t theChunk) const {
+            const size_t aFrom = theChunk * THE_CHUNK_QUADS;
+            const size_t aNb   = stMin(THE_CHUNK_QUADS, myNbQuads - aFrom);
+            (*myDone)[theChunk] = StBase64::decodeQuads(myDst + aFrom * 3, mySrc + aFrom * 4, aNb);
+        }
+
+            private:
+
+        stUByte_t*           myDst;
+        const stUByte_t*     mySrc;
+        size_t               myNbQuads;
+        std::vector<size_t>* myDone;
+
+    };
+
+}
+
+size_t StBase64::getDecodedSize(const char*  theSrc,
+                                const size_t theSrcLen) {
+    const size_t aLen = theSrcLen - getPadding(theSrc, theSrcLen);
+    const size_t aTail = aLen % 4;
+    return (aLen / 4) * 3 + (aTail > 1 ? aTail - 1 : 0);
+}
+
+const char* StBase64::getSimdName() {
+    switch(getSimdLevel()) {
+        case SimdLevel_AVX2:  return "AVX2";
+        case SimdLevel_SSSE3: return "SSSE3";
+        case SimdLevel_NEON:  return "NEON";
+        case SimdLevel_None:  break;
+    }
+    return "scalar";
+}
+
+size_t StBase64::decodeQuads(stUByte_t*       theDst,
+                             const stUByte_t* theSrc,
+                             const size_t     theNbQuads,
+                             const Impl       theImpl) {
+    size_t aQuad = 0;
+    while(aQuad < theNbQuads) {
+        if(theImpl == Impl_Auto) {
+            aQuad += decodeSimd(theDst + aQuad * 3, theSrc + aQuad * 4, theNbQuads - aQuad);
+        }
+
+        // scalar path decodes the tail and blocks rejected by SIMD path (URL-safe alphabet or invalid characters)
+        const size_t aNbScalar = theImpl == Impl_Auto
+                               ? stMin(theNbQuads - aQuad, THE_SCALAR_BLOCK)
+                               : theNbQuads - aQuad;
+        const size_t aNbDone = decodeScalar(theDst + aQuad * 3, theSrc + aQuad * 4, aNbScalar);
+        aQuad += aNbDone;
+        if(aNbDone != aNbScalar) {
+            break;
+        }
+    }
+    return aQuad;
+}
+
+bool StBase64::decode(stUByte_t*   theDst,
+                      const char*  theSrc,
+                      const size_t theSrcLen,
+                      size_t&      theErrorPos,
+                      const Impl   theImpl) {
+    const stUByte_t* aSrc = (const stUByte_t* )theSrc;
+    const size_t aLen     = theSrcLen - getPadding(theSrc, theSrcLen);
+    const size_t aNbQuads = aLen / 4;
+    const size_t aDone = decodeQuads(theDst, aSrc, aNbQuads, theImpl);
+    if(aDone != aNbQuads) {
+        theErrorPos = aDone * 4 + findInvalid(aSrc + aDone * 4, 4);
+        return false;
+    }
+
+    const size_t aTail = aLen % 4;
+    if(aTail != 0
+    && !decodeTail(theDst + aNbQuads * 3, aSrc + aNbQuads * 4, aTail, theErrorPos)) {
+        theErrorPos += aNbQuads * 4;
+        return false;
+    }
+    return true;
+}
+
+bool StBase64::decodeParallel(stUByte_t*   theDst,
+                              const char*  theSrc,
+                              const size_t theSrcLen,
+                              size_t&      theErrorPos) {
+    const size_t aLen     = theSrcLen - getPadding(theSrc, theSrcLen);
+    const size_t aNbQuads = aLen / 4;
+    if(aNbQuads < THE_CHUNK_QUADS * 2) {
+        return decode(theDst, theSrc, theSrcLen, theErrorPos);
+    }
+
+    // chunks are aligned to groups, so that each chunk is decoded into its own part of destination buffer
+    const stUByte_t* aSrc = (const stUByte_t* )theSrc;
+    const size_t aNbChunks = (aNbQuads + THE_CHUNK_QUADS - 1) / THE_CHUNK_QUADS;
+    std::vector<size_t> aDone(aNbChunks, 0);
+    StTaskPool::GetDefault().parallelFor(0, aNbChunks, StBase64ChunkFunctor(theDst, aSrc, aNbQuads, aDone),
+                                         StTaskPool::Priority_Interactive, 1);
+    for(size_t aChunk = 0; aChunk < aNbChunks; ++aChunk) {
+        const size_t aFrom = aChunk * THE_CHUNK_QUADS;
+        if(aDone[aChunk] != stMin(THE_CHUNK_QUADS, aNbQuads - aFrom)) {
+            const size_t aQuad = aFrom + aDone[aChunk];
+            theErrorPos = aQuad * 4 + findInvalid(aSrc + aQuad * 4, 4);
+            return false;
+        }
+    }
+
+    const size_t aTail = aLen % 4;
+    if(aTail != 0
+    && !decodeTail(theDst + aNbQuads * 3, aSrc + aNbQuads * 4, aTail, theErrorPos)) {
+        theErrorPos += aNbQuads * 4;
+        return false;
+    }
+    return true;
+}
@@ -8,8 +8,170 @@
 
 #include <StGLMesh/StBndBox.h>
 #include <StTemplates/StArrayList.h>
+#include <StThreads/StTaskPool.h>
+
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ST_BNDBOX_SSE2
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define ST_BNDBOX_NEON
+    #include <arm_neon.h>
+#endif
 
 namespace {
+
+    /**
+     * Number of points processed by single task.
+     */
+    static const size_t THE_CHUNK_POINTS = 64 * 1024;
+
+    /**
+     * Extreme values and points within the range.
+     */
+    struct StPointsExtremes {
+        StGLVec3 Min;    //!< x/y/z minimal values
+        StGLVec3 Max;    //!< x/y/z maximal values
+        size_t   Ids[6]; //!< indices of points with minimal and maximal values
+
+        /**
+         * Initialize by the first point.
+         */
+        void init(const StGLVec3& thePnt,
+                  const size_t    theIndex) {
+            Min = thePnt;
+            Max = thePnt;
+            for(int anAxis = 0; anAxis < 6; ++anAxis) {
+                Ids[anAxis] = theIndex;
+            }
+        }
+
+        /**
+         * Add the point.
+         */
+        void add(const StGLVec3& thePnt,
+                 const size_t    theIndex) {
+            for(int anAxis = 0; anAxis < 3; ++anAxis) {
+                if(thePnt[anAxis] < Min[anAxis]) {
+                    Min[anAxis] = thePnt[anAxis];
+                    Ids[anAxis] = theIndex;
+                }
+                if(thePnt[anAxis] > Max[anAxis]) {
+                    Max[anAxis] = thePnt[anAxis];
+                    Ids[anAxis + 3] = theIndex;
+                }
+            }
+        }
+
+        /**
+         * Merge with extremes of the following range.
+         */
+        void merge(const StPointsExtremes& theOther) {
+            for(int anAxis = 0; anAxis < 3; ++anAxis) {
+                if(theOther.Min[anAxis] < Min[anAxis]) {
+                    Min[anAxis] = theOther.Min[anAxis];
+                    Ids[anAxis] = theOther.Ids[anAxis];
+                }
+                if(theOther.Max[anAxis] > Max[anAxis]) {
+                    Max[anAxis] = theOther.Max[anAxis];
+                    Ids[anAxis + 3] = theOther.Ids[anAxis + 3];
+                }
+            }
+        }
+
+    };
+
+    /**
+     * Find extremes within the range of points.
+     * SIMD path checks blocks of 4 points against current extremes
+     * and falls back to per-point update only when block contains new extreme (which is rare).
+     * Each point is loaded as 4 floats, so that the block is processed only when one more point follows it.
+     */
+    static void findExtremes(const StGLVec3*   thePoints,
+                             const size_t      theFrom,
+                             const size_t      theTo,
+                             StPointsExtremes& theRes) {
+        theRes.init(thePoints[theFrom], theFrom);
+        size_t aPntIter = theFrom + 1;
+    #if defined(ST_BNDBOX_SSE2)
+        __m128 aMin = _mm_setr_ps(theRes.Min.x(), theRes.Min.y(), theRes.Min.z(), 0.0f);
+        __m128 aMax = _mm_setr_ps(theRes.Max.x(), theRes.Max.y(), theRes.Max.z(), 0.0f);
+        for(; aPntIter + 4 < theTo; aPntIter += 4) {
+            const __m128 aPnt0 = _mm_loadu_ps(thePoints[aPntIter + 0].getData());
+            const __m128 aPnt1 = _mm_loadu_ps(thePoints[aPntIter + 1].getData());
+            const __m128 aPnt2 = _mm_loadu_ps(thePoints[aPntIter + 2].getData());
+            const __m128 aPnt3 = _mm_loadu_ps(thePoints[aPntIter + 3].getData());
+            const __m128 aBlockMin = _mm_min_ps(_mm_min_ps(aPnt0, aPnt1), _mm_min_ps(aPnt2, aPnt3));
+            const __m128 aBlockMax = _mm_max_ps(_mm_max_ps(aPnt0, aPnt1), _mm_max_ps(aPnt2, aPnt3));
+            const int aMask = _mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(aBlockMin, aMin),
+                                                        _mm_cmpgt_ps(aBlockMax, aMax))) & 0x7;
+            if(aMask != 0) {
+                for(size_t aSubIter = 0; aSubIter < 4; ++aSubIter) {
+                    theRes.add(thePoints[aPntIter + aSubIter], aPntIter + aSubIter);
+                }
+                aMin = _mm_setr_ps(theRes.Min.x(), theRes.Min.y(), theRes.Min.z(), 0.0f);
+                aMax = _mm_setr_ps(theRes.Max.x(), theRes.Max.y(), theRes.Max.z(), 0.0f);
+            }
+        }
+    #elif defined(ST_BNDBOX_NEON)
+        static const uint32_t THE_MASK_XYZ[4] = { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0u };
+        const uint32x4_t aMaskXyz = vld1q_u32(THE_MASK_XYZ);
+        const float aFirstVals[4] = { theRes.Min.x(), theRes.Min.y(), theRes.Min.z(), 0.0f };
+        float32x4_t aMin = vld1q_f32(aFirstVals);
+        float32x4_t aMax = aMin;
+        for(; aPntIter + 4 < theTo; aPntIter += 4) {
+            const float32x4_t aPnt0 = vld1q_f32(thePoints[aPntIter + 0].getData());
+            const float32x4_t aPnt1 = vld1q_f32(thePoints[aPntIter + 1].getData());
+            const float32x4_t aPnt2 = vld1q_f32(thePoints[aPntIter + 2].getData());
+            const float32x4_t aPnt3 = vld1q_f32(thePoints[aPntIter + 3].getData());
+            const float32x4_t aBlockMin = vminq_f32(vminq_f32(aPnt0, aPnt1), vminq_f32(aPnt2, aPnt3));
+            const float32x4_t aBlockMax = vmaxq_f32(vmaxq_f32(aPnt0, aPnt1), vmaxq_f32(aPnt2, aPnt3));
+            const uint32x4_t  aMask = vandq_u32(vorrq_u32(vcltq_f32(aBlockMin, aMin),
+                                                          vcgtq_f32(aBlockMax, aMax)), aMaskXyz);
+            if(vmaxvq_u32(aMask) != 0) {
+                for(size_t aSubIter = 0; aSubIter < 4; ++aSubIter) {
+                    theRes.add(thePoints[aPntIter + aSubIter], aPntIter + aSubIter);
+                }
+                const float aMinVals[4] = { theRes.Min.x(), theRes.Min.y(), theRes.Min.z(), 0.0f };
+                const float aMaxVals[4] = { theRes.Max.x(), theRes.Max.y(), theRes.Max.z(), 0.0f };
+                aMin = vld1q_f32(aMinVals);
+                aMax = vld1q_f32(aMaxVals);
+            }
+        }
+    #endif
+        for(; aPntIter < theTo; ++aPntIter) {
+            theRes.add(thePoints[aPntIter], aPntIter);
+        }
+    }
+
+    /**
+     * Functor finding extremes within chunks of points.
+     */
+    class StExtremesFunctor {
+
+            public:
+
+        StExtremesFunctor(const StGLVec3*                thePoints,
+                          const size_t                   theNbPoints,
+                          std::vector<StPointsExtremes>& theResults)
+        : myPoints(thePoints),
+          myNbPoints(theNbPoints),
+          myResults(theResults) {}
+
+        void operator()(const size_t theChunk) const {
+            const size_t aFrom = theChunk * THE_CHUNK_POINTS;
+            findExtremes(myPoints, aFrom, stMin(aFrom + THE_CHUNK_POINTS, myNbPoints), myResults[theChunk]);
+        }
+
+            private:
+
+        const StGLVec3*                myPoints;
+        const size_t                   myNbPoints;
+        std::vector<StPointsExtremes>& myResults;
+
+    };
+
     static StGLVec3 getMinValues(const StGLVec3& theVec1, const StGLVec3& theVec2) {
         return StGLVec3(stMin(theVec1.x(), theVec2.x()),
                         stMin(theVec1.y(), theVec2.y()),
@@ -85,15 +247,43 @@ void StBndBox::enlarge(const StArray<StGLVec3>& thePoints) {
     if(thePoints.size() == 0) {
         return;
     }
+    StGLVec3 aMin, aMax;
+    computeExtremes(&thePoints.getFirst(), thePoints.size(), aMin, aMax);
     if(isVoid()) {
-        // setup the first point
-        myMin = thePoints.getFirst();
-        myMax = thePoints.getFirst();
+        myMin = aMin;
+        myMax = aMax;
         StBndContainer::setDefined();
+    } else {
+        myMin = getMinValues(myMin, aMin);
+        myMax = getMaxValues(myMax, aMax);
+    }
+}
+
+void StBndBox::computeExtremes(const StGLVec3* thePoints,
+                               const size_t    theNbPoints,
+                               StGLVec3&       theMin,
+                               StGLVec3&       theMax,
+                               size_t*         theExtremes) {
+    ST_DEBUG_ASSERT(theNbPoints > 0);
+    StPointsExtremes aRes;
+    if(theNbPoints < THE_CHUNK_POINTS * 2) {
+        findExtremes(thePoints, 0, theNbPoints, aRes);
+    } else {
+        // merge chunks in order, so that result does not depend on threads scheduling
+        std::vector<StPointsExtremes> aChunks((theNbPoints + THE_CHUNK_POINTS - 1) / THE_CHUNK_POINTS);
+        StTaskPool::GetDefault().parallelFor(0, aChunks.size(), StExtremesFunctor(thePoints, theNbPoints, aChunks),
+                                             StTaskPool::Priority_Interactive, 1);
+        aRes = aChunks[0];
+        for(size_t aChunkIter = 1; aChunkIter < aChunks.size(); ++aChunkIter) {
+            aRes.merge(aChunks[aChunkIter]);
+        }
     }
-    for(size_t aPntId = 1; aPntId < thePoints.size(); ++aPntId) {
-        const StGLVec3& aPnt = thePoints[aPntId];
-        myMin = getMinValues(myMin, aPnt);
-        myMax = getMaxValues(myMax, aPnt);
+
+    theMin = aRes.Min;
+    theMax = aRes.Max;
+    if(theExtremes != NULL) {
+        for(int anAxis = 0; anAxis < 6; ++anAxis) {
+            theExtremes[anAxis] = aRes.Ids[anAxis];
+        }
     }
 }
@@ -8,10 +8,194 @@
  */
 
 #include <StGLMesh/StBndSphere.h>
+#include <StGLMesh/StBndBox.h>
 #include <StTemplates/StArrayList.h>
 #include <StGL/StGLMatrix.h>
+#include <StThreads/StTaskPool.h>
 
 #include <cfloat>
+#include <vector>
+
+namespace {
+
+    /**
+     * Number of points processed by single task.
+     */
+    static const size_t THE_CHUNK_POINTS = 64 * 1024;
+
+    /**
+     * Minimal number of points to compute sphere in parallel instead of Welzl's algorithm.
+     */
+    static const size_t THE_PARALLEL_MIN = 2 * THE_CHUNK_POINTS;
+
+    /**
+     * Number of refinement iterations of parallel sphere.
+     */
+    static const int THE_REFINE_ITERS = 16;
+
+    /**
+     * Sphere defined by center and radius.
+     */
+    struct StRitterSphere {
+        StGLVec3 Center;
+        GLfloat  Radius;
+
+        StRitterSphere() : Radius(0.0f) {}
+
+        /**
+         * Enlarge sphere to include the point.
+         */
+        void add(const StGLVec3& thePnt) {
+            const StGLVec3 dV = thePnt - Center;
+            const GLfloat aDistSquare = dV.squareModulus();
+            if(aDistSquare <= Radius * Radius) {
+                return;
+            }
+            const GLfloat aDist = std::sqrt(aDistSquare);
+            Radius = (Radius + aDist) * 0.5f;
+            Center = Center + dV * ((aDist - Radius) / aDist);
+        }
+
+        /**
+         * Enlarge sphere to include another sphere.
+         */
+        void add(const StRitterSphere& theOther) {
+            const StGLVec3 dV = theOther.Center - Center;
+            const GLfloat aDist = dV.modulus();
+            if(aDist + theOther.Radius <= Radius) {
+                return;
+            } else if(aDist + Radius <= theOther.Radius) {
+                *this = theOther;
+                return;
+            }
+            const GLfloat aRadius = (aDist + Radius + theOther.Radius) * 0.5f;
+            Center = Center + dV * ((aRadius - Radius) / aDist);
+            Radius = aRadius;
+        }
+    };
+
+    /**
+     * Define initial sphere by the largest extent between extreme points.
+     */
+    static StRitterSphere initialSphere(const StArray<StGLVec3>& thePoints) {
+        StGLVec3 aMin, aMax;
+        size_t anExtremes[6];
+        StBndBox::computeExtremes(&thePoints.getFirst(), thePoints.size(), aMin, aMax, anExtremes);
+
+        int aBestAxis = 0;
+        GLfloat aBestSquare = -1.0f;
+        for(int anAxis = 0; anAxis < 3; ++anAxis) {
+            const GLfloat aSquare = (thePoints[anExtremes[anAxis + 3]] - thePoints[anExtremes[anAxis]]).squareModulus();
+            if(aSquare > aBestSquare) {
+                aBestSquare = aSquare;
+                aBestAxis   = anAxis;
+            }
+        }
+
+        const StGLVec3& aPntMin = thePoints[anExtremes[aBestAxis]];
+        const StGLVec3& aPntMax = thePoints[anExtremes[aBestAxis + 3]];
+        StRitterSphere aSphere;
+        aSphere.Center = aPntMin + (aPntMax - aPntMin) * 0.5f;
+        aSphere.Radius = (aPntMax - aSphere.Center).modulus();
+        return aSphere;
+    }
+
+    /**
+     * Functor growing the initial sphere by chunks of points.
+     */
+    class StRitterFunctor {
+
+            public:
+
+        StRitterFunctor(const StArray<StGLVec3>&     thePoints,
+                        const StRitterSphere&        theInitial,
+                        std::vector<StRitterSphere>& theResults)
+        : myPoints(thePoints),
+          myInitial(theInitial),
+          myResults(theResults) {}
+
+        void operator()(const size_t theChunk) const {
+            const size_t aFrom = theChunk * THE_CHUNK_POINTS;
+            const size_t aTo   = stMin(aFrom + THE_CHUNK_POINTS, myPoints.size());
+            StRitterSphere aSphere = myInitial;
+            for(size_t aPntId = aFrom; aPntId < aTo; ++aPntId) {
+                aSphere.add(myPoints[aPntId]);
+            }
+            myResults[theChunk] = aSphere;
+        }
+
+            private:
+
+        const StArray<StGLVec3>&     myPoints;
+        const StRitterSphere         myInitial;
+        std::vector<StRitterSphere>& myResults;
+
+    };
+
+    /**
+     * The farthest point within the chunk.
+     */
+    struct StFarthestPoint {
+        GLfloat SquareDist;
+        size_t  Index;
+    };
+
+    /**
+     * Functor searching the farthest point from the center by chunks of points.
+     */
+    class StFarthestFunctor {
+
+            public:
+
+        StFarthestFunctor(const StArray<StGLVec3>&      thePoints,
+                          const StGLVec3&               theCenter,
+                          std::vector<StFarthestPoint>& theResults)
+        : myPoints(thePoints),
+          myCenter(theCenter),
+          myResults(theResults) {}
+
+        void operator()(const size_t theChunk) const {
+            const size_t aFrom = theChunk * THE_CHUNK_POINTS;
+            const size_t aTo   = stMin(aFrom + THE_CHUNK_POINTS, myPoints.size());
+            StFarthestPoint aRes;
+            aRes.SquareDist = -1.0f;
+            aRes.Index      = aFrom;
+            for(size_t aPntId = aFrom; aPntId < aTo; ++aPntId) {
+                const GLfloat aSquare = (myPoints[aPntId] - myCenter).squareModulus();
+                if(aSquare > aRes.SquareDist) {
+                    aRes.SquareDist = aSquare;
+                    aRes.Index      = aPntId;
+                }
+            }
+            myResults[theChunk] = aRes;
+        }
+
+            private:
+
+        const StArray<StGLVec3>&      myPoints;
+        const StGLVec3                myCenter;
+        std::vector<StFarthestPoint>& myResults;
+
+    };
+
+    /**
+     * Find the farthest point from the center.
+     */
+    static StFarthestPoint findFarthest(const StArray<StGLVec3>&      thePoints,
+                                        const StGLVec3&               theCenter,
+                                        std::vector<StFarthestPoint>& theChunks) {
+        StTaskPool::GetDefault().parallelFor(0, theChunks.size(), StFarthestFunctor(thePoints, theCenter, theChunks),
+                                             StTaskPool::Priority_Interactive, 1);
+        StFarthestPoint aRes = theChunks[0];
+        for(size_t aChunkIter = 1; aChunkIter < theChunks.size(); ++aChunkIter) {
+            if(theChunks[aChunkIter].SquareDist > aRes.SquareDist) {
+                aRes = theChunks[aChunkIter];
+            }
+        }
+        return aRes;
+    }
+
+}
 
 StBndSphere::StBndSphere()
 : StBndContainer(),
@@ -24,7 +208,11 @@ StBndSphere::~StBndSphere() {
 }
 
 void StBndSphere::init(const StArray<StGLVec3>& thePoints) {
-    initWelzl(thePoints);
+    if(thePoints.size() >= THE_PARALLEL_MIN) {
+        initRitter(thePoints);
+    } else {
+        initWelzl(thePoints);
+    }
 }
 
 void StBndSphere::reset() {
@@ -67,6 +255,24 @@ void StBndSphere::enlarge(const StGLVec3& theNewPnt) {
 void StBndSphere::enlarge(const StArray<StGLVec3>& thePoints) {
     if(thePoints.size() == 0) {
         return;
+    } else if(thePoints.size() >= THE_PARALLEL_MIN) {
+        // parallel sphere includes all points, just merge it with current one
+        StBndSphere aSphere;
+        aSphere.initRitter(thePoints);
+        if(isVoid()) {
+            define(aSphere.myCenter, aSphere.myRadius);
+            return;
+        }
+
+        StRitterSphere aMerged;
+        aMerged.Center = myCenter;
+        aMerged.Radius = myRadius;
+        StRitterSphere aPart;
+        aPart.Center = aSphere.myCenter;
+        aPart.Radius = aSphere.myRadius;
+        aMerged.add(aPart);
+        define(aMerged.Center, aMerged.Radius);
+        return;
     } else if(isVoid()) {
         // find first approximation (initial sphere center and diameter)
         init(thePoints);
@@ -101,63 +307,11 @@ void StBndSphere::initFast(const StArray<StGLVec3>& thePoints) {
     }
 
     // find a large diameter to start with
-    // first get the bounding box and extreme points for it
-    StGLVec3 aMin = thePoints.getFirst();
-    StGLVec3 aMax = thePoints.getFirst();
-    size_t aPntMinX = 0;
-    size_t aPntMinY = 0;
-    size_t aPntMinZ = 0;
-    size_t aPntMaxX = 0;
-    size_t aPntMaxY = 0;
-    size_t aPntMaxZ = 0;
-    for(size_t aPntId = 0; aPntId < thePoints.size(); ++aPntId) {
-        const StGLVec3& aPnt = thePoints[aPntId];
-        if(aPnt.x() < aMin.x()) {
-            aMin.x() = aPnt.x();
-            aPntMinX = aPntId;
-        } else if(aPnt.x() > aMax.x()) {
-            aMax.x() = aPnt.x();
-            aPntMaxX = aPntId;
-        }
-        if(aPnt.y() < aMin.y()) {
-            aMin.y() = aPnt.y();
-            aPntMinY = aPntId;
-        } else if(aPnt.y() > aMax.y()) {
-            aMax.y() = aPnt.y();
-            aPntMaxY = aPntId;
-        }
-        if(aPnt.z() < aMin.z()) {
-            aMin.z() = aPnt.z();
-            aPntMinZ = aPntId;
-        } else if(aPnt.z() > aMax.z()) {
-            aMax.z() = aPnt.z();
-            aPntMaxZ = aPntId;
-        }
-    }
-
-    // select the largest extent as an initial diameter for the sphere
-    StGLVec3 dVX = thePoints[aPntMaxX] - thePoints[aPntMinX];
-    StGLVec3 dVY = thePoints[aPntMaxY] - thePoints[aPntMinY];
-    StGLVec3 dVZ = thePoints[aPntMaxZ] - thePoints[aPntMinZ];
-    GLfloat dXSquare = dVX.squareModulus();
-    GLfloat dYSquare = dVY.squareModulus();
-    GLfloat dZSquare = dVZ.squareModulus();
-    if(dXSquare >= dYSquare && dXSquare >= dZSquare) {
-        // center = midpoint of extremes
-        myCenter = thePoints[aPntMinX] + (dVX * 0.5f);
-        // radius squared
-        myRadius = (thePoints[aPntMaxX] - myCenter).modulus();
-    } else if(dYSquare >= dXSquare && dYSquare >= dZSquare) {
-        // center = midpoint of extremes
-        myCenter = thePoints[aPntMinY] + (dVY * 0.5f);
-        // radius squared
-        myRadius = (thePoints[aPntMaxY] - myCenter).modulus();
-    } else {
-        // center = midpoint of extremes
-        myCenter = thePoints[aPntMinZ] + (dVZ * 0.5f);
-        // radius squared
-        myRadius = (thePoints[aPntMaxZ] - myCenter).modulus();
-    }
+    // first get the bounding box and extreme points for it,
+    // then select the largest extent as an initial diameter for the sphere
+    const StRitterSphere aSphere = initialSphere(thePoints);
+    myCenter = aSphere.Center;
+    myRadius = aSphere.Radius;
     // now we should check that all points are in the sphere
 }
 
@@ -774,3 +928,49 @@ void StBndSphere::initWelzl(const StArray<StGLVec3>& thePoints) {
     /// TODO (Kirill Gavrilov#9) check the algorithm implementation for errors
     // now we should check that all points are in the sphere
 }
+
+void StBndSphere::initRitter(const StArray<StGLVec3>& thePoints) {
+    reset();
+    if(thePoints.size() == 0) {
+        return;
+    }
+
+    // grow the initial sphere by chunks of points in parallel and merge results in order
+    const size_t aNbChunks = (thePoints.size() + THE_CHUNK_POINTS - 1) / THE_CHUNK_POINTS;
+    const StRitterSphere anInitial = initialSphere(thePoints);
+    std::vector<StRitterSphere> aChunkSpheres(aNbChunks);
+    StTaskPool::GetDefault().parallelFor(0, aNbChunks, StRitterFunctor(thePoints, anInitial, aChunkSpheres),
+                                         StTaskPool::Priority_Interactive, 1);
+    StRitterSphere aSphere = aChunkSpheres[0];
+    for(size_t aChunkIter = 1; aChunkIter < aNbChunks; ++aChunkIter) {
+        aSphere.add(aChunkSpheres[aChunkIter]);
+    }
+
+    // merged sphere is larger than necessary - take the distance to the farthest point as radius
+    // and then shift the center toward the farthest point with decreasing step, keeping the best sphere;
+    // the radius can not be smaller than half of initial diameter
+    std::vector<StFarthestPoint> aChunkFarthest(aNbChunks);
+    StGLVec3 aCenter = aSphere.Center;
+    StFarthestPoint aFarthest = findFarthest(thePoints, aCenter, aChunkFarthest);
+    StGLVec3 aBestCenter = aCenter;
+    GLfloat  aBestSquare = aFarthest.SquareDist;
+    GLfloat  aStep = std::sqrt(aBestSquare) - anInitial.Radius;
+    for(int anIter = 0; anIter < THE_REFINE_ITERS && aStep > 0.0f; ++anIter) {
+        const StGLVec3 dV = thePoints[aFarthest.Index] - aCenter;
+        const GLfloat aDist = dV.modulus();
+        if(aDist <= aStep) {
+            break;
+        }
+        aStep *= 0.5f;
+        aCenter   = aCenter + dV * (aStep / aDist);
+        aFarthest = findFarthest(thePoints, aCenter, aChunkFarthest);
+        if(aFarthest.SquareDist < aBestSquare) {
+            aBestCenter = aCenter;
+            aBestSquare = aFarthest.SquareDist;
+        }
+    }
+
+    myCenter = aBestCenter;
+    myRadius = std::sqrt(aBestSquare);
+    StBndContainer::setDefined();
+}
@@ -18,12 +18,17 @@ StFTFont::StFTFont(StHandle<StFTLibrary> theFTLib)
   myLoadFlags(FT_LOAD_NO_HINTING | FT_LOAD_TARGET_NORMAL),
   myGlyphMaxWidth(1),
   myGlyphMaxHeight(1),
+  myPointSize(0),
+  myResolution(72),
   myUChar(0) {
     if(myFTLib.isNull()) {
         myFTLib = new StFTLibrary();
     }
     stMemZero(mySubsets, sizeof(mySubsets));
     stMemZero(myFTFaces, sizeof(myFTFaces));
+    stMemZero(myFontData,     sizeof(myFontData));
+    stMemZero(myFontDataLen,  sizeof(myFontDataLen));
+    stMemZero(myToSyntItalic, sizeof(myToSyntItalic));
 }
 
 StFTFont::~StFTFont() {
@@ -43,6 +48,9 @@ void StFTFont::release() {
             aFace = NULL;
         }
         myFontPaths[aStyleIt].clear();
+        myFontData[aStyleIt]     = NULL;
+        myFontDataLen[aStyleIt]  = 0;
+        myToSyntItalic[aStyleIt] = false;
     }
 }
 
@@ -71,6 +79,8 @@ bool StFTFont::init(const unsigned int thePointSize,
     myGlyphImg.nullify();
     myGlyphMaxWidth  = 1;
     myGlyphMaxHeight = 1;
+    myPointSize  = thePointSize;
+    myResolution = theResolution;
     if(myFTFaces[Style_Regular] == NULL) {
         return false;
     }
@@ -115,7 +125,10 @@ bool StFTFont::load(const StString& theFontPath,
     myUChar  = 0;
     myFTFace = NULL;
     myGlyphImg.nullify();
-    myFontPaths[theStyle] = theFontPath;
+    myFontPaths[theStyle]    = theFontPath;
+    myFontData[theStyle]     = NULL;
+    myFontDataLen[theStyle]  = 0;
+    myToSyntItalic[theStyle] = theToSyntItalic;
 
     FT_Face& aFace = myFTFaces[theStyle];
     if(aFace != NULL) {
@@ -160,7 +173,10 @@ bool StFTFont::loadInternal(const StString&       theFontName,
     myUChar  = 0;
     myFTFace = NULL;
     myGlyphImg.nullify();
-    myFontPaths[theStyle] = theFontName;
+    myFontPaths[theStyle]    = theFontName;
+    myFontData[theStyle]     = theFontData;
+    myFontDataLen[theStyle]  = theDataLen;
+    myToSyntItalic[theStyle] = false;
 
     FT_Face& aFace = myFTFaces[theStyle];
     if(aFace != NULL) {
@@ -176,6 +192,31 @@ bool StFTFont::loadInternal(const StString&       theFontName,
     return loadCharmap(theFontName, aFace);
 }
 
+bool StFTFont::loadCopy(const StFTFont& theFont) {
+    release();
+    bool isLoaded = false;
+    for(int aStyleIt = 0; aStyleIt < StylesNB; ++aStyleIt) {
+        if(theFont.myFTFaces[aStyleIt] == NULL) {
+            continue;
+        }
+
+        const StFTFont::Style aStyle = (StFTFont::Style )aStyleIt;
+        if(theFont.myFontData[aStyleIt] != NULL) {
+            isLoaded = loadInternal(theFont.myFontPaths[aStyleIt], theFont.myFontData[aStyleIt],
+                                    theFont.myFontDataLen[aStyleIt], aStyle) || isLoaded;
+        } else {
+            isLoaded = load(theFont.myFontPaths[aStyleIt], aStyle, theFont.myToSyntItalic[aStyleIt]) || isLoaded;
+        }
+    }
+    if(!isLoaded) {
+        return false;
+    }
+
+    myStyle = theFont.myStyle;
+    return theFont.myPointSize == 0
+        || init(theFont.myPointSize, theFont.myResolution);
+}
+
 bool StFTFont::loadCharmap(const StString& theFontName,
                            FT_Face&        theFace) {
     (void )theFontName;
@@ -0,0 +1,119 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StFT/StFTFontRasterizer.h>
+
+#include <StStrings/StLogger.h>
+
+SV_THREAD_FUNCTION StFTFontRasterizer::threadFunction(void* theRasterizer) {
+    StFTFontRasterizer* aRasterizer = (StFTFontRasterizer* )theRasterizer;
+    aRasterizer->mainLoop();
+    return SV_THREAD_RETURN 0;
+}
+
+StFTFontRasterizer::StFTFontRasterizer()
+: myEvent(false),
+  myGeneration(0),
+  myToQuit(false) {
+    myThread = new StThread(threadFunction, (void* )this, "StFTFontRaster");
+}
+
+StFTFontRasterizer::~StFTFontRasterizer() {
+    myToQuit = true;
+    myEvent.set();
+    myThread->wait();
+    myThread.nullify();
+}
+
+bool StFTFontRasterizer::setFont(const StFTFont& theFont) {
+    // the copy uses own FT library instance, so that it can be used by working thread
+    StHandle<StFTFont> aFontCopy = new StFTFont();
+    if(!aFontCopy->loadCopy(theFont)
+    || !aFontCopy->isValid()) {
+        ST_DEBUG_LOG("StFTFontRasterizer, unable to load copy of font '" + theFont.getFilePath(StFTFont::Style_Regular) + "'");
+        aFontCopy.nullify();
+    }
+
+    StMutexAuto aLock(myMutex);
+    myFont = aFontCopy;
+    ++myGeneration;
+    myRequests.clear();
+    myReady.clear();
+    for(size_t aStyleIt = 0; aStyleIt < StFTFont::StylesNB; ++aStyleIt) {
+        myRequested[aStyleIt].clear();
+    }
+    return !myFont.isNull();
+}
+
+void StFTFontRasterizer::request(const stUtf32_t       theUChar,
+                                 const StFTFont::Style theStyle) {
+    if(theUChar == 0
+    || theStyle >= StFTFont::StylesNB) {
+        return;
+    }
+
+    StMutexAuto aLock(myMutex);
+    if(myFont.isNull()
+    || myRequested[theStyle].find(theUChar) != StFTGlyphMap::INVALID_ID) {
+        return;
+    }
+
+    myRequested[theStyle].bind(theUChar, 1);
+    Request aRequest;
+    aRequest.UChar = theUChar;
+    aRequest.Style = theStyle;
+    myRequests.push_back(aRequest);
+    myEvent.set();
+}
+
+bool StFTFontRasterizer::takeGlyphs(std::vector< StHandle<StFTGlyphBitmap> >& theGlyphs) {
+    theGlyphs.clear();
+    StMutexAuto aLock(myMutex);
+    theGlyphs.swap(myReady);
+    return !theGlyphs.empty();
+}
+
+void StFTFontRasterizer::mainLoop() {
+    std::vector<Request> aRequests;
+    for(;;) {
+        myEvent.wait();
+        if(myToQuit) {
+            return;
+        }
+
+        myMutex.lock();
+        myEvent.reset();
+        aRequests.swap(myRequests);
+        StHandle<StFTFont> aFont       = myFont;
+        const size_t       aGeneration = myGeneration;
+        myMutex.unlock();
+
+        for(size_t aReqIter = 0; aReqIter < aRequests.size() && !aFont.isNull() && !myToQuit; ++aReqIter) {
+            const Request& aRequest = aRequests[aReqIter];
+            if(!aFont->setActiveStyle(aRequest.Style)
+            || !aFont->renderGlyph(aRequest.UChar)) {
+                continue;
+            }
+
+            StHandle<StFTGlyphBitmap> aGlyph = new StFTGlyphBitmap();
+            aGlyph->UChar = aRequest.UChar;
+            aGlyph->Style = aRequest.Style;
+            aFont->getGlyphRect(aGlyph->Rect);
+            if(!aGlyph->Image.initCopy(aFont->getGlyphImage(), true)) {
+                continue;
+            }
+
+            StMutexAuto aLock(myMutex);
+            if(aGeneration != myGeneration) {
+                break;
+            }
+            myReady.push_back(aGlyph);
+        }
+        aRequests.clear();
+    }
+}
@@ -9,6 +9,7 @@
 #include <StFT/StFTFontRegistry.h>
 
 #include <StFile/StFolder.h>
+#include <StFile/StRawFile.h>
 #include <StStrings/StLogger.h>
 #include <StThreads/StProcess.h>
 #include <stAssert.h>
@@ -20,6 +21,7 @@
 
 namespace {
     static const StFTFontFamily THE_NO_FAMILY;
+    static const char THE_INDEX_HEADER[] = "sView fonts index 1";
 }
 
 StFTFontRegistry::StFTFontRegistry() {
@@ -168,22 +170,27 @@ StFTFontRegistry::StFTFontRegistry() {
 }
 
 StFTFontRegistry::~StFTFontRegistry() {
-    //
+    if(!myIndexThread.isNull()) {
+        myIndexThread->wait();
+    }
 }
 
 void StFTFontRegistry::appendSearchPath(const StString& theFolder) {
     myFolders.add(theFolder);
 }
 
-void StFTFontRegistry::searchFiles(const StArrayList<StString>& theNames,
-                                   const bool                   theIsMajor) {
+void StFTFontRegistry::searchFiles(StFTLibrary&                 theFTLib,
+                                   const StFolder&              theRoot,
+                                   const StArrayList<StString>& theNames,
+                                   const bool                   theIsMajor,
+                                   Index&                       theIndex) {
     for(size_t aNameIter = 0; aNameIter < theNames.size(); ++aNameIter) {
         const StString& aName = theNames.getValue(aNameIter);
         StString aPath;
         if(StFileNode::isAbsolutePath(aName)) {
             aPath = aName;
         } else {
-            const StFileNode* aNode = myFoldersRoot.findValue(aName);
+            const StFileNode* aNode = theRoot.findValue(aName);
             if(aNode != NULL) {
                 aPath = aNode->getPath();
             }
@@ -196,7 +203,7 @@ void StFTFontRegistry::searchFiles(const StArrayList<StString>& theNames,
         }
 
         FT_Face aFace = NULL;
-        if(FT_New_Face(myFTLib->getInstance(), aPath.toCString(), 0, &aFace) != 0) {
+        if(FT_New_Face(theFTLib.getInstance(), aPath.toCString(), 0, &aFace) != 0) {
             if(theIsMajor) {
                 ST_ERROR_LOG("StFTFontRegistry, major font file '" + aName + "' fail to load"
                             + " from path '" + aPath + "'!");
@@ -207,34 +214,224 @@ void StFTFontRegistry::searchFiles(const StArrayList<StString>& theNames,
             continue;
         }
 
-        StFTFontFamily& aFamily = myFonts[aFace->family_name];
-        aFamily.FamilyName = aFace->family_name;
-        if(aFace->style_flags == (FT_STYLE_FLAG_ITALIC | FT_STYLE_FLAG_BOLD)) {
-            aFamily.BoldItalic = aPath;
-        } else if(aFace->style_flags == FT_STYLE_FLAG_BOLD) {
-            aFamily.Bold = aPath;
-        } else if(aFace->style_flags == FT_STYLE_FLAG_ITALIC) {
-            aFamily.Italic = aPath;
+        IndexFont aFont;
+        aFont.Name      = aName;
+        aFont.Path      = aPath;
+        aFont.Family    = aFace->family_name;
+        aFont.Style     = int(aFace->style_flags & (FT_STYLE_FLAG_ITALIC | FT_STYLE_FLAG_BOLD));
+        aFont.FaceIndex = 0;
+        theIndex.Fonts.push_back(aFont);
+        //ST_DEBUG_LOG("StFTFontRegistry, font file '" + aName + "', family '" + aFont.Family + "', contains " + aFace->num_glyphs + " glyphs!");
+
+        FT_Done_Face(aFace);
+    }
+}
+
+void StFTFontRegistry::collectFolders(const StFolder& theFolder,
+                                      Index&          theIndex) {
+    for(size_t anIter = 0; anIter < theFolder.size(); ++anIter) {
+        const StFileNode* aNode = theFolder.getValue(anIter);
+        if(!aNode->isFolder()) {
+            continue;
+        }
+
+        const StString aPath = aNode->getPath();
+        theIndex.Folders.push_back(std::make_pair(aPath, StString(StFileNode::getModificationTime(aPath))));
+        collectFolders(*(const StFolder* )aNode, theIndex);
+    }
+}
+
+void StFTFontRegistry::scanFolders(StFTLibrary& theFTLib,
+                                   Index&       theIndex) const {
+    theIndex.Config = getConfigHash();
+    theIndex.Folders.clear();
+    theIndex.Fonts.clear();
+
+    // empty folders are also recorded so that fonts added into them would invalidate the index
+    StFolder aFoldersRoot;
+    for(size_t aFolderIter = 0; aFolderIter < myFolders.size(); ++aFolderIter) {
+        StFolder* aSubFolder = new StFolder(myFolders.getValue(aFolderIter), &aFoldersRoot);
+        aSubFolder->init(myExtensions, 4, true);
+        aFoldersRoot.add(aSubFolder);
+    }
+    collectFolders(aFoldersRoot, theIndex);
+
+    searchFiles(theFTLib, aFoldersRoot, myFilesMajor, true,  theIndex);
+    searchFiles(theFTLib, aFoldersRoot, myFilesMinor, false, theIndex);
+}
+
+StString StFTFontRegistry::getConfigHash() const {
+    // 64-bit FNV-1a over folders and file names
+    stUInt64_t aHash = 14695981039346656037ULL;
+    const StArrayList<StString>* aLists[3] = { &myFolders, &myFilesMajor, &myFilesMinor };
+    for(size_t aListIter = 0; aListIter < 3; ++aListIter) {
+        const StArrayList<StString>& aList = *aLists[aListIter];
+        for(size_t anIter = 0; anIter < aList.size(); ++anIter) {
+            const StString& aName = aList.getValue(anIter);
+            const stUByte_t* aData = (const stUByte_t* )aName.toCString();
+            for(size_t aByteIter = 0; aByteIter <= aName.getSize(); ++aByteIter) {
+                aHash ^= aData[aByteIter]; // including NULL-terminator as separator
+                aHash *= 1099511628211ULL;
+            }
+        }
+    }
+    return StString(aHash);
+}
+
+bool StFTFontRegistry::loadIndex(Index& theIndex) const {
+    if(myIndexPath.isEmpty()
+    || !StFileNode::isFileExists(myIndexPath)) {
+        return false;
+    }
+
+    const StString aContent = StRawFile::readTextFile(myIndexPath);
+    StHandle< StArrayList<StString> > aLines = aContent.split('\n');
+    if(aLines.isNull()
+    || aLines->size() < 3
+    || aLines->getValue(0) != THE_INDEX_HEADER) {
+        return false;
+    }
+
+    bool isComplete = false;
+    for(size_t aLineIter = 1; aLineIter < aLines->size(); ++aLineIter) {
+        const StString& aLine = aLines->getValue(aLineIter);
+        if(aLine == stCString("end")) {
+            isComplete = true;
+            break;
+        }
+
+        StHandle< StArrayList<StString> > aFields = aLine.split('\t');
+        if(aFields->size() == 2
+        && aFields->getValue(0) == stCString("config")) {
+            theIndex.Config = aFields->getValue(1);
+        } else if(aFields->size() == 3
+               && aFields->getValue(0) == stCString("folder")) {
+            theIndex.Folders.push_back(std::make_pair(aFields->getValue(2), aFields->getValue(1)));
+        } else if(aFields->size() == 6
+               && aFields->getValue(0) == stCString("font")) {
+            IndexFont aFont;
+            aFont.Style     = ::atoi(aFields->getValue(1).toCString());
+            aFont.FaceIndex = ::atoi(aFields->getValue(2).toCString());
+            aFont.Name      = aFields->getValue(3);
+            aFont.Family    = aFields->getValue(4);
+            aFont.Path      = aFields->getValue(5);
+            theIndex.Fonts.push_back(aFont);
         } else {
-            aFamily.Regular = aPath;
+            return false;
         }
-        //ST_DEBUG_LOG("StFTFontRegistry, font file '" + aName + "', family '" + aFamily.FamilyName + "', contains " + aFace->num_glyphs + " glyphs!");
+    }
+    return isComplete;
+}
 
-        FT_Done_Face(aFace);
+bool StFTFontRegistry::saveIndex(const Index& theIndex) const {
+    if(myIndexPath.isEmpty()) {
+        return false;
+    }
+
+    StString aContent = StString(THE_INDEX_HEADER) + "\n";
+    aContent += StString("config\t") + theIndex.Config + "\n";
+    for(size_t anIter = 0; anIter < theIndex.Folders.size(); ++anIter) {
+        aContent += StString("folder\t") + theIndex.Folders[anIter].second + "\t" + theIndex.Folders[anIter].first + "\n";
+    }
+    for(size_t anIter = 0; anIter < theIndex.Fonts.size(); ++anIter) {
+        const IndexFont& aFont = theIndex.Fonts[anIter];
+        aContent += StString("font\t") + aFont.Style + "\t" + aFont.FaceIndex
+                  + "\t" + aFont.Name + "\t" + aFont.Family + "\t" + aFont.Path + "\n";
+    }
+    aContent += "end\n";
+
+    StRawFile aFile(myIndexPath);
+    if(!aFile.openFile(StRawFile::WRITE)) {
+        ST_DEBUG_LOG("StFTFontRegistry, unable to write fonts index '" + myIndexPath + "'");
+        return false;
+    }
+    const bool isWritten = aFile.write(aContent) == aContent.getSize();
+    aFile.closeFile();
+    return isWritten;
+}
+
+bool StFTFontRegistry::isUpToDate(const Index& theIndex) const {
+    if(theIndex.Config != getConfigHash()) {
+        return false;
+    }
+
+    for(size_t anIter = 0; anIter < myFolders.size(); ++anIter) {
+        const StString& aFolder = myFolders.getValue(anIter);
+        if(StFolder::isFolder(aFolder)) {
+            bool isIndexed = false;
+            for(size_t aFolderIter = 0; aFolderIter < theIndex.Folders.size() && !isIndexed; ++aFolderIter) {
+                isIndexed = theIndex.Folders[aFolderIter].first == aFolder;
+            }
+            if(!isIndexed) {
+                return false;
+            }
+        }
+    }
+
+    for(size_t anIter = 0; anIter < theIndex.Folders.size(); ++anIter) {
+        const std::pair<StString, StString>& aFolder = theIndex.Folders[anIter];
+        if(StString(StFileNode::getModificationTime(aFolder.first)) != aFolder.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void StFTFontRegistry::registerFonts(const Index& theIndex) {
+    for(size_t anIter = 0; anIter < theIndex.Fonts.size(); ++anIter) {
+        const IndexFont& aFont = theIndex.Fonts[anIter];
+        StFTFontFamily& aFamily = myFonts[aFont.Family];
+        aFamily.FamilyName = aFont.Family;
+        if(aFont.Style == (FT_STYLE_FLAG_ITALIC | FT_STYLE_FLAG_BOLD)) {
+            aFamily.BoldItalic = aFont.Path;
+        } else if(aFont.Style == FT_STYLE_FLAG_BOLD) {
+            aFamily.Bold = aFont.Path;
+        } else if(aFont.Style == FT_STYLE_FLAG_ITALIC) {
+            aFamily.Italic = aFont.Path;
+        } else {
+            aFamily.Regular = aFont.Path;
+        }
     }
 }
 
+SV_THREAD_FUNCTION StFTFontRegistry::rebuildIndexThread(void* theRegistry) {
+    const StFTFontRegistry* aRegistry = (const StFTFontRegistry* )theRegistry;
+    StFTLibrary anFTLib;
+    Index anIndex;
+    aRegistry->scanFolders(anFTLib, anIndex);
+    aRegistry->saveIndex(anIndex);
+    ST_DEBUG_LOG("StFTFontRegistry, fonts index has been rebuilt (" + anIndex.Fonts.size() + " files)");
+    return SV_THREAD_RETURN 0;
+}
+
 void StFTFontRegistry::init(const bool theToSearchAll) {
-    myFoldersRoot.clear();
+    if(!myIndexThread.isNull()) {
+        myIndexThread->wait();
+        myIndexThread.nullify();
+    }
     myFonts.clear();
-    for(size_t aFolderIter = 0; aFolderIter < myFolders.size(); ++aFolderIter) {
-        StFolder* aSubFolder = new StFolder(myFolders.getValue(aFolderIter), &myFoldersRoot);
-        aSubFolder->init(myExtensions, 4);
-        myFoldersRoot.add(aSubFolder);
+
+    Index anIndex;
+    bool isLoaded = loadIndex(anIndex);
+    bool isActual = isLoaded && isUpToDate(anIndex);
+    if(isLoaded && !isActual) {
+        // outdated index can be still used while all listed files exist
+        for(size_t anIter = 0; anIter < anIndex.Fonts.size(); ++anIter) {
+            if(!StFileNode::isFileExists(anIndex.Fonts[anIter].Path)) {
+                isLoaded = false;
+                break;
+            }
+        }
     }
 
-    searchFiles(myFilesMajor, true);
-    searchFiles(myFilesMinor, false);
+    if(!isLoaded) {
+        anIndex = Index();
+        scanFolders(*myFTLib, anIndex);
+        saveIndex(anIndex);
+    } else if(!isActual) {
+        myIndexThread = new StThread(rebuildIndexThread, (void* )this, "StFTFontRegistry");
+    }
+    registerFonts(anIndex);
 
     if(theToSearchAll) {
         //
@@ -81,6 +81,21 @@ bool StFileNode::isFileExists(const StCString& thePath) {
 #endif
 }
 
+int64_t StFileNode::getModificationTime(const StCString& thePath) {
+#ifdef _WIN32
+    StStringUtfWide aPath;
+    aPath.fromUnicode(thePath);
+    struct __stat64 aStatBuffer;
+    return _wstat64(aPath.toCString(), &aStatBuffer) == 0 ? int64_t(aStatBuffer.st_mtime) : -1;
+#elif (defined(__APPLE__))
+    struct stat aStatBuffer;
+    return stat(thePath.toCString(), &aStatBuffer) == 0 ? int64_t(aStatBuffer.st_mtime) : -1;
+#else
+    struct stat64 aStatBuffer;
+    return stat64(thePath.toCString(), &aStatBuffer) == 0 ? int64_t(aStatBuffer.st_mtime) : -1;
+#endif
+}
+
 bool StFileNode::isFileReadOnly(const StCString& thePath) {
 #ifdef _WIN32
     StStringUtfWide aPath;
@@ -29,6 +29,15 @@ void StGLFont::release(StGLContext& theCtx) {
     }
 }
 
+void StGLFont::getGenerations(uint32_t theGenerations[StFTFont::SubsetsNB]) const {
+    // generations are taken from global monotonic counter, so that they change on any entry release
+    // and can not match to another (even reallocated at the same address) font entry
+    for(size_t anIter = 0; anIter < StFTFont::SubsetsNB; ++anIter) {
+        const StHandle<StGLFontEntry>& aFont = myFonts[anIter];
+        theGenerations[anIter] = !aFont.isNull() ? aFont->getGeneration() : 0;
+    }
+}
+
 bool StGLFont::stglInit(StGLContext&       theCtx,
                         const unsigned int thePointSize,
                         const unsigned int theResolution) {
@@ -88,3 +97,42 @@ void StGLFont::renderGlyph(StGLContext&    theCtx,
     }
     myFonts[0]->renderGlyph(theCtx, true, theUChar, theUCharNext, theGlyph, thePen);
 }
+
+void StGLFont::prefetchText(const StString&       theText,
+                            const StFTFont::Style theStyle) {
+    for(StUtf8Iter anIter = theText.iterator(); *anIter != 0; ++anIter) {
+        const stUtf32_t aUChar = *anIter;
+        if(aUChar == ' '
+        || aUChar == '\x0A'
+        || aUChar == '\x0D') {
+            continue;
+        }
+
+        const StFTFont::Subset aSubset = StFTFont::subset(aUChar);
+        StHandle<StGLFontEntry>& aFont = myFonts[aSubset];
+        if(!aFont.isNull()
+        && aFont->hasSymbol(aUChar)) {
+            aFont->prefetchGlyph(aUChar, theStyle);
+        } else if(!myFonts[0].isNull()) {
+            myFonts[0]->prefetchGlyph(aUChar, theStyle);
+        }
+    }
+}
+
+void StGLFont::stglUploadPrefetched(StGLContext& theCtx) {
+    for(size_t anIter = 0; anIter < StFTFont::SubsetsNB; ++anIter) {
+        StHandle<StGLFontEntry>& aFont = myFonts[anIter];
+        if(!aFont.isNull()) {
+            aFont->stglUploadPrefetched(theCtx);
+        }
+    }
+}
+
+void StGLFont::stglFlush(StGLContext& theCtx) {
+    for(size_t anIter = 0; anIter < StFTFont::SubsetsNB; ++anIter) {
+        StHandle<StGLFontEntry>& aFont = myFonts[anIter];
+        if(!aFont.isNull()) {
+            aFont->stglFlush(theCtx);
+        }
+    }
+}
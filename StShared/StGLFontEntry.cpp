@@ -13,8 +13,16 @@
 #include <StGL/StGLFrameBuffer.h>
 
 #include <StStrings/StLogger.h>
+#include <StThreads/StAtomicOp.h>
 #include <stAssert.h>
 
+#include <cmath>
+
+namespace {
+    static const int THE_GLYPH_PADDING = 2; //!< gap between glyphs within the texture
+    static volatile uint32_t THE_GENERATION_COUNTER = 0;
+}
+
 StGLFontEntry::StGLFontEntry(const StHandle<StFTFont>& theFont)
 : myFont(theFont),
   myAscender(0.0f),
@@ -22,8 +30,8 @@ StGLFontEntry::StGLFontEntry(const StHandle<StFTFont>& theFont)
   myTileSizeX(0),
   myTileSizeY(0),
   myLastTileId(size_t(-1)),
+  myGeneration(StAtomicOp::Increment(THE_GENERATION_COUNTER)),
   myGlyphMap(NULL) {
-    stMemZero(&myLastTilePx, sizeof(myLastTilePx));
     if(!myFont.isNull()) {
         myFont->setActiveStyle(StFTFont::Style_Regular);
     }
@@ -45,14 +53,21 @@ void StGLFontEntry::release(StGLContext& theCtx) {
         aTexture->release(theCtx);
         aTexture.nullify();
     }
+    if(!myTextures.isEmpty()) {
+        ST_DEBUG_LOG("StGLFontEntry, " + myStats.NbGlyphs + " glyphs in " + myStats.NbTextures + " textures"
+                   + " (" + int(myStats.getOccupancy() * 100.0f) + "% occupied), "
+                   + myStats.NbUploads + " uploads of " + (myStats.UploadedBytes / 1024) + " KiB");
+    }
     myTextures.clear();
     myFbos.clear();
+    myAtlases.clear();
+    myStats = Statistics();
+    myGeneration = StAtomicOp::Increment(THE_GENERATION_COUNTER);
 
     myAscender    = 0.0f;
     myLineSpacing = 0.0f;
     myTileSizeX   = 0;
     myTileSizeY   = 0;
-    stMemZero(&myLastTilePx, sizeof(myLastTilePx));
     myTiles.clear();
     for(size_t aStyleIt = 0; aStyleIt < StFTFont::StylesNB; ++aStyleIt) {
         myGlyphMaps[aStyleIt].clear();
@@ -85,6 +100,9 @@ bool StGLFontEntry::stglInit(StGLContext& theCtx,
     myTileSizeY   = myFont->getGlyphMaxSizeY();
 
     myLastTileId = size_t(-1);
+    if(!myRasterizer.isNull()) {
+        myRasterizer->setFont(*myFont);
+    }
     return !theToCreateTexture
          || createTexture(theCtx);
 }
@@ -106,15 +124,19 @@ bool StGLFontEntry::createTexture(StGLContext& theCtx) {
         aGlyphsNb = stMin(1000, 4 * myFont->getGlyphsNumber() - GLint(myLastTileId) + 1);
     }
 
-    const GLsizei aTextureSizeX = getPowerOfTwo(aGlyphsNb * myTileSizeX, aMaxSize);
-    const size_t  aTilesPerRow  = aTextureSizeX / myTileSizeX;
-    GLsizei aTextureSizeY = stMin(getEvenNumber(GLint((aGlyphsNb / aTilesPerRow) + 1) * myTileSizeY), aMaxSize);
+    // glyphs are packed densely, so that square-like texture can be used
+    const double  anArea        = double(aGlyphsNb) * double(myTileSizeX + THE_GLYPH_PADDING) * double(myTileSizeY + THE_GLYPH_PADDING);
+    const GLsizei aTextureSizeX = getPowerOfTwo(stMax(GLsizei(std::sqrt(anArea)), GLsizei(myTileSizeX + THE_GLYPH_PADDING)), aMaxSize);
+    GLsizei aTextureSizeY = stMin(getEvenNumber(GLint(anArea / double(aTextureSizeX)) + myTileSizeY + THE_GLYPH_PADDING), aMaxSize);
     if(!theCtx.arbNPTW) {
         aTextureSizeY = getPowerOfTwo(aTextureSizeY, aMaxSize);
     }
 
-    stMemZero(&myLastTilePx, sizeof(myLastTilePx));
-    myLastTilePx.bottom() = myTileSizeY;
+    StHandle<Atlas> anAtlas = new Atlas();
+    if(!anAtlas->init(aTextureSizeX, aTextureSizeY)) {
+        ST_ERROR_LOG("StGLFontEntry, unable to allocate " + aTextureSizeX + "x" + aTextureSizeY + " glyphs buffer!");
+        return false;
+    }
 
     myTextures.add(new StGLTexture(theCtx.arbTexRG ? GL_R8 : GL_ALPHA));
     myFbos.add(new StGLFrameBuffer());
@@ -123,6 +145,9 @@ bool StGLFontEntry::createTexture(StGLContext& theCtx) {
     if(!aTexture->initTrash(theCtx, aTextureSizeX, aTextureSizeY)) {
         return false;
     }
+    myAtlases.push_back(anAtlas);
+    ++myStats.NbTextures;
+    myStats.AreaTotal += size_t(aTextureSizeX) * size_t(aTextureSizeY);
     aTexture->bind(theCtx);
     theCtx.core11fwd->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     theCtx.core11fwd->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -165,83 +190,272 @@ bool StGLFontEntry::renderGlyph(StGLContext&    theCtx,
         }
     }
 
+    StGLRect aRect;
+    myFont->getGlyphRect(aRect);
+    return addTile(theCtx, myFont->getGlyphImage(), aRect);
+}
+
+bool StGLFontEntry::addTile(StGLContext&         theCtx,
+                            const StImagePlane&  theImage,
+                            const StRect<float>& theRect) {
     if(myTextures.isEmpty()
     && !createTexture(theCtx)) {
         return false;
     }
 
-    StHandle<StGLTexture>& aTexture = myTextures[myTextures.size() - 1];
-
-    const StImagePlane& anImg = myFont->getGlyphImage();
-    const size_t aTileId = myLastTileId + 1;
-    myLastTilePx.left()  = myLastTilePx.right() + 3;
-    myLastTilePx.right() = myLastTilePx.left() + (int )anImg.getSizeX();
-    if(myLastTilePx.right() >= aTexture->getSizeX()) {
-        myLastTilePx.left()    = 0;
-        myLastTilePx.right()   = (int )anImg.getSizeX();
-        myLastTilePx.top()    += myTileSizeY;
-        myLastTilePx.bottom() += myTileSizeY;
-
-        if(myLastTilePx.bottom() >= aTexture->getSizeY()) {
-            if(!createTexture(theCtx)) {
-                return false;
-            }
-            return renderGlyph(theCtx, theChar, theToForce);
+    const int aSizeX = (int )theImage.getSizeX();
+    const int aSizeY = (int )theImage.getSizeY();
+    StVec2<int> aPos;
+    if(!myAtlases.back()->pack(aSizeX + THE_GLYPH_PADDING, aSizeY + THE_GLYPH_PADDING, aPos)) {
+        if(!createTexture(theCtx)
+        || !myAtlases.back()->pack(aSizeX + THE_GLYPH_PADDING, aSizeY + THE_GLYPH_PADDING, aPos)) {
+            return false;
         }
     }
 
-    /// TODO
-    aTexture->bind(theCtx);
-#if !defined(GL_ES_VERSION_2_0)
-    theCtx.core11fwd->glPixelStorei(GL_UNPACK_LSB_FIRST,  GL_FALSE);
-    theCtx.core11fwd->glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-#endif
-    theCtx.core11fwd->glPixelStorei(GL_UNPACK_ALIGNMENT,  1);
-
-    theCtx.core11fwd->glTexSubImage2D(GL_TEXTURE_2D, 0,
-                                      myLastTilePx.left(), myLastTilePx.top(), (GLsizei )anImg.getSizeX(), (GLsizei )anImg.getSizeY(),
-                                      theCtx.arbTexRG ? GL_RED : GL_ALPHA,
-                                      GL_UNSIGNED_BYTE, anImg.getData());
+    Atlas& anAtlas = *myAtlases.back();
+    anAtlas.put(theImage, aPos);
 
+    const StHandle<StGLTexture>& aTexture = myTextures[myTextures.size() - 1];
     StGLTile aTile;
-    aTile.uv.left()   = GLfloat(myLastTilePx.left())                   / GLfloat(aTexture->getSizeX());
-    aTile.uv.right()  = GLfloat(myLastTilePx.right())                  / GLfloat(aTexture->getSizeX());
-    aTile.uv.top()    = GLfloat(myLastTilePx.top())                    / GLfloat(aTexture->getSizeY());
-    aTile.uv.bottom() = GLfloat(myLastTilePx.top() + anImg.getSizeY()) / GLfloat(aTexture->getSizeY());
+    aTile.uv.left()   = GLfloat(aPos.x())          / GLfloat(aTexture->getSizeX());
+    aTile.uv.right()  = GLfloat(aPos.x() + aSizeX) / GLfloat(aTexture->getSizeX());
+    aTile.uv.top()    = GLfloat(aPos.y())          / GLfloat(aTexture->getSizeY());
+    aTile.uv.bottom() = GLfloat(aPos.y() + aSizeY) / GLfloat(aTexture->getSizeY());
     aTile.texture     = aTexture->getTextureId();
-    myFont->getGlyphRect(aTile.px);
+    aTile.px          = theRect;
 
-    myLastTileId = aTileId;
+    ++myLastTileId;
     myTiles.add(aTile);
+    ++myStats.NbGlyphs;
+    myStats.AreaUsed += size_t(aSizeX) * size_t(aSizeY);
     return true;
 }
 
+void StGLFontEntry::stglFlush(StGLContext& theCtx) {
+    for(size_t anAtlasIter = 0; anAtlasIter < myAtlases.size(); ++anAtlasIter) {
+        Atlas& anAtlas = *myAtlases[anAtlasIter];
+        if(!anAtlas.IsDirty) {
+            continue;
+        }
+
+        StRect<int> aRect = anAtlas.Dirty;
+        const bool hasUnpack = theCtx.getDeviceCaps().hasUnpack;
+        if(!hasUnpack) {
+            // upload complete rows to keep data contiguous
+            aRect.left()  = 0;
+            aRect.right() = (int )anAtlas.Image.getSizeX();
+        }
+
+        StHandle<StGLTexture>& aTexture = myTextures[anAtlasIter];
+        aTexture->bind(theCtx);
+        if(hasUnpack) {
+            theCtx.core11fwd->glPixelStorei(GL_UNPACK_ROW_LENGTH, GLint(anAtlas.Image.getSizeX()));
+        }
+        theCtx.core11fwd->glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        theCtx.core11fwd->glTexSubImage2D(GL_TEXTURE_2D, 0,
+                                          aRect.left(), aRect.top(), aRect.width(), aRect.height(),
+                                          theCtx.arbTexRG ? GL_RED : GL_ALPHA,
+                                          GL_UNSIGNED_BYTE, anAtlas.Image.getData(aRect.top(), aRect.left()));
+        if(hasUnpack) {
+            theCtx.core11fwd->glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        }
+        aTexture->unbind(theCtx);
+
+        anAtlas.IsDirty = false;
+        ++myStats.NbUploads;
+        myStats.UploadedBytes += size_t(aRect.width()) * size_t(aRect.height());
+    }
+}
+
+bool StGLFontEntry::Atlas::init(const int theSizeX,
+                                const int theSizeY) {
+    IsDirty = false;
+    Skyline.clear();
+    if(!Image.initZero(StImagePlane::ImgGray, size_t(theSizeX), size_t(theSizeY))) {
+        return false;
+    }
+
+    SkylineNode aNode;
+    aNode.X     = 0;
+    aNode.Y     = 0;
+    aNode.Width = theSizeX;
+    Skyline.push_back(aNode);
+    return true;
+}
+
+int StGLFontEntry::Atlas::fit(const size_t theNode,
+                              const int    theSizeX,
+                              const int    theSizeY) const {
+    const int aLeft = Skyline[theNode].X;
+    if(aLeft + theSizeX > (int )Image.getSizeX()) {
+        return -1;
+    }
+
+    // the rectangle should lay on top of all segments it covers
+    int aTop = 0;
+    int aWidthLeft = theSizeX;
+    for(size_t aNodeIter = theNode; aWidthLeft > 0 && aNodeIter < Skyline.size(); ++aNodeIter) {
+        aTop        = stMax(aTop, Skyline[aNodeIter].Y);
+        aWidthLeft -= Skyline[aNodeIter].Width;
+    }
+    if(aTop + theSizeY > (int )Image.getSizeY()) {
+        return -1;
+    }
+    return aTop;
+}
+
+bool StGLFontEntry::Atlas::pack(const int    theSizeX,
+                                const int    theSizeY,
+                                StVec2<int>& thePos) {
+    size_t aBestNode   = size_t(-1);
+    int    aBestBottom = 0;
+    int    aBestWidth  = 0;
+    for(size_t aNodeIter = 0; aNodeIter < Skyline.size(); ++aNodeIter) {
+        const int aTop = fit(aNodeIter, theSizeX, theSizeY);
+        if(aTop < 0) {
+            continue;
+        }
+
+        const int aBottom = aTop + theSizeY;
+        if(aBestNode == size_t(-1)
+        || aBottom <  aBestBottom
+        || (aBottom == aBestBottom && Skyline[aNodeIter].Width < aBestWidth)) {
+            aBestNode   = aNodeIter;
+            aBestBottom = aBottom;
+            aBestWidth  = Skyline[aNodeIter].Width;
+        }
+    }
+    if(aBestNode == size_t(-1)) {
+        return false;
+    }
+
+    thePos.x() = Skyline[aBestNode].X;
+    thePos.y() = aBestBottom - theSizeY;
+
+    // insert new segment and shrink the segments it overlaps
+    SkylineNode aNewNode;
+    aNewNode.X     = thePos.x();
+    aNewNode.Y     = aBestBottom;
+    aNewNode.Width = theSizeX;
+    Skyline.insert(Skyline.begin() + aBestNode, aNewNode);
+    for(size_t aNodeIter = aBestNode + 1; aNodeIter < Skyline.size();) {
+        SkylineNode& aNode = Skyline[aNodeIter];
+        const int aNewRight = aNewNode.X + aNewNode.Width;
+        if(aNode.X >= aNewRight) {
+            break;
+        }
+
+        const int aShrink = aNewRight - aNode.X;
+        if(aNode.Width <= aShrink) {
+            Skyline.erase(Skyline.begin() + aNodeIter);
+            continue;
+        }
+        aNode.X     += aShrink;
+        aNode.Width -= aShrink;
+        break;
+    }
+
+    // merge neighbors at the same level
+    for(size_t aNodeIter = 0; aNodeIter + 1 < Skyline.size();) {
+        if(Skyline[aNodeIter].Y == Skyline[aNodeIter + 1].Y) {
+            Skyline[aNodeIter].Width += Skyline[aNodeIter + 1].Width;
+            Skyline.erase(Skyline.begin() + aNodeIter + 1);
+        } else {
+            ++aNodeIter;
+        }
+    }
+    return true;
+}
+
+void StGLFontEntry::Atlas::put(const StImagePlane& theImage,
+                               const StVec2<int>&  thePos) {
+    const size_t aSizeX = theImage.getSizeX();
+    const size_t aSizeY = theImage.getSizeY();
+    if(aSizeX == 0 || aSizeY == 0) {
+        return;
+    }
+
+    for(size_t aRow = 0; aRow < aSizeY; ++aRow) {
+        stMemCpy(Image.changeData(size_t(thePos.y()) + aRow, size_t(thePos.x())), theImage.getData(aRow, 0), aSizeX);
+    }
+
+    const StRect<int> aRect(thePos.y(), thePos.y() + int(aSizeY),
+                            thePos.x(), thePos.x() + int(aSizeX));
+    if(!IsDirty) {
+        Dirty   = aRect;
+        IsDirty = true;
+        return;
+    }
+    Dirty.left()   = stMin(Dirty.left(),   aRect.left());
+    Dirty.right()  = stMax(Dirty.right(),  aRect.right());
+    Dirty.top()    = stMin(Dirty.top(),    aRect.top());
+    Dirty.bottom() = stMax(Dirty.bottom(), aRect.bottom());
+}
+
+void StGLFontEntry::prefetchGlyph(const stUtf32_t       theUChar,
+                                  const StFTFont::Style theStyle) {
+    if(myFont.isNull()
+    || !myFont->isValid()
+    || theStyle >= StFTFont::StylesNB
+    || myGlyphMaps[theStyle].find(theUChar) != StFTGlyphMap::INVALID_ID) {
+        return;
+    }
+
+    if(myRasterizer.isNull()) {
+        myRasterizer = new StFTFontRasterizer();
+        myRasterizer->setFont(*myFont);
+    }
+    myRasterizer->request(theUChar, theStyle);
+}
+
+void StGLFontEntry::stglUploadPrefetched(StGLContext& theCtx) {
+    if(myRasterizer.isNull()
+    || !myRasterizer->takeGlyphs(myPrefetched)) {
+        return;
+    }
+
+    for(size_t aGlyphIter = 0; aGlyphIter < myPrefetched.size(); ++aGlyphIter) {
+        const StHandle<StFTGlyphBitmap>& aGlyph = myPrefetched[aGlyphIter];
+        StFTGlyphMap& aGlyphMap = myGlyphMaps[aGlyph->Style];
+        if(aGlyphMap.find(aGlyph->UChar) == StFTGlyphMap::INVALID_ID
+        && addTile(theCtx, aGlyph->Image, aGlyph->Rect)) {
+            aGlyphMap.bind(aGlyph->UChar, myLastTileId);
+        }
+    }
+    myPrefetched.clear();
+}
+
 bool StGLFontEntry::renderGlyph(StGLContext&    theCtx,
                                 const bool      theToDrawUndef,
                                 const stUtf32_t theUChar,
                                 const stUtf32_t theUCharNext,
                                 StGLTile&       theGlyph,
                                 StGLVec2&       thePen) {
-    std::map<stUtf32_t, size_t>::const_iterator aTileIter = myGlyphMap->find(theUChar);
-    size_t aTileId;
-    if(aTileIter != myGlyphMap->end()) {
-        aTileId = aTileIter->second;
+    size_t aTileId = myGlyphMap->find(theUChar);
+    if(aTileId == StFTGlyphMap::INVALID_ID
+    && !myRasterizer.isNull()) {
+        // the glyph might be already rendered by working thread
+        stglUploadPrefetched(theCtx);
+        aTileId = myGlyphMap->find(theUChar);
+    }
+
+    if(aTileId != StFTGlyphMap::INVALID_ID) {
+        // already in texture
     } else if(renderGlyph(theCtx, theUChar, false)) {
         aTileId = myLastTileId;
-        (*myGlyphMap)[theUChar] = aTileId;
+        myGlyphMap->bind(theUChar, aTileId);
     } else if(!theToDrawUndef) {
         return false;
+    } else if((aTileId = myGlyphMap->find(0)) != StFTGlyphMap::INVALID_ID) {
+        myGlyphMap->bind(theUChar, aTileId);
+    } else if(renderGlyph(theCtx, theUChar, true)) {
+        aTileId = myLastTileId;
+        myGlyphMap->bind(0,        aTileId);
+        myGlyphMap->bind(theUChar, aTileId);
     } else {
-        aTileIter = myGlyphMap->find(0);
-        if(aTileIter != myGlyphMap->end()) {
-            aTileId = aTileIter->second;
-        } else if(renderGlyph(theCtx, theUChar, true)) {
-            aTileId = myLastTileId;
-            (*myGlyphMap)[theUChar] = aTileId;
-        } else {
-            thePen.x() += myFont->getAdvanceX(theUChar, theUCharNext);
-            return false;
-        }
+        thePen.x() += myFont->getAdvanceX(theUChar, theUCharNext);
+        return false;
     }
 
     const StGLTile& aTile = myTiles[aTileId];
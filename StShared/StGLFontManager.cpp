@@ -18,10 +18,14 @@ namespace {
 
 }
 
-StGLFontManager::StGLFontManager(const unsigned int theResolution)
+StGLFontManager::StGLFontManager(const unsigned int theResolution,
+                                 const StString&    theCacheFolder)
 : myFTLib(new StFTLibrary()),
   myResolution(theResolution) {
     myRegistry = new StFTFontRegistry();
+    if(!theCacheFolder.isEmpty()) {
+        myRegistry->setIndexFile(theCacheFolder + "fonts.idx");
+    }
     myRegistry->init(false);
 }
 
@@ -38,6 +42,12 @@ void StGLFontManager::release(StGLContext& theCtx) {
     }
     myFonts.clear();
     myFontTypes.clear();
+
+    if(myLayoutCache.getNbHits() + myLayoutCache.getNbMisses() != 0) {
+        ST_DEBUG_LOG("StGLFontManager, text layouts cache hit rate " + int(myLayoutCache.getHitRate() * 100.0f) + "% ("
+                   + myLayoutCache.getNbHits() + " hits, " + myLayoutCache.getNbMisses() + " misses)");
+    }
+    myLayoutCache.clear();
 }
 
 void StGLFontManager::setResolution(const unsigned int theResolution) {
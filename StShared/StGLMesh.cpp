@@ -11,8 +11,163 @@
 #include <StGLCore/StGLCore20.h>
 #include <StGL/StGLContext.h>
 
+#include <StThreads/StTaskPool.h>
+
 #include <stAssert.h>
 
+#include <vector>
+
+namespace {
+
+    /**
+     * Minimal number of triangles to compute normals in parallel.
+     */
+    static const size_t THE_NORMALS_PARALLEL_MIN = 64 * 1024;
+
+    /**
+     * Triangles of the mesh for normals computation.
+     */
+    struct StNormalsTriangles {
+        const StGLVec3* Vertices; //!< vertices array
+        const GLuint*   Indices;  //!< indices array or NULL for not indexed mesh
+        size_t          Delta;    //!< delta between triangles start node
+
+        /**
+         * @return vertex index of the triangle node
+         */
+        size_t getNode(const size_t theTriangle,
+                       const size_t theNode) const {
+            const size_t anId = theTriangle * Delta + theNode;
+            return Indices != NULL ? size_t(Indices[anId]) : anId;
+        }
+
+        /**
+         * Accumulate not normalized triangle normals into nodes.
+         * @param theFrom    first triangle
+         * @param theTo      triangle after the last one
+         * @param theNormals normals of nodes starting from theOffset
+         * @param theOffset  first node index within theNormals
+         */
+        void accumulate(const size_t theFrom,
+                        const size_t theTo,
+                        StGLVec3*    theNormals,
+                        const size_t theOffset) const {
+            for(size_t aTriIter = theFrom; aTriIter < theTo; ++aTriIter) {
+                const size_t aV1 = getNode(aTriIter, 0);
+                const size_t aV2 = getNode(aTriIter, 1);
+                const size_t aV3 = getNode(aTriIter, 2);
+                const StGLVec3& aVert1 = Vertices[aV1];
+                const StGLVec3& aVert2 = Vertices[aV2];
+                const StGLVec3& aVert3 = Vertices[aV3];
+                const StGLVec3 aNorm = StGLVec3::cross(aVert2 - aVert1, aVert3 - aVert1);
+                theNormals[aV1 - theOffset] += aNorm;
+                theNormals[aV2 - theOffset] += aNorm;
+                theNormals[aV3 - theOffset] += aNorm;
+            }
+        }
+    };
+
+    /**
+     * Partial sums of normals computed from the range of triangles.
+     */
+    struct StNormalsChunk {
+        size_t                TriFrom;  //!< first triangle
+        size_t                TriTo;    //!< triangle after the last one
+        size_t                NodeFrom; //!< minimal node index
+        size_t                NodeTo;   //!< maximal node index + 1
+        std::vector<StGLVec3> Normals;  //!< partial sums for nodes range
+    };
+
+    /**
+     * Functor computing nodes range of triangles chunk.
+     */
+    class StNormalsRangeFunctor {
+
+            public:
+
+        StNormalsRangeFunctor(const StNormalsTriangles&    theTris,
+                              std::vector<StNormalsChunk>& theChunks)
+        : myTris(theTris),
+          myChunks(theChunks) {}
+
+        void operator()(const size_t theChunk) const {
+            StNormalsChunk& aChunk = myChunks[theChunk];
+            aChunk.NodeFrom = size_t(-1);
+            aChunk.NodeTo   = 0;
+            for(size_t aTriIter = aChunk.TriFrom; aTriIter < aChunk.TriTo; ++aTriIter) {
+                for(size_t aNodeIter = 0; aNodeIter < 3; ++aNodeIter) {
+                    const size_t aNode = myTris.getNode(aTriIter, aNodeIter);
+                    aChunk.NodeFrom = stMin(aChunk.NodeFrom, aNode);
+                    aChunk.NodeTo   = stMax(aChunk.NodeTo,   aNode + 1);
+                }
+            }
+        }
+
+            private:
+
+        const StNormalsTriangles&    myTris;
+        std::vector<StNormalsChunk>& myChunks;
+
+    };
+
+    /**
+     * Functor accumulating normals of triangles chunk into private buffer.
+     */
+    class StNormalsAccumFunctor {
+
+            public:
+
+        StNormalsAccumFunctor(const StNormalsTriangles&    theTris,
+                              std::vector<StNormalsChunk>& theChunks)
+        : myTris(theTris),
+          myChunks(theChunks) {}
+
+        void operator()(const size_t theChunk) const {
+            StNormalsChunk& aChunk = myChunks[theChunk];
+            aChunk.Normals.resize(aChunk.NodeTo - aChunk.NodeFrom);
+            myTris.accumulate(aChunk.TriFrom, aChunk.TriTo, &aChunk.Normals[0], aChunk.NodeFrom);
+        }
+
+            private:
+
+        const StNormalsTriangles&    myTris;
+        std::vector<StNormalsChunk>& myChunks;
+
+    };
+
+    /**
+     * Functor summing partial normals for blocks of nodes and normalizing the result.
+     */
+    class StNormalsSumFunctor {
+
+            public:
+
+        StNormalsSumFunctor(const std::vector<StNormalsChunk>& theChunks,
+                            StArray<StGLVec3>&                 theNormals)
+        : myChunks(theChunks),
+          myNormals(theNormals) {}
+
+        void operator()(const size_t theNode) const {
+            StGLVec3& aNorm = myNormals.changeValue(theNode);
+            for(size_t aChunkIter = 0; aChunkIter < myChunks.size(); ++aChunkIter) {
+                const StNormalsChunk& aChunk = myChunks[aChunkIter];
+                if(theNode >= aChunk.NodeFrom
+                && theNode <  aChunk.NodeTo) {
+                    aNorm += aChunk.Normals[theNode - aChunk.NodeFrom];
+                }
+            }
+            aNorm.normalize();
+        }
+
+            private:
+
+        const std::vector<StNormalsChunk>& myChunks;
+        StArray<StGLVec3>&                 myNormals;
+
+    };
+
+}
+
 StGLMeshProgram::StGLMeshProgram(const StString& theTitle)
 : StGLProgram(theTitle) {
     //
@@ -234,40 +389,47 @@ bool StGLMesh::computeNormals(size_t theDelta) {
     // for each node we compute summary of normals for all triangles where this node used
     // normals are NOT normalized per triangle - this allows to interpolate result normal
     // with respect to each triangle dimensions
-    GLuint aV1, aV2, aV3;
-    StGLVec3 aNorm;
+    StNormalsTriangles aTris;
+    aTris.Vertices = &myVertices.getFirst();
+    aTris.Indices  = NULL;
+    aTris.Delta    = theDelta;
+    size_t aNbTris = 0;
     if(myIndices.size() >= 3) {
-        size_t aLimit = myIndices.size() - 3;
-        for(size_t anIndexId = 0; anIndexId <= aLimit; anIndexId += theDelta) {
-            aV1 = myIndices[anIndexId];
-            aV2 = myIndices[anIndexId + 1];
-            aV3 = myIndices[anIndexId + 2];
-            const StGLVec3& aVert1 = myVertices[aV1];
-            const StGLVec3& aVert2 = myVertices[aV2];
-            const StGLVec3& aVert3 = myVertices[aV3];
-            aNorm = StGLVec3::cross(aVert2 - aVert1, aVert3 - aVert1);
-            myNormals.changeValue(aV1) += aNorm;
-            myNormals.changeValue(aV2) += aNorm;
-            myNormals.changeValue(aV3) += aNorm;
-        }
+        aTris.Indices = &myIndices.getFirst();
+        aNbTris = (myIndices.size() - 3) / theDelta + 1;
     } else if(myVertices.size() >= 3) {
-        size_t aLimit = myVertices.size() - 3;
-        for(size_t aVertId = 0; aVertId <= aLimit; aVertId += theDelta) {
-            aV1 = GLuint(aVertId);
-            aV2 = GLuint(aVertId + 1);
-            aV3 = GLuint(aVertId + 2);
-            const StGLVec3& aVert1 = myVertices[aV1];
-            const StGLVec3& aVert2 = myVertices[aV2];
-            const StGLVec3& aVert3 = myVertices[aV3];
-            aNorm = StGLVec3::cross(aVert2 - aVert1, aVert3 - aVert1);
-            myNormals.changeValue(aV1) += aNorm;
-            myNormals.changeValue(aV2) += aNorm;
-            myNormals.changeValue(aV3) += aNorm;
-        }
+        aNbTris = (myVertices.size() - 3) / theDelta + 1;
     } else {
         return false;
     }
 
+    StTaskPool& aPool = StTaskPool::GetDefault();
+    if(aNbTris >= THE_NORMALS_PARALLEL_MIN
+    && aPool.getNbThreads() > 0) {
+        // split triangles into chunks accumulating normals into private buffers
+        // covering the range of nodes used by chunk (usually local within the mesh)
+        const size_t aNbChunks = size_t(aPool.getNbThreads()) + 1;
+        std::vector<StNormalsChunk> aChunks(aNbChunks);
+        for(size_t aChunkIter = 0; aChunkIter < aNbChunks; ++aChunkIter) {
+            aChunks[aChunkIter].TriFrom = aNbTris *  aChunkIter      / aNbChunks;
+            aChunks[aChunkIter].TriTo   = aNbTris * (aChunkIter + 1) / aNbChunks;
+        }
+        aPool.parallelFor(0, aNbChunks, StNormalsRangeFunctor(aTris, aChunks), StTaskPool::Priority_Interactive, 1);
+
+        // fallback to single thread for meshes with scattered indices to avoid excessive memory usage
+        size_t aNbPartial = 0;
+        for(size_t aChunkIter = 0; aChunkIter < aNbChunks; ++aChunkIter) {
+            aNbPartial += aChunks[aChunkIter].NodeTo - aChunks[aChunkIter].NodeFrom;
+        }
+        if(aNbPartial <= myVertices.size() * 2) {
+            aPool.parallelFor(0, aNbChunks, StNormalsAccumFunctor(aTris, aChunks), StTaskPool::Priority_Interactive, 1);
+            aPool.parallelFor(0, myNormals.size(), StNormalsSumFunctor(aChunks, myNormals), StTaskPool::Priority_Interactive, 4096);
+            return true;
+        }
+    }
+
+    aTris.accumulate(0, aNbTris, &myNormals.changeFirst(), 0);
+
     // normalize normals (important for OpenGL)
     for(size_t aNormId = 0; aNormId < myNormals.size(); ++aNormId) {
         myNormals.changeValue(aNormId).normalize();
@@ -86,6 +86,7 @@ void StGLTextFormatter::reset() {
     myRectsNb  = 0;
     myLineSpacing = myAscender = 0.0f;
     myRects.clear(); /// TODO - clear without setting each rectangle to default value
+    myLayout.nullify();
 }
 
 /**
@@ -102,6 +103,13 @@ inline StGLVec2& floor(StGLVec2& theVec) {
 void StGLTextFormatter::getResult(std::vector<GLuint>&                               theTextures,
                                   std::vector< StHandle <std::vector <StGLVec2> > >& theVertsPerTexture,
                                   std::vector< StHandle <std::vector <StGLVec2> > >& theTCrdsPerTexture) const {
+    if(!myLayout.isNull()) {
+        theTextures        = myLayout->Textures;
+        theVertsPerTexture = myLayout->VertsPerTexture;
+        theTCrdsPerTexture = myLayout->TCrdsPerTexture;
+        return;
+    }
+
     StGLVec2 aVec(0.0f, 0.0f);
     theTextures.clear();
     theVertsPerTexture.clear();
@@ -537,3 +545,72 @@ void StGLTextFormatter::format(const GLfloat theWidth,
         moveY(myRects, myBndTop, 0, myRectsNb - 1);
     }
 }
+
+bool StGLTextFormatter::formatCached(StGLContext&         theCtx,
+                                     const StString&      theString,
+                                     StGLFont&            theFont,
+                                     const GLfloat        theWidth,
+                                     const GLfloat        theHeight,
+                                     StGLTextLayoutCache& theCache) {
+    StGLTextLayoutCache::Key aKey;
+    aKey.Hash           = StGLTextLayoutCache::hashString(theString);
+    theFont.getGenerations(aKey.FontGenerations);
+    aKey.Width          = theWidth;
+    aKey.Height         = theHeight;
+    aKey.Size           = !theFont.getFont().isNull() && !theFont.getFont()->getFont().isNull()
+                        ? theFont.getFont()->getFont()->getPointSize()
+                        : 0;
+    aKey.Style          = myDefStyle;
+    aKey.AlignX         = myAlignX;
+    aKey.AlignY         = myAlignY;
+    aKey.Parser         = myParser;
+
+    StHandle<StGLTextLayout> aLayout = theCache.find(aKey, theString);
+    if(!aLayout.isNull()) {
+        restoreLayout(aLayout);
+        return true;
+    }
+
+    reset();
+    append(theCtx, theString, theFont);
+    format(theWidth, theHeight);
+    if(myRectsNb == 0) {
+        return false;
+    }
+
+    aLayout = new StGLTextLayout();
+    aLayout->Text = theString;
+    storeLayout(*aLayout);
+    theCache.add(aKey, aLayout);
+    return false;
+}
+
+void StGLTextFormatter::storeLayout(StGLTextLayout& theLayout) const {
+    theLayout.Rects.assign(myRects.begin(), myRects.begin() + myRectsNb);
+    theLayout.LineSpacing = myLineSpacing;
+    theLayout.Ascender    = myAscender;
+    theLayout.AlignWidth  = myAlignWidth;
+    theLayout.TextWidth   = myTextWidth;
+    theLayout.BndTop      = myBndTop;
+    theLayout.LinesNb     = myLinesNb;
+    getResult(theLayout.Textures, theLayout.VertsPerTexture, theLayout.TCrdsPerTexture);
+}
+
+void StGLTextFormatter::restoreLayout(const StHandle<StGLTextLayout>& theLayout) {
+    reset();
+    if(theLayout.isNull()) {
+        return;
+    }
+
+    myString      = theLayout->Text;
+    myRects       = theLayout->Rects;
+    myRectsNb     = myRects.size();
+    myLineSpacing = theLayout->LineSpacing;
+    myAscender    = theLayout->Ascender;
+    myAlignWidth  = theLayout->AlignWidth;
+    myTextWidth   = theLayout->TextWidth;
+    myBndTop      = theLayout->BndTop;
+    myLinesNb     = theLayout->LinesNb;
+    myIsFormatted = true;
+    myLayout      = theLayout;
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StGL/StGLTextLayoutCache.h>
+
+bool StGLTextLayoutCache::Key::operator<(const Key& theOther) const {
+    if(Hash != theOther.Hash) {
+        return Hash < theOther.Hash;
+    }
+    for(size_t aSubset = 0; aSubset < StFTFont::SubsetsNB; ++aSubset) {
+        if(FontGenerations[aSubset] != theOther.FontGenerations[aSubset]) {
+            return FontGenerations[aSubset] < theOther.FontGenerations[aSubset];
+        }
+    }
+    if(Width != theOther.Width) {
+        return Width < theOther.Width;
+    } else if(Height != theOther.Height) {
+        return Height < theOther.Height;
+    } else if(Size != theOther.Size) {
+        return Size < theOther.Size;
+    } else if(Style != theOther.Style) {
+        return Style < theOther.Style;
+    } else if(AlignX != theOther.AlignX) {
+        return AlignX < theOther.AlignX;
+    } else if(AlignY != theOther.AlignY) {
+        return AlignY < theOther.AlignY;
+    }
+    return Parser < theOther.Parser;
+}
+
+stUInt64_t StGLTextLayoutCache::hashString(const StString& theText) {
+    stUInt64_t aHash = 14695981039346656037ULL;
+    const stUByte_t* aData = (const stUByte_t* )theText.toCString();
+    for(size_t anIter = 0; anIter < theText.getSize(); ++anIter) {
+        aHash ^= aData[anIter];
+        aHash *= 1099511628211ULL;
+    }
+    return aHash;
+}
+
+StGLTextLayoutCache::StGLTextLayoutCache(const size_t theMaxSize)
+: myMaxSize(theMaxSize),
+  myNbHits(0),
+  myNbMisses(0) {
+    //
+}
+
+void StGLTextLayoutCache::setMaxSize(const size_t theMaxSize) {
+    myMaxSize = theMaxSize;
+    trim();
+}
+
+StHandle<StGLTextLayout> StGLTextLayoutCache::find(const Key&      theKey,
+                                                   const StString& theText) {
+    std::map<Key, Entry>::iterator anIter = myMap.find(theKey);
+    if(anIter == myMap.end()
+    || anIter->second.Layout->Text != theText) {
+        ++myNbMisses;
+        return StHandle<StGLTextLayout>();
+    }
+
+    ++myNbHits;
+    myLruList.splice(myLruList.begin(), myLruList, anIter->second.LruIter);
+    return anIter->second.Layout;
+}
+
+void StGLTextLayoutCache::add(const Key&                      theKey,
+                              const StHandle<StGLTextLayout>& theLayout) {
+    if(theLayout.isNull()
+    || myMaxSize == 0) {
+        return;
+    }
+
+    std::map<Key, Entry>::iterator anIter = myMap.find(theKey);
+    if(anIter != myMap.end()) {
+        // hash collision - replace existing layout
+        anIter->second.Layout = theLayout;
+        myLruList.splice(myLruList.begin(), myLruList, anIter->second.LruIter);
+        return;
+    }
+
+    myLruList.push_front(theKey);
+    Entry& anEntry  = myMap[theKey];
+    anEntry.Layout  = theLayout;
+    anEntry.LruIter = myLruList.begin();
+    trim();
+}
+
+void StGLTextLayoutCache::clear() {
+    myMap.clear();
+    myLruList.clear();
+    myNbHits   = 0;
+    myNbMisses = 0;
+}
+
+void StGLTextLayoutCache::trim() {
+    while(myMap.size() > myMaxSize) {
+        myMap.erase(myLruList.back());
+        myLruList.pop_back();
+    }
+}
@@ -0,0 +1,154 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StGLStereo/StGLTextureBufferPool.h>
+
+#include <StStrings/StLogger.h>
+#include <StTemplates/StTemplates.h>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+    #include <sys/mman.h>
+#endif
+
+namespace {
+
+    /**
+     * Minimal size class.
+     */
+    static const size_t THE_SIZE_MIN = 64 * 1024;
+
+    /**
+     * Huge page size and minimal buffer size to be backed by huge pages.
+     */
+    static const size_t THE_HUGE_PAGE = 2 * 1024 * 1024;
+
+    /**
+     * Alignment of regular buffers (memory page).
+     */
+    static const size_t THE_PAGE = 4096;
+
+}
+
+StGLTextureBufferPool::StGLTextureBufferPool(const char* theName)
+: myFreeBytes(0),
+  myTimer(true),
+  myMemClient(theName, StMemoryClient::Role_Cache, 2),
+  myIdleTime(5.0),
+  myToUseHugePages(true) {
+    myMutex.setName("StGLTextureBufferPool::myMutex");
+}
+
+StGLTextureBufferPool::~StGLTextureBufferPool() {
+    trim(true);
+}
+
+size_t StGLTextureBufferPool::getSizeClass(const size_t theSizeBytes) {
+    if(theSizeBytes <= THE_SIZE_MIN) {
+        return THE_SIZE_MIN;
+    }
+
+    // 4 classes per power of two - no more than 25% of wasted memory
+    size_t aPower = THE_SIZE_MIN;
+    while(aPower * 2 <= theSizeBytes) {
+        aPower *= 2;
+    }
+    const size_t aStep = aPower / 4;
+    return ((theSizeBytes + aStep - 1) / aStep) * aStep;
+}
+
+GLubyte* StGLTextureBufferPool::acquire(const size_t theSizeBytes,
+                                        size_t&      theCapacity) {
+    const size_t aCapacity = getSizeClass(theSizeBytes);
+    theCapacity = aCapacity;
+    myMutex.lock();
+    // take the newest buffer of the same class
+    for(size_t anIter = myFree.size(); anIter > 0; --anIter) {
+        const Entry& anEntry = myFree[anIter - 1];
+        if(anEntry.Capacity == aCapacity) {
+            GLubyte* aBuffer = anEntry.Buffer;
+            myFree.erase(myFree.begin() + (anIter - 1));
+            myFreeBytes -= aCapacity;
+            myMemClient.setBytes(myFreeBytes);
+            myMutex.unlock();
+            return aBuffer;
+        }
+    }
+    trimLocked(false);
+    myMutex.unlock();
+
+    const bool isHuge = myToUseHugePages && aCapacity >= THE_HUGE_PAGE;
+    GLubyte* aBuffer = stMemAllocAligned<GLubyte*>(aCapacity, isHuge ? THE_HUGE_PAGE : THE_PAGE);
+    if(aBuffer == NULL) {
+        // release unused buffers and try once again
+        trim(true);
+        aBuffer = stMemAllocAligned<GLubyte*>(aCapacity, isHuge ? THE_HUGE_PAGE : THE_PAGE);
+        if(aBuffer == NULL) {
+            theCapacity = 0;
+            return NULL;
+        }
+    }
+#if defined(__linux__) && !defined(__ANDROID__) && defined(MADV_HUGEPAGE)
+    if(isHuge) {
+        // hint transparent huge pages to reduce page faults and TLB misses on large frames
+        madvise(aBuffer, aCapacity, MADV_HUGEPAGE);
+    }
+#endif
+    ST_DEBUG_LOG("StGLTextureBufferPool allocated " + aCapacity + " bytes");
+    return aBuffer;
+}
+
+void StGLTextureBufferPool::release(GLubyte*     theBuffer,
+                                    const size_t theCapacity) {
+    if(theBuffer == NULL) {
+        return;
+    }
+
+    Entry anEntry;
+    anEntry.Buffer      = theBuffer;
+    anEntry.Capacity    = theCapacity;
+    StMutexAuto aLock(myMutex);
+    anEntry.ReleaseTime = myTimer.getElapsedTimeInSec();
+    myFree.push_back(anEntry);
+    myFreeBytes += theCapacity;
+    trimLocked(false);
+}
+
+void StGLTextureBufferPool::trim(const bool theToForce) {
+    StMutexAuto aLock(myMutex);
+    trimLocked(theToForce);
+}
+
+size_t StGLTextureBufferPool::getFreeBytes() {
+    StMutexAuto aLock(myMutex);
+    return myFreeBytes;
+}
+
+void StGLTextureBufferPool::trimLocked(const bool theToForce) {
+    // buffers are sorted by release time - remove the oldest ones first
+    const double aTime  = myTimer.getElapsedTimeInSec();
+    const size_t aLimit = myMemClient.getLimit();
+    size_t aNbRemoved = 0;
+    for(; aNbRemoved < myFree.size(); ++aNbRemoved) {
+        const Entry& anEntry = myFree[aNbRemoved];
+        if(!theToForce
+        && myFreeBytes <= aLimit
+        && aTime - anEntry.ReleaseTime < myIdleTime) {
+            break;
+        }
+        freeBuffer(anEntry.Buffer);
+        myFreeBytes -= anEntry.Capacity;
+    }
+    if(aNbRemoved != 0) {
+        myFree.erase(myFree.begin(), myFree.begin() + aNbRemoved);
+    }
+    myMemClient.setBytes(myFreeBytes);
+}
+
+void StGLTextureBufferPool::freeBuffer(GLubyte* theBuffer) {
+    stMemFreeAligned(theBuffer);
+}
@@ -8,21 +8,26 @@
 
 #include <StGLStereo/StGLTextureData.h>
 #include <StStrings/StLogger.h>
+#include <StThreads/StTracer.h>
 
 #include <StGLCore/StGLCore11.h>
 
-StGLTextureData::StGLTextureData(const StHandle<StGLTextureUploadParams>& theUploadParams)
+StGLTextureData::StGLTextureData(const StHandle<StGLTextureUploadParams>& theUploadParams,
+                                 const StHandle<StGLTextureBufferPool>&   theBufferPool)
 : myPrev(NULL),
   myNext(NULL),
   myDataPtr(NULL),
   myDataSizeBytes(0),
+  myDataCapacity(0),
+  myBufferPool(theBufferPool),
   myStParams(),
   myPts(0.0),
   mySrcFormat(StFormat_AUTO),
   myCubemapFormat(StCubemap_OFF),
   myUploadParams(theUploadParams),
   myFillFromRow(0),
-  myFillRows(0) {
+  myFillRows(0),
+  myTelUpload(StTelemetry::GetDefault().getHistogram("render.upload")) {
     //
 }
 
@@ -31,34 +36,53 @@ StGLTextureData::~StGLTextureData() {
 }
 
 void StGLTextureData::reset() {
+    StMutexAuto aLock(myDataMutex);
     myDataPair.nullify();
     myDataL.nullify();
     myDataR.nullify();
     if(myDataPtr != NULL) {
-        stMemFreeAligned(myDataPtr);
+        myBufferPool->release(myDataPtr, myDataCapacity);
         myDataPtr = NULL;
     }
     myDataSizeBytes = 0;
+    myDataCapacity  = 0;
     myFillRows = myFillFromRow = 0;
 }
 
+bool StGLTextureData::tryReset() {
+    if(!myDataMutex.tryLock()) {
+        return false;
+    }
+    reset();
+    myDataMutex.unlock();
+    return true;
+}
+
 bool StGLTextureData::reAllocate(const size_t theSizeBytes) {
     // reallocate only if summary data is not same
     // this allows to smoothly switch to different stereo source formats
     // over/under -> sideBySide -> mono
     // because the summary buffer needed for both views will be same
-    if(myDataSizeBytes != theSizeBytes) {
-        reset();
-        myDataSizeBytes = theSizeBytes;
-        myDataPtr       = stMemAllocAligned<GLubyte*>(myDataSizeBytes);
+    if(myDataSizeBytes == theSizeBytes) {
+        return false;
+    }
 
-        // reset the buffer (make black)
-        /// this is probably useless and wrong in case of non RGB image data
-        stMemZero(myDataPtr, myDataSizeBytes);
-        ST_DEBUG_LOG("StGLTextureData (re)allocated to " + myDataSizeBytes + " bytes");
-        return true;
+    // keep the buffer when new size falls into the same size class
+    myDataPair.nullify();
+    myDataL.nullify();
+    myDataR.nullify();
+    myFillRows = myFillFromRow = 0;
+    if(myDataPtr != NULL
+    && myDataCapacity == StGLTextureBufferPool::getSizeClass(theSizeBytes)) {
+        myDataSizeBytes = theSizeBytes;
+        return false;
     }
-    return false;
+
+    reset();
+    // buffer is not cleared - it is completely overwritten by the following copy
+    myDataPtr       = myBufferPool->acquire(theSizeBytes, myDataCapacity);
+    myDataSizeBytes = myDataPtr != NULL ? theSizeBytes : 0;
+    return true;
 }
 
 static GLubyte* readFromParallel(const StImagePlane& theSrc,
@@ -360,6 +384,7 @@ void StGLTextureData::updateData(const StGLDeviceCaps&           theDeviceCaps,
                                  const StFormat                  theFormat,
                                  const StCubemap                 theCubemap,
                                  const double                    thePts) {
+    StMutexAuto aLock(myDataMutex);
     // setup new stereo source
     myStParams  = theStParams;
     myPts       = thePts;
@@ -762,6 +787,8 @@ static void prepareTextures(StGLContext&       theCtx,
 
 bool StGLTextureData::fillTexture(StGLContext&     theCtx,
                                   StGLQuadTexture& theQTexture) {
+    StTelemetryTimer aTelTimer(myTelUpload);
+    ST_TRACE_SCOPE("fillTexture");
 
     // setup rows count to be filled per fillTexture()
     if(myFillRows == 0 || myFillFromRow == 0) {
@@ -9,6 +9,22 @@
 #include <StGLStereo/StGLTextureQueue.h>
 
 #include <StGL/StGLContext.h>
+#include <StThreads/StTracer.h>
+
+namespace {
+
+    /**
+     * @return size of image planes
+     */
+    inline size_t getImageBytes(const StImage& theImage) {
+        size_t aBytes = 0;
+        for(size_t aPlaneId = 0; aPlaneId < 4; ++aPlaneId) {
+            aBytes += theImage.getPlane(aPlaneId).getSizeBytes();
+        }
+        return aBytes;
+    }
+
+}
 
 StGLTextureQueue::StGLTextureQueue(const size_t theQueueSizeMax)
 : myDataFront(NULL),
@@ -16,6 +32,8 @@ StGLTextureQueue::StGLTextureQueue(const size_t theQueueSizeMax)
   myDataBack(NULL),
   myQueueSize(0),
   myQueueSizeMax(theQueueSizeMax),
+  myFrameBytes(0),
+  myMemClient("textureQueue", StMemoryClient::Role_Queue, 8),
   mySwapFBCount(0),
   myCurrSrcFormat(StFormat_Mono),
   myCurrPts(0.0),
@@ -24,8 +42,15 @@ StGLTextureQueue::StGLTextureQueue(const size_t theQueueSizeMax)
   myIsReadyToSwap(false),
   myToCompress(false),
   myHasStream(false),
-  myUploadParams(new StGLTextureUploadParams()) {
+  myUploadParams(new StGLTextureUploadParams()),
+  myBufferPool(new StGLTextureBufferPool()) {
     ST_ASSERT(myQueueSizeMax >= 2, "StGLTextureQueue() - queue size limit should be >= 2");
+    myMutexPop      .setName("StGLTextureQueue::myMutexPop");
+    myMutexPush     .setName("StGLTextureQueue::myMutexPush");
+    myMutexSize     .setName("StGLTextureQueue::myMutexSize");
+    mySwapFBMutex   .setName("StGLTextureQueue::mySwapFBMutex");
+    myMeterMutex    .setName("StGLTextureQueue::myMeterMutex");
+    myMutexSrcFormat.setName("StGLTextureQueue::myMutexSrcFormat");
     // 1920x1080@YUV420p   ~  3 MiB
     // 1920x1080@RGB8      ~  6 MiB
     // 3840x2160@YUV420p   ~ 12 MiB
@@ -35,10 +60,10 @@ StGLTextureQueue::StGLTextureQueue(const size_t theQueueSizeMax)
     myUploadParams->MaxUploadIterations = 1;
 
     // we create 'empty' queue
-    myDataFront = new StGLTextureData(myUploadParams);
+    myDataFront = new StGLTextureData(myUploadParams, myBufferPool);
     StGLTextureData* iter = myDataFront;
     for(size_t i = 1; i < myQueueSizeMax; ++i) {
-        iter->setNext(new StGLTextureData(myUploadParams));
+        iter->setNext(new StGLTextureData(myUploadParams, myBufferPool));
         iter = iter->getNext();
     }
     iter->setNext(myDataFront); // data in loop
@@ -84,8 +109,11 @@ bool StGLTextureQueue::push(const StImage&     theSrcDataLeft,
 
     myMutexSize.lock();
         ++myQueueSize;
+        myFrameBytes = getImageBytes(theSrcDataLeft) + getImageBytes(theSrcDataRight);
+        updateMemoryUsage();
     myMutexSize.unlock();
     myMutexPush.unlock();
+    signals.onNewFrame();
     return true;
 }
 
@@ -118,6 +146,7 @@ int StGLTextureQueue::swapFBOnReady(StGLContext& theCtx) {
 
 // this function called ONLY from plugin thread
 bool StGLTextureQueue::stglUpdateStTextures(StGLContext& theCtx) {
+    ST_TRACE_SCOPE("stglUpdateStTextures");
     int aSwapState = swapFBOnReady(theCtx);
     if(aSwapState == SWAPONREADY_WAITLIM) {
         return false;
@@ -151,11 +180,13 @@ bool StGLTextureQueue::stglUpdateStTextures(StGLContext& theCtx) {
             myCurrPts   = myDataFront->getPTS();
             myDataSnap  = myDataFront; myNewShotEvent.set();
             if(myToCompress) {
-                myDataFront->reset();
+                // never wait for snapshot copying - the data will be released by next update of the slot
+                myDataFront->tryReset();
             }
             myDataFront = myDataFront->getNext();
             ST_ASSERT(myQueueSize != 0, "StGLTextureQueue::stglUpdateStTextures() - critical error!");
             --myQueueSize;
+            updateMemoryUsage();
         myMutexSize.unlock();
         myIsInUpdTexture = false;
     }
@@ -179,6 +210,7 @@ void StGLTextureQueue::clear() {
         }
         // reset queue
         myQueueSize     = 0;
+        updateMemoryUsage();
         myDataBack      = myDataFront;
         if(myDataSnap != NULL) {
             myDataSnap->resetStParams();
@@ -215,6 +247,7 @@ void StGLTextureQueue::drop(const size_t theCount,
         thePtsFront = myDataFront->getPTS();
         // reset queue
         myQueueSize -= decr;
+        updateMemoryUsage();
         // empty texture update sequence
         myIsInUpdTexture = false;
     myMutexSize.unlock();
@@ -229,12 +262,18 @@ int StGLTextureQueue::getSnapshot(StImage* theOutDataLeft,
         return SNAPSHOT_NO_NEW;
     }
     myMutexPop.lock();
-    if(myDataSnap == NULL) {
+    StGLTextureData* aSnap = myDataSnap;
+    if(aSnap == NULL) {
         myMutexPop.unlock();
         return SNAPSHOT_NO_NEW;
     }
-    myDataSnap->getCopy(theOutDataLeft, theOutDataRight);
+    // pin the slot data and copy it without holding the queue lock,
+    // so that texture upload is not stalled by copying of the whole frame
+    aSnap->lockData();
     myNewShotEvent.reset();
     myMutexPop.unlock();
+
+    aSnap->getCopy(theOutDataLeft, theOutDataRight);
+    aSnap->unlockData();
     return SNAPSHOT_SUCCESS;
 }
@@ -9,9 +9,12 @@
 #include <StStrings/StLogger.h>
 
 #include <StStrings/stConsole.h>
+#include <StThreads/StAtomicOp.h>
+#include <StThreads/StCondition.h>
 #include <StThreads/StMutexSlim.h>
 #include <StThreads/StProcess.h>
 #include <StThreads/StThread.h>
+#include <StThreads/StTimer.h>
 
 #if defined(__ANDROID__)
     #include <android/log.h>
@@ -26,6 +29,163 @@
     #define ST_LOG_CERR std::cerr
 #endif
 
+namespace {
+
+    /**
+     * Number of messages in the queue of asynchronous logger (should be power of 2).
+     */
+    static const size_t THE_QUEUE_SIZE = 4096;
+
+    /**
+     * Interval for writing queued messages in milliseconds.
+     */
+    static const size_t THE_WRITE_INTERVAL_MS = 100;
+
+    /**
+     * Maximum time to wait for flushing in milliseconds.
+     */
+    static const int THE_FLUSH_TIMEOUT_MS = 2000;
+
+    /**
+     * Default maximum size of the log file.
+     */
+    static const size_t THE_FILE_SIZE_MAX = 32 * 1024 * 1024;
+
+}
+
+/**
+ * Bounded lock-free queue of log messages with multiple producers and single consumer.
+ * Each cell holds sequence number defining whether it is free for the producer
+ * with the same position or filled for the consumer (position + 1).
+ */
+class StLogQueue {
+
+        public:
+
+    StLogQueue()
+    : myEnqueuePos(0),
+      myDequeuePos(0),
+      myWrittenPos(0),
+      myDropped(0) {
+        for(size_t aCellIter = 0; aCellIter < THE_QUEUE_SIZE; ++aCellIter) {
+            myCells[aCellIter].Sequence = int32_t(aCellIter);
+            myCells[aCellIter].Message  = NULL;
+        }
+    }
+
+    ~StLogQueue() {
+        for(size_t aCellIter = 0; aCellIter < THE_QUEUE_SIZE; ++aCellIter) {
+            delete myCells[aCellIter].Message;
+        }
+    }
+
+    /**
+     * Put the message into the queue.
+     * @return position of the message or -1 if queue is full
+     */
+    int32_t push(const StString&       theMessage,
+                 const StLogger::Level theLevel,
+                 const size_t          theThreadId) {
+        int32_t aPos = myEnqueuePos;
+        Cell* aCell = NULL;
+        for(;;) {
+            aCell = &myCells[size_t(aPos) & (THE_QUEUE_SIZE - 1)];
+            const int32_t aDiff = int32_t(uint32_t(StAtomicOp::Add(aCell->Sequence, 0)) - uint32_t(aPos));
+            if(aDiff == 0) {
+                if(StAtomicOp::CompareAndSwap(myEnqueuePos, aPos, aPos + 1)) {
+                    break;
+                }
+            } else if(aDiff < 0) {
+                StAtomicOp::Increment(myDropped);
+                return -1;
+            }
+            aPos = myEnqueuePos;
+        }
+
+        aCell->Message  = new StString(theMessage);
+        aCell->Level    = theLevel;
+        aCell->ThreadId = theThreadId;
+        StAtomicOp::Increment(aCell->Sequence); // publish the cell to the consumer
+        return aPos;
+    }
+
+    /**
+     * Retrieve the next message from the queue (consumer thread).
+     * @param theMessage message to be deleted by caller
+     * @return false if queue is empty
+     */
+    bool pop(StString*&       theMessage,
+             StLogger::Level& theLevel,
+             size_t&          theThreadId) {
+        Cell& aCell = myCells[size_t(myDequeuePos) & (THE_QUEUE_SIZE - 1)];
+        const int32_t aDiff = int32_t(uint32_t(StAtomicOp::Add(aCell.Sequence, 0)) - uint32_t(myDequeuePos + 1));
+        if(aDiff < 0) {
+            return false;
+        }
+
+        theMessage    = aCell.Message;
+        theLevel      = aCell.Level;
+        theThreadId   = aCell.ThreadId;
+        aCell.Message = NULL;
+        StAtomicOp::Add(aCell.Sequence, int32_t(THE_QUEUE_SIZE - 1)); // release the cell for the next round
+        ++myDequeuePos;
+        return true;
+    }
+
+    /**
+     * @return true if queue is filled more than a half
+     */
+    bool isHalfFull() const {
+        return uint32_t(myEnqueuePos - myDequeuePos) > uint32_t(THE_QUEUE_SIZE / 2);
+    }
+
+    /**
+     * Mark messages retrieved so far as written (consumer thread).
+     */
+    void setWritten() {
+        StAtomicOp::Add(myWrittenPos, myDequeuePos - myWrittenPos);
+    }
+
+    /**
+     * @return true if message at specified position has been written
+     */
+    bool isWritten(const int32_t thePos) const {
+        return int32_t(uint32_t(myWrittenPos) - uint32_t(thePos)) > 0;
+    }
+
+    /**
+     * @return position of the next message to be pushed
+     */
+    int32_t getEnqueuePos() const {
+        return myEnqueuePos;
+    }
+
+    /**
+     * @return number of dropped messages
+     */
+    size_t getDropped() const {
+        return size_t(uint32_t(myDropped));
+    }
+
+        private:
+
+    struct Cell {
+        volatile int32_t Sequence; //!< sequence number
+        StString*        Message;  //!< message text
+        StLogger::Level  Level;    //!< message level
+        size_t           ThreadId; //!< thread id
+    };
+
+        private:
+
+    Cell             myCells[THE_QUEUE_SIZE];
+    volatile int32_t myEnqueuePos; //!< position for the next producer
+    volatile int32_t myDequeuePos; //!< position for the consumer
+    volatile int32_t myWrittenPos; //!< position of the first not yet written message
+    volatile int32_t myDropped;    //!< number of dropped messages
+
+};
+
 StLogger& StLogger::GetDefault() {
     // global instance
     static StLogger THE_DEFAULT_LOGGER(
@@ -39,7 +199,7 @@ StLogger& StLogger::GetDefault() {
     #else
         StLogger::ST_VERBOSE,
     #endif
-        StLogger::ST_OPT_COUT | StLogger::ST_OPT_LOCK
+        StLogger::ST_OPT_COUT | StLogger::ST_OPT_LOCK | StLogger::ST_OPT_ASYNC
     );
     return THE_DEFAULT_LOGGER;
 }
@@ -60,13 +220,18 @@ StLogContext::~StLogContext() {
 StLogger::StLogger(const StString&       theLogFile,
                    const StLogger::Level theFilter,
                    const int             theOptions)
-: myMutex((theOptions & StLogger::ST_OPT_LOCK) ? new StMutexSlim() : (StMutexSlim* )NULL),
+: myMutex((theOptions & (StLogger::ST_OPT_LOCK | StLogger::ST_OPT_ASYNC)) ? new StMutexSlim() : (StMutexSlim* )NULL),
 #ifdef _WIN32
   myFilePath(theLogFile.toUtfWide()),
 #else
   myFilePath(theLogFile),
 #endif
   myFileHandle(NULL),
+  myFileSize(0),
+  myFileSizeMax(THE_FILE_SIZE_MAX),
+  myDroppedLast(0),
+  myNbPushing(0),
+  myToQuit(false),
   myFilter(theFilter),
   myToLogCout(theOptions & StLogger::ST_OPT_COUT),
 #ifdef ST_DEBUG_SYSLOG
@@ -80,11 +245,147 @@ StLogger::StLogger(const StString&       theLogFile,
   myToLogThreadId(false)
 #endif
 {
-    //
+    if(!myMutex.isNull()) {
+        myMutex->setName("StLogger::myMutex");
+    }
+    if((theOptions & StLogger::ST_OPT_ASYNC) != 0) {
+        myQueue        = new StLogQueue();
+        myEvent        = new StCondition(false);
+        myWrittenEvent = new StCondition(false);
+        myThread       = new StThread(threadFunction, (void* )this, "StLogger");
+    }
 }
 
 StLogger::~StLogger() {
-    //
+    shutdown();
+    if(myFileHandle != NULL) {
+        fclose(myFileHandle);
+        myFileHandle = NULL;
+    }
+}
+
+void StLogger::shutdown() {
+    if(!myThread.isNull()) {
+        myToQuit = true;
+        myEvent->set();
+        myThread->wait();
+
+        // producers which have seen the flag unset may still be putting messages into the queue;
+        // wait for them and write the rest within this thread
+        while(StAtomicOp::Add(myNbPushing, 0) != 0) {
+            StThread::sleep(1);
+        }
+        writeQueued();
+        myThread.nullify();
+    }
+}
+
+SV_THREAD_FUNCTION StLogger::threadFunction(void* theLogger) {
+    StLogger* aLogger = (StLogger* )theLogger;
+    aLogger->writerLoop();
+    return SV_THREAD_RETURN 0;
+}
+
+void StLogger::writerLoop() {
+    for(;;) {
+        myEvent->wait(THE_WRITE_INTERVAL_MS);
+        myEvent->reset();
+        const bool toQuit = myToQuit;
+        writeQueued();
+        if(toQuit) {
+            return;
+        }
+    }
+}
+
+void StLogger::writeQueued() {
+    // the lock serializes this writer with synchronous writing used after stopping the thread
+    myMutex->lock();
+    bool hasWritten = false;
+    StString*       aMessage  = NULL;
+    StLogger::Level aLevel    = ST_INFO;
+    size_t          aThreadId = 0;
+    while(myQueue->pop(aMessage, aLevel, aThreadId)) {
+        writeRecord(*aMessage, aLevel, aThreadId, true);
+        delete aMessage;
+        hasWritten = true;
+    }
+
+    const size_t aDropped = myQueue->getDropped();
+    if(aDropped != myDroppedLast) {
+        writeRecord(StString("Log queue overflow, ") + (aDropped - myDroppedLast) + " message(s) dropped",
+                    ST_WARNING, 0, true);
+        myDroppedLast = aDropped;
+        hasWritten = true;
+    }
+
+    if(hasWritten && myFileHandle != NULL) {
+        fflush(myFileHandle);
+    }
+    myQueue->setWritten();
+    myMutex->unlock();
+    myWrittenEvent->set();
+}
+
+bool StLogger::openFile() {
+#ifdef _WIN32
+    myFileHandle = _wfopen(myFilePath.toCString(), L"ab");
+#else
+    myFileHandle =   fopen(myFilePath.toCString(),  "ab");
+#endif
+    if(myFileHandle == NULL) {
+        return false;
+    }
+
+    fseek(myFileHandle, 0, SEEK_END);
+    const long aSize = ftell(myFileHandle);
+    myFileSize = aSize > 0 ? size_t(aSize) : 0;
+    return true;
+}
+
+void StLogger::rotateFile() {
+    if(myFileHandle != NULL) {
+        fclose(myFileHandle);
+        myFileHandle = NULL;
+    }
+
+#ifdef _WIN32
+    const StStringUtfWide aPathOld = myFilePath + L".1";
+    _wremove(aPathOld.toCString());
+    _wrename(myFilePath.toCString(), aPathOld.toCString());
+#else
+    const StString aPathOld = myFilePath + ".1";
+    ::remove(aPathOld.toCString());
+    ::rename(myFilePath.toCString(), aPathOld.toCString());
+#endif
+    myFileSize = 0;
+}
+
+size_t StLogger::getDroppedCount() const {
+    return !myQueue.isNull() ? myQueue->getDropped() : 0;
+}
+
+void StLogger::flush() {
+    if(myThread.isNull()
+    || myToQuit) {
+        return;
+    }
+
+    const int32_t aLastPos = myQueue->getEnqueuePos() - 1;
+    for(StTimer aTimer(true); !myQueue->isWritten(aLastPos);) {
+        const double aTimeLeft = THE_FLUSH_TIMEOUT_MS - aTimer.getElapsedTimeInMilliSec();
+        if(aTimeLeft <= 0.0) {
+            break;
+        }
+
+        // reset before re-checking the position, so that the signal from the next pass is not lost
+        myWrittenEvent->reset();
+        if(myQueue->isWritten(aLastPos)) {
+            break;
+        }
+        myEvent->set();
+        myWrittenEvent->wait(stMax(size_t(aTimeLeft), size_t(1)));
+    }
 }
 
 void StLogger::write(const StString&       theMessage,
@@ -95,38 +396,67 @@ void StLogger::write(const StString&       theMessage,
         return;
     }
 
+    const size_t aThreadId = myToLogThreadId ? StThread::getCurrentThreadId() : 0;
+    if(!myThread.isNull()) {
+        // register the producer before checking the flag, so that destructor writes its message
+        StAtomicOp::Increment(myNbPushing);
+        if(!myToQuit) {
+            // just put the message into the queue, the file is written by dedicated thread
+            myQueue->push(theMessage, theLevel, aThreadId);
+            StAtomicOp::Decrement(myNbPushing);
+            if(theLevel <= ST_FATAL) {
+                flush();
+            } else if(myQueue->isHalfFull()) {
+                myEvent->set();
+            }
+            return;
+        }
+        StAtomicOp::Decrement(myNbPushing);
+    }
+
     // lock for safety
     if(!myMutex.isNull()) {
         myMutex->lock();
     }
+    writeRecord(theMessage, theLevel, aThreadId, false);
+    // unlock mutex
+    if(!myMutex.isNull()) {
+        myMutex->unlock();
+    }
+}
 
+void StLogger::writeRecord(const StString&       theMessage,
+                           const StLogger::Level theLevel,
+                           const size_t          theThreadId,
+                           const bool            theToKeepOpen) {
     // log to the file
-    if(!myFilePath.isEmpty()) {
-    #ifdef _WIN32
-        myFileHandle = _wfopen(myFilePath.toCString(), L"ab");
-    #else
-        myFileHandle =   fopen(myFilePath.toCString(),  "ab");
-    #endif
-        if(myFileHandle != NULL) {
-            switch(theLevel) {
-                case ST_PANIC:   fwrite("PANIC !! ", 1, 9, myFileHandle); break;
-                case ST_FATAL:   fwrite("FATAL !! ", 1, 9, myFileHandle); break;
-                case ST_ERROR:   fwrite("ERROR !! ", 1, 9, myFileHandle); break;
-                case ST_WARNING: fwrite("WARN  -- ", 1, 9, myFileHandle); break;
-                case ST_INFO:
-                case ST_VERBOSE: fwrite("INFO  -- ", 1, 9, myFileHandle); break;
-                case ST_TRACE:   fwrite("TRACE -- ", 1, 9, myFileHandle); break;
-                case ST_QUIET: break;
-            }
-            if(myToLogThreadId) {
-                const size_t   aThreadId  = StThread::getCurrentThreadId();
-                const StString aThreadStr = StString("[") + aThreadId + "]";
-                fwrite(aThreadStr.toCString(), 1, aThreadStr.getSize(), myFileHandle);
-            }
-            fwrite(theMessage.toCString(), 1, theMessage.getSize(), myFileHandle);
-            fwrite("\n", 1, 1, myFileHandle);
+    if(!myFilePath.isEmpty()
+    && (myFileHandle != NULL || openFile())) {
+        switch(theLevel) {
+            case ST_PANIC:   fwrite("PANIC !! ", 1, 9, myFileHandle); break;
+            case ST_FATAL:   fwrite("FATAL !! ", 1, 9, myFileHandle); break;
+            case ST_ERROR:   fwrite("ERROR !! ", 1, 9, myFileHandle); break;
+            case ST_WARNING: fwrite("WARN  -- ", 1, 9, myFileHandle); break;
+            case ST_INFO:
+            case ST_VERBOSE: fwrite("INFO  -- ", 1, 9, myFileHandle); break;
+            case ST_TRACE:   fwrite("TRACE -- ", 1, 9, myFileHandle); break;
+            case ST_QUIET: break;
+        }
+        myFileSize += 9;
+        if(myToLogThreadId) {
+            const StString aThreadStr = StString("[") + theThreadId + "]";
+            fwrite(aThreadStr.toCString(), 1, aThreadStr.getSize(), myFileHandle);
+            myFileSize += aThreadStr.getSize();
+        }
+        fwrite(theMessage.toCString(), 1, theMessage.getSize(), myFileHandle);
+        fwrite("\n", 1, 1, myFileHandle);
+        myFileSize += theMessage.getSize() + 1;
+        if(!theToKeepOpen) {
             fclose(myFileHandle);
             myFileHandle = NULL;
+        } else if(myFileSizeMax != 0
+               && myFileSize >= myFileSizeMax) {
+            rotateFile();
         }
     }
 
@@ -208,11 +538,6 @@ void StLogger::write(const StString&       theMessage,
         __android_log_write(anAPrior, "StLogger", theMessage.toCString());
     }
 #endif
-
-    // unlock mutex
-    if(!myMutex.isNull()) {
-        myMutex->unlock();
-    }
 }
 
 #ifdef _WIN32
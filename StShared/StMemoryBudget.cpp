@@ -0,0 +1,300 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StThreads/StMemoryBudget.h>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__APPLE__)
+    #include <sys/types.h>
+    #include <sys/sysctl.h>
+#else
+    #include <unistd.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+
+    /**
+     * Minimal and maximal default budget.
+     */
+    static const uint64_t THE_DEFAULT_MIN = uint64_t(128) * 1024 * 1024;
+#if defined(_WIN64) || defined(__LP64__)
+    static const uint64_t THE_DEFAULT_MAX = uint64_t(4096) * 1024 * 1024;
+#else
+    static const uint64_t THE_DEFAULT_MAX = uint64_t(1024) * 1024 * 1024;
+#endif
+
+    /**
+     * Duration of pressure state after the last event.
+     */
+    static const double THE_PRESSURE_SEC = 10.0;
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+
+    /**
+     * Read the first line of the text file.
+     */
+    static bool readLine(const StString& thePath,
+                         char*           theBuffer,
+                         const int       theSize) {
+        FILE* aFile = std::fopen(thePath.toCString(), "rb");
+        if(aFile == NULL) {
+            return false;
+        }
+        const bool isRead = std::fgets(theBuffer, theSize, aFile) != NULL;
+        std::fclose(aFile);
+        return isRead;
+    }
+
+    /**
+     * Find path to the cgroup v2 directory of this process.
+     */
+    static StString findCGroupPath() {
+        FILE* aFile = std::fopen("/proc/self/cgroup", "rb");
+        if(aFile == NULL) {
+            return StString();
+        }
+
+        // unified hierarchy is listed as "0::/path" - not necessarily
+        // on the first line when v1 controllers are mounted as well
+        char aLine[1024];
+        bool isFound = false;
+        while(std::fgets(aLine, sizeof(aLine), aFile) != NULL) {
+            if(std::strncmp(aLine, "0::", 3) == 0) {
+                isFound = true;
+                break;
+            }
+        }
+        std::fclose(aFile);
+        if(!isFound) {
+            return StString();
+        }
+
+        char* anEnd = std::strchr(aLine, '\n');
+        if(anEnd != NULL) {
+            *anEnd = '\0';
+        }
+
+        // hybrid layout mounts the unified hierarchy in a sub-folder
+        StString aRoot("/sys/fs/cgroup");
+        FILE* aHybrid = std::fopen("/sys/fs/cgroup/unified/cgroup.controllers", "rb");
+        if(aHybrid != NULL) {
+            std::fclose(aHybrid);
+            aRoot = StString("/sys/fs/cgroup/unified");
+        }
+        const StString aPath = aRoot + (aLine + 3);
+        return aPath.isEndsWith(stCString("/")) ? aPath : (aPath + "/");
+    }
+
+    /**
+     * Read memory limit of control group ("max" means no limit).
+     */
+    static uint64_t readCGroupLimit(const StString& theFile) {
+        char aLine[64];
+        if(!readLine(theFile, aLine, sizeof(aLine))
+        || aLine[0] < '0' || aLine[0] > '9') {
+            return 0;
+        }
+        return std::strtoull(aLine, NULL, 10);
+    }
+
+#endif
+
+}
+
+StMemoryClient::StMemoryClient(const StString& theName,
+                               const Role      theRole,
+                               const size_t    theWeight,
+                               StMemoryBudget* theBudget)
+: myBudget(theBudget != NULL ? theBudget : &StMemoryBudget::GetDefault()),
+  myName(theName),
+  myRole(theRole),
+  myWeight(stMax(theWeight, size_t(1))),
+  myBytes(0),
+  myLimit(0) {
+    myBudget->add(this);
+}
+
+StMemoryClient::~StMemoryClient() {
+    myBudget->remove(this);
+}
+
+StMemoryBudget& StMemoryBudget::GetDefault() {
+    static StMemoryBudget THE_DEFAULT_BUDGET(size_t(stMin(stMax(getSystemMemory() / 4, THE_DEFAULT_MIN), THE_DEFAULT_MAX)));
+    return THE_DEFAULT_BUDGET;
+}
+
+uint64_t StMemoryBudget::getSystemMemory() {
+#if defined(_WIN32)
+    MEMORYSTATUSEX aStatus;
+    aStatus.dwLength = sizeof(aStatus);
+    if(!GlobalMemoryStatusEx(&aStatus)) {
+        return 0;
+    }
+    return stMin(uint64_t(aStatus.ullTotalPhys), uint64_t(aStatus.ullTotalVirtual));
+#elif defined(__APPLE__)
+    int      aMib[2] = { CTL_HW, HW_MEMSIZE };
+    uint64_t aSize   = 0;
+    size_t   aLen    = sizeof(aSize);
+    if(sysctl(aMib, 2, &aSize, &aLen, NULL, 0) != 0) {
+        return 0;
+    }
+    return aSize;
+#else
+    const long aNbPages  = sysconf(_SC_PHYS_PAGES);
+    const long aPageSize = sysconf(_SC_PAGESIZE);
+    uint64_t aSize = (aNbPages > 0 && aPageSize > 0) ? uint64_t(aNbPages) * uint64_t(aPageSize) : 0;
+
+    // container might be limited much stronger than physical memory
+    const StString aCGroup = findCGroupPath();
+    if(!aCGroup.isEmpty()) {
+        const uint64_t aLimits[2] = {
+            readCGroupLimit(aCGroup + "memory.high"),
+            readCGroupLimit(aCGroup + "memory.max")
+        };
+        for(int anIter = 0; anIter < 2; ++anIter) {
+            if(aLimits[anIter] != 0) {
+                aSize = aSize != 0 ? stMin(aSize, aLimits[anIter]) : aLimits[anIter];
+            }
+        }
+    }
+    return aSize;
+#endif
+}
+
+StMemoryBudget::StMemoryBudget(const size_t theLimit)
+: myLimit(theLimit),
+  myIsPressure(false),
+  myPollTimer(true),
+  myPressureTimer(false),
+  myNbEvents(0),
+  myHasEvents(false),
+  myTelUsed    (StTelemetry::GetDefault().getGauge  ("memory.usedMiB")),
+  myTelPressure(StTelemetry::GetDefault().getCounter("memory.pressure")) {
+    myMutex.setName("StMemoryBudget::myMutex");
+    StTelemetry::GetDefault().getGauge("memory.budgetMiB")->setValue(int32_t(myLimit / (1024 * 1024)));
+#if !defined(_WIN32) && !defined(__APPLE__)
+    myCGroupPath = findCGroupPath();
+    myHasEvents  = readPressureEvents(myNbEvents);
+#endif
+}
+
+void StMemoryBudget::setLimit(const size_t theLimit) {
+    StMutexAuto aLock(myMutex);
+    myLimit = theLimit;
+    updateLimits();
+}
+
+size_t StMemoryBudget::getUsedBytes() {
+    StMutexAuto aLock(myMutex);
+    size_t aBytes = 0;
+    for(size_t anIter = 0; anIter < myClients.size(); ++anIter) {
+        aBytes += myClients[anIter]->getBytes();
+    }
+    return aBytes;
+}
+
+void StMemoryBudget::setPressure(const bool theIsPressure) {
+    StMutexAuto aLock(myMutex);
+    if(theIsPressure) {
+        myPressureTimer.restart();
+        myTelPressure->increment();
+    }
+    if(myIsPressure != theIsPressure) {
+        myIsPressure = theIsPressure;
+        updateLimits();
+    }
+}
+
+void StMemoryBudget::checkPressure() {
+    if(myPollTimer.getElapsedTimeInSec() < 1.0) {
+        return;
+    }
+    myPollTimer.restart();
+    myTelUsed->setValue(int32_t(getUsedBytes() / (1024 * 1024)));
+
+    uint64_t aNbEvents = 0;
+    if(myHasEvents
+    && readPressureEvents(aNbEvents)
+    && aNbEvents != myNbEvents) {
+        myNbEvents = aNbEvents;
+        setPressure(true);
+    } else if(myIsPressure
+           && myPressureTimer.getElapsedTimeInSec() > THE_PRESSURE_SEC) {
+        setPressure(false);
+    }
+}
+
+bool StMemoryBudget::readPressureEvents(uint64_t& theNbEvents) {
+#if !defined(_WIN32) && !defined(__APPLE__)
+    if(myCGroupPath.isEmpty()) {
+        return false;
+    }
+
+    // memory.events lists "high" counter - number of times memory.high has been exceeded
+    FILE* aFile = std::fopen((myCGroupPath + "memory.events").toCString(), "rb");
+    if(aFile == NULL) {
+        return false;
+    }
+    char aLine[128];
+    bool isFound = false;
+    while(std::fgets(aLine, sizeof(aLine), aFile) != NULL) {
+        if(std::strncmp(aLine, "high ", 5) == 0) {
+            theNbEvents = std::strtoull(aLine + 5, NULL, 10);
+            isFound = true;
+            break;
+        }
+    }
+    std::fclose(aFile);
+    return isFound;
+#else
+    (void )theNbEvents;
+    return false;
+#endif
+}
+
+void StMemoryBudget::add(StMemoryClient* theClient) {
+    StMutexAuto aLock(myMutex);
+    myClients.push_back(theClient);
+    updateLimits();
+}
+
+void StMemoryBudget::remove(StMemoryClient* theClient) {
+    StMutexAuto aLock(myMutex);
+    for(size_t anIter = 0; anIter < myClients.size(); ++anIter) {
+        if(myClients[anIter] == theClient) {
+            myClients.erase(myClients.begin() + anIter);
+            break;
+        }
+    }
+    updateLimits();
+}
+
+void StMemoryBudget::updateLimits() {
+    size_t aWeights = 0;
+    for(size_t anIter = 0; anIter < myClients.size(); ++anIter) {
+        aWeights += myClients[anIter]->getWeight();
+    }
+    if(aWeights == 0) {
+        return;
+    }
+
+    const size_t aShare = myLimit / aWeights;
+    for(size_t anIter = 0; anIter < myClients.size(); ++anIter) {
+        StMemoryClient* aClient = myClients[anIter];
+        size_t aLimit = aShare * aClient->getWeight();
+        if(myIsPressure) {
+            aLimit /= (aClient->getRole() == StMemoryClient::Role_Cache) ? 4 : 2;
+        }
+        aClient->myLimit = aLimit;
+    }
+}
@@ -46,6 +46,11 @@ void StMsgQueue::popAll() {
     }
 }
 
+bool StMsgQueue::isEmpty() {
+    StMutexAuto aLock(myMutex);
+    return myQueue.empty();
+}
+
 bool StMsgQueue::pop(StMsg& theMessage) {
     myMutex.lock();
     if(myQueue.empty()) {
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2013 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * Distributed under the Boost Software License, Version 1.0.
  * See accompanying file license-boost.txt or copy at
@@ -15,8 +15,10 @@
 #endif
 
 #include <StThreads/StMutex.h>
+#include <StThreads/StMutexProfiler.h>
 
-StMutex::StMutex() {
+StMutex::StMutex()
+: myStats(NULL) {
 #ifdef _WIN32
     myMutex = (void* )CreateMutex(NULL, false, NULL);
 #else
@@ -29,6 +31,10 @@ StMutex::StMutex() {
 }
 
 StMutex::~StMutex() {
+    if(myStats != NULL) {
+        StMutexProfiler::unregisterMutex(myStats);
+        myStats = NULL;
+    }
 #ifdef _WIN32
     if(lock()) {
         CloseHandle((HANDLE )myMutex);
@@ -38,7 +44,17 @@ StMutex::~StMutex() {
 #endif
 }
 
+void StMutex::setName(const char* theName) {
+    if(myStats == NULL
+    && StMutexProfiler::isEnabled()) {
+        myStats = StMutexProfiler::registerMutex(theName);
+    }
+}
+
 bool StMutex::lock() {
+    if(myStats != NULL) {
+        return lockProfiled();
+    }
 #ifdef _WIN32
     return (WaitForSingleObject((HANDLE )myMutex, INFINITE) != WAIT_FAILED);
 #else
@@ -46,15 +62,45 @@ bool StMutex::lock() {
 #endif
 }
 
+bool StMutex::lockProfiled() {
+    // try to obtain the lock without waiting to detect contention
+#ifdef _WIN32
+    bool isLocked = (WaitForSingleObject((HANDLE )myMutex, (DWORD )0) != WAIT_TIMEOUT);
+#else
+    bool isLocked = (pthread_mutex_trylock(&myMutex) == 0);
+#endif
+    double aWaitUs = -1.0;
+    if(!isLocked) {
+        const double aWaitFrom = StMutexProfiler::getTimeUs();
+    #ifdef _WIN32
+        isLocked = (WaitForSingleObject((HANDLE )myMutex, INFINITE) != WAIT_FAILED);
+    #else
+        isLocked = (pthread_mutex_lock(&myMutex) == 0);
+    #endif
+        aWaitUs = StMutexProfiler::getTimeUs() - aWaitFrom;
+    }
+    if(isLocked) {
+        myStats->onLocked(aWaitUs);
+    }
+    return isLocked;
+}
+
 bool StMutex::tryLock() {
 #ifdef _WIN32
-    return (WaitForSingleObject((HANDLE )myMutex, (DWORD )0) != WAIT_TIMEOUT);
+    const bool isLocked = (WaitForSingleObject((HANDLE )myMutex, (DWORD )0) != WAIT_TIMEOUT);
 #else
-    return (pthread_mutex_trylock(&myMutex) == 0);
+    const bool isLocked = (pthread_mutex_trylock(&myMutex) == 0);
 #endif
+    if(isLocked && myStats != NULL) {
+        myStats->onLocked(-1.0);
+    }
+    return isLocked;
 }
 
 bool StMutex::unlock() {
+    if(myStats != NULL) {
+        myStats->onUnlock();
+    }
 #ifdef _WIN32
     return (ReleaseMutex((HANDLE )myMutex) != 0);
 #else
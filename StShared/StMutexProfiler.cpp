@@ -0,0 +1,249 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+#include <StThreads/StMutexProfiler.h>
+
+#include <StStrings/StLogger.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StProcess.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+    /**
+     * Registry of statistics records.
+     */
+    struct StMutexRegistry {
+        StMutex                              Mutex;   //!< lock for the lists (not profiled)
+        std::vector<StMutexStats*>           Active;  //!< records of alive mutexes
+        std::vector<StMutexProfiler::Entry>  Retired; //!< accumulated records of destroyed mutexes
+    };
+
+    /**
+     * Registry is never destroyed, so that mutexes released at process exit
+     * (e.g. within other global objects) can safely unregister.
+     */
+    static StMutexRegistry& getRegistry() {
+        static StMutexRegistry* THE_REGISTRY = new StMutexRegistry();
+        return *THE_REGISTRY;
+    }
+
+    /**
+     * Find or append entry with specified name.
+     */
+    static StMutexProfiler::Entry& findEntry(std::vector<StMutexProfiler::Entry>& theEntries,
+                                             const char*                          theName) {
+        for(size_t anIter = 0; anIter < theEntries.size(); ++anIter) {
+            if(std::strcmp(theEntries[anIter].Name.toCString(), theName) == 0) {
+                return theEntries[anIter];
+            }
+        }
+
+        StMutexProfiler::Entry anEntry;
+        anEntry.Name        = theName;
+        anEntry.NbMutexes   = 0;
+        anEntry.NbLocks     = 0;
+        anEntry.NbContended = 0;
+        anEntry.WaitUs      = 0.0;
+        anEntry.WaitMaxUs   = 0.0;
+        anEntry.HoldUs      = 0.0;
+        anEntry.HoldMaxUs   = 0.0;
+        theEntries.push_back(anEntry);
+        return theEntries.back();
+    }
+
+    /**
+     * Accumulate mutex statistics into the entry.
+     */
+    static void addStats(StMutexProfiler::Entry& theEntry,
+                         const StMutexStats&     theStats) {
+        theEntry.NbLocks     += theStats.NbLocks;
+        theEntry.NbContended += theStats.NbContended;
+        theEntry.WaitUs      += theStats.WaitUs;
+        theEntry.WaitMaxUs    = stMax(theEntry.WaitMaxUs, theStats.WaitMaxUs);
+        theEntry.HoldUs      += theStats.HoldUs;
+        theEntry.HoldMaxUs    = stMax(theEntry.HoldMaxUs, theStats.HoldMaxUs);
+    }
+
+    /**
+     * Sort entries by total wait time.
+     */
+    static bool isWaitingLonger(const StMutexProfiler::Entry& theEntry1,
+                                const StMutexProfiler::Entry& theEntry2) {
+        return theEntry1.WaitUs > theEntry2.WaitUs;
+    }
+
+    /**
+     * Format milliseconds.
+     */
+    inline StString formatMs(const double theValueUs) {
+        char aBuff[64];
+        stsprintf(aBuff, sizeof(aBuff), "%.3f", theValueUs * 0.001);
+        return StString(aBuff);
+    }
+
+    /**
+     * Read profiling flag from environment.
+     */
+    static bool readEnabledFlag() {
+        const StString aValue = StProcess::getEnv("StMutexProfile");
+        return !aValue.isEmpty()
+            && !aValue.isEquals(stCString("0"));
+    }
+
+}
+
+void StMutexStats::onLocked(const double theWaitUs) {
+    if(Depth++ != 0) {
+        return; // recursive lock
+    }
+
+    ++NbLocks;
+    if(theWaitUs >= 0.0) {
+        ++NbContended;
+        WaitUs   += theWaitUs;
+        WaitMaxUs = stMax(WaitMaxUs, theWaitUs);
+    }
+    LockedAt = StMutexProfiler::getTimeUs();
+}
+
+void StMutexStats::onUnlock() {
+    if(--Depth != 0) {
+        return; // recursive unlock
+    }
+
+    const double aHoldUs = StMutexProfiler::getTimeUs() - LockedAt;
+    HoldUs   += aHoldUs;
+    HoldMaxUs = stMax(HoldMaxUs, aHoldUs);
+}
+
+bool StMutexProfiler::isEnabled() {
+    static const bool THE_IS_ENABLED = readEnabledFlag();
+    return THE_IS_ENABLED;
+}
+
+double StMutexProfiler::getTimeUs() {
+#ifdef _WIN32
+    static LARGE_INTEGER THE_FREQ = {};
+    if(THE_FREQ.QuadPart == 0) {
+        QueryPerformanceFrequency(&THE_FREQ);
+    }
+    LARGE_INTEGER aCounter;
+    QueryPerformanceCounter(&aCounter);
+    return double(aCounter.QuadPart) * 1000000.0 / double(THE_FREQ.QuadPart);
+#else
+    timespec aTime;
+    clock_gettime(CLOCK_MONOTONIC, &aTime);
+    return double(aTime.tv_sec) * 1000000.0 + double(aTime.tv_nsec) * 0.001;
+#endif
+}
+
+StMutexStats* StMutexProfiler::registerMutex(const char* theName) {
+    StMutexStats* aStats = new StMutexStats();
+    aStats->Name        = theName;
+    aStats->NbLocks     = 0;
+    aStats->NbContended = 0;
+    aStats->WaitUs      = 0.0;
+    aStats->WaitMaxUs   = 0.0;
+    aStats->HoldUs      = 0.0;
+    aStats->HoldMaxUs   = 0.0;
+    aStats->LockedAt    = 0.0;
+    aStats->Depth       = 0;
+
+    StMutexRegistry& aRegistry = getRegistry();
+    StMutexAuto aLock(aRegistry.Mutex);
+    aRegistry.Active.push_back(aStats);
+    return aStats;
+}
+
+void StMutexProfiler::unregisterMutex(StMutexStats* theStats) {
+    if(theStats == NULL) {
+        return;
+    }
+
+    StMutexRegistry& aRegistry = getRegistry();
+    StMutexAuto aLock(aRegistry.Mutex);
+    std::vector<StMutexStats*>::iterator anIter = std::find(aRegistry.Active.begin(), aRegistry.Active.end(), theStats);
+    if(anIter != aRegistry.Active.end()) {
+        aRegistry.Active.erase(anIter);
+    }
+
+    StMutexProfiler::Entry& anEntry = findEntry(aRegistry.Retired, theStats->Name);
+    addStats(anEntry, *theStats);
+    ++anEntry.NbMutexes;
+    delete theStats;
+}
+
+void StMutexProfiler::getEntries(std::vector<Entry>& theEntries) {
+    StMutexRegistry& aRegistry = getRegistry();
+    aRegistry.Mutex.lock();
+    theEntries = aRegistry.Retired;
+    for(size_t anIter = 0; anIter < aRegistry.Active.size(); ++anIter) {
+        const StMutexStats& aStats = *aRegistry.Active[anIter];
+        StMutexProfiler::Entry& anEntry = findEntry(theEntries, aStats.Name);
+        addStats(anEntry, aStats);
+        ++anEntry.NbMutexes;
+    }
+    aRegistry.Mutex.unlock();
+    std::stable_sort(theEntries.begin(), theEntries.end(), isWaitingLonger);
+}
+
+StString StMutexProfiler::toJson() {
+    std::vector<Entry> anEntries;
+    getEntries(anEntries);
+    StString aJson = "[";
+    for(size_t anIter = 0; anIter < anEntries.size(); ++anIter) {
+        const Entry& anEntry = anEntries[anIter];
+        aJson += StString(anIter == 0 ? "\n" : ",\n")
+               + "  {\"name\": \"" + anEntry.Name + "\""
+               + ", \"instances\": " + anEntry.NbMutexes
+               + ", \"locks\": " + anEntry.NbLocks
+               + ", \"contended\": " + anEntry.NbContended
+               + ", \"waitMs\": " + formatMs(anEntry.WaitUs)
+               + ", \"waitMaxMs\": " + formatMs(anEntry.WaitMaxUs)
+               + ", \"holdMs\": " + formatMs(anEntry.HoldUs)
+               + ", \"holdMaxMs\": " + formatMs(anEntry.HoldMaxUs) + "}";
+    }
+    aJson += anEntries.empty() ? "]" : "\n]";
+    return aJson;
+}
+
+StString StMutexProfiler::toText() {
+    std::vector<Entry> anEntries;
+    getEntries(anEntries);
+    StString aText = "Lock contention (sorted by total wait time):\n"
+                     "  name | instances | locks | contended | wait ms | max wait ms | hold ms | max hold ms";
+    for(size_t anIter = 0; anIter < anEntries.size(); ++anIter) {
+        const Entry& anEntry = anEntries[anIter];
+        aText += StString("\n  ") + anEntry.Name
+               + " | " + anEntry.NbMutexes
+               + " | " + anEntry.NbLocks
+               + " | " + anEntry.NbContended
+               + " | " + formatMs(anEntry.WaitUs)
+               + " | " + formatMs(anEntry.WaitMaxUs)
+               + " | " + formatMs(anEntry.HoldUs)
+               + " | " + formatMs(anEntry.HoldMaxUs);
+    }
+    return aText;
+}
+
+void StMutexProfiler::dump() {
+    if(!isEnabled()) {
+        return;
+    }
+
+    StLogger::GetDefault().write(toText(), StLogger::ST_INFO);
+}
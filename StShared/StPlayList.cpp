@@ -168,7 +168,7 @@ StPlayList::StPlayList(const int  theRecursionDeep,
   myRecentLimit(10),
   myIsNewRecent(false),
   myWasCleared(false) {
-    //
+    myMutex.setName("StPlayList::myMutex");
 }
 
 void StPlayList::setExtensions(const StArrayList<StString>& theExtensions) {
@@ -0,0 +1,259 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StThreads/StTaskPool.h>
+
+#include <StThreads/StMutexSlim.h>
+
+#include <deque>
+
+#if defined(_MSC_VER)
+    #define ST_THREAD_LOCAL __declspec(thread)
+#else
+    #define ST_THREAD_LOCAL __thread
+#endif
+
+/**
+ * Worker thread with its task queues.
+ */
+struct StTaskPool::Worker {
+
+    StTaskPool*                    Pool;                  //!< owner
+    int                            Index;                 //!< worker index, -1 for shared queue
+    StMutexSlim                    Lock;                  //!< queues lock
+    std::deque< StHandle<StTask> > Queues[Priority_NB];   //!< queues per priority
+    StHandle<StThread>             Thread;                //!< worker thread
+
+    Worker(StTaskPool* thePool,
+           const int   theIndex)
+    : Pool(thePool),
+      Index(theIndex) {}
+
+    /**
+     * Push the task to the end of queue.
+     */
+    void push(const StHandle<StTask>& theTask,
+              const Priority          thePriority) {
+        Lock.lock();
+        Queues[thePriority].push_back(theTask);
+        Lock.unlock();
+    }
+
+    /**
+     * Take the task from the queue.
+     * @param theToPopBack take the newest task (owner) or the oldest one (thief)
+     */
+    bool pop(StHandle<StTask>& theTask,
+             const Priority    thePriority,
+             const bool        theToPopBack) {
+        Lock.lock();
+        std::deque< StHandle<StTask> >& aQueue = Queues[thePriority];
+        if(aQueue.empty()) {
+            Lock.unlock();
+            return false;
+        }
+        if(theToPopBack) {
+            theTask = aQueue.back();
+            aQueue.pop_back();
+        } else {
+            theTask = aQueue.front();
+            aQueue.pop_front();
+        }
+        Lock.unlock();
+        return true;
+    }
+
+};
+
+namespace {
+
+    /**
+     * Worker of the current thread.
+     */
+    static ST_THREAD_LOCAL StTaskPool::Worker* THE_THREAD_WORKER = NULL;
+
+}
+
+StTask::StTask()
+: myIsFinished(false),
+  myState(State_Pending),
+  myToCancel(0) {
+    //
+}
+
+StTask::~StTask() {
+    //
+}
+
+bool StTask::cancel() {
+    StAtomicOp::CompareAndSwap(myToCancel, 0, 1);
+    if(!StAtomicOp::CompareAndSwap(myState, State_Pending, State_Cancelled)) {
+        return false;
+    }
+
+    myIsFinished.set();
+    return true;
+}
+
+bool StTask::execute() {
+    if(!StAtomicOp::CompareAndSwap(myState, State_Pending, State_Running)) {
+        return false;
+    }
+
+    run();
+    StAtomicOp::CompareAndSwap(myState, State_Running, State_Done);
+    myIsFinished.set();
+    return true;
+}
+
+void StTask::wait() {
+    execute();
+    // the event is checked under its lock, so that results of the task become visible
+    do {
+        myIsFinished.wait();
+    } while(!myIsFinished.check());
+}
+
+bool StTask::wait(const size_t theTimeMilliseconds) {
+    return myIsFinished.wait(theTimeMilliseconds)
+        && myIsFinished.check();
+}
+
+StTaskPool& StTaskPool::GetDefault() {
+    static StTaskPool THE_DEFAULT_POOL(stMax(StThread::countLogicalProcessors() - 1, 1));
+    return THE_DEFAULT_POOL;
+}
+
+StTaskPool::StTaskPool(const int theNbThreads)
+: myShared(new Worker(this, -1)),
+  myWakeUp(false),
+  myNbQueued(0),
+  myNbIdle(0),
+  myToStop(false) {
+    myIdleLock.setName("StTaskPool::myIdleLock");
+    const int aNbThreads = stMax(theNbThreads, 0);
+    myWorkers.reserve(aNbThreads);
+    for(int aWorkerIter = 0; aWorkerIter < aNbThreads; ++aWorkerIter) {
+        myWorkers.push_back(new Worker(this, aWorkerIter));
+    }
+    for(int aWorkerIter = 0; aWorkerIter < aNbThreads; ++aWorkerIter) {
+        myWorkers[aWorkerIter]->Thread = new StThread(workerThread, myWorkers[aWorkerIter], "StTaskPool");
+    }
+}
+
+StTaskPool::~StTaskPool() {
+    myIdleLock.lock();
+    myToStop = true;
+    myWakeUp.set();
+    myIdleLock.unlock();
+    for(size_t aWorkerIter = 0; aWorkerIter < myWorkers.size(); ++aWorkerIter) {
+        myWorkers[aWorkerIter]->Thread->wait();
+    }
+
+    // cancel remaining tasks to release waiting threads
+    for(StHandle<StTask> aTask = takeTask(-1); !aTask.isNull(); aTask = takeTask(-1)) {
+        aTask->cancel();
+    }
+    for(size_t aWorkerIter = 0; aWorkerIter < myWorkers.size(); ++aWorkerIter) {
+        delete myWorkers[aWorkerIter];
+    }
+    delete myShared;
+}
+
+void StTaskPool::submit(const StHandle<StTask>& theTask,
+                        const Priority          thePriority) {
+    if(theTask.isNull()) {
+        return;
+    }
+
+    Worker* aWorker = THE_THREAD_WORKER;
+    if(aWorker == NULL
+    || aWorker->Pool != this) {
+        aWorker = myShared;
+    }
+    aWorker->push(theTask, thePriority);
+    StAtomicOp::Increment(myNbQueued);
+    if(myNbIdle > 0) {
+        myIdleLock.lock();
+        myWakeUp.set();
+        myIdleLock.unlock();
+    }
+}
+
+StHandle<StTask> StTaskPool::takeTask(const int theWorker) {
+    StHandle<StTask> aTask;
+    const int aNbWorkers = (int )myWorkers.size();
+    for(int aPriority = 0; aPriority < Priority_NB; ++aPriority) {
+        const Priority aPrior = (Priority )aPriority;
+        if(theWorker >= 0
+        && myWorkers[theWorker]->pop(aTask, aPrior, true)) {
+            break;
+        }
+        if(myShared->pop(aTask, aPrior, false)) {
+            break;
+        }
+        for(int aVictimIter = 1; aVictimIter <= aNbWorkers; ++aVictimIter) {
+            const int aVictim = (stMax(theWorker, 0) + aVictimIter) % aNbWorkers;
+            if(aVictim != theWorker
+            && myWorkers[aVictim]->pop(aTask, aPrior, false)) {
+                break;
+            }
+        }
+        if(!aTask.isNull()) {
+            break;
+        }
+    }
+
+    if(!aTask.isNull()) {
+        StAtomicOp::Decrement(myNbQueued);
+    }
+    return aTask;
+}
+
+bool StTaskPool::executeOne() {
+    const int aWorker = (THE_THREAD_WORKER != NULL && THE_THREAD_WORKER->Pool == this)
+                      ? THE_THREAD_WORKER->Index
+                      : -1;
+    for(StHandle<StTask> aTask = takeTask(aWorker); !aTask.isNull(); aTask = takeTask(aWorker)) {
+        if(aTask->execute()) {
+            return true;
+        }
+        // skip cancelled tasks
+    }
+    return false;
+}
+
+void StTaskPool::waitTasks() {
+    // the idle counter is incremented before checking the queue,
+    // while submit() increments the queue counter before checking idle counter,
+    // so that at least one side observes another
+    myIdleLock.lock();
+    StAtomicOp::Increment(myNbIdle);
+    myWakeUp.reset();
+    if(StAtomicOp::Add(myNbQueued, 0) == 0
+    && !myToStop) {
+        myIdleLock.unlock();
+        myWakeUp.wait();
+        myIdleLock.lock();
+    }
+    StAtomicOp::Decrement(myNbIdle);
+    myIdleLock.unlock();
+}
+
+SV_THREAD_FUNCTION StTaskPool::workerThread(void* theWorker) {
+    Worker* aWorker = (Worker* )theWorker;
+    StTaskPool* aPool = aWorker->Pool;
+    THE_THREAD_WORKER = aWorker;
+    while(!aPool->myToStop) {
+        if(!aPool->executeOne()) {
+            aPool->waitTasks();
+        }
+    }
+    THE_THREAD_WORKER = NULL;
+    return SV_THREAD_RETURN 0;
+}
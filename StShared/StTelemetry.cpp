@@ -0,0 +1,218 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StThreads/StTelemetry.h>
+
+#include <StThreads/StMutexProfiler.h>
+
+namespace {
+
+    /**
+     * Upper limit of the first bucket in seconds.
+     */
+    static const double THE_FIRST_LIMIT = 0.000125;
+
+    /**
+     * Find metric by name.
+     */
+    template<typename Type>
+    inline Type* findMetric(std::vector< StHandle<Type> >& theList,
+                            const StString&                theName) {
+        for(size_t anIter = 0; anIter < theList.size(); ++anIter) {
+            if(theList[anIter]->getName() == theName) {
+                return theList[anIter].access();
+            }
+        }
+        return NULL;
+    }
+
+    /**
+     * Format duration in milliseconds.
+     */
+    inline StString formatMs(const double theValue) {
+        char aBuff[64];
+        stsprintf(aBuff, sizeof(aBuff), "%.3f", theValue);
+        return StString(aBuff);
+    }
+
+}
+
+void StTelemetryHistogram::addSeconds(const double theSeconds) {
+    int    aBucket = 0;
+    double aLimit  = THE_FIRST_LIMIT;
+    for(; aBucket < BucketsNb - 1 && theSeconds > aLimit; ++aBucket) {
+        aLimit *= 2.0;
+    }
+    StAtomicOp::Increment(myBuckets[aBucket]);
+}
+
+void StTelemetryHistogram::getCounts(int32_t* theCounts) const {
+    for(int aBucket = 0; aBucket < BucketsNb; ++aBucket) {
+        theCounts[aBucket] = myBuckets[aBucket];
+    }
+}
+
+double StTelemetryHistogram::getBucketLimitMs(const int theBucket) {
+    return THE_FIRST_LIMIT * 1000.0 * double(1 << stMin(theBucket, int(BucketsNb - 1)));
+}
+
+double StTelemetryHistogram::getPercentileMs(const int32_t* theCounts,
+                                             const double   theRatio) {
+    int64_t aTotal = 0;
+    for(int aBucket = 0; aBucket < BucketsNb; ++aBucket) {
+        aTotal += theCounts[aBucket];
+    }
+    if(aTotal <= 0) {
+        return 0.0;
+    }
+
+    // interpolate linearly within the bucket holding requested rank
+    const double aRank = stMin(stMax(theRatio, 0.0), 1.0) * double(aTotal);
+    int64_t aCumul = 0;
+    for(int aBucket = 0; aBucket < BucketsNb; ++aBucket) {
+        const int32_t aCount = theCounts[aBucket];
+        if(aCount <= 0) {
+            continue;
+        } else if(double(aCumul + aCount) < aRank
+               && aBucket != BucketsNb - 1) {
+            aCumul += aCount;
+            continue;
+        }
+
+        const double aLower = aBucket == 0 ? 0.0 : getBucketLimitMs(aBucket - 1);
+        const double anUpper = getBucketLimitMs(aBucket);
+        return aLower + (anUpper - aLower) * stMin((aRank - double(aCumul)) / double(aCount), 1.0);
+    }
+    return getBucketLimitMs(BucketsNb - 1);
+}
+
+StTelemetry& StTelemetry::GetDefault() {
+    // global instance
+    static StTelemetry THE_DEFAULT_TELEMETRY;
+    return THE_DEFAULT_TELEMETRY;
+}
+
+StTelemetryCounter* StTelemetry::getCounter(const StString& theName) {
+    StMutexAuto aLock(myMutex);
+    StTelemetryCounter* aMetric = findMetric(myCounters, theName);
+    if(aMetric == NULL) {
+        myCounters.push_back(new StTelemetryCounter(theName));
+        aMetric = myCounters.back().access();
+    }
+    return aMetric;
+}
+
+StTelemetryGauge* StTelemetry::getGauge(const StString& theName) {
+    StMutexAuto aLock(myMutex);
+    StTelemetryGauge* aMetric = findMetric(myGauges, theName);
+    if(aMetric == NULL) {
+        myGauges.push_back(new StTelemetryGauge(theName));
+        aMetric = myGauges.back().access();
+    }
+    return aMetric;
+}
+
+StTelemetryHistogram* StTelemetry::getHistogram(const StString& theName) {
+    StMutexAuto aLock(myMutex);
+    StTelemetryHistogram* aMetric = findMetric(myHistograms, theName);
+    if(aMetric == NULL) {
+        myHistograms.push_back(new StTelemetryHistogram(theName));
+        aMetric = myHistograms.back().access();
+    }
+    return aMetric;
+}
+
+StString StTelemetry::toJson() {
+    StMutexAuto aLock(myMutex);
+    StString aJson = "{\n\"counters\": {";
+    for(size_t anIter = 0; anIter < myCounters.size(); ++anIter) {
+        const StTelemetryCounter& aMetric = *myCounters[anIter];
+        aJson += StString(anIter == 0 ? "\n" : ",\n")
+               + "  \"" + aMetric.getName() + "\": " + aMetric.getValue();
+    }
+    aJson += "\n},\n\"gauges\": {";
+    for(size_t anIter = 0; anIter < myGauges.size(); ++anIter) {
+        const StTelemetryGauge& aMetric = *myGauges[anIter];
+        aJson += StString(anIter == 0 ? "\n" : ",\n")
+               + "  \"" + aMetric.getName() + "\": " + aMetric.getValue();
+    }
+    aJson += "\n},\n\"histograms\": {";
+    int32_t aCounts[StTelemetryHistogram::BucketsNb];
+    for(size_t anIter = 0; anIter < myHistograms.size(); ++anIter) {
+        const StTelemetryHistogram& aMetric = *myHistograms[anIter];
+        aMetric.getCounts(aCounts);
+        int64_t aTotal = 0;
+        StString aBuckets;
+        for(int aBucket = 0; aBucket < StTelemetryHistogram::BucketsNb; ++aBucket) {
+            aTotal   += aCounts[aBucket];
+            aBuckets += StString(aBucket == 0 ? "" : ", ") + aCounts[aBucket];
+        }
+        aJson += StString(anIter == 0 ? "\n" : ",\n")
+               + "  \"" + aMetric.getName() + "\": {"
+               + "\"count\": " + StString(size_t(aTotal))
+               + ", \"p50\": " + formatMs(StTelemetryHistogram::getPercentileMs(aCounts, 0.50))
+               + ", \"p95\": " + formatMs(StTelemetryHistogram::getPercentileMs(aCounts, 0.95))
+               + ", \"p99\": " + formatMs(StTelemetryHistogram::getPercentileMs(aCounts, 0.99))
+               + ", \"buckets\": [" + aBuckets + "]}";
+    }
+    aJson += "\n},\n\"bucketLimitsMs\": [";
+    for(int aBucket = 0; aBucket < StTelemetryHistogram::BucketsNb - 1; ++aBucket) {
+        aJson += StString(aBucket == 0 ? "" : ", ") + formatMs(StTelemetryHistogram::getBucketLimitMs(aBucket));
+    }
+    aJson += "]";
+    if(StMutexProfiler::isEnabled()) {
+        aJson += ",\n\"locks\": " + StMutexProfiler::toJson();
+    }
+    aJson += "\n}\n";
+    return aJson;
+}
+
+StString StTelemetry::toText(std::vector<int32_t>& thePrevCounts) {
+    StMutexAuto aLock(myMutex);
+    StString aText;
+    for(size_t anIter = 0; anIter < myHistograms.size(); ++anIter) {
+        const StTelemetryHistogram& aMetric = *myHistograms[anIter];
+        int32_t aCounts[StTelemetryHistogram::BucketsNb];
+        int32_t aDelta [StTelemetryHistogram::BucketsNb];
+        aMetric.getCounts(aCounts);
+        const size_t anOffset = anIter * StTelemetryHistogram::BucketsNb;
+        if(thePrevCounts.size() < anOffset + StTelemetryHistogram::BucketsNb) {
+            thePrevCounts.resize(anOffset + StTelemetryHistogram::BucketsNb, 0);
+        }
+
+        int32_t aTotal = 0;
+        for(int aBucket = 0; aBucket < StTelemetryHistogram::BucketsNb; ++aBucket) {
+            aDelta[aBucket] = aCounts[aBucket] - thePrevCounts[anOffset + aBucket];
+            thePrevCounts[anOffset + aBucket] = aCounts[aBucket];
+            aTotal += aDelta[aBucket];
+        }
+        if(aTotal <= 0) {
+            continue;
+        }
+
+        if(!aText.isEmpty()) {
+            aText += "\n";
+        }
+        aText += aMetric.getName() + ": "
+               + formatMs(StTelemetryHistogram::getPercentileMs(aDelta, 0.50)) + " / "
+               + formatMs(StTelemetryHistogram::getPercentileMs(aDelta, 0.95)) + " ms (" + aTotal + ")";
+    }
+    for(size_t anIter = 0; anIter < myGauges.size(); ++anIter) {
+        if(!aText.isEmpty()) {
+            aText += "\n";
+        }
+        aText += myGauges[anIter]->getName() + ": " + myGauges[anIter]->getValue();
+    }
+    for(size_t anIter = 0; anIter < myCounters.size(); ++anIter) {
+        if(!aText.isEmpty()) {
+            aText += "\n";
+        }
+        aText += myCounters[anIter]->getName() + ": " + myCounters[anIter]->getValue();
+    }
+    return aText;
+}
@@ -0,0 +1,239 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#include <StThreads/StTracer.h>
+
+#include <StThreads/StMutexSlim.h>
+#include <StThreads/StThread.h>
+#include <StStrings/StLogger.h>
+
+#include <cstdio>
+
+#if defined(_MSC_VER)
+    #define ST_THREAD_LOCAL __declspec(thread)
+#else
+    #define ST_THREAD_LOCAL __thread
+#endif
+
+namespace {
+
+    /**
+     * Number of events kept per thread (should be power of 2).
+     */
+    static const size_t THE_BUFFER_SIZE = 65536;
+
+}
+
+/**
+ * Ring buffer of events recorded by single thread.
+ */
+class StTraceBuffer {
+
+        public:
+
+    struct Event {
+        const char* Name;     //!< event name
+        double      Begin;    //!< start time in microseconds
+        double      Duration; //!< duration in microseconds, negative for instant events
+    };
+
+        public:
+
+    StTraceBuffer()
+    : myThreadId(StThread::getCurrentThreadId()),
+      myEvents(THE_BUFFER_SIZE),
+      myCount(0) {
+    #if defined(__APPLE__) || (defined(__linux__) && !defined(__ANDROID__))
+        char aName[64] = {};
+        if(pthread_getname_np(pthread_self(), aName, sizeof(aName)) == 0) {
+            myThreadName = aName;
+        }
+    #endif
+    }
+
+    size_t getThreadId() const {
+        return myThreadId;
+    }
+
+    const StString& getThreadName() const {
+        return myThreadName;
+    }
+
+    /**
+     * Append the event, overriding the oldest one when buffer is full.
+     * Only the owner thread can call this method.
+     */
+    void add(const char*  theName,
+             const double theBegin,
+             const double theDuration) {
+        myLock.lock();
+        Event& anEvent = myEvents[myCount & (THE_BUFFER_SIZE - 1)];
+        anEvent.Name     = theName;
+        anEvent.Begin    = theBegin;
+        anEvent.Duration = theDuration;
+        ++myCount;
+        myLock.unlock();
+    }
+
+    /**
+     * Copy recorded events in chronological order of their completion.
+     */
+    void getEvents(std::vector<Event>& theEvents) {
+        theEvents.clear();
+        myLock.lock();
+        const size_t aNbEvents = stMin(myCount, THE_BUFFER_SIZE);
+        theEvents.reserve(aNbEvents);
+        for(size_t anIter = myCount - aNbEvents; anIter < myCount; ++anIter) {
+            theEvents.push_back(myEvents[anIter & (THE_BUFFER_SIZE - 1)]);
+        }
+        myLock.unlock();
+    }
+
+        private:
+
+    StMutexSlim        myLock;       //!< lock, only contended while exporting events
+    size_t             myThreadId;   //!< thread id
+    StString           myThreadName; //!< thread name
+    std::vector<Event> myEvents;     //!< ring buffer
+    size_t             myCount;      //!< number of recorded events
+
+};
+
+namespace {
+
+    /**
+     * Buffer of the current thread.
+     */
+    static ST_THREAD_LOCAL StTraceBuffer* THE_THREAD_BUFFER = NULL;
+
+    /**
+     * Append JSON-escaped string.
+     */
+    inline void appendEscaped(std::string& theJson,
+                              const char*  theText) {
+        for(const char* aChar = theText; *aChar != '\0'; ++aChar) {
+            if(*aChar == '"' || *aChar == '\\') {
+                theJson += '\\';
+            } else if((unsigned char )*aChar < 0x20) {
+                continue;
+            }
+            theJson += *aChar;
+        }
+    }
+
+}
+
+StTracer& StTracer::GetDefault() {
+    // global instance
+    static StTracer THE_DEFAULT_TRACER;
+    return THE_DEFAULT_TRACER;
+}
+
+StTracer::StTracer()
+: myTimer(true),
+  myIsEnabled(false) {
+    //
+}
+
+void StTracer::setEnabled(const bool theToEnable) {
+    myIsEnabled = theToEnable;
+}
+
+StString StTracer::getFilePath() {
+    StMutexAuto aLock(myMutex);
+    return myFilePath;
+}
+
+void StTracer::setFilePath(const StString& thePath) {
+    StMutexAuto aLock(myMutex);
+    myFilePath = thePath;
+}
+
+StTraceBuffer* StTracer::getThreadBuffer() {
+    if(THE_THREAD_BUFFER == NULL) {
+        // buffers are never released, so that events of finished threads are kept
+        StMutexAuto aLock(myMutex);
+        myBuffers.push_back(new StTraceBuffer());
+        THE_THREAD_BUFFER = myBuffers.back().access();
+    }
+    return THE_THREAD_BUFFER;
+}
+
+void StTracer::addSpan(const char*  theName,
+                       const double theBegin) {
+    const double anEnd = getTimeUs();
+    getThreadBuffer()->add(theName, theBegin, anEnd - theBegin);
+}
+
+void StTracer::addInstant(const char* theName) {
+    getThreadBuffer()->add(theName, getTimeUs(), -1.0);
+}
+
+void StTracer::toJson(std::string& theJson) {
+    theJson = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    std::vector< StHandle<StTraceBuffer> > aBuffers;
+    myMutex.lock();
+    aBuffers = myBuffers;
+    myMutex.unlock();
+
+    char aBuff[256];
+    bool isFirst = true;
+    std::vector<StTraceBuffer::Event> anEvents;
+    for(size_t aBufIter = 0; aBufIter < aBuffers.size(); ++aBufIter) {
+        StTraceBuffer& aBuffer = *aBuffers[aBufIter];
+        const unsigned long aThreadId = (unsigned long )aBuffer.getThreadId();
+        if(!aBuffer.getThreadName().isEmpty()) {
+            stsprintf(aBuff, sizeof(aBuff), "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,\"args\":{\"name\":\"",
+                      isFirst ? "" : ",", aThreadId);
+            theJson += aBuff;
+            appendEscaped(theJson, aBuffer.getThreadName().toCString());
+            theJson += "\"}}";
+            isFirst = false;
+        }
+
+        aBuffer.getEvents(anEvents);
+        for(size_t anIter = 0; anIter < anEvents.size(); ++anIter) {
+            const StTraceBuffer::Event& anEvent = anEvents[anIter];
+            theJson += isFirst ? "\n{\"name\":\"" : ",\n{\"name\":\"";
+            appendEscaped(theJson, anEvent.Name);
+            if(anEvent.Duration >= 0.0) {
+                stsprintf(aBuff, sizeof(aBuff), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f}",
+                          aThreadId, anEvent.Begin, anEvent.Duration);
+            } else {
+                stsprintf(aBuff, sizeof(aBuff), "\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f}",
+                          aThreadId, anEvent.Begin);
+            }
+            theJson += aBuff;
+            isFirst = false;
+        }
+    }
+    theJson += "\n]}\n";
+}
+
+bool StTracer::save(const StString& thePath) {
+    const StString aPath = !thePath.isEmpty() ? thePath : getFilePath();
+    if(aPath.isEmpty()) {
+        return false;
+    }
+
+    std::string aJson;
+    toJson(aJson);
+#ifdef _WIN32
+    FILE* aFile = _wfopen(aPath.toUtfWide().toCString(), L"wb");
+#else
+    FILE* aFile =   fopen(aPath.toCString(), "wb");
+#endif
+    if(aFile == NULL) {
+        ST_ERROR_LOG("StTracer, unable to open file '" + aPath + "' for writing");
+        return false;
+    }
+
+    const bool isWritten = fwrite(aJson.c_str(), 1, aJson.size(), aFile) == aJson.size();
+    fclose(aFile);
+    return isWritten;
+}
@@ -19,6 +19,7 @@
 #ifndef __StTest_h_
 #define __StTest_h_
 
+#include <StStrings/stConsole.h>
 #include <StThreads/StTimer.h>
 
 /**
@@ -28,13 +29,37 @@ class ST_LOCAL StTest {
 
         public:
 
+    StTest() : myNbFailed(0) {}
+
     virtual void perform() = 0;
 
     virtual ~StTest() {}
 
+    /**
+     * @return true if all checks have been passed
+     */
+    bool isPassed() const { return myNbFailed == 0; }
+
+        protected:
+
+    /**
+     * Print check result and count failures.
+     */
+    void check(const char* theName,
+               const bool  theResult) {
+        if(theResult) {
+            st::cout << stostream_text("  ") << theName << stostream_text(":\tOK\n");
+        } else {
+            ++myNbFailed;
+            st::cout << st::COLOR_FOR_RED << stostream_text("  ") << theName
+                     << stostream_text(":\tFAILED\n") << st::COLOR_FOR_WHITE;
+        }
+    }
+
         protected:
 
     StTimer myTimer;
+    size_t  myNbFailed; //!< number of failed checks
 
 };
 
@@ -0,0 +1,168 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestBase64.h"
+
+#include <StStrings/StBase64.h>
+#include <StStrings/stConsole.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+    static const char THE_BASE64_STD[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static const char THE_BASE64_URL[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+    /**
+     * Reference encoder.
+     */
+    static std::string encodeBase64(const std::vector<stUByte_t>& theData,
+                                    const char*                   theAlphabet,
+                                    const bool                    theToPad) {
+        std::string aStr;
+        aStr.reserve((theData.size() + 2) / 3 * 4);
+        size_t aByte = 0;
+        for(; aByte + 3 <= theData.size(); aByte += 3) {
+            const uint32_t aBits = (uint32_t(theData[aByte]) << 16) | (uint32_t(theData[aByte + 1]) << 8) | theData[aByte + 2];
+            aStr += theAlphabet[(aBits >> 18) & 0x3F];
+            aStr += theAlphabet[(aBits >> 12) & 0x3F];
+            aStr += theAlphabet[(aBits >>  6) & 0x3F];
+            aStr += theAlphabet[ aBits        & 0x3F];
+        }
+
+        const size_t aRest = theData.size() - aByte;
+        if(aRest != 0) {
+            uint32_t aBits = uint32_t(theData[aByte]) << 16;
+            if(aRest == 2) {
+                aBits |= uint32_t(theData[aByte + 1]) << 8;
+            }
+            aStr += theAlphabet[(aBits >> 18) & 0x3F];
+            aStr += theAlphabet[(aBits >> 12) & 0x3F];
+            if(aRest == 2) {
+                aStr += theAlphabet[(aBits >> 6) & 0x3F];
+            }
+            if(theToPad) {
+                aStr += aRest == 1 ? "==" : "=";
+            }
+        }
+        return aStr;
+    }
+
+    /**
+     * Fill the buffer with deterministic pseudo-random bytes.
+     */
+    static void fillRandom(std::vector<stUByte_t>& theData,
+                           uint32_t                theSeed) {
+        for(size_t aByte = 0; aByte < theData.size(); ++aByte) {
+            theSeed = theSeed * 1664525u + 1013904223u;
+            theData[aByte] = stUByte_t(theSeed >> 24);
+        }
+    }
+
+    /**
+     * Decode the stream and compare with reference data.
+     */
+    static bool isDecoded(const std::string&            theStr,
+                          const std::vector<stUByte_t>& theRef,
+                          const StBase64::Impl          theImpl,
+                          const bool                    theIsParallel) {
+        if(StBase64::getDecodedSize(theStr.c_str(), theStr.size()) != theRef.size()) {
+            return false;
+        }
+
+        // guard byte to detect writes out of range
+        std::vector<stUByte_t> aData(theRef.size() + 1, 0xA5);
+        size_t anErrorPos = 0;
+        const bool isOk = theIsParallel
+                        ? StBase64::decodeParallel(&aData.front(), theStr.c_str(), theStr.size(), anErrorPos)
+                        : StBase64::decode        (&aData.front(), theStr.c_str(), theStr.size(), anErrorPos, theImpl);
+        return isOk
+            && aData.back() == 0xA5
+            && (theRef.empty() || std::memcmp(&aData.front(), &theRef.front(), theRef.size()) == 0);
+    }
+
+    /**
+     * Decode the stream with invalid character and check reported position.
+     */
+    static bool isErrorFound(const std::string&   theStr,
+                             const size_t         thePos,
+                             const StBase64::Impl theImpl,
+                             const bool           theIsParallel) {
+        std::vector<stUByte_t> aData(StBase64::getDecodedSize(theStr.c_str(), theStr.size()) + 1);
+        size_t anErrorPos = 0;
+        const bool isOk = theIsParallel
+                        ? StBase64::decodeParallel(&aData.front(), theStr.c_str(), theStr.size(), anErrorPos)
+                        : StBase64::decode        (&aData.front(), theStr.c_str(), theStr.size(), anErrorPos, theImpl);
+        return !isOk && anErrorPos == thePos;
+    }
+
+}
+
+void StTestBase64::perform() {
+    st::cout << stostream_text("Base64 tests (") << StBase64::getSimdName() << stostream_text(").\n");
+    myNbFailed = 0;
+
+    // all lengths around SIMD block sizes, with and without padding, both alphabets
+    {
+        bool isStdOk = true, isUrlOk = true, isNoPadOk = true, isScalarOk = true;
+        for(size_t aLen = 0; aLen < 400; ++aLen) {
+            std::vector<stUByte_t> aData(aLen);
+            fillRandom(aData, uint32_t(aLen));
+            isStdOk    = isStdOk    && isDecoded(encodeBase64(aData, THE_BASE64_STD, true),  aData, StBase64::Impl_Auto,   false);
+            isUrlOk    = isUrlOk    && isDecoded(encodeBase64(aData, THE_BASE64_URL, true),  aData, StBase64::Impl_Auto,   false);
+            isNoPadOk  = isNoPadOk  && isDecoded(encodeBase64(aData, THE_BASE64_STD, false), aData, StBase64::Impl_Auto,   false);
+            isScalarOk = isScalarOk && isDecoded(encodeBase64(aData, THE_BASE64_STD, true),  aData, StBase64::Impl_Scalar, false);
+        }
+        check("decode.standard", isStdOk);
+        check("decode.urlSafe",  isUrlOk);
+        check("decode.noPadding", isNoPadOk);
+        check("decode.scalar",   isScalarOk);
+    }
+
+    // invalid characters at every position of SIMD blocks
+    {
+        std::vector<stUByte_t> aData(300);
+        fillRandom(aData, 1);
+        const std::string aStr = encodeBase64(aData, THE_BASE64_STD, true);
+        const char THE_INVALID[] = { '*', ' ', '\n', '=', char(0x80), char(0xFF) };
+        bool isOk = true;
+        for(size_t aPos = 0; aPos < aStr.size() - 2; ++aPos) {
+            std::string aBroken = aStr;
+            aBroken[aPos] = THE_INVALID[aPos % sizeof(THE_INVALID)];
+            isOk = isOk && isErrorFound(aBroken, aPos, StBase64::Impl_Auto, false)
+                        && isErrorFound(aBroken, aPos, StBase64::Impl_Scalar, false);
+        }
+        check("error.position", isOk);
+        check("error.length", isErrorFound("QUJDR", 4, StBase64::Impl_Auto, false)
+                           && isErrorFound("QQ=A",  2, StBase64::Impl_Auto, false));
+    }
+
+    // parallel decoding of stream split into several chunks
+    {
+        std::vector<stUByte_t> aData(6 * 1024 * 1024 + 2);
+        fillRandom(aData, 7);
+        std::string aStr = encodeBase64(aData, THE_BASE64_STD, true);
+        check("parallel.decode", isDecoded(aStr, aData, StBase64::Impl_Auto, true));
+
+        const size_t aPos = aStr.size() / 2 + 3;
+        aStr[aPos] = '!';
+        check("parallel.error", isErrorFound(aStr, aPos, StBase64::Impl_Auto, true));
+    }
+}
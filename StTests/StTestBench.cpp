@@ -0,0 +1,826 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestBench.h"
+
+#include <StAV/StAVImage.h>
+#include <StFile/StFolder.h>
+#include <StFile/StMIME.h>
+#include <StFile/StRawFile.h>
+#include <StGL/StGLTextFormatter.h>
+#include <StGL/StPlayList.h>
+#include <StGLCore/StGLCore20.h>
+#include <StGLMesh/StBndBox.h>
+#include <StGLMesh/StGLMesh.h>
+#include <StGLStereo/StGLTextureData.h>
+#include <StImage/StJpegParser.h>
+#include <StStrings/StBase64.h>
+#include <StStrings/stConsole.h>
+#include <StThreads/StProcess.h>
+#include <StThreads/StTaskPool.h>
+
+#include "../StMoviePlayer/StVideo/StAVPacketQueue.h"
+#include "../StMoviePlayer/StVideo/StPCMBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    static const size_t THE_NB_WARMUP  = 3;    //!< iterations before measurements
+    static const size_t THE_NB_REPS    = 25;   //!< minimal number of measured iterations
+    static const size_t THE_NB_REPSMAX = 1000; //!< maximal number of measured iterations
+    static const double THE_TIME_MIN   = 0.25; //!< minimal measuring time per case in seconds
+
+    static const size_t THE_FRAME_SIZEX = 1920;
+    static const size_t THE_FRAME_SIZEY = 1080;
+
+    /**
+     * Fill the plane with deterministic pattern.
+     */
+    static void fillPattern(StImagePlane& thePlane) {
+        for(size_t aRow = 0; aRow < thePlane.getSizeY(); ++aRow) {
+            uint8_t* aData = thePlane.changeData(aRow, 0);
+            for(size_t aByte = 0; aByte < thePlane.getSizeRowBytes(); ++aByte) {
+                aData[aByte] = uint8_t(aRow * 7 + aByte * 3);
+            }
+        }
+    }
+
+    /**
+     * Initialize RGB frame.
+     */
+    static bool initFrameRGB(StImage&     theImage,
+                             const size_t theSizeX,
+                             const size_t theSizeY) {
+        theImage.setColorModel(StImage::ImgColor_RGB);
+        if(!theImage.changePlane(0).initTrash(StImagePlane::ImgRGB, theSizeX, theSizeY)) {
+            return false;
+        }
+        fillPattern(theImage.changePlane(0));
+        return true;
+    }
+
+    /**
+     * Format number for JSON.
+     */
+    inline StString formatNumber(const double theValue) {
+        char aBuff[64];
+        stsprintf(aBuff, sizeof(aBuff), "%.4f", theValue);
+        return StString(aBuff);
+    }
+
+    /**
+     * Packet queue without stream.
+     */
+    class StBenchPacketQueue : public StAVPacketQueue {
+
+            public:
+
+        StBenchPacketQueue() : StAVPacketQueue(1024) {}
+
+        virtual AVMediaType getCodecType() const ST_ATTR_OVERRIDE { return AVMEDIA_TYPE_VIDEO; }
+
+    };
+
+    /**
+     * StAVPacketQueue push/pop of the sequence of 4 KiB packets.
+     */
+    class StBenchPacketQueueCase : public StTestBench::Case {
+
+            public:
+
+        StBenchPacketQueueCase() : StTestBench::Case("avPacketQueue.pushPop") {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            myData.resize(4096, 0x55);
+            AVPacket aPkt;
+            stMemZero(&aPkt, sizeof(aPkt));
+            aPkt.data = &myData.front();
+            aPkt.size = int(myData.size());
+            myPacket.setAVpkt(aPkt);
+            myPacket.setDurationSeconds(0.001);
+            return myPacket.getData() != NULL;
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            size_t aNbPopped = 0;
+            for(int aPass = 0; aPass < 4; ++aPass) {
+                for(int aPktIter = 0; aPktIter < 256; ++aPktIter) {
+                    myQueue.push(myPacket);
+                }
+                for(StHandle<StAVPacket> aPkt = myQueue.pop(); !aPkt.isNull(); aPkt = myQueue.pop()) {
+                    ++aNbPopped;
+                }
+            }
+            return aNbPopped == 4 * 256;
+        }
+
+            private:
+
+        std::vector<uint8_t> myData;
+        StAVPacket           myPacket;
+        StBenchPacketQueue   myQueue;
+
+    };
+
+    /**
+     * StGLTextureData::updateData() for specified stereoscopic layout of Full HD frame.
+     */
+    class StBenchTextureDataCase : public StTestBench::Case {
+
+            public:
+
+        StBenchTextureDataCase(const StFormat theFormat)
+        : StTestBench::Case(StString("textureData.updateData.") + st::formatToString(theFormat)),
+          myData(new StGLTextureUploadParams(), new StGLTextureBufferPool()),
+          myFormat(theFormat) {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            myCaps.maxTexDim = 16384;
+            myCaps.setSupportedFormat(StImagePlane::ImgRGB, true);
+            if(!initFrameRGB(myFrameL, THE_FRAME_SIZEX, THE_FRAME_SIZEY)) {
+                return false;
+            }
+            return (myFormat != StFormat_SeparateFrames && myFormat != StFormat_FrameSequence)
+                || initFrameRGB(myFrameR, THE_FRAME_SIZEX, THE_FRAME_SIZEY);
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            myData.updateData(myCaps, myFrameL, myFrameR, StHandle<StStereoParams>(), myFormat, StCubemap_OFF, 0.0);
+            return true;
+        }
+
+            private:
+
+        StGLDeviceCaps  myCaps;
+        StImage         myFrameL;
+        StImage         myFrameR;
+        StGLTextureData myData;
+        StFormat        myFormat;
+
+    };
+
+    /**
+     * StPCMBuffer::addData() of 1 second of audio, dispatched to addConvert() variants.
+     */
+    class StBenchPcmCase : public StTestBench::Case {
+
+            public:
+
+        StBenchPcmCase(const StString&              theName,
+                       const StChannelMap::Channels theChannels,
+                       const StPcmFormat            theFormatSrc,
+                       const size_t                 thePlanesSrc,
+                       const StPcmFormat            theFormatOut,
+                       const size_t                 thePlanesOut)
+        : StTestBench::Case(StString("pcmBuffer.addConvert.") + theName),
+          myBufferSrc(theFormatSrc),
+          myBufferOut(theFormatOut) {
+            myBufferSrc.setupChannels(theChannels, StChannelMap::PCM, thePlanesSrc);
+            myBufferOut.setupChannels(theChannels, StChannelMap::PCM, thePlanesOut);
+            myBufferSrc.setFreq(FREQ_48000);
+            myBufferOut.setFreq(FREQ_48000);
+        }
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            const size_t aSizeSrc = myBufferSrc.getSecondSize();
+            myBufferSrc.resize(aSizeSrc, false);
+            myBufferOut.resize(myBufferOut.getSecondSize(), false);
+            for(size_t aPlaneIter = 0; aPlaneIter < myBufferSrc.getPlanesNb(); ++aPlaneIter) {
+                uint8_t* aData = myBufferSrc.getPlane(aPlaneIter);
+                for(size_t aByte = 0; aByte < aSizeSrc / myBufferSrc.getPlanesNb(); ++aByte) {
+                    aData[aByte] = uint8_t(aByte * 13);
+                }
+            }
+            if(myBufferSrc.getFormat() == StPcmFormat_Float32) {
+                // keep float samples within valid range
+                for(size_t aPlaneIter = 0; aPlaneIter < myBufferSrc.getPlanesNb(); ++aPlaneIter) {
+                    float* aData = (float* )myBufferSrc.getPlane(aPlaneIter);
+                    for(size_t aSample = 0; aSample < aSizeSrc / myBufferSrc.getPlanesNb() / sizeof(float); ++aSample) {
+                        aData[aSample] = float(aSample % 200) * 0.01f - 1.0f;
+                    }
+                }
+            }
+            return myBufferSrc.setDataSize(aSizeSrc);
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            myBufferOut.setDataSize(0);
+            return myBufferOut.addData(myBufferSrc);
+        }
+
+            private:
+
+        StPCMBuffer myBufferSrc;
+        StPCMBuffer myBufferOut;
+
+    };
+
+    /**
+     * StImage::initRGB() conversion of Full HD YUV 4:2:0 frame.
+     */
+    class StBenchImageRGBCase : public StTestBench::Case {
+
+            public:
+
+        StBenchImageRGBCase() : StTestBench::Case("image.initRGB.yuv420p") {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            myFrame.setColorModel(StImage::ImgColor_YUV);
+            myFrame.setColorScale(StImage::ImgScale_Mpeg);
+            if(!myFrame.changePlane(0).initTrash(StImagePlane::ImgGray, THE_FRAME_SIZEX,     THE_FRAME_SIZEY)
+            || !myFrame.changePlane(1).initTrash(StImagePlane::ImgGray, THE_FRAME_SIZEX / 2, THE_FRAME_SIZEY / 2)
+            || !myFrame.changePlane(2).initTrash(StImagePlane::ImgGray, THE_FRAME_SIZEX / 2, THE_FRAME_SIZEY / 2)) {
+                return false;
+            }
+            for(size_t aPlaneIter = 0; aPlaneIter < 3; ++aPlaneIter) {
+                fillPattern(myFrame.changePlane(aPlaneIter));
+            }
+            return true;
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            StImage anRgb;
+            return anRgb.initRGB(myFrame);
+        }
+
+            private:
+
+        StImage myFrame;
+
+    };
+
+    /**
+     * StImage::initSideBySide() of two Full HD RGB views.
+     */
+    class StBenchImageSideBySideCase : public StTestBench::Case {
+
+            public:
+
+        StBenchImageSideBySideCase() : StTestBench::Case("image.initSideBySide.rgb") {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            return initFrameRGB(myFrameL, THE_FRAME_SIZEX, THE_FRAME_SIZEY)
+                && initFrameRGB(myFrameR, THE_FRAME_SIZEX, THE_FRAME_SIZEY);
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            StImage aPair;
+            return aPair.initSideBySide(myFrameL, myFrameR, 0, 0);
+        }
+
+            private:
+
+        StImage myFrameL;
+        StImage myFrameR;
+
+    };
+
+    /**
+     * StFolder::init() on synthetic tree of 8 folders with 128 files each.
+     * The tree is created within temporary folder once and reused by next runs.
+     */
+    class StBenchFolderCase : public StTestBench::Case {
+
+            public:
+
+        StBenchFolderCase() : StTestBench::Case("folder.init") {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            myRoot = StProcess::getTempFolder() + "sViewBenchTree";
+            StFolder::createFolder(myRoot);
+            for(int aSubIter = 0; aSubIter < 8; ++aSubIter) {
+                const StString aSubFolder = myRoot + SYS_FS_SPLITTER + "sub" + aSubIter;
+                StFolder::createFolder(aSubFolder);
+                for(int aFileIter = 0; aFileIter < 128; ++aFileIter) {
+                    const StString aPath = aSubFolder + SYS_FS_SPLITTER + "image" + aFileIter + (aFileIter % 4 == 0 ? ".txt" : ".jpg");
+                    if(StFileNode::isFileExists(aPath)) {
+                        continue;
+                    }
+                    StRawFile aFile(aPath);
+                    if(!aFile.openFile(StRawFile::WRITE)) {
+                        return false;
+                    }
+                    aFile.closeFile();
+                }
+            }
+            myExtensions.add("jpg");
+            myExtensions.add("png");
+            return true;
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            StFolder aFolder(myRoot);
+            aFolder.init(myExtensions, 2);
+            return aFolder.size() == 8;
+        }
+
+            private:
+
+        StString              myRoot;
+        StArrayList<StString> myExtensions;
+
+    };
+
+    /**
+     * StPlayList navigation through 2000 items.
+     */
+    class StBenchPlayListCase : public StTestBench::Case {
+
+            public:
+
+        StBenchPlayListCase()
+        : StTestBench::Case("playList.walk"),
+          myList(1, false) {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            const StString aFolder = StProcess::getTempFolder() + "sViewBenchList" + SYS_FS_SPLITTER;
+            for(size_t anIter = 0; anIter < THE_NB_ITEMS; ++anIter) {
+                myList.addOneFile(aFolder + "movie" + anIter + ".mkv", StMIME());
+            }
+            return myList.getCurrentPosition() != StPlayList::CurrentPosition_NONE;
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            size_t aNbSteps = 0;
+            myList.walkToFirst();
+            while(myList.walkToNext(false)) {
+                ++aNbSteps;
+            }
+            while(myList.walkToPrev()) {
+                //
+            }
+            for(size_t anIter = 0; anIter < 64; ++anIter) {
+                myList.walkToPosition((anIter * 997) % THE_NB_ITEMS);
+                if(myList.getCurrentTitle().isEmpty()) {
+                    return false;
+                }
+            }
+            return aNbSteps == THE_NB_ITEMS - 1;
+        }
+
+            private:
+
+        static const size_t THE_NB_ITEMS = 2000;
+
+        StPlayList myList;
+
+    };
+
+    /**
+     * Text formatter with synthetic monospaced glyphs,
+     * so that layout can be measured without OpenGL context and font files.
+     */
+    class StBenchTextFormatter : public StGLTextFormatter {
+
+            public:
+
+        void setText(const StString& theText) {
+            reset();
+            myString      = theText;
+            myAscender    = 14.0f;
+            myLineSpacing = 18.0f;
+            StGLTile aTile;
+            aTile.texture = 0;
+            for(StUtf8Iter anIter = theText.iterator(); *anIter != 0; ++anIter) {
+                const stUtf32_t aChar = *anIter;
+                if(aChar == '\x0D'
+                || aChar == '\x0A') {
+                    continue;
+                } else if(aChar == ' ') {
+                    myPen.x() += 9.0f;
+                    continue;
+                }
+
+                aTile.px.left()   = myPen.x() + 1.0f;
+                aTile.px.right()  = myPen.x() + 8.0f;
+                aTile.px.top()    = myPen.y() + 12.0f;
+                aTile.px.bottom() = myPen.y() - 2.0f;
+                myRects.push_back(aTile);
+                ++myRectsNb;
+                myPen.x() += 9.0f;
+            }
+        }
+
+    };
+
+    /**
+     * StGLTextFormatter::format() of multi-paragraph text.
+     */
+    class StBenchTextLayoutCase : public StTestBench::Case {
+
+            public:
+
+        StBenchTextLayoutCase() : StTestBench::Case("textFormatter.format") {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            const StString aParagraph = "sView is a stereoscopic media player with support of many input and output formats. "
+                                        "It can play video, show images and display 3D models in side-by-side, anaglyph and other layouts.\n";
+            for(int anIter = 0; anIter < 32; ++anIter) {
+                myText += aParagraph;
+            }
+            myFormatter.setupAlignment(StGLTextFormatter::ST_ALIGN_X_CENTER, StGLTextFormatter::ST_ALIGN_Y_CENTER);
+            return true;
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            myFormatter.setText(myText);
+            myFormatter.format(640.0f, 480.0f);
+            return myFormatter.getResultHeight() > 0.0f;
+        }
+
+            private:
+
+        StString             myText;
+        StBenchTextFormatter myFormatter;
+
+    };
+
+    /**
+     * StJpegParser::parse() of MPO file with two views.
+     */
+    class StBenchJpegParserCase : public StTestBench::Case {
+
+            public:
+
+        StBenchJpegParserCase() : StTestBench::Case("jpegParser.parse.mpo") {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            StAVImage anImage;
+            if(!initFrameRGB(anImage, 640, 480)) {
+                return false;
+            }
+
+            StRawFile aJpeg;
+            size_t aJpegSize = 0;
+            if(!anImage.encode(aJpeg, aJpegSize, StImageFile::ST_TYPE_JPEG)) {
+                return false;
+            }
+
+            const StString aPath = StProcess::getTempFolder() + "sViewBench.mpo";
+            StRawFile aFile(aPath);
+            if(!aFile.openFile(StRawFile::WRITE)) {
+                return false;
+            }
+            aFile.write((const char* )aJpeg.getBuffer(), aJpegSize);
+            aFile.write((const char* )aJpeg.getBuffer(), aJpegSize);
+            aFile.closeFile();
+            const bool isRead = myParser.readFile(aPath);
+            StFileNode::removeFile(aPath);
+            return isRead;
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            return myParser.parse()
+                && myParser.getNbImages() == 2;
+        }
+
+            private:
+
+        StJpegParser myParser;
+
+    };
+
+    /**
+     * Luminance of RGB frame rows.
+     */
+    class StBenchLumaFunctor {
+
+            public:
+
+        StBenchLumaFunctor(const StImagePlane& theSrc,
+                           StImagePlane&       theDst)
+        : mySrc(&theSrc),
+          myDst(&theDst) {}
+
+        void operator()(const size_t theRow) const {
+            const uint8_t* aSrc = mySrc->getData(theRow, 0);
+            uint8_t*       aDst = myDst->changeData(theRow, 0);
+            for(size_t aCol = 0; aCol < mySrc->getSizeX(); ++aCol, aSrc += 3) {
+                aDst[aCol] = uint8_t((aSrc[0] * 77 + aSrc[1] * 150 + aSrc[2] * 29) >> 8);
+            }
+        }
+
+            private:
+
+        const StImagePlane* mySrc;
+        StImagePlane*       myDst;
+
+    };
+
+    /**
+     * Row-wise processing of Full HD frame by StTaskPool::parallelFor() or by serial loop.
+     */
+    class StBenchParallelForCase : public StTestBench::Case {
+
+            public:
+
+        StBenchParallelForCase(const bool theIsParallel)
+        : StTestBench::Case(theIsParallel ? "taskPool.parallelFor.luma" : "taskPool.serialFor.luma"),
+          myIsParallel(theIsParallel) {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            if(!mySrc.initTrash(StImagePlane::ImgRGB,  THE_FRAME_SIZEX, THE_FRAME_SIZEY)
+            || !myDst.initTrash(StImagePlane::ImgGray, THE_FRAME_SIZEX, THE_FRAME_SIZEY)) {
+                return false;
+            }
+            fillPattern(mySrc);
+            return true;
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            const StBenchLumaFunctor aFunctor(mySrc, myDst);
+            if(myIsParallel) {
+                StTaskPool::GetDefault().parallelFor(0, THE_FRAME_SIZEY, aFunctor);
+            } else {
+                for(size_t aRow = 0; aRow < THE_FRAME_SIZEY; ++aRow) {
+                    aFunctor(aRow);
+                }
+            }
+            return true;
+        }
+
+            private:
+
+        StImagePlane mySrc;
+        StImagePlane myDst;
+        bool         myIsParallel;
+
+    };
+
+    /**
+     * Decoding of 16 MiB base64 stream (embedded glTF buffer) by scalar, SIMD or parallel SIMD path.
+     */
+    class StBenchBase64Case : public StTestBench::Case {
+
+            public:
+
+        enum Mode {
+            Mode_Scalar,
+            Mode_Simd,
+            Mode_Parallel,
+        };
+
+        StBenchBase64Case(const Mode theMode)
+        : StTestBench::Case(theMode == Mode_Scalar ? "base64.decode.scalar.16MiB"
+                          : (theMode == Mode_Simd  ? "base64.decode.simd.16MiB"
+                                                   : "base64.decode.parallel.16MiB")),
+          myMode(theMode) {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            static const char THE_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            const size_t aNbQuads = 16 * 1024 * 1024 / 3;
+            myStr.resize(aNbQuads * 4);
+            for(size_t aChar = 0; aChar < myStr.size(); ++aChar) {
+                myStr[aChar] = THE_ALPHABET[(aChar * 7 + aChar / 64) & 0x3F];
+            }
+            myData.resize(StBase64::getDecodedSize(&myStr.front(), myStr.size()));
+            return true;
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            size_t anErrorPos = 0;
+            switch(myMode) {
+                case Mode_Scalar:   return StBase64::decode(&myData.front(), &myStr.front(), myStr.size(), anErrorPos, StBase64::Impl_Scalar);
+                case Mode_Simd:     return StBase64::decode(&myData.front(), &myStr.front(), myStr.size(), anErrorPos, StBase64::Impl_Auto);
+                case Mode_Parallel: return StBase64::decodeParallel(&myData.front(), &myStr.front(), myStr.size(), anErrorPos);
+            }
+            return false;
+        }
+
+            private:
+
+        std::vector<char>      myStr;
+        std::vector<stUByte_t> myData;
+        Mode                   myMode;
+
+    };
+
+    /**
+     * Bounding volumes and normals of synthetic mesh (wavy grid of 2048x2048 nodes, 8M triangles).
+     */
+    class StBenchMeshCase : public StTestBench::Case {
+
+            public:
+
+        enum Mode {
+            Mode_BndBox,
+            Mode_BndSphere,
+            Mode_Normals,
+        };
+
+        StBenchMeshCase(const Mode theMode)
+        : StTestBench::Case(theMode == Mode_BndBox    ? "mesh.bndbox.4M"
+                          : (theMode == Mode_BndSphere ? "mesh.bndsphere.4M"
+                                                       : "mesh.normals.4M")),
+          myMesh(GL_TRIANGLES),
+          myMode(theMode) {}
+
+        virtual bool init() ST_ATTR_OVERRIDE {
+            const size_t aNbNodes = 2048;
+            StArrayList<StGLVec3>& aVerts = myMesh.changeVertices();
+            aVerts.initList(aNbNodes * aNbNodes);
+            for(size_t aRow = 0; aRow < aNbNodes; ++aRow) {
+                for(size_t aCol = 0; aCol < aNbNodes; ++aCol) {
+                    aVerts.add(StGLVec3(float(aCol), float(aRow),
+                                        std::sin(float(aCol) * 0.01f) * std::cos(float(aRow) * 0.02f) * 100.0f));
+                }
+            }
+            if(myMode != Mode_Normals) {
+                return true;
+            }
+
+            StArrayList<GLuint>& anIndices = myMesh.changeIndices();
+            anIndices.initList((aNbNodes - 1) * (aNbNodes - 1) * 6);
+            for(size_t aRow = 0; aRow + 1 < aNbNodes; ++aRow) {
+                for(size_t aCol = 0; aCol + 1 < aNbNodes; ++aCol) {
+                    const GLuint aNode = GLuint(aRow * aNbNodes + aCol);
+                    anIndices.add(aNode);
+                    anIndices.add(aNode + 1);
+                    anIndices.add(aNode + GLuint(aNbNodes));
+                    anIndices.add(aNode + 1);
+                    anIndices.add(aNode + GLuint(aNbNodes) + 1);
+                    anIndices.add(aNode + GLuint(aNbNodes));
+                }
+            }
+            return true;
+        }
+
+        virtual bool run() ST_ATTR_OVERRIDE {
+            switch(myMode) {
+                case Mode_BndBox: {
+                    StBndBox aBox;
+                    aBox.enlarge(myMesh.getVertices());
+                    return !aBox.isVoid();
+                }
+                case Mode_BndSphere: {
+                    StBndSphere aSphere;
+                    aSphere.enlarge(myMesh.getVertices());
+                    return !aSphere.isVoid();
+                }
+                case Mode_Normals: {
+                    return myMesh.computeNormals();
+                }
+            }
+            return false;
+        }
+
+            private:
+
+        StGLMesh myMesh;
+        Mode     myMode;
+
+    };
+
+}
+
+StTestBench::StTestBench(const StString& theJsonPath)
+: myJsonPath(theJsonPath) {
+    //
+}
+
+void StTestBench::measure(Case& theCase) {
+    Result aResult;
+    aResult.Name     = theCase.getName();
+    aResult.NbReps   = 0;
+    aResult.MedianMs = 0.0;
+    aResult.P95Ms    = 0.0;
+    aResult.MinMs    = 0.0;
+    aResult.IsOk     = theCase.init();
+    for(size_t anIter = 0; anIter < THE_NB_WARMUP && aResult.IsOk; ++anIter) {
+        aResult.IsOk = theCase.run();
+    }
+
+    std::vector<double> aTimes;
+    StTimer aTotalTimer(true);
+    while(aResult.IsOk
+       && aTimes.size() < THE_NB_REPSMAX
+       && (aTimes.size() < THE_NB_REPS || aTotalTimer.getElapsedTimeInSec() < THE_TIME_MIN)) {
+        myTimer.restart();
+        aResult.IsOk = theCase.run();
+        aTimes.push_back(myTimer.getElapsedTimeInMilliSec());
+    }
+
+    if(aResult.IsOk && !aTimes.empty()) {
+        std::sort(aTimes.begin(), aTimes.end());
+        aResult.NbReps   = aTimes.size();
+        aResult.MedianMs = aTimes[aTimes.size() / 2];
+        aResult.P95Ms    = aTimes[stMin((aTimes.size() * 95) / 100, aTimes.size() - 1)];
+        aResult.MinMs    = aTimes.front();
+        st::cout << stostream_text("  ") << aResult.Name
+                 << stostream_text(":\tmedian ") << aResult.MedianMs
+                 << stostream_text(" ms,\tp95 ")  << aResult.P95Ms
+                 << stostream_text(" ms (")       << aResult.NbReps << stostream_text(" reps)\n");
+    } else {
+        ++myNbFailed;
+        st::cout << st::COLOR_FOR_RED << stostream_text("  ") << aResult.Name
+                 << stostream_text(":\tFAILED\n") << st::COLOR_FOR_WHITE;
+    }
+    myResults.push_back(aResult);
+}
+
+bool StTestBench::saveJson() const {
+    StString aJson = "{\n\"benchmarks\": [";
+    for(size_t anIter = 0; anIter < myResults.size(); ++anIter) {
+        const Result& aResult = myResults[anIter];
+        aJson += StString(anIter == 0 ? "\n" : ",\n")
+               + "  {\"name\": \"" + aResult.Name + "\""
+               + ", \"ok\": " + (aResult.IsOk ? "true" : "false")
+               + ", \"reps\": " + aResult.NbReps
+               + ", \"medianMs\": " + formatNumber(aResult.MedianMs)
+               + ", \"p95Ms\": " + formatNumber(aResult.P95Ms)
+               + ", \"minMs\": " + formatNumber(aResult.MinMs) + "}";
+    }
+    aJson += "\n]\n}\n";
+
+    StRawFile aFile(myJsonPath);
+    if(!aFile.openFile(StRawFile::WRITE)) {
+        return false;
+    }
+    const bool isWritten = aFile.write(aJson.toCString(), aJson.getSize()) == aJson.getSize();
+    aFile.closeFile();
+    return isWritten;
+}
+
+void StTestBench::perform() {
+    st::cout << stostream_text("Microbenchmarks (") << THE_NB_WARMUP << stostream_text(" warmup iterations, at least ")
+             << THE_NB_REPS << stostream_text(" measured repetitions).\n");
+    myResults.clear();
+    myNbFailed = 0;
+
+    StBenchPacketQueueCase aPacketQueue;
+    measure(aPacketQueue);
+
+    for(int aFormat = StFormat_Mono; aFormat < StFormat_NB; ++aFormat) {
+        StBenchTextureDataCase aTextureData((StFormat )aFormat);
+        measure(aTextureData);
+    }
+
+    StBenchPcmCase aPcmS16ToF32("s16.to.f32.stereo",          StChannelMap::CH20, StPcmFormat_Int16,   1, StPcmFormat_Float32, 1);
+    StBenchPcmCase aPcmF32PlanarToS16("f32p.to.s16.stereo",   StChannelMap::CH20, StPcmFormat_Float32, 2, StPcmFormat_Int16,   1);
+    StBenchPcmCase aPcmS16ToF32Planar("s16.to.f32p.5.1",      StChannelMap::CH51, StPcmFormat_Int16,   1, StPcmFormat_Float32, 6);
+    StBenchPcmCase aPcmS32ToS16("s32.to.s16.7.1",             StChannelMap::CH71, StPcmFormat_Int32,   1, StPcmFormat_Int16,   1);
+    measure(aPcmS16ToF32);
+    measure(aPcmF32PlanarToS16);
+    measure(aPcmS16ToF32Planar);
+    measure(aPcmS32ToS16);
+
+    StBenchImageRGBCase anImageRgb;
+    measure(anImageRgb);
+    StBenchImageSideBySideCase anImageSbs;
+    measure(anImageSbs);
+
+    StBenchFolderCase aFolder;
+    measure(aFolder);
+    StBenchPlayListCase aPlayList;
+    measure(aPlayList);
+    StBenchTextLayoutCase aTextLayout;
+    measure(aTextLayout);
+    StBenchJpegParserCase aJpegParser;
+    measure(aJpegParser);
+
+    StBenchParallelForCase aSerialFor(false);
+    measure(aSerialFor);
+    StBenchParallelForCase aParallelFor(true);
+    measure(aParallelFor);
+
+    StBenchBase64Case aBase64Scalar(StBenchBase64Case::Mode_Scalar);
+    measure(aBase64Scalar);
+    StBenchBase64Case aBase64Simd(StBenchBase64Case::Mode_Simd);
+    measure(aBase64Simd);
+    StBenchBase64Case aBase64Parallel(StBenchBase64Case::Mode_Parallel);
+    measure(aBase64Parallel);
+
+    StBenchMeshCase aMeshBndBox(StBenchMeshCase::Mode_BndBox);
+    measure(aMeshBndBox);
+    StBenchMeshCase aMeshBndSphere(StBenchMeshCase::Mode_BndSphere);
+    measure(aMeshBndSphere);
+    StBenchMeshCase aMeshNormals(StBenchMeshCase::Mode_Normals);
+    measure(aMeshNormals);
+
+    if(!myJsonPath.isEmpty()) {
+        if(saveJson()) {
+            st::cout << stostream_text("Results have been saved into '") << myJsonPath << stostream_text("'\n");
+        } else {
+            ++myNbFailed;
+            st::cout << st::COLOR_FOR_RED << stostream_text("Unable to write '") << myJsonPath << stostream_text("'\n")
+                     << st::COLOR_FOR_WHITE;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StTestBench_h_
+#define __StTestBench_h_
+
+#include "StTest.h"
+
+#include <StStrings/StString.h>
+
+#include <vector>
+
+/**
+ * Microbenchmarks for the core hot paths.
+ * Each case is executed several times for warmup and then measured
+ * within a series of repetitions; median and 95th percentile are reported
+ * to the console and optionally written into JSON file.
+ * Cases do not require a display, so that the suite can be executed by automated builds.
+ */
+class ST_LOCAL StTestBench : public StTest {
+
+        public:
+
+    /**
+     * Interface for benchmark case.
+     */
+    class Case {
+
+            public:
+
+        /**
+         * @param theName case name
+         */
+        Case(const StString& theName) : myName(theName) {}
+
+        virtual ~Case() {}
+
+        /**
+         * @return case name
+         */
+        const StString& getName() const { return myName; }
+
+        /**
+         * Prepare input data (not measured).
+         * @return false if case can not be executed
+         */
+        virtual bool init() { return true; }
+
+        /**
+         * Perform single measured iteration.
+         * @return false on failure
+         */
+        virtual bool run() = 0;
+
+            private:
+
+        StString myName;
+
+    };
+
+    /**
+     * Measurements of single case.
+     */
+    struct Result {
+        StString Name;     //!< case name
+        size_t   NbReps;   //!< number of measured repetitions
+        double   MedianMs; //!< median time of single iteration
+        double   P95Ms;    //!< 95th percentile of single iteration
+        double   MinMs;    //!< minimal time of single iteration
+        bool     IsOk;     //!< execution state
+    };
+
+        public:
+
+    /**
+     * Main constructor.
+     * @param theJsonPath file to store results in JSON format, ignored when empty
+     */
+    StTestBench(const StString& theJsonPath);
+
+    virtual void perform() ST_ATTR_OVERRIDE;
+
+        private:
+
+    /**
+     * Perform warmup and measurements of the case.
+     */
+    void measure(Case& theCase);
+
+    /**
+     * Save results into JSON file.
+     */
+    bool saveJson() const;
+
+        private:
+
+    StString            myJsonPath; //!< output file
+    std::vector<Result> myResults;  //!< collected results
+
+};
+
+#endif // __StTestBench_h_
@@ -0,0 +1,226 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestBounds.h"
+
+#include <StGLMesh/StBndBox.h>
+#include <StGLMesh/StBndSphere.h>
+#include <StGLMesh/StGLMesh.h>
+#include <StGLCore/StGLCore20.h>
+#include <StStrings/stConsole.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+    /**
+     * Synthetic point distribution.
+     */
+    enum PointsShape {
+        PointsShape_Cube,      //!< points within the cube
+        PointsShape_Sphere,    //!< points on the sphere surface
+        PointsShape_Ellipsoid, //!< points on the thin ellipsoid surface
+    };
+
+    /**
+     * Deterministic pseudo-random value within [-1, 1].
+     */
+    static float nextRandom(uint32_t& theSeed) {
+        theSeed = theSeed * 1664525u + 1013904223u;
+        return float(theSeed >> 8) / float(1u << 23) - 1.0f;
+    }
+
+    /**
+     * Generate the point set.
+     */
+    static void fillPoints(StArray<StGLVec3>& thePoints,
+                           const PointsShape  theShape,
+                           uint32_t           theSeed) {
+        for(size_t aPntIter = 0; aPntIter < thePoints.size(); ++aPntIter) {
+            StGLVec3 aPnt(nextRandom(theSeed), nextRandom(theSeed), nextRandom(theSeed));
+            if(theShape != PointsShape_Cube) {
+                aPnt.normalize();
+            }
+            if(theShape == PointsShape_Ellipsoid) {
+                aPnt = StGLVec3(aPnt.x() * 10.0f + 3.0f, aPnt.y() * 0.5f - 7.0f, aPnt.z() * 0.1f);
+            }
+            thePoints.changeValue(aPntIter) = aPnt;
+        }
+    }
+
+    /**
+     * Sphere giving access to protected initialization methods.
+     */
+    class StTestSphere : public StBndSphere {
+
+            public:
+
+        using StBndSphere::initWelzl;
+        using StBndSphere::initRitter;
+
+        /**
+         * @return true if all points are inside the sphere
+         */
+        bool isInside(const StArray<StGLVec3>& thePoints) const {
+            const GLfloat aTol = getRadius() * 1.0e-5f;
+            for(size_t aPntIter = 0; aPntIter < thePoints.size(); ++aPntIter) {
+                if((thePoints[aPntIter] - getCenter()).modulus() > getRadius() + aTol) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    };
+
+    /**
+     * Compare extreme points with reference (the first point for equal values).
+     */
+    static bool isSameExtremes(const StArray<StGLVec3>& thePoints) {
+        if(thePoints.size() == 0) {
+            return true;
+        }
+
+        StGLVec3 aMin = thePoints.getFirst(), aMax = thePoints.getFirst();
+        size_t anIds[6] = { 0, 0, 0, 0, 0, 0 };
+        for(size_t aPntIter = 1; aPntIter < thePoints.size(); ++aPntIter) {
+            const StGLVec3& aPnt = thePoints[aPntIter];
+            for(int anAxis = 0; anAxis < 3; ++anAxis) {
+                if(aPnt[anAxis] < aMin[anAxis]) {
+                    aMin[anAxis]  = aPnt[anAxis];
+                    anIds[anAxis] = aPntIter;
+                }
+                if(aPnt[anAxis] > aMax[anAxis]) {
+                    aMax[anAxis]      = aPnt[anAxis];
+                    anIds[anAxis + 3] = aPntIter;
+                }
+            }
+        }
+
+        StGLVec3 aMinTest, aMaxTest;
+        size_t anIdsTest[6];
+        StBndBox::computeExtremes(&thePoints.getFirst(), thePoints.size(), aMinTest, aMaxTest, anIdsTest);
+        for(int anAxis = 0; anAxis < 6; ++anAxis) {
+            if(anIds[anAxis] != anIdsTest[anAxis]) {
+                return false;
+            }
+        }
+        return aMin.isEqual(aMinTest)
+            && aMax.isEqual(aMaxTest);
+    }
+
+    /**
+     * Compare computed normals of wavy grid with reference ones.
+     */
+    static bool isSameNormals(const size_t theNbCells) {
+        StGLMesh aMesh(GL_TRIANGLES);
+        const size_t aNbNodes = theNbCells + 1;
+        StArrayList<StGLVec3>& aVerts = aMesh.changeVertices();
+        aVerts.initArray(aNbNodes * aNbNodes);
+        for(size_t aRow = 0; aRow < aNbNodes; ++aRow) {
+            for(size_t aCol = 0; aCol < aNbNodes; ++aCol) {
+                aVerts.changeValue(aRow * aNbNodes + aCol) = StGLVec3(float(aCol), float(aRow),
+                                                                      std::sin(float(aCol) * 0.1f) * std::cos(float(aRow) * 0.07f) * 4.0f);
+            }
+        }
+        StArrayList<GLuint>& anIndices = aMesh.changeIndices();
+        anIndices.initList(theNbCells * theNbCells * 6);
+        for(size_t aRow = 0; aRow < theNbCells; ++aRow) {
+            for(size_t aCol = 0; aCol < theNbCells; ++aCol) {
+                const GLuint aNode = GLuint(aRow * aNbNodes + aCol);
+                anIndices.add(aNode);
+                anIndices.add(aNode + 1);
+                anIndices.add(aNode + GLuint(aNbNodes));
+                anIndices.add(aNode + 1);
+                anIndices.add(aNode + GLuint(aNbNodes) + 1);
+                anIndices.add(aNode + GLuint(aNbNodes));
+            }
+        }
+        if(!aMesh.computeNormals()) {
+            return false;
+        }
+
+        std::vector<StGLVec3> aRef(aVerts.size());
+        for(size_t anIndexIter = 0; anIndexIter < anIndices.size(); anIndexIter += 3) {
+            const GLuint aV1 = anIndices[anIndexIter], aV2 = anIndices[anIndexIter + 1], aV3 = anIndices[anIndexIter + 2];
+            const StGLVec3 aNorm = StGLVec3::cross(aVerts[aV2] - aVerts[aV1], aVerts[aV3] - aVerts[aV1]);
+            aRef[aV1] += aNorm;
+            aRef[aV2] += aNorm;
+            aRef[aV3] += aNorm;
+        }
+        const StArray<StGLVec3>& aNormals = aMesh.getNormals();
+        for(size_t aNodeIter = 0; aNodeIter < aRef.size(); ++aNodeIter) {
+            aRef[aNodeIter].normalize();
+            if((aRef[aNodeIter] - aNormals[aNodeIter]).modulus() > 1.0e-5f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+void StTestBounds::perform() {
+    st::cout << stostream_text("Bounding volumes tests.\n");
+    myNbFailed = 0;
+
+    // extremes for all lengths around SIMD block size and for several parallel chunks
+    {
+        bool isOk = true;
+        for(size_t aNbPoints = 1; aNbPoints < 40 && isOk; ++aNbPoints) {
+            StArray<StGLVec3> aPoints(aNbPoints);
+            fillPoints(aPoints, PointsShape_Cube, uint32_t(aNbPoints));
+            isOk = isSameExtremes(aPoints);
+        }
+        check("box.extremes", isOk);
+
+        StArray<StGLVec3> aPoints(300000);
+        fillPoints(aPoints, PointsShape_Ellipsoid, 3);
+        // duplicated extreme values should return the first point
+        aPoints.changeValue(200000) = aPoints[0];
+        aPoints.changeValue(100)    = aPoints[250000];
+        check("box.extremes.parallel", isSameExtremes(aPoints));
+    }
+
+    // parallel sphere should include all points and be close to the minimal one
+    {
+        const char* THE_NAMES[3] = { "sphere.cube", "sphere.surface", "sphere.ellipsoid" };
+        for(int aShape = PointsShape_Cube; aShape <= PointsShape_Ellipsoid; ++aShape) {
+            StArray<StGLVec3> aPoints(20000);
+            fillPoints(aPoints, PointsShape(aShape), uint32_t(aShape + 1));
+            StTestSphere aWelzl, aRitter;
+            aWelzl .initWelzl (aPoints);
+            aRitter.initRitter(aPoints);
+            check(THE_NAMES[aShape], aRitter.isInside(aPoints)
+                                  && aRitter.getRadius() >= aWelzl.getRadius() * 0.999f
+                                  && aRitter.getRadius() <= aWelzl.getRadius() * 1.05f);
+        }
+
+        StArray<StGLVec3> aPoints(500000);
+        fillPoints(aPoints, PointsShape_Sphere, 5);
+        StTestSphere aSphere;
+        aSphere.enlarge(aPoints);
+        check("sphere.parallel", aSphere.isInside(aPoints)
+                              && aSphere.getRadius() <= 1.1f);
+    }
+
+    // parallel normals for grid split into several chunks
+    check("mesh.normals",          isSameNormals(16));
+    check("mesh.normals.parallel", isSameNormals(512));
+}
@@ -0,0 +1,37 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StTestBounds_h_
+#define __StTestBounds_h_
+
+#include "StTest.h"
+
+/**
+ * Unit tests for bounding volumes of large point sets:
+ * SIMD extreme points search, parallel bounding sphere compared to Welzl's algorithm
+ * and parallel normals computation compared to the reference one.
+ */
+class ST_LOCAL StTestBounds : public StTest {
+
+        public:
+
+    virtual void perform() ST_ATTR_OVERRIDE;
+
+};
+
+#endif // __StTestBounds_h_
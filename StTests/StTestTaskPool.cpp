@@ -0,0 +1,266 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StTestTaskPool.h"
+
+#include <StStrings/stConsole.h>
+#include <StThreads/StTaskPool.h>
+
+namespace {
+
+    /**
+     * Count visits of each index.
+     */
+    class StVisitFunctor {
+
+            public:
+
+        StVisitFunctor(std::vector<int32_t>& theVisits) : myVisits(&theVisits.front()) {}
+
+        void operator()(const size_t theIndex) const {
+            StAtomicOp::Increment(myVisits[theIndex]);
+        }
+
+            private:
+
+        volatile int32_t* myVisits;
+
+    };
+
+    /**
+     * Outer loop launching nested parallel loop for each row.
+     */
+    class StNestedFunctor {
+
+            public:
+
+        StNestedFunctor(StTaskPool&           thePool,
+                        std::vector<int32_t>& theVisits,
+                        const size_t          theRowSize)
+        : myPool(&thePool),
+          myVisits(&theVisits),
+          myRowSize(theRowSize) {}
+
+        void operator()(const size_t theRow) const {
+            std::vector<int32_t> aRow(myRowSize, 0);
+            myPool->parallelFor(0, myRowSize, StVisitFunctor(aRow));
+            int32_t aSum = 0;
+            for(size_t anIter = 0; anIter < myRowSize; ++anIter) {
+                aSum += aRow[anIter];
+            }
+            (*myVisits)[theRow] = aSum;
+        }
+
+            private:
+
+        StTaskPool*           myPool;
+        std::vector<int32_t>* myVisits;
+        size_t                myRowSize;
+
+    };
+
+    /**
+     * Compute sum of the range.
+     */
+    class StSumFuture : public StTaskFuture<uint64_t> {
+
+            public:
+
+        StSumFuture(const uint64_t theFrom,
+                    const uint64_t theTo)
+        : myFrom(theFrom),
+          myTo(theTo) {
+            myResult = 0;
+        }
+
+            protected:
+
+        virtual uint64_t compute() ST_ATTR_OVERRIDE {
+            uint64_t aSum = 0;
+            for(uint64_t aValue = myFrom; aValue < myTo; ++aValue) {
+                aSum += aValue;
+            }
+            return aSum;
+        }
+
+            private:
+
+        uint64_t myFrom;
+        uint64_t myTo;
+
+    };
+
+    /**
+     * Task blocking the worker until released.
+     */
+    class StBlockingTask : public StTask {
+
+            public:
+
+        StBlockingTask() : myIsStarted(false), myToRelease(false) {}
+
+        StCondition& started() { return myIsStarted; }
+
+        StCondition& release() { return myToRelease; }
+
+            protected:
+
+        virtual void run() ST_ATTR_OVERRIDE {
+            myIsStarted.set();
+            myToRelease.wait();
+        }
+
+            private:
+
+        StCondition myIsStarted;
+        StCondition myToRelease;
+
+    };
+
+    /**
+     * Task appending its identifier into the shared list.
+     */
+    class StOrderTask : public StTask {
+
+            public:
+
+        StOrderTask(std::vector<int>& theOrder,
+                    StMutex&          theMutex,
+                    const int         theId)
+        : myOrder(&theOrder),
+          myMutex(&theMutex),
+          myId(theId) {}
+
+            protected:
+
+        virtual void run() ST_ATTR_OVERRIDE {
+            myMutex->lock();
+            myOrder->push_back(myId);
+            myMutex->unlock();
+        }
+
+            private:
+
+        std::vector<int>* myOrder;
+        StMutex*          myMutex;
+        int               myId;
+
+    };
+
+    /**
+     * @return true if all elements are equal to specified value
+     */
+    static bool isAllEqual(const std::vector<int32_t>& theValues,
+                           const int32_t               theValue) {
+        for(size_t anIter = 0; anIter < theValues.size(); ++anIter) {
+            if(theValues[anIter] != theValue) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
+
+void StTestTaskPool::perform() {
+    StTaskPool& aPool = StTaskPool::GetDefault();
+    st::cout << stostream_text("Task pool tests (") << aPool.getNbThreads() << stostream_text(" worker threads).\n");
+    myNbFailed = 0;
+
+    // each index should be visited exactly once
+    {
+        std::vector<int32_t> aVisits(1000003, 0);
+        aPool.parallelFor(0, aVisits.size(), StVisitFunctor(aVisits));
+        check("parallelFor.visitOnce", isAllEqual(aVisits, 1));
+
+        std::vector<int32_t> aSmall(3, 0);
+        aPool.parallelFor(1, 3, StVisitFunctor(aSmall), StTaskPool::Priority_Background, 1);
+        aPool.parallelFor(2, 2, StVisitFunctor(aSmall));
+        check("parallelFor.subrange", aSmall[0] == 0 && aSmall[1] == 1 && aSmall[2] == 1);
+    }
+
+    // nested loops should not deadlock
+    {
+        const size_t aRowSize = 4096;
+        std::vector<int32_t> aRows(64, 0);
+        aPool.parallelFor(0, aRows.size(), StNestedFunctor(aPool, aRows, aRowSize), StTaskPool::Priority_Interactive, 1);
+        check("parallelFor.nested", isAllEqual(aRows, int32_t(aRowSize)));
+    }
+
+    // futures
+    {
+        std::vector< StHandle<StSumFuture> > aFutures;
+        for(uint64_t aPart = 0; aPart < 8; ++aPart) {
+            aFutures.push_back(new StSumFuture(aPart * 100000, (aPart + 1) * 100000));
+            aPool.submit(aFutures.back());
+        }
+        uint64_t aSum = 0;
+        for(size_t anIter = 0; anIter < aFutures.size(); ++anIter) {
+            aSum += aFutures[anIter]->getResult();
+        }
+        const uint64_t aNbValues = 800000;
+        check("future.result", aSum == aNbValues * (aNbValues - 1) / 2);
+    }
+
+    // cancellation and priorities within single-thread pool
+    {
+        StTaskPool aSinglePool(1);
+        StHandle<StBlockingTask> aBlocker = new StBlockingTask();
+        aSinglePool.submit(aBlocker);
+        aBlocker->started().wait();
+
+        StMutex aMutex;
+        std::vector<int> anOrder;
+        StHandle<StTask> aBackground  = new StOrderTask(anOrder, aMutex, 1);
+        StHandle<StTask> anInteractive = new StOrderTask(anOrder, aMutex, 2);
+        StHandle<StTask> aCancelled   = new StOrderTask(anOrder, aMutex, 3);
+        aSinglePool.submit(aBackground,   StTaskPool::Priority_Background);
+        aSinglePool.submit(aCancelled,    StTaskPool::Priority_Interactive);
+        aSinglePool.submit(anInteractive, StTaskPool::Priority_Interactive);
+        const bool isCancelled = aCancelled->cancel();
+        check("task.cancel", isCancelled
+                          && aCancelled->getState() == StTask::State_Cancelled
+                          && !aBlocker->cancel()
+                          && !aBlocker->wait(10));
+
+        aBlocker->release().set();
+        aBackground->wait(2000);
+        anInteractive->wait(2000);
+        check("task.priority", anOrder.size() == 2
+                            && anOrder[0] == 2
+                            && anOrder[1] == 1
+                            && aBackground->getState() == StTask::State_Done);
+    }
+
+    // wait() executes pending task within the calling thread
+    {
+        StTaskPool anEmptyPool(0);
+        StHandle<StSumFuture> aFuture = new StSumFuture(0, 10);
+        anEmptyPool.submit(aFuture);
+        check("future.waitInline", aFuture->getResult() == 45
+                                && aFuture->getState() == StTask::State_Done);
+
+        // pending tasks are cancelled on pool destruction
+        StHandle<StTask> aPending = new StSumFuture(0, 10);
+        {
+            StTaskPool aPool2(0);
+            aPool2.submit(aPending, StTaskPool::Priority_Background);
+        }
+        check("pool.destroy", aPending->getState() == StTask::State_Cancelled);
+    }
+}
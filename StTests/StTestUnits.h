@@ -0,0 +1,112 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * StTests program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StTests program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __StTestUnits_h_
+#define __StTestUnits_h_
+
+#include <StStrings/StString.h>
+
+#include "StTestTaskPool.h"
+#include "StTestBase64.h"
+#include "StTestBounds.h"
+
+/**
+ * Unit test suites shared by application entry points.
+ * Suites require neither display nor user input and report result through StTest::isPassed().
+ */
+class ST_LOCAL StTestUnits {
+
+        public:
+
+    /**
+     * Perform the suite with specified name.
+     * @param theName     suite name
+     * @param theIsPassed flag reset to false when some check fails
+     * @return false if there is no suite with specified name
+     */
+    static bool perform(const StString& theName,
+                        bool&           theIsPassed) {
+        for(size_t aSuiteIter = 0; aSuiteIter < SuitesNb; ++aSuiteIter) {
+            const Suite& aSuite = getSuites()[aSuiteIter];
+            if(theName == StString(aSuite.Name)) {
+                theIsPassed = aSuite.Perform() && theIsPassed;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Perform all suites.
+     * @return true if all checks have been passed
+     */
+    static bool performAll() {
+        bool isPassed = true;
+        for(size_t aSuiteIter = 0; aSuiteIter < SuitesNb; ++aSuiteIter) {
+            isPassed = getSuites()[aSuiteIter].Perform() && isPassed;
+        }
+        return isPassed;
+    }
+
+    /**
+     * Print options for all suites.
+     */
+    static void printHelp() {
+        for(size_t aSuiteIter = 0; aSuiteIter < SuitesNb; ++aSuiteIter) {
+            st::cout << getSuites()[aSuiteIter].Help;
+        }
+    }
+
+        private:
+
+    /**
+     * Create, perform and check the suite.
+     */
+    template<typename TestType>
+    static bool performSuite() {
+        TestType aTest;
+        aTest.perform();
+        return aTest.isPassed();
+    }
+
+    /**
+     * Suite definition.
+     */
+    struct Suite {
+        const char* Name;    //!< option name
+        const char* Help;    //!< option description
+        bool (*Perform)();   //!< suite function
+    };
+
+    enum { SuitesNb = 3 };
+
+    /**
+     * @return array of SuitesNb suites
+     */
+    static const Suite* getSuites() {
+        static const Suite THE_SUITES[SuitesNb] = {
+            { "tasks",  "  tasks  - task pool unit tests\n",         &performSuite<StTestTaskPool> },
+            { "base64", "  base64 - base64 decoder unit tests\n",    &performSuite<StTestBase64>   },
+            { "bounds", "  bounds - bounding volumes unit tests\n",  &performSuite<StTestBounds>   },
+        };
+        return THE_SUITES;
+    }
+
+};
+
+#endif // __StTestUnits_h_
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2011-2015 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2011-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * StTests program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -25,6 +25,8 @@
 #include "StTestEmbed.h"
 #include "StTestImageLib.h"
 #include "StTestGlStress.h"
+#include "StTestBench.h"
+#include "StTestUnits.h"
 
 int main(int , char** ) { // force console output
 #if defined(_WIN32)
@@ -54,8 +56,11 @@ int main(int , char** ) { // force console output
     const StString ST_TEST_GLHANG  = "glhang";
     const StString ST_TEST_EMBED   = "embed";
     const StString ST_TEST_IMAGE   = "image";
+    const StString ST_TEST_BENCH   = "bench";
     const StString ST_TEST_ALL     = "all";
     size_t aFound = 0;
+    bool toPause  = true;
+    bool isPassed = true;
     for(size_t anArgId = 0; anArgId < anArgs.size(); ++anArgId) {
         const StString& aParam = anArgs[anArgId];
         if(aParam == ST_TEST_MUTICES) {
@@ -88,6 +93,24 @@ int main(int , char** ) { // force console output
             StTestImageLib anImage(anArgs[anArgId]);
             anImage.perform();
             ++aFound;
+        } else if(aParam == ST_TEST_BENCH) {
+            // microbenchmarks, optionally followed by JSON file for results;
+            // no key is awaited on exit so that benchmarks can be executed by automated builds
+            StString aJsonPath;
+            if(anArgId + 1 < anArgs.size()
+            && anArgs[anArgId + 1].isEndsWith(stCString(".json"))) {
+                aJsonPath = anArgs[++anArgId];
+            }
+
+            StTestBench aBench(aJsonPath);
+            aBench.perform();
+            isPassed = isPassed && aBench.isPassed();
+            toPause  = false;
+            ++aFound;
+        } else if(StTestUnits::perform(aParam, isPassed)) {
+            // unit tests
+            toPause = false;
+            ++aFound;
         } else if(aParam == ST_TEST_ALL) {
             // mutex speed test
             StTestMutex aMutices;
@@ -101,6 +124,14 @@ int main(int , char** ) { // force console output
             StTestEmbed anEmbed;
             anEmbed.perform();
 
+            // unit tests
+            isPassed = StTestUnits::performAll() && isPassed;
+
+            // microbenchmarks
+            StTestBench aBench("");
+            aBench.perform();
+            isPassed = aBench.isPassed() && isPassed;
+
             ++aFound;
             break;
         }
@@ -115,8 +146,12 @@ int main(int , char** ) { // force console output
                  << stostream_text("  glhang - gl stress test\n")
                  << stostream_text("  embed  - test window embedding\n")
                  << stostream_text("  image fileName - test image libraries\n");
+        StTestUnits::printHelp();
+        st::cout << stostream_text("  bench [results.json] - microbenchmarks of core routines (no display required)\n");
     }
 
-    st::cout << stostream_text("Press any key to exit...") << st::SYS_PAUSE_EMPTY;
-    return 0;
+    if(toPause) {
+        st::cout << stostream_text("Press any key to exit...") << st::SYS_PAUSE_EMPTY;
+    }
+    return isPassed ? 0 : 1;
 }
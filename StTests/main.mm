@@ -29,6 +29,8 @@
 #include "StTestGlBand.h"
 #include "StTestEmbed.h"
 #include "StTestImageLib.h"
+#include "StTestBench.h"
+#include "StTestUnits.h"
 
 namespace {
 
@@ -121,8 +123,10 @@ namespace {
         const StString ST_TEST_GLBAND  = "glband";
         const StString ST_TEST_EMBED   = "embed";
         const StString ST_TEST_IMAGE   = "image";
+        const StString ST_TEST_BENCH   = "bench";
         const StString ST_TEST_ALL     = "all";
         size_t aFound = 0;
+        bool isPassed = true;
         for(size_t anArgId = 0; anArgId < anArgs.size(); ++anArgId) {
             const StString& aParam = anArgs[anArgId];
             if(aParam == ST_TEST_MUTICES) {
@@ -150,6 +154,20 @@ namespace {
                 StTestImageLib anImage(anArgs[anArgId]);
                 anImage.perform();
                 ++aFound;
+            } else if(aParam == ST_TEST_BENCH) {
+                // microbenchmarks, optionally followed by JSON file for results
+                StString aJsonPath;
+                if(anArgId + 1 < anArgs.size()
+                && anArgs[anArgId + 1].isEndsWith(stCString(".json"))) {
+                    aJsonPath = anArgs[++anArgId];
+                }
+
+                StTestBench aBench(aJsonPath);
+                aBench.perform();
+                ++aFound;
+            } else if(StTestUnits::perform(aParam, isPassed)) {
+                // unit tests
+                ++aFound;
             } else if(aParam == ST_TEST_ALL) {
                 // mutex speed test
                 StTestMutex aMutices;
@@ -176,6 +194,11 @@ namespace {
                      << stostream_text("  glband - gl <-> cpu trasfer speed test\n")
                      << stostream_text("  embed  - test window embedding\n")
                      << stostream_text("  image fileName - test image libraries\n");
+            StTestUnits::printHelp();
+            st::cout << stostream_text("  bench [results.json] - microbenchmarks of core routines\n");
+        }
+        if(!isPassed) {
+            st::cout << st::COLOR_FOR_RED << stostream_text("Some checks have FAILED\n") << st::COLOR_FOR_WHITE;
         }
     }
 
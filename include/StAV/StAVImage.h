@@ -12,6 +12,8 @@
 #include <StImage/StImageFile.h>
 #include <StAV/StAVFrame.h>
 
+class StRawFile;
+
 struct AVInputFormat;
 struct AVFormatContext;
 struct AVCodecContext;
@@ -84,6 +86,21 @@ class StAVImage : public StImageFile {
                                    ImageType       theImageType,
                                    StFormat        theSrcFormat = StFormat_AUTO) ST_ATTR_OVERRIDE;
 
+    /**
+     * Encode image into the memory buffer.
+     * @param theBuffer      buffer to fill
+     * @param theDataSize    size of encoded data within the buffer
+     * @param theImageType   image type (PNG or JPEG)
+     * @param theSrcFormat   stereoscopic format to be stored within frame metadata
+     * @param theJpegQuality JPEG quantizer (2..31), lesser is better
+     * @return true on success
+     */
+    ST_CPPEXPORT bool encode(StRawFile& theBuffer,
+                             size_t&    theDataSize,
+                             ImageType  theImageType,
+                             StFormat   theSrcFormat   = StFormat_AUTO,
+                             const int  theJpegQuality = 5);
+
         private:
 
     ST_LOCAL static int getAVPixelFormat(const StImage& theImage);
@@ -443,6 +443,55 @@ class StWindow {
      */
     ST_CPPEXPORT const StString& getStatistics() const;
 
+    /**
+     * @return true if window content is redrawn only on request
+     */
+    ST_CPPEXPORT bool isRedrawOnDemand() const;
+
+    /**
+     * Enable/disable redrawing window content only on request (disabled by default).
+     * In this mode main loop will wait for window events or invalidate() calls
+     * instead of redrawing the same frame.
+     */
+    ST_CPPEXPORT void setRedrawOnDemand(const bool theToEnable);
+
+    /**
+     * Return true if output requires continuous redraw regardless of redraw on demand mode,
+     * e.g. to track device orientation or to emulate page-flipping.
+     */
+    ST_CPPEXPORT virtual bool isContinuousRedraw() const;
+
+    /**
+     * Request window content to be redrawn.
+     * Can be called from any thread.
+     */
+    ST_CPPEXPORT void invalidate();
+
+    /**
+     * Request window content to be redrawn after specified delay.
+     * Can be called from any thread.
+     * @param theDelaySec delay in seconds
+     */
+    ST_CPPEXPORT void invalidateAfter(const double theDelaySec);
+
+    /**
+     * Return true if window content should be redrawn within this iteration.
+     * Resets pending redraw request.
+     */
+    ST_CPPEXPORT bool toRedraw();
+
+    /**
+     * Block calling thread until redraw request, window events or timeout.
+     * @param theMaxSec maximum waiting time in seconds, negative to wait without timeout
+     */
+    ST_CPPEXPORT void waitRedraw(const double theMaxSec);
+
+    /**
+     * @return ratio of time main loop has been waiting for redraw requests within last second,
+     *         or -1 if redraw on demand is disabled
+     */
+    ST_CPPEXPORT double getIdleRatio() const;
+
     /**
      * Turn hardware stereo on/off, when appropriate API is available.
      */
@@ -200,6 +200,16 @@ class StFTFont {
                                    const int             theDataLen,
                                    const StFTFont::Style theStyle);
 
+    /**
+     * Load the same font faces as specified font (but using own FT_Face objects)
+     * and initialize them with the same size.
+     * Intended for rendering glyphs from another thread
+     * (font should use own FT library instance in this case).
+     * @param theFont the font to copy
+     * @return true on success
+     */
+    ST_CPPEXPORT bool loadCopy(const StFTFont& theFont);
+
     /**
      * Re-initialize the font.
      * @param thePointSize  the face size in points (1/72 inch)
@@ -209,6 +219,13 @@ class StFTFont {
     ST_CPPEXPORT bool init(const unsigned int thePointSize,
                            const unsigned int theResolution = 72);
 
+    /**
+     * @return the face size in points (1/72 inch) specified on initialization
+     */
+    ST_LOCAL unsigned int getPointSize() const {
+        return myPointSize;
+    }
+
     /**
      * Release currently loaded font.
      */
@@ -396,18 +413,23 @@ class StFTFont {
 
         protected:
 
-    StHandle<StFTLibrary> myFTLib;               //!< handle to the FT library object
-    FT_Face               myFTFace;              //!< active FT face object
-    StFTFont::Style       myStyle;               //!< active FT face style
-    FT_Face               myFTFaces[StylesNB];   //!< FT face objects
-    StString              myFontPaths[StylesNB]; //!< font paths
+    StHandle<StFTLibrary> myFTLib;                  //!< handle to the FT library object
+    FT_Face               myFTFace;                 //!< active FT face object
+    StFTFont::Style       myStyle;                  //!< active FT face style
+    FT_Face               myFTFaces[StylesNB];      //!< FT face objects
+    StString              myFontPaths[StylesNB];    //!< font paths
+    const unsigned char*  myFontData[StylesNB];     //!< font data for faces loaded from memory
+    int                   myFontDataLen[StylesNB];  //!< font data length
+    bool                  myToSyntItalic[StylesNB]; //!< flags indicating synthesized italic style
     bool                  mySubsets[SubsetsNB];
-    FT_Int32              myLoadFlags;           //!< default load flags
-    unsigned int          myGlyphMaxWidth;       //!< maximum glyph width
-    unsigned int          myGlyphMaxHeight;      //!< maximum glyph height
-
-    StImagePlane          myGlyphImg;            //!< cached glyph plane
-    stUtf32_t             myUChar;               //!< currently loaded unicode character
+    FT_Int32              myLoadFlags;              //!< default load flags
+    unsigned int          myGlyphMaxWidth;          //!< maximum glyph width
+    unsigned int          myGlyphMaxHeight;         //!< maximum glyph height
+    unsigned int          myPointSize;              //!< face size in points
+    unsigned int          myResolution;             //!< resolution of the target device
+
+    StImagePlane          myGlyphImg;               //!< cached glyph plane
+    stUtf32_t             myUChar;                  //!< currently loaded unicode character
 
 };
 
@@ -0,0 +1,109 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StFTFontRasterizer_h_
+#define __StFTFontRasterizer_h_
+
+#include <StFT/StFTFont.h>
+#include <StFT/StFTGlyphMap.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThread.h>
+
+#include <vector>
+
+/**
+ * Glyph rendered in advance.
+ */
+struct StFTGlyphBitmap {
+
+    StImagePlane    Image; //!< glyph bitmap (own copy)
+    StRect<float>   Rect;  //!< glyph rectangle relative to the pen position
+    stUtf32_t       UChar; //!< unicode character
+    StFTFont::Style Style; //!< font style
+
+    ST_LOCAL StFTGlyphBitmap() : UChar(0), Style(StFTFont::Style_Regular) {}
+
+};
+
+/**
+ * Auxiliary class rendering glyphs using FreeType within dedicated working thread,
+ * so that the rendering thread will only upload bitmaps to the texture.
+ * The thread uses own copy of the font, since StFTFont can not be used from concurrent threads.
+ */
+class StFTFontRasterizer {
+
+        public:
+
+    /**
+     * Main constructor, starts the working thread.
+     */
+    ST_CPPEXPORT StFTFontRasterizer();
+
+    /**
+     * Destructor, stops the working thread.
+     */
+    ST_CPPEXPORT ~StFTFontRasterizer();
+
+    /**
+     * Setup the font to render glyphs with.
+     * The font files are loaded into own FT library instance,
+     * all previous requests and not yet retrieved glyphs are discarded.
+     * @param theFont initialized font
+     * @return true if font copy has been loaded
+     */
+    ST_CPPEXPORT bool setFont(const StFTFont& theFont);
+
+    /**
+     * Put the glyph into rendering queue.
+     * Repeated requests of the same glyph are ignored.
+     */
+    ST_CPPEXPORT void request(const stUtf32_t       theUChar,
+                              const StFTFont::Style theStyle);
+
+    /**
+     * Retrieve glyphs rendered since the last call.
+     * @param theGlyphs list to fill with rendered glyphs (previous content is discarded)
+     * @return true if list is not empty
+     */
+    ST_CPPEXPORT bool takeGlyphs(std::vector< StHandle<StFTGlyphBitmap> >& theGlyphs);
+
+        private:
+
+    /**
+     * Thread function.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION threadFunction(void* theRasterizer);
+
+    /**
+     * Main loop of the working thread.
+     */
+    ST_LOCAL void mainLoop();
+
+        private:
+
+    struct Request {
+        stUtf32_t       UChar;
+        StFTFont::Style Style;
+    };
+
+        private:
+
+    StHandle<StThread>   myThread;                        //!< working thread
+    StCondition          myEvent;                         //!< event to wake up working thread
+    StMutex              myMutex;                         //!< lock for fields below
+    StHandle<StFTFont>   myFont;                          //!< font copy for the working thread
+    std::vector<Request> myRequests;                      //!< pending requests
+    StFTGlyphMap         myRequested[StFTFont::StylesNB]; //!< already requested glyphs
+    std::vector< StHandle<StFTGlyphBitmap> > myReady;     //!< rendered glyphs
+    size_t               myGeneration;                    //!< counter incremented on font change
+    volatile bool        myToQuit;                        //!< flag to stop working thread
+
+};
+
+#endif // __StFTFontRasterizer_h_
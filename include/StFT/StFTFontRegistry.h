@@ -11,8 +11,10 @@
 
 #include <StFT/StFTFont.h>
 #include <StFile/StFolder.h>
+#include <StThreads/StThread.h>
 
 #include <map>
+#include <vector>
 
 /**
  * Class to manage the list of available fonts in the system.
@@ -33,14 +35,28 @@ class StFTFontRegistry {
      */
     ST_CPPEXPORT virtual ~StFTFontRegistry();
 
+    /**
+     * Setup the file to store fonts index, so that next initialization would not need scanning font folders.
+     * Should be called before init().
+     * @param theFilePath index file path; empty string disables the index
+     */
+    ST_LOCAL void setIndexFile(const StString& theFilePath) {
+        myIndexPath = theFilePath;
+    }
+
     /**
      * Initialize the fonts list.
+     * When index file is defined, the fonts list is read from the index.
+     * The index is validated by modification time of font folders
+     * and outdated index is rebuilt within background thread (for the next launch),
+     * or immediately when some of indexed files have been removed.
      * @param theToSearchAll flag to register ALL font files within specified search folders (slower)
      */
     ST_CPPEXPORT void init(const bool theToSearchAll = false);
 
     /**
      * Append folder to the list of search paths.
+     * Should be called before init().
      */
     ST_CPPEXPORT void appendSearchPath(const StString& theFolder);
 
@@ -58,11 +74,78 @@ class StFTFontRegistry {
 
         private:
 
+    /**
+     * Font file record within the index.
+     */
+    struct IndexFont {
+        StString Name;      //!< file name as listed in search names
+        StString Path;      //!< full file path
+        StString Family;    //!< font family name
+        int      Style;     //!< FreeType style flags
+        int      FaceIndex; //!< face index within the file
+    };
+
+    /**
+     * Fonts index.
+     */
+    struct Index {
+        StString                                     Config;  //!< hash of search configuration
+        std::vector< std::pair<StString, StString> > Folders; //!< scanned folders and their modification time
+        std::vector<IndexFont>                       Fonts;   //!< found font files
+    };
+
+        private:
+
+    /**
+     * Scan font folders and fill the index.
+     */
+    ST_LOCAL void scanFolders(StFTLibrary& theFTLib,
+                              Index&       theIndex) const;
+
     /**
      * Search the specified font files.
      */
-    void searchFiles(const StArrayList<StString>& theNames,
-                     const bool                   theIsMajor);
+    ST_LOCAL static void searchFiles(StFTLibrary&                 theFTLib,
+                                     const StFolder&              theRoot,
+                                     const StArrayList<StString>& theNames,
+                                     const bool                   theIsMajor,
+                                     Index&                       theIndex);
+
+    /**
+     * Collect folders of the files tree with their modification time.
+     */
+    ST_LOCAL static void collectFolders(const StFolder& theFolder,
+                                        Index&          theIndex);
+
+    /**
+     * @return hash of search configuration (folders and file names)
+     */
+    ST_LOCAL StString getConfigHash() const;
+
+    /**
+     * Read the index file.
+     */
+    ST_LOCAL bool loadIndex(Index& theIndex) const;
+
+    /**
+     * Write the index file.
+     */
+    ST_LOCAL bool saveIndex(const Index& theIndex) const;
+
+    /**
+     * @return true if font folders have not been modified since index creation
+     */
+    ST_LOCAL bool isUpToDate(const Index& theIndex) const;
+
+    /**
+     * Fill the fonts map from the index.
+     */
+    ST_LOCAL void registerFonts(const Index& theIndex);
+
+    /**
+     * Thread function rebuilding the index.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION rebuildIndexThread(void* theRegistry);
 
         private:
 
@@ -71,8 +154,9 @@ class StFTFontRegistry {
     StArrayList<StString> myFilesMajor;  //!< major font file names which should present in the system
     StArrayList<StString> myFilesMinor;  //!< minor font file names
 
-    StFolder              myFoldersRoot; //!< files tree
     StHandle<StFTLibrary> myFTLib;       //!< handle to the FT library object
+    StString              myIndexPath;   //!< path to the fonts index file
+    StHandle<StThread>    myIndexThread; //!< background thread rebuilding the index
 
     std::map<StString, StFTFontFamily> myFonts; //!< map family name -> font files
 
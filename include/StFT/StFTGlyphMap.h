@@ -0,0 +1,114 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StFTGlyphMap_h_
+#define __StFTGlyphMap_h_
+
+#include <stTypes.h>
+
+#include <map>
+
+/**
+ * Map from Unicode character to glyph index.
+ * Characters within Basic Multilingual Plane are looked up directly
+ * within lazily allocated pages of 256 entries,
+ * while rare characters from other planes are stored within the tree.
+ */
+class StFTGlyphMap {
+
+        public:
+
+    static const size_t INVALID_ID = size_t(-1);
+
+        public:
+
+    /**
+     * Empty constructor.
+     */
+    ST_LOCAL StFTGlyphMap() {
+        stMemZero(myPages, sizeof(myPages));
+    }
+
+    /**
+     * Destructor.
+     */
+    ST_LOCAL ~StFTGlyphMap() {
+        clear();
+    }
+
+    /**
+     * @return glyph index for specified character or INVALID_ID if not bound
+     */
+    ST_LOCAL size_t find(const stUtf32_t theUChar) const {
+        if(theUChar < PLANE_SIZE) {
+            const size_t* aPage = myPages[theUChar >> PAGE_BITS];
+            return aPage != NULL
+                 ? aPage[theUChar & PAGE_MASK]
+                 : INVALID_ID;
+        }
+
+        std::map<stUtf32_t, size_t>::const_iterator anIter = myOther.find(theUChar);
+        return anIter != myOther.end()
+             ? anIter->second
+             : INVALID_ID;
+    }
+
+    /**
+     * Bind glyph index to the character.
+     */
+    ST_LOCAL void bind(const stUtf32_t theUChar,
+                       const size_t    theId) {
+        if(theUChar >= PLANE_SIZE) {
+            myOther[theUChar] = theId;
+            return;
+        }
+
+        size_t*& aPage = myPages[theUChar >> PAGE_BITS];
+        if(aPage == NULL) {
+            aPage = new size_t[PAGE_SIZE];
+            for(size_t anIter = 0; anIter < PAGE_SIZE; ++anIter) {
+                aPage[anIter] = INVALID_ID;
+            }
+        }
+        aPage[theUChar & PAGE_MASK] = theId;
+    }
+
+    /**
+     * Remove all bindings.
+     */
+    ST_LOCAL void clear() {
+        for(size_t aPageIter = 0; aPageIter < PAGES_NB; ++aPageIter) {
+            delete[] myPages[aPageIter];
+            myPages[aPageIter] = NULL;
+        }
+        myOther.clear();
+    }
+
+        private:
+
+    enum {
+        PAGE_BITS  = 8,
+        PAGE_SIZE  = 1 << PAGE_BITS,
+        PAGE_MASK  = PAGE_SIZE - 1,
+        PLANE_SIZE = 0x10000,
+        PAGES_NB   = PLANE_SIZE / PAGE_SIZE,
+    };
+
+        private:
+
+    size_t*                     myPages[PAGES_NB]; //!< direct lookup pages for Basic Multilingual Plane
+    std::map<stUtf32_t, size_t> myOther;           //!< characters outside of Basic Multilingual Plane
+
+        private:
+
+    StFTGlyphMap(const StFTGlyphMap& );
+    StFTGlyphMap& operator=(const StFTGlyphMap& );
+
+};
+
+#endif // __StFTGlyphMap_h_
@@ -215,6 +215,12 @@ class StFileNode : public StNode {
      */
     ST_CPPEXPORT static bool isFileExists(const StCString& thePath);
 
+    /**
+     * @param thePath file path
+     * @return time of last modification of the file/folder (seconds since epoch) or -1 on error
+     */
+    ST_CPPEXPORT static int64_t getModificationTime(const StCString& thePath);
+
     /**
      * @param thePath file path
      * @return true if file/folder has read-only flag
@@ -79,6 +79,13 @@ class StGLFont : public StGLResource {
              && myFonts[0]->wasInitialized();
     }
 
+    /**
+     * Return numbers identifying current state of glyph textures of each subset (0 for undefined subset),
+     * so that text layouts computed with different values become invalid.
+     * Generations are unique among all font instances.
+     */
+    ST_CPPEXPORT void getGenerations(uint32_t theGenerations[StFTFont::SubsetsNB]) const;
+
     /**
      * Compute glyph rectangle at specified pen position (on baseline)
      * and render it to texture if not already.
@@ -94,6 +101,26 @@ class StGLFont : public StGLResource {
                                   StGLTile&       theGlyph,
                                   StGLVec2&       thePen);
 
+    /**
+     * Request glyphs of specified text to be rendered in advance by working thread,
+     * so that following text layout will not block on glyphs rasterization.
+     * @param theText  text to prepare
+     * @param theStyle font style
+     */
+    ST_CPPEXPORT void prefetchText(const StString&       theText,
+                                   const StFTFont::Style theStyle);
+
+    /**
+     * Upload to the textures glyphs already rendered by working thread.
+     */
+    ST_CPPEXPORT void stglUploadPrefetched(StGLContext& theCtx);
+
+    /**
+     * Upload glyphs staged within textures atlases since the last call.
+     * Should be called after text formatting and before drawing.
+     */
+    ST_CPPEXPORT void stglFlush(StGLContext& theCtx);
+
         protected:
 
     StHandle<StGLFontEntry> myFonts[StFTFont::SubsetsNB]; //!< textured font instances
@@ -10,13 +10,13 @@
 #define __StGLFontEntry_h_
 
 #include <StFT/StFTFont.h>
+#include <StFT/StFTFontRasterizer.h>
+#include <StFT/StFTGlyphMap.h>
 #include <StGL/StGLTexture.h>
 #include <StGL/StGLFrameBuffer.h>
 #include <StGL/StGLVec.h>
 #include <StTemplates/StRect.h>
 
-#include <map>
-
 typedef StRect<GLfloat> StGLRect;
 
 /**
@@ -48,6 +48,31 @@ class StGLFontEntry : public StGLResource {
 
         public:
 
+    /**
+     * Glyph textures usage statistics.
+     */
+    struct Statistics {
+
+        size_t NbTextures;    //!< number of glyph textures
+        size_t NbGlyphs;      //!< number of glyphs put into textures
+        size_t AreaUsed;      //!< textures area occupied by glyphs, in pixels
+        size_t AreaTotal;     //!< overall textures area, in pixels
+        size_t NbUploads;     //!< number of texture uploads
+        size_t UploadedBytes; //!< amount of uploaded data, in bytes
+
+        ST_LOCAL Statistics() { stMemZero(this, sizeof(Statistics)); }
+
+        /**
+         * @return fraction of textures area occupied by glyphs
+         */
+        ST_LOCAL float getOccupancy() const {
+            return AreaTotal != 0 ? float(double(AreaUsed) / double(AreaTotal)) : 0.0f;
+        }
+
+    };
+
+        public:
+
     /**
      * Main constructor.
      */
@@ -170,6 +195,42 @@ class StGLFontEntry : public StGLResource {
                                   StGLTile&       theGlyph,
                                   StGLVec2&       thePen);
 
+    /**
+     * Request the glyph to be rendered in advance by working thread.
+     * The glyph will be uploaded to the texture on next stglUploadPrefetched() call or glyph lookup.
+     * @param theUChar unicode symbol to prepare
+     * @param theStyle font style
+     */
+    ST_CPPEXPORT void prefetchGlyph(const stUtf32_t       theUChar,
+                                    const StFTFont::Style theStyle);
+
+    /**
+     * Upload to the texture glyphs already rendered by working thread.
+     */
+    ST_CPPEXPORT void stglUploadPrefetched(StGLContext& theCtx);
+
+    /**
+     * Upload glyphs staged since the last call to the textures.
+     * New glyphs are accumulated within CPU copy of the texture,
+     * so that each modified texture is updated by single call.
+     * Should be called before drawing the text.
+     */
+    ST_CPPEXPORT void stglFlush(StGLContext& theCtx);
+
+    /**
+     * @return glyph textures usage statistics
+     */
+    ST_LOCAL const Statistics& getStatistics() const {
+        return myStats;
+    }
+
+    /**
+     * @return unique number identifying current set of glyph tiles, changed on each release
+     */
+    ST_LOCAL uint32_t getGeneration() const {
+        return myGeneration;
+    }
+
         protected:
 
     /**
@@ -179,6 +240,17 @@ class StGLFontEntry : public StGLResource {
                                   const stUtf32_t theChar,
                                   const bool      theToForce);
 
+    /**
+     * Put glyph bitmap into the texture (staged till stglFlush()).
+     * @param theCtx   active context
+     * @param theImage glyph bitmap
+     * @param theRect  glyph rectangle relative to the pen position
+     * @return true on success, the tile has myLastTileId index
+     */
+    ST_CPPEXPORT bool addTile(StGLContext&         theCtx,
+                              const StImagePlane&  theImage,
+                              const StRect<float>& theRect);
+
     /**
      * Allocate new texture.
      */
@@ -186,20 +258,80 @@ class StGLFontEntry : public StGLResource {
 
         protected:
 
+    /**
+     * Segment of skyline - the upper boundary of occupied texture area.
+     */
+    struct SkylineNode {
+        int X;     //!< left position
+        int Y;     //!< first free row
+        int Width; //!< segment width
+    };
+
+    /**
+     * CPU-side state of the glyph texture.
+     */
+    struct Atlas {
+
+        StImagePlane             Image;   //!< copy of texture content
+        std::vector<SkylineNode> Skyline; //!< skyline of packed glyphs, sorted by X
+        StRect<int>              Dirty;   //!< area modified since last upload
+        bool                     IsDirty; //!< flag indicating that Dirty rectangle is defined
+
+        /**
+         * Initialize empty atlas of specified dimensions.
+         */
+        ST_LOCAL bool init(const int theSizeX,
+                           const int theSizeY);
+
+        /**
+         * Find position for the rectangle using bottom-left skyline heuristic and reserve it.
+         * @param theSizeX rectangle width
+         * @param theSizeY rectangle height
+         * @param thePos   found position of top-left corner
+         * @return false if atlas has no space for the rectangle
+         */
+        ST_LOCAL bool pack(const int    theSizeX,
+                           const int    theSizeY,
+                           StVec2<int>& thePos);
+
+        /**
+         * Copy glyph image into specified position and extend dirty area.
+         */
+        ST_LOCAL void put(const StImagePlane& theImage,
+                          const StVec2<int>&  thePos);
+
+            private:
+
+        /**
+         * @return top position for rectangle placed at specified skyline node or -1 if it does not fit
+         */
+        ST_LOCAL int fit(const size_t theNode,
+                         const int    theSizeX,
+                         const int    theSizeY) const;
+
+    };
+
+        protected:
+
     StHandle<StFTFont> myFont;                //!< FreeType font instance
     GLfloat            myAscender;            //!< ascender     provided my FT font
     GLfloat            myLineSpacing;         //!< line spacing provided my FT font
     GLsizei            myTileSizeX;           //!< tile width
     GLsizei            myTileSizeY;           //!< tile height
     size_t             myLastTileId;          //!< id of last tile
-    StRect<int>        myLastTilePx;
+    uint32_t           myGeneration;          //!< unique number of current tiles set
 
     StArrayList< StHandle<StGLTexture> >     myTextures; //!< texture list
     StArrayList< StHandle<StGLFrameBuffer> > myFbos;     //!< FBO list
+    std::vector< StHandle<Atlas> >           myAtlases;  //!< CPU-side state of each texture
+    Statistics                               myStats;    //!< textures usage statistics
     StArrayList<StGLTile> myTiles;            //!< tiles list
 
-    std::map<stUtf32_t, size_t>  myGlyphMaps[StFTFont::StylesNB];
-    std::map<stUtf32_t, size_t>* myGlyphMap;                      //!< glyphs map for active style
+    StFTGlyphMap  myGlyphMaps[StFTFont::StylesNB]; //!< glyphs maps for each style
+    StFTGlyphMap* myGlyphMap;                      //!< glyphs map for active style
+
+    StHandle<StFTFontRasterizer>             myRasterizer; //!< working thread rendering glyphs in advance (created on first request)
+    std::vector< StHandle<StFTGlyphBitmap> > myPrefetched; //!< temporary list of glyphs rendered in advance
 
 };
 
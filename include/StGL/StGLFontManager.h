@@ -10,6 +10,7 @@
 #define __StGLFontManager_h_
 
 #include <StGL/StGLFont.h>
+#include <StGL/StGLTextLayoutCache.h>
 #include <StFT/StFTFontRegistry.h>
 
 #include <map>
@@ -51,8 +52,11 @@ class StGLFontManager : public StGLResource {
 
     /**
      * Main constructor.
+     * @param theResolution  fonts resolution
+     * @param theCacheFolder folder to store fonts index (empty string to scan system fonts on each launch)
      */
-    ST_CPPEXPORT StGLFontManager(const unsigned int theResolution = 72);
+    ST_CPPEXPORT StGLFontManager(const unsigned int theResolution  = 72,
+                                 const StString&    theCacheFolder = StString());
 
     /**
      * Destructor - should be called after release()!
@@ -106,6 +110,13 @@ class StGLFontManager : public StGLResource {
         return myFTLib;
     }
 
+    /**
+     * @return shared cache of formatted text layouts
+     */
+    ST_LOCAL StGLTextLayoutCache& getLayoutCache() {
+        return myLayoutCache;
+    }
+
         protected:
 
     StHandle<StFTLibrary>               myFTLib;      //!< handle to the FT library object
@@ -114,6 +125,7 @@ class StGLFontManager : public StGLResource {
               StHandle<StGLFontEntry> > myFonts;      //!< fonts map
     std::map< StGLFontTypeKey,
               StHandle<StGLFont> >      myFontTypes;  //!< font typefaces map
+    StGLTextLayoutCache                 myLayoutCache; //!< formatted text layouts cache
     unsigned int                        myResolution; //!< fonts resolution
 
 };
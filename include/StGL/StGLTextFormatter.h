@@ -10,6 +10,7 @@
 #define __StGLTextFormatter_h_
 
 #include <StGL/StGLFont.h>
+#include <StGL/StGLTextLayoutCache.h>
 
 #include <vector>
 
@@ -124,6 +125,34 @@ class StGLTextFormatter {
     ST_CPPEXPORT void format(const GLfloat theWidth,
                              const GLfloat theHeight);
 
+    /**
+     * Perform reset(), append() and format() or take the same layout from the cache.
+     * @param theCtx    active context
+     * @param theString text to format
+     * @param theFont   font to use
+     * @param theWidth  width limit
+     * @param theHeight height for vertical alignment
+     * @param theCache  layouts cache
+     * @return true if layout has been found in cache
+     */
+    ST_CPPEXPORT bool formatCached(StGLContext&         theCtx,
+                                   const StString&      theString,
+                                   StGLFont&            theFont,
+                                   const GLfloat        theWidth,
+                                   const GLfloat        theHeight,
+                                   StGLTextLayoutCache& theCache);
+
+    /**
+     * Store formatting results into the layout.
+     */
+    ST_CPPEXPORT void storeLayout(StGLTextLayout& theLayout) const;
+
+    /**
+     * Restore formatting results from the layout.
+     * The layout is referred (not copied) for retrieving vertex arrays.
+     */
+    ST_CPPEXPORT void restoreLayout(const StHandle<StGLTextLayout>& theLayout);
+
     /**
      * Retrieve formatting results.
      */
@@ -211,6 +240,10 @@ class StGLTextFormatter {
     GLfloat               myBndTop;
     StGLVec2              myMoveVec;       //!< local variable
 
+        protected: //! @name cached results
+
+    StHandle<StGLTextLayout> myLayout;     //!< restored layout providing vertex arrays
+
 };
 
 #endif // __StGLTextFormatter_h_
@@ -0,0 +1,176 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StGLTextLayoutCache_h_
+#define __StGLTextLayoutCache_h_
+
+#include <StGL/StGLFontEntry.h>
+
+#include <list>
+#include <map>
+#include <vector>
+
+/**
+ * Formatted text layout - the final glyph tiles and vertex arrays
+ * produced by StGLTextFormatter.
+ */
+struct StGLTextLayout {
+
+    StString              Text;        //!< source text (to detect hash collisions)
+    std::vector<StGLTile> Rects;       //!< formatted glyphs rectangles
+    GLfloat               LineSpacing; //!< line spacing
+    GLfloat               Ascender;    //!< ascender
+    GLfloat               AlignWidth;  //!< line width used for horizontal alignment
+    GLfloat               TextWidth;   //!< maximum text width
+    GLfloat               BndTop;      //!< top of bounding box
+    size_t                LinesNb;     //!< overall lines number
+
+    std::vector<GLuint>                               Textures;        //!< textures list
+    std::vector< StHandle < std::vector<StGLVec2> > > VertsPerTexture; //!< vertices per texture
+    std::vector< StHandle < std::vector<StGLVec2> > > TCrdsPerTexture; //!< texture coordinates per texture
+
+    ST_LOCAL StGLTextLayout()
+    : LineSpacing(0.0f),
+      Ascender(0.0f),
+      AlignWidth(0.0f),
+      TextWidth(0.0f),
+      BndTop(0.0f),
+      LinesNb(0) {}
+
+};
+
+/**
+ * Cache of formatted text layouts with limited size.
+ * Least recently used layouts are discarded first.
+ * Layouts refer to glyph textures of the font, hence the key includes generations of font subsets
+ * (unique among all font instances) so that layouts become unreachable when font textures are released.
+ */
+class StGLTextLayoutCache {
+
+        public:
+
+    /**
+     * Layout key.
+     */
+    struct Key {
+
+        stUInt64_t  Hash;           //!< text hash
+        uint32_t    FontGenerations[StFTFont::SubsetsNB]; //!< textures generations of font subsets
+        GLfloat     Width;          //!< width limit
+        GLfloat     Height;         //!< height for vertical alignment
+        unsigned    Size;           //!< font size
+        int         Style;          //!< default font style
+        int         AlignX;         //!< horizontal alignment
+        int         AlignY;         //!< vertical   alignment
+        int         Parser;         //!< text parser
+
+        ST_LOCAL Key() { stMemZero(this, sizeof(Key)); }
+
+        ST_CPPEXPORT bool operator<(const Key& theOther) const;
+
+    };
+
+        public:
+
+    /**
+     * Compute hash of the string (64-bit FNV-1a).
+     */
+    ST_CPPEXPORT static stUInt64_t hashString(const StString& theText);
+
+    /**
+     * Main constructor.
+     * @param theMaxSize maximum number of layouts to keep
+     */
+    ST_CPPEXPORT StGLTextLayoutCache(const size_t theMaxSize = 512);
+
+    /**
+     * @return maximum number of layouts to keep
+     */
+    ST_LOCAL size_t getMaxSize() const {
+        return myMaxSize;
+    }
+
+    /**
+     * Setup maximum number of layouts to keep.
+     */
+    ST_CPPEXPORT void setMaxSize(const size_t theMaxSize);
+
+    /**
+     * @return number of cached layouts
+     */
+    ST_LOCAL size_t size() const {
+        return myMap.size();
+    }
+
+    /**
+     * @return number of successful lookups
+     */
+    ST_LOCAL size_t getNbHits() const {
+        return myNbHits;
+    }
+
+    /**
+     * @return number of failed lookups
+     */
+    ST_LOCAL size_t getNbMisses() const {
+        return myNbMisses;
+    }
+
+    /**
+     * @return fraction of successful lookups
+     */
+    ST_LOCAL float getHitRate() const {
+        const size_t aNbTotal = myNbHits + myNbMisses;
+        return aNbTotal != 0 ? float(double(myNbHits) / double(aNbTotal)) : 0.0f;
+    }
+
+    /**
+     * Find the layout and mark it as recently used.
+     * @param theKey  layout key
+     * @param theText source text
+     * @return layout or NULL if not found
+     */
+    ST_CPPEXPORT StHandle<StGLTextLayout> find(const Key&      theKey,
+                                               const StString& theText);
+
+    /**
+     * Put the layout into the cache, discarding least recently used layouts on overflow.
+     */
+    ST_CPPEXPORT void add(const Key&                      theKey,
+                          const StHandle<StGLTextLayout>& theLayout);
+
+    /**
+     * Remove all layouts and reset counters.
+     */
+    ST_CPPEXPORT void clear();
+
+        private:
+
+    /**
+     * Remove least recently used layouts exceeding the limit.
+     */
+    ST_LOCAL void trim();
+
+        private:
+
+    struct Entry {
+        StHandle<StGLTextLayout>  Layout;  //!< cached layout
+        std::list<Key>::iterator  LruIter; //!< position within LRU list
+    };
+
+        private:
+
+    std::map<Key, Entry> myMap;      //!< layouts map
+    std::list<Key>       myLruList;  //!< keys from most to least recently used
+    size_t               myMaxSize;  //!< maximum number of layouts
+    size_t               myNbHits;   //!< number of successful lookups
+    size_t               myNbMisses; //!< number of failed lookups
+
+};
+
+#endif // __StGLTextLayoutCache_h_
@@ -82,6 +82,23 @@ class StBndBox : public StBndContainer {
         return StGLVec3::getLERP(myMin, myMax, 0.5f);
     }
 
+    /**
+     * Compute the bounding box of the points set and indices of extreme points along each axis.
+     * Large sets are split into chunks processed by StTaskPool,
+     * each chunk is scanned using SIMD instructions (SSE2 / NEON) when available.
+     * When several points have the same extreme value, the first one is returned.
+     * @param thePoints   points array
+     * @param theNbPoints number of points, should be greater than 0
+     * @param theMin      x/y/z minimal values
+     * @param theMax      x/y/z maximal values
+     * @param theExtremes optional array of 6 indices of points with minimal x/y/z and maximal x/y/z values
+     */
+    ST_CPPEXPORT static void computeExtremes(const StGLVec3* thePoints,
+                                             const size_t    theNbPoints,
+                                             StGLVec3&       theMin,
+                                             StGLVec3&       theMax,
+                                             size_t*         theExtremes = NULL);
+
     /**
      * Check that bounding boxes are disjoint.
      * @param theBndBox (const StBndBox& ) - another bounding box;
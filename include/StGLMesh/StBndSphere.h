@@ -38,6 +38,15 @@ class StBndSphere : public StBndContainer {
      */
     ST_CPPEXPORT void initWelzl(const StArray<StGLVec3>& thePoints);
 
+    /**
+     * Compute the bounding sphere for a large point set in parallel.
+     * Ritter's sphere is grown by chunks of points processed by StTaskPool and merged,
+     * then refined by shifting the center toward the farthest point.
+     * Computed sphere includes all points but is NOT the smallest one (usually within several percents).
+     * @param thePoints the points set
+     */
+    ST_CPPEXPORT void initRitter(const StArray<StGLVec3>& thePoints);
+
         public: //!< inheritance methods
 
     ST_CPPEXPORT virtual ~StBndSphere();
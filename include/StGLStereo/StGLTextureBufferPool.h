@@ -0,0 +1,137 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StGLTextureBufferPool_h_
+#define __StGLTextureBufferPool_h_
+
+#include <StThreads/StMemoryBudget.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StTimer.h>
+
+#include <vector>
+
+/**
+ * Pool of aligned frame buffers shared by texture queue slots.
+ * Requested sizes are rounded up to size classes (4 classes per power of two),
+ * so that buffers can be reused when switching between clips of similar resolution
+ * or when slots release memory after each frame (compress mode).
+ * Released buffers are kept for specified idle time and within memory budget.
+ */
+class StGLTextureBufferPool {
+
+        public:
+
+    /**
+     * Default constructor.
+     * @param theName name of memory budget client
+     */
+    ST_CPPEXPORT StGLTextureBufferPool(const char* theName = "textureQueue.pool");
+
+    /**
+     * Destructor, releases all free buffers.
+     * All borrowed buffers should be returned before.
+     */
+    ST_CPPEXPORT ~StGLTextureBufferPool();
+
+    /**
+     * @return time in seconds to keep unused buffers
+     */
+    ST_LOCAL double getIdleTime() const {
+        return myIdleTime;
+    }
+
+    /**
+     * Setup time in seconds to keep unused buffers.
+     */
+    ST_LOCAL void setIdleTime(const double theSeconds) {
+        myIdleTime = theSeconds;
+    }
+
+    /**
+     * @return true if large buffers are backed by huge pages (when supported by system)
+     */
+    ST_LOCAL bool isHugePages() const {
+        return myToUseHugePages;
+    }
+
+    /**
+     * Use huge pages for large buffers (Linux transparent huge pages).
+     */
+    ST_LOCAL void setHugePages(const bool theToUse) {
+        myToUseHugePages = theToUse;
+    }
+
+    /**
+     * @return size of the buffer which will be returned for requested size
+     */
+    ST_CPPEXPORT static size_t getSizeClass(const size_t theSizeBytes);
+
+    /**
+     * Borrow the buffer.
+     * @param theSizeBytes requested size
+     * @param theCapacity  actual buffer size (size class)
+     * @return buffer or NULL on allocation failure
+     */
+    ST_CPPEXPORT GLubyte* acquire(const size_t theSizeBytes,
+                                  size_t&      theCapacity);
+
+    /**
+     * Return the buffer into the pool.
+     * @param theBuffer   buffer returned by acquire()
+     * @param theCapacity buffer size returned by acquire()
+     */
+    ST_CPPEXPORT void release(GLubyte*     theBuffer,
+                              const size_t theCapacity);
+
+    /**
+     * Release buffers unused for longer than idle time or exceeding memory budget.
+     * @param theToForce release all free buffers
+     */
+    ST_CPPEXPORT void trim(const bool theToForce = false);
+
+    /**
+     * @return size of free buffers
+     */
+    ST_CPPEXPORT size_t getFreeBytes();
+
+        private:
+
+    /**
+     * Release buffers, should be called under lock.
+     */
+    ST_LOCAL void trimLocked(const bool theToForce);
+
+    /**
+     * Free the buffer.
+     */
+    ST_LOCAL static void freeBuffer(GLubyte* theBuffer);
+
+        private:
+
+    /**
+     * Unused buffer.
+     */
+    struct Entry {
+        GLubyte* Buffer;       //!< buffer
+        size_t   Capacity;     //!< buffer size
+        double   ReleaseTime;  //!< time of release
+    };
+
+        private:
+
+    StMutex            myMutex;          //!< lock for thread-safety
+    std::vector<Entry> myFree;           //!< unused buffers, from oldest to newest
+    size_t             myFreeBytes;      //!< size of unused buffers
+    StTimer            myTimer;          //!< timer for idle time
+    StMemoryClient     myMemClient;      //!< memory budget client (only unused buffers are reported)
+    double             myIdleTime;       //!< time in seconds to keep unused buffers
+    bool               myToUseHugePages; //!< use huge pages for large buffers
+
+};
+
+#endif // __StGLTextureBufferPool_h_
@@ -10,9 +10,12 @@
 #define __StGLTextureData_h_
 
 #include <StImage/StImage.h>
+#include <StGLStereo/StGLTextureBufferPool.h>
 #include <StGLStereo/StGLTextureUploadParams.h>
 #include <StGLStereo/StGLQuadTexture.h>
 #include <StGL/StGLDeviceCaps.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StTelemetry.h>
 
 /**
  * This class represents stereo data for textures
@@ -38,8 +41,11 @@ class StGLTextureData {
 
     /**
      * Default constructor
+     * @param theUploadParams texture streaming parameters
+     * @param theBufferPool   pool to borrow data buffers from
      */
-    ST_CPPEXPORT StGLTextureData(const StHandle<StGLTextureUploadParams>& theUploadParams);
+    ST_CPPEXPORT StGLTextureData(const StHandle<StGLTextureUploadParams>& theUploadParams,
+                                 const StHandle<StGLTextureBufferPool>&   theBufferPool);
 
     /**
      * Destructor.
@@ -151,10 +157,28 @@ class StGLTextureData {
     ST_CPPEXPORT void getCopy(StImage* outDataL, StImage* outDataR) const;
 
     /**
-     * Release memory.
+     * Lock the image data against modification (updateData() and reset() will wait).
+     * Allows copying the data without holding the queue locks.
+     */
+    ST_LOCAL void lockData() { myDataMutex.lock(); }
+
+    /**
+     * Unlock the image data previously locked by lockData().
+     */
+    ST_LOCAL void unlockData() { myDataMutex.unlock(); }
+
+    /**
+     * Release memory (data buffer is returned to the pool).
      */
     ST_CPPEXPORT void reset();
 
+    /**
+     * Release memory unless the data is locked by lockData() within another thread.
+     * Allows rendering thread to skip memory compression instead of waiting for snapshot copying.
+     * @return false if data is locked and has been kept
+     */
+    ST_CPPEXPORT bool tryReset();
+
         private:
 
     ST_LOCAL bool reAllocate(const size_t theSizeBytes);
@@ -182,10 +206,13 @@ class StGLTextureData {
     StGLTextureData*         myNext;          //!< pointer to next item
 
     GLubyte*                 myDataPtr;       //!< data for left and right views
-    size_t                   myDataSizeBytes; //!< allocated data size in bytes
+    size_t                   myDataSizeBytes; //!< used data size in bytes
+    size_t                   myDataCapacity;  //!< allocated data size in bytes
+    StHandle<StGLTextureBufferPool> myBufferPool; //!< pool of data buffers
     StImage                  myDataPair;
     StImage                  myDataL;
     StImage                  myDataR;
+    StMutex                  myDataMutex;     //!< lock guarding image data modification
 
     StHandle<StStereoParams> myStParams;
     double                   myPts;           //!< presentation timestamp
@@ -195,6 +222,7 @@ class StGLTextureData {
     StHandle<StGLTextureUploadParams> myUploadParams; //!< texture streaming parameters
     GLsizei                  myFillFromRow;
     GLsizei                  myFillRows;
+    StTelemetryHistogram*    myTelUpload;     //!< telemetry - time to upload the chunk of frame into texture
 
 };
 
@@ -11,9 +11,11 @@
 
 #include <StThreads/StCondition.h>
 #include <StThreads/StFPSMeter.h>
+#include <StThreads/StMemoryBudget.h>
 #include <StThreads/StMutex.h>
 
 #include <StGL/StGLDeviceCaps.h>
+#include <StSlots/StSignal.h>
 
 #include "StGLQuadTexture.h"
 #include "StGLTextureData.h"
@@ -67,6 +69,11 @@ class StGLTextureQueue {
      */
     ST_LOCAL StGLTextureUploadParams& getUploadParams() { return *myUploadParams; }
 
+    /**
+     * Return pool of frame buffers shared by queue slots.
+     */
+    ST_LOCAL StGLTextureBufferPool& getBufferPool() { return *myBufferPool; }
+
     /**
      * @return input stream connection state
      */
@@ -105,10 +112,15 @@ class StGLTextureQueue {
     ST_LOCAL inline void getQueueInfo(int&    theQueued,
                                       int&    theQueueLen,
                                       double& theFps) {
+        myMutexSize.lock();
+            const size_t aQueueSize  = myQueueSize;
+            const size_t aQueueLimit = getQueueSizeLimit();
+        myMutexSize.unlock();
+
         myMeterMutex.lock();
         if(myHasStream) {
-            theQueued   = int(myQueueSize + 1);
-            theQueueLen = int(myQueueSizeMax);
+            theQueued   = int(aQueueSize + 1);
+            theQueueLen = int(aQueueLimit);
             theFps      = myFPSMeter.getAverage();
         } else {
             theQueued   = 0;
@@ -151,7 +163,7 @@ class StGLTextureQueue {
      */
     ST_LOCAL bool isFull() const {
         myMutexSize.lock();
-            const bool aResult = ((myQueueSize + 1) == myQueueSizeMax);
+            const bool aResult = ((myQueueSize + 1) >= getQueueSizeLimit());
         myMutexSize.unlock();
         return aResult;
     }
@@ -199,6 +211,7 @@ class StGLTextureQueue {
         if(theLimit == 0 || mySwapFBCount < theLimit) {
             ++mySwapFBCount;
             mySwapFBMutex.unlock();
+            signals.onNewFrame();
             return true;
         }
         mySwapFBMutex.unlock();
@@ -239,10 +252,31 @@ class StGLTextureQueue {
         SNAPSHOT_SUCCESS = 1,
     };
 
+    /**
+     * @return true if some frame has been displayed, so that getSnapshot() can retrieve it
+     */
+    ST_LOCAL bool hasSnapshot() const {
+        myMutexSize.lock();
+            const bool aResult = myDataSnap != NULL;
+        myMutexSize.unlock();
+        return aResult;
+    }
+
     ST_CPPEXPORT int getSnapshot(StImage* theOutDataLeft,
                                  StImage* theOutDataRight,
                                  bool     theToForce = false);
 
+        public: //! @name Signals
+
+    struct {
+        /**
+         * Emitted from the filling thread when new frame has been pushed into the queue
+         * or frame swap has been requested, so that GL thread should update textures.
+         * Should be connected before the filling thread is started.
+         */
+        StSignal<void (void )> onNewFrame;
+    } signals;
+
         private:
 
     enum {
@@ -255,6 +289,26 @@ class StGLTextureQueue {
 
     ST_CPPEXPORT int swapFBOnReady(StGLContext& theCtx);
 
+    /**
+     * Return queue length limited by memory budget (at least 2 frames).
+     * Should be called under myMutexSize lock.
+     */
+    ST_LOCAL size_t getQueueSizeLimit() const {
+        if(myFrameBytes == 0) {
+            return myQueueSizeMax;
+        }
+        const size_t aNbFrames = myMemClient.getLimit() / myFrameBytes + 1;
+        return stMax(stMin(aNbFrames, myQueueSizeMax), size_t(2));
+    }
+
+    /**
+     * Report memory held by queued frames to the budget.
+     * Should be called under myMutexSize lock.
+     */
+    ST_LOCAL void updateMemoryUsage() {
+        myMemClient.setBytes((myQueueSize + 1) * myFrameBytes);
+    }
+
         private:
 
     StMutex          myMutexPop;
@@ -266,6 +320,8 @@ class StGLTextureQueue {
     mutable StMutex  myMutexSize;
     size_t           myQueueSize;
     size_t           myQueueSizeMax;
+    size_t           myFrameBytes;     //!< size of last pushed frame
+    StMemoryClient   myMemClient;      //!< memory budget client
 
     StGLQuadTexture  myQTexture;       //!< quad stereo texture
 
@@ -288,6 +344,7 @@ class StGLTextureQueue {
 
     StGLDeviceCaps   myDeviceCaps;     //!< device capabilities
     StHandle<StGLTextureUploadParams> myUploadParams; //!< texture streaming parameters
+    StHandle<StGLTextureBufferPool>   myBufferPool;   //!< pool of frame buffers shared by slots
 
 };
 
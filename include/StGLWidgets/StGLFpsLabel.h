@@ -13,6 +13,8 @@
 #include <StGLWidgets/StGLTextArea.h>
 #include <StGLWidgets/StGLMenuProgram.h>
 
+#include <vector>
+
 /**
  * Widget for displaying diagnostic information
  * (frame rate, buffers state, etc.).
@@ -26,14 +28,27 @@ class StGLFpsLabel : public StGLTextArea {
 
         public:
 
+    /**
+     * Update statistics, should be called for each drawn frame.
+     * @param theIsStereo  stereoscopic output flag
+     * @param theTargetFps target FPS
+     * @param theExtraInfo extra statistics to display
+     * @param theIdleRatio ratio of time main loop has been idle (see StWindow::getIdleRatio()), negative to hide
+     */
     ST_CPPEXPORT void update(const bool      theIsStereo,
                              const double    theTargetFps,
-                             const StString& theExtraInfo);
+                             const StString& theExtraInfo,
+                             const double    theIdleRatio = -1.0);
 
     ST_LOCAL double& changePlayFps()         { return myPlayFps; }
     ST_LOCAL int&    changePlayQueued()      { return myPlayQueued; }
     ST_LOCAL int&    changePlayQueueLength() { return myPlayQueueLen; }
 
+    /**
+     * Append pipeline telemetry (see StTelemetry) to displayed statistics.
+     */
+    ST_LOCAL void setShowTelemetry(const bool theToShow) { myToShowTelemetry = theToShow; }
+
         public:  //! @name Signals
 
     struct {
@@ -55,6 +70,8 @@ class StGLFpsLabel : public StGLTextArea {
     int          myPlayQueueLen; //!< queue length
     StTimer      myTimer;        //!< FPS timer
     unsigned int myCounter;      //!< frames counter
+    std::vector<int32_t> myTelemetryPrev;   //!< telemetry histograms state on previous update
+    bool                 myToShowTelemetry; //!< flag to display pipeline telemetry
 
 };
 
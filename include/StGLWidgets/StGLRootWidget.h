@@ -476,6 +476,20 @@ class StGLRootWidget : public StGLWidget {
         myIsMenuPressed = theIsPressed;
     }
 
+    /**
+     * Request the scene to be redrawn after specified delay.
+     * Several requests are merged into the earliest one.
+     * @param theDelaySec delay in seconds, 0 to redraw as soon as possible
+     */
+    ST_CPPEXPORT void requestRedraw(const double theDelaySec);
+
+    /**
+     * Retrieve and reset pending redraw request.
+     * @param theDelaySec delay of the earliest requested redraw
+     * @return true if redraw has been requested
+     */
+    ST_CPPEXPORT bool popRedrawRequest(double& theDelaySec);
+
         private:
 
     /**
@@ -524,6 +538,7 @@ class StGLRootWidget : public StGLWidget {
     StGLMessageBox*           myModalDialog;   //!< active dialog
 
     bool                      myIsMenuPressed; //!< global flag to perform navigation in menu after first item clicked
+    double                    myRedrawDelay;   //!< delay of the earliest pending redraw request, negative if not requested
 
         protected:
 
@@ -49,16 +49,11 @@ class StGLSubtitles : public StGLTextArea {
         ST_LOCAL StSubShowItems();
 
         /**
-         * Remove subtitle items with outdated PTS.
-         * @param thePTS current presentation timestamp
-         * @return true if active representation was changed (items were removed)
+         * Replace active subtitle items.
+         * @param theItems items active at current presentation timestamp
+         * @return true if active representation was changed
          */
-        ST_LOCAL bool pop(const double thePTS);
-
-        /**
-         * Append subtitle item.
-         */
-        ST_LOCAL void add(const StHandle<StSubItem>& theItem);
+        ST_LOCAL bool update(const std::vector< StHandle<StSubItem> >& theItems);
 
     };
 
@@ -111,8 +106,10 @@ class StGLSubtitles : public StGLTextArea {
     StGLTexture              myTexture;   //!< texture for image-based subtitles
     StGLVertexBuffer         myVertBuf;   //!< vertex buffer for image-based subtitles
     StGLVertexBuffer         myTCrdBuf;   //!< texture coordinates buffer for image-based subtitles
-    StHandle<StSubQueue>     myQueue;     //!< thread-safe subtitles queue
+    StHandle<StSubQueue>     myQueue;     //!< thread-safe subtitles store
     StSubShowItems           myShowItems; //!< active (shown) subtitle items
+    std::vector< StHandle<StSubItem> > myActiveItems; //!< temporary list of items active at current PTS
+    StString                 myPendingText; //!< text of upcoming subtitle items
     double                   myPTS;       //!< active PTS
 
     class StImgProgram;
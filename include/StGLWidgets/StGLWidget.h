@@ -271,6 +271,12 @@ class StGLWidget {
      */
     ST_CPPEXPORT virtual void setOpacity(const float theOpacity, bool theToSetChildren);
 
+    /**
+     * Request the scene containing this widget to be redrawn.
+     * @param theDelaySec delay in seconds, 0 to redraw as soon as possible
+     */
+    ST_CPPEXPORT void invalidate(const double theDelaySec = 0.0);
+
     /**
      * @return true if widget can process input events
      */
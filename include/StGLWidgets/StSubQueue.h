@@ -10,11 +10,15 @@
 #ifndef __StSubQueue_h_
 #define __StSubQueue_h_
 
+#include <StGLStereo/StGLTextureBufferPool.h>
 #include <StTemplates/StHandle.h>
 #include <StTemplates/StArrayList.h>
+#include <StThreads/StMemoryBudget.h>
 #include <StThreads/StMutex.h>
 #include <StImage/StImagePlane.h>
 
+#include <vector>
+
 /**
  * Subtitle primitive (Text that bound to one time interval).
  */
@@ -34,14 +38,73 @@ class StSubItem {
                        double theTimeEnd)
     : TimeStart(theTimeStart),
       TimeEnd(theTimeEnd),
-      Scale(1.0f) {
+      Scale(1.0f),
+      myImageCapacity(0) {
         //
     }
 
+    /**
+     * Destructor, returns image buffer into the pool.
+     */
+    ST_LOCAL ~StSubItem() {
+        if(!myImagePool.isNull()) {
+            GLubyte* aBuffer = Image.changeData();
+            Image.nullify();
+            myImagePool->release(aBuffer, myImageCapacity);
+        }
+    }
+
+    /**
+     * Initialize the image using the buffer from the pool.
+     * The buffer is returned into the pool when item is destroyed,
+     * i.e. when it is evicted from StSubQueue and not displayed anymore.
+     * @param thePool   buffers pool
+     * @param theFormat pixel format
+     * @param theSizeX  image width
+     * @param theSizeY  image height
+     * @return false on allocation failure
+     */
+    ST_LOCAL bool initImage(const StHandle<StGLTextureBufferPool>& thePool,
+                            const StImagePlane::ImgFormat          theFormat,
+                            const size_t                           theSizeX,
+                            const size_t                           theSizeY) {
+        if(!myImagePool.isNull()
+        || theSizeX == 0
+        || theSizeY == 0) {
+            return false;
+        }
+
+        Image.nullify(theFormat);
+        GLubyte* aBuffer = thePool->acquire(theSizeX * theSizeY * Image.getSizePixelBytes(), myImageCapacity);
+        if(aBuffer == NULL
+        || !Image.initWrapper(theFormat, aBuffer, theSizeX, theSizeY)) {
+            thePool->release(aBuffer, myImageCapacity);
+            Image.nullify();
+            return false;
+        }
+        myImagePool = thePool;
+        return true;
+    }
+
+        private:
+
+    StSubItem(const StSubItem& );
+    StSubItem& operator=(const StSubItem& );
+
+        private:
+
+    StHandle<StGLTextureBufferPool> myImagePool;     //!< pool owning image buffer
+    size_t                          myImageCapacity; //!< capacity of image buffer
+
 };
 
 /**
- * Thread-safe subtitles queue.
+ * Thread-safe store of decoded subtitle items of active track.
+ * Items are kept sorted by start time within interval index
+ * (implicit tree holding maximum end time of each subtree),
+ * so that items active at specified PTS are found in logarithmic time.
+ * Decoded items are kept across seeks - only bitmap items
+ * are evicted when their total size exceeds the limit (reduced under memory pressure).
  */
 class StSubQueue {
 
@@ -58,47 +121,88 @@ class StSubQueue {
     ST_CPPEXPORT virtual ~StSubQueue();
 
     /**
-     * Returns true if queue is empty.
+     * Returns true if store is empty.
      */
     ST_CPPEXPORT bool isEmpty();
 
     /**
-     * Clean up the queue.
+     * Clean up the store (e.g. on switching to another track).
      */
     ST_CPPEXPORT void clear();
 
     /**
-     * Return new subtitle item to show according to current presentation timestamp
-     * and automatically remove outdated items.
-     * @param thePTS current presentation timestamp
-     * @return new subtitle item to show or NULL handle
+     * Find subtitle items active at specified presentation timestamp.
+     * @param thePTS   current presentation timestamp
+     * @param theItems found items sorted by start time (previous content is discarded)
+     * @return true if list is not empty
      */
-    ST_CPPEXPORT StHandle<StSubItem> pop(const double thePTS);
+    ST_CPPEXPORT bool getActive(const double thePTS,
+                                std::vector< StHandle<StSubItem> >& theItems);
 
     /**
-     * Append subtitle item to the queue.
+     * Append subtitle item to the store.
+     * Item duplicating already stored one (e.g. decoded once again after seeking) is ignored.
      * @param theSubItem item to add
      */
     ST_CPPEXPORT void push(const StHandle<StSubItem>& theSubItem);
 
+    /**
+     * Retrieve text of items pushed since the last call,
+     * so that glyphs can be prepared before items should be shown.
+     * @param theText text of new items (separated by line breaks)
+     * @return true if text is not empty
+     */
+    ST_CPPEXPORT bool popPendingText(StString& theText);
+
+    /**
+     * @return number of stored items
+     */
+    ST_CPPEXPORT size_t getSize();
+
         private:
 
-    struct QueueItem {
+    /**
+     * Rebuild the tree of maximum end times.
+     */
+    ST_LOCAL void rebuildTree();
+
+    /**
+     * Update the tree for modified leaf.
+     */
+    ST_LOCAL void updateTree(const size_t theIndex);
 
-        StHandle<StSubItem> myItem;
-        QueueItem* myNext;
+    /**
+     * Collect items with start index lower than theIndexTo and end time not lower than thePTS.
+     */
+    ST_LOCAL void findActive(const size_t theNode,
+                             const size_t theNodeFrom,
+                             const size_t theNodeTo,
+                             const size_t theIndexTo,
+                             const double thePTS,
+                             std::vector< StHandle<StSubItem> >& theItems) const;
 
-        ST_LOCAL QueueItem(const StHandle<StSubItem>& theItem)
-        : myItem(theItem),
-          myNext(NULL) {}
+    /**
+     * @return limit for total size of stored images
+     */
+    ST_LOCAL size_t getImageBytesLimit() const;
 
-    };
+    /**
+     * Remove bitmap items most distant from last requested PTS
+     * while total size exceeds the limit.
+     */
+    ST_LOCAL void evictImages();
 
         private: //! @name private fields
 
-    QueueItem* myFront; //!< queue front item
-    QueueItem* myBack;  //!< queue back item
-    StMutex    myMutex; //!< lock for thread safety
+    std::vector< StHandle<StSubItem> > myItems;  //!< items sorted by start time
+    std::vector<double> myTreeEnd;     //!< implicit binary tree with maximum end time of items within subtree
+    size_t              myTreeLeaves;  //!< number of leaves in the tree (power of two)
+    bool                myIsTreeValid; //!< flag indicating that tree is up-to-date
+    size_t              myImageBytes;  //!< total size of stored images
+    double              myLastPts;     //!< last requested PTS
+    StString            myPendingText; //!< text of items not yet retrieved by popPendingText()
+    StMemoryClient      myMemClient;   //!< memory budget client
+    StMutex             myMutex;       //!< lock for thread safety
 
 };
 
@@ -0,0 +1,94 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StBase64_h_
+#define __StBase64_h_
+
+#include <stTypes.h>
+
+/**
+ * Base64 decoder (RFC 4648, standard and URL-safe alphabets).
+ * Long streams are decoded using SIMD instructions (SSSE3 / AVX2 selected at runtime on x86, NEON on ARM64)
+ * with scalar decoding of the tail and of blocks which SIMD path can not handle.
+ * Padding characters are allowed only at the end of the stream; whitespaces are not allowed.
+ */
+class StBase64 {
+
+        public:
+
+    /**
+     * Decoding implementation.
+     */
+    enum Impl {
+        Impl_Auto,   //!< fastest implementation supported by CPU
+        Impl_Scalar, //!< portable implementation
+    };
+
+        public:
+
+    /**
+     * Compute the size of decoded data.
+     * @param theSrc    base64 stream
+     * @param theSrcLen stream length
+     * @return number of decoded bytes (exact for valid stream)
+     */
+    ST_CPPEXPORT static size_t getDecodedSize(const char*  theSrc,
+                                              const size_t theSrcLen);
+
+    /**
+     * Decode the stream.
+     * @param theDst      destination buffer of getDecodedSize() bytes
+     * @param theSrc      base64 stream
+     * @param theSrcLen   stream length
+     * @param theErrorPos position of the first invalid character within the stream (when decoding fails)
+     * @param theImpl     implementation to use
+     * @return false if stream is invalid
+     */
+    ST_CPPEXPORT static bool decode(stUByte_t*   theDst,
+                                    const char*  theSrc,
+                                    const size_t theSrcLen,
+                                    size_t&      theErrorPos,
+                                    const Impl   theImpl = Impl_Auto);
+
+    /**
+     * Decode the stream in chunks processed by StTaskPool.
+     * Short streams are decoded within the calling thread.
+     * @param theDst      destination buffer of getDecodedSize() bytes
+     * @param theSrc      base64 stream
+     * @param theSrcLen   stream length
+     * @param theErrorPos position of the first invalid character within the stream (when decoding fails)
+     * @return false if stream is invalid
+     */
+    ST_CPPEXPORT static bool decodeParallel(stUByte_t*   theDst,
+                                            const char*  theSrc,
+                                            const size_t theSrcLen,
+                                            size_t&      theErrorPos);
+
+    /**
+     * @return name of the fastest implementation supported by CPU
+     */
+    ST_CPPEXPORT static const char* getSimdName();
+
+        public:
+
+    /**
+     * Decode the sequence of complete 4-character groups without padding.
+     * @param theDst      destination buffer of theNbQuads * 3 bytes
+     * @param theSrc      base64 stream of theNbQuads * 4 characters
+     * @param theNbQuads  number of groups
+     * @param theImpl     implementation to use
+     * @return number of decoded groups, less than theNbQuads if invalid character has been found
+     */
+    ST_CPPEXPORT static size_t decodeQuads(stUByte_t*       theDst,
+                                           const stUByte_t* theSrc,
+                                           const size_t     theNbQuads,
+                                           const Impl       theImpl = Impl_Auto);
+
+};
+
+#endif // __StBase64_h_
@@ -11,10 +11,13 @@
 
 #include "StString.h"
 #include <StTemplates/StHandle.h>
+#include <StThreads/StThread.h>
 
 #include <typeinfo>
 
 // forward declarations
+class StCondition;
+class StLogQueue;
 class StMutexSlim;
 
 /**
@@ -73,6 +76,7 @@ class StLogger {
         ST_OPT_NONE = 0x00, //!< no options
         ST_OPT_COUT = 0x01, //!< (additionally) write into standard streams std::cerr and std::cout.
         ST_OPT_LOCK = 0x02, //!< use mutex to ensure thread-safety
+        ST_OPT_ASYNC= 0x04, //!< put messages into lock-free queue and write them from dedicated thread
     };
 
         public:
@@ -99,6 +103,42 @@ class StLogger {
         myFilter = theFilter;
     }
 
+    /**
+     * @return maximum size of log file before rotation
+     */
+    inline size_t getMaxFileSize() const {
+        return myFileSizeMax;
+    }
+
+    /**
+     * Setup maximum size of log file.
+     * When exceeded, the file is renamed with ".1" suffix (replacing previous one) and new file is started.
+     * Applied only to asynchronous logger, which keeps the file open.
+     * @param theSize size in bytes, 0 means unlimited
+     */
+    inline void setMaxFileSize(const size_t theSize) {
+        myFileSizeMax = theSize;
+    }
+
+    /**
+     * @return number of messages dropped due to overflow of the queue (asynchronous logger)
+     */
+    ST_CPPEXPORT size_t getDroppedCount() const;
+
+    /**
+     * Wait until all messages put into the queue are written (asynchronous logger).
+     * Called automatically for ST_FATAL and ST_PANIC messages.
+     */
+    ST_CPPEXPORT void flush();
+
+    /**
+     * Stop the writing thread of asynchronous logger and write all queued messages;
+     * following messages are written synchronously.
+     * Should be called for the default logger before exit (e.g. by StApplication destructor),
+     * because joining the thread from static destructor may deadlock under DLL loader lock on Windows.
+     */
+    ST_CPPEXPORT void shutdown();
+
     /**
      * Main logging function.
      * @param theMessage message text
@@ -118,6 +158,43 @@ class StLogger {
 
         private:
 
+    /**
+     * Write the message to all outputs.
+     * @param theToKeepOpen keep the file open after writing (asynchronous logger)
+     */
+    ST_LOCAL void writeRecord(const StString&       theMessage,
+                              const StLogger::Level theLevel,
+                              const size_t          theThreadId,
+                              const bool            theToKeepOpen);
+
+    /**
+     * Open the log file for appending.
+     */
+    ST_LOCAL bool openFile();
+
+    /**
+     * Close the log file and rename it with ".1" suffix.
+     */
+    ST_LOCAL void rotateFile();
+
+    /**
+     * Thread function.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION threadFunction(void* theLogger);
+
+    /**
+     * Main loop of the working thread writing queued messages.
+     */
+    ST_LOCAL void writerLoop();
+
+    /**
+     * Write all queued messages under the lock (asynchronous logger).
+     * Called by the working thread and, after it has been stopped, by destructor.
+     */
+    ST_LOCAL void writeQueued();
+
+        private:
+
     StHandle<StMutexSlim> myMutex;         //!< mutex lock for thread-safety
 #ifdef _WIN32
     StStringUtfWide       myFilePath;      //!< file to write into
@@ -125,6 +202,15 @@ class StLogger {
     StString              myFilePath;      //!< file to write into
 #endif
     FILE*                 myFileHandle;    //!< file object
+    size_t                myFileSize;      //!< current size of opened file
+    size_t                myFileSizeMax;   //!< maximum size of the file before rotation
+    StHandle<StLogQueue>  myQueue;         //!< queue of messages for asynchronous writing
+    StHandle<StCondition> myEvent;         //!< event to wake up writing thread
+    StHandle<StCondition> myWrittenEvent;  //!< event signaled after each pass of writing thread
+    StHandle<StThread>    myThread;        //!< thread writing queued messages
+    size_t                myDroppedLast;   //!< number of dropped messages already reported
+    volatile int32_t      myNbPushing;     //!< number of threads putting message into the queue
+    volatile bool         myToQuit;        //!< flag to stop writing thread
     StLogger::Level       myFilter;        //!< define messages filter
     const bool            myToLogCout;
     const bool            myToLogToSystem; //!< log into system journal, false by default
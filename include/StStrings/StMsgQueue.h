@@ -38,6 +38,11 @@ class StMsgQueue {
      */
     ST_CPPEXPORT virtual ~StMsgQueue();
 
+    /**
+     * @return true if queue has no pending messages
+     */
+    ST_CPPEXPORT bool isEmpty();
+
     /**
      * Pop message from the queue.
      */
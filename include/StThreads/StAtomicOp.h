@@ -75,6 +75,56 @@ class StAtomicOp {
     #endif
     }
 
+    /**
+     * Add the delta to the value and return result.
+     * @param theValue (volatile int32_t& ) - input value;
+     * @param theDelta (int32_t ) - value to add;
+     * @return sum.
+     */
+    static inline int32_t Add(volatile int32_t& theValue,
+                              const int32_t      theDelta) {
+    #ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+        // g++ compiler
+        return __sync_add_and_fetch(&theValue, theDelta);
+    #elif defined(_WIN32)
+        return InterlockedExchangeAdd((volatile LONG* )&theValue, theDelta) + theDelta;
+    #elif defined(__APPLE__)
+        return OSAtomicAdd32Barrier(theDelta, &theValue);
+    #elif defined(__GNUC__)
+        #error "Set -march=i486 or -march=armv7-a for gcc compiler"
+        return theValue += theDelta;
+    #else
+        #error "Atomic operation doesn't implemented for current platform!"
+        return theValue += theDelta;
+    #endif
+    }
+
+    /**
+     * Replace the value with new one only if it is equal to expected value.
+     * @param theValue    (volatile int32_t& ) - input value;
+     * @param theExpected (int32_t ) - expected value;
+     * @param theNewValue (int32_t ) - value to set;
+     * @return true if value has been replaced.
+     */
+    static inline bool CompareAndSwap(volatile int32_t& theValue,
+                                      const int32_t      theExpected,
+                                      const int32_t      theNewValue) {
+    #ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+        // g++ compiler
+        return __sync_bool_compare_and_swap(&theValue, theExpected, theNewValue);
+    #elif defined(_WIN32)
+        return InterlockedCompareExchange((volatile LONG* )&theValue, theNewValue, theExpected) == theExpected;
+    #elif defined(__APPLE__)
+        return OSAtomicCompareAndSwap32Barrier(theExpected, theNewValue, &theValue);
+    #elif defined(__GNUC__)
+        #error "Set -march=i486 or -march=armv7-a for gcc compiler"
+        return false;
+    #else
+        #error "Atomic operation doesn't implemented for current platform!"
+        return false;
+    #endif
+    }
+
     /**
      * Increment the value with 1 and return result.
      * @param theValue (volatile uint32_t& ) - input value;
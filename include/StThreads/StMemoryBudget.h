@@ -0,0 +1,221 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StMemoryBudget_h_
+#define __StMemoryBudget_h_
+
+#include <StStrings/StString.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StTelemetry.h>
+#include <StThreads/StTimer.h>
+
+#include <vector>
+
+class StMemoryBudget;
+
+/**
+ * Memory consumer (queue or cache) registered within StMemoryBudget.
+ * The owner reports the number of bytes held and enforces the limit given by the budget.
+ * Limits are recomputed by the budget, so that getLimit() is lock-free.
+ */
+class StMemoryClient {
+
+        public:
+
+    /**
+     * Client role.
+     */
+    enum Role {
+        Role_Queue, //!< playback queue - owner should keep minimal depth regardless of the limit
+        Role_Cache, //!< cache - shrunk first under memory pressure
+    };
+
+        public:
+
+    /**
+     * Register the client.
+     * @param theName   client name (for statistics)
+     * @param theRole   client role
+     * @param theWeight share of the budget relative to other clients
+     * @param theBudget budget to register within, global one when NULL
+     */
+    ST_CPPEXPORT StMemoryClient(const StString& theName,
+                                const Role      theRole,
+                                const size_t    theWeight = 1,
+                                StMemoryBudget* theBudget = NULL);
+
+    /**
+     * Unregister the client.
+     */
+    ST_CPPEXPORT ~StMemoryClient();
+
+    /**
+     * @return client name
+     */
+    ST_LOCAL const StString& getName() const {
+        return myName;
+    }
+
+    /**
+     * @return client role
+     */
+    ST_LOCAL Role getRole() const {
+        return myRole;
+    }
+
+    /**
+     * @return share of the budget relative to other clients
+     */
+    ST_LOCAL size_t getWeight() const {
+        return myWeight;
+    }
+
+    /**
+     * @return bytes held by the client
+     */
+    ST_LOCAL size_t getBytes() const {
+        return myBytes;
+    }
+
+    /**
+     * Report bytes held by the client.
+     */
+    ST_LOCAL void setBytes(const size_t theBytes) {
+        myBytes = theBytes;
+    }
+
+    /**
+     * @return current limit in bytes
+     */
+    ST_LOCAL size_t getLimit() const {
+        return myLimit;
+    }
+
+    /**
+     * @return true if client holds more than allowed
+     */
+    ST_LOCAL bool isOverLimit() const {
+        return myBytes > myLimit;
+    }
+
+        private:
+
+    StMemoryBudget*  myBudget; //!< owner
+    const StString   myName;   //!< client name
+    const Role       myRole;   //!< client role
+    const size_t     myWeight; //!< budget share
+    volatile size_t  myBytes;  //!< bytes held
+    volatile size_t  myLimit;  //!< limit set by the budget
+
+    friend class StMemoryBudget;
+
+};
+
+/**
+ * Global memory budget shared by playback queues and caches.
+ * Total limit is split between registered clients proportionally to their weights.
+ * Under memory pressure (system reports reclaim within control group)
+ * limits of caches are reduced to 1/4 and limits of queues to 1/2 for several seconds.
+ */
+class StMemoryBudget {
+
+        public:
+
+    /**
+     * Access global budget.
+     * Default limit is a quarter of memory available to the process (see getSystemMemory()).
+     */
+    ST_CPPEXPORT static StMemoryBudget& GetDefault();
+
+    /**
+     * @return physical memory size or memory limit of the control group (whatever is smaller), 0 if unknown
+     */
+    ST_CPPEXPORT static uint64_t getSystemMemory();
+
+    /**
+     * @param theLimit total limit in bytes
+     */
+    ST_CPPEXPORT StMemoryBudget(const size_t theLimit);
+
+    /**
+     * @return total limit in bytes
+     */
+    ST_LOCAL size_t getLimit() const {
+        return myLimit;
+    }
+
+    /**
+     * Setup total limit.
+     */
+    ST_CPPEXPORT void setLimit(const size_t theLimit);
+
+    /**
+     * @return bytes held by all clients
+     */
+    ST_CPPEXPORT size_t getUsedBytes();
+
+    /**
+     * @return true if memory pressure has been reported
+     */
+    ST_LOCAL bool isUnderPressure() const {
+        return myIsPressure;
+    }
+
+    /**
+     * Enter (or leave) memory pressure state.
+     */
+    ST_CPPEXPORT void setPressure(const bool theIsPressure);
+
+    /**
+     * Poll system memory pressure notifications.
+     * Can be called frequently (from single thread) - the system is polled at most once per second.
+     */
+    ST_CPPEXPORT void checkPressure();
+
+        private:
+
+    /**
+     * Register the client.
+     */
+    ST_LOCAL void add(StMemoryClient* theClient);
+
+    /**
+     * Unregister the client.
+     */
+    ST_LOCAL void remove(StMemoryClient* theClient);
+
+    /**
+     * Recompute limits of clients, should be called under lock.
+     */
+    ST_LOCAL void updateLimits();
+
+    /**
+     * Read pressure events counter of control group.
+     * @return false if not available
+     */
+    ST_LOCAL bool readPressureEvents(uint64_t& theNbEvents);
+
+        private:
+
+    StMutex                      myMutex;         //!< lock for clients list
+    std::vector<StMemoryClient*> myClients;       //!< registered clients
+    size_t                       myLimit;         //!< total limit
+    volatile bool                myIsPressure;    //!< memory pressure state
+    StTimer                      myPollTimer;     //!< timer for polling system
+    StTimer                      myPressureTimer; //!< time since last pressure event
+    uint64_t                     myNbEvents;      //!< last value of pressure events counter
+    bool                         myHasEvents;     //!< flag indicating that pressure events are available
+    StString                     myCGroupPath;    //!< path to control group of the process
+    StTelemetryGauge*            myTelUsed;       //!< telemetry - bytes held by clients in MiB
+    StTelemetryCounter*          myTelPressure;   //!< telemetry - number of pressure events
+
+    friend class StMemoryClient;
+
+};
+
+#endif // __StMemoryBudget_h_
@@ -1,5 +1,5 @@
 /**
- * Copyright © 2009-2013 Kirill Gavrilov <kirill@sview.ru>
+ * Copyright © 2009-2026 Kirill Gavrilov <kirill@sview.ru>
  *
  * Distributed under the Boost Software License, Version 1.0.
  * See accompanying file license-boost.txt or copy at
@@ -15,6 +15,8 @@
     #include <pthread.h>
 #endif
 
+struct StMutexStats;
+
 /**
  * StMutex is a simple Mutex class-wrapper
  * with behaviour similar to WinAPI mutex object.
@@ -55,6 +57,20 @@ class StMutex {
      */
     ST_CPPEXPORT bool unlock();
 
+    /**
+     * Assign the name to this mutex for lock contention profiling.
+     * Has no effect when profiling is disabled (see StMutexProfiler).
+     * @param theName mutex name, should be a string literal
+     */
+    ST_CPPEXPORT void setName(const char* theName);
+
+        private:
+
+    /**
+     * Lock the mutex with statistics update.
+     */
+    ST_LOCAL bool lockProfiled();
+
         private:
 
 #ifdef _WIN32
@@ -62,6 +78,7 @@ class StMutex {
 #else
     pthread_mutex_t myMutex;
 #endif
+    StMutexStats*   myStats; //!< lock statistics, NULL when profiling is disabled
 
 };
 
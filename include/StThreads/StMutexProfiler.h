@@ -0,0 +1,118 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StMutexProfiler_h_
+#define __StMutexProfiler_h_
+
+#include <StStrings/StString.h>
+
+#include <vector>
+
+/**
+ * Lock statistics of single named mutex.
+ * Fields are modified only by the thread owning the mutex,
+ * thus they are implicitly protected by the mutex itself;
+ * values read from other threads are approximate.
+ */
+struct StMutexStats {
+
+    const char* Name;        //!< mutex name (string literal)
+    uint64_t    NbLocks;     //!< number of acquisitions (recursive ones are not counted)
+    uint64_t    NbContended; //!< number of acquisitions which had to wait for another thread
+    double      WaitUs;      //!< total wait time in microseconds
+    double      WaitMaxUs;   //!< maximum wait time in microseconds
+    double      HoldUs;      //!< total hold time in microseconds
+    double      HoldMaxUs;   //!< maximum hold time in microseconds
+    double      LockedAt;    //!< time of the last acquisition
+    int         Depth;       //!< recursion depth of the current owner
+
+    /**
+     * Register acquisition, should be called right after obtaining the lock.
+     * @param theWaitUs wait time in microseconds or negative value if lock has been obtained without waiting
+     */
+    ST_CPPEXPORT void onLocked(const double theWaitUs);
+
+    /**
+     * Register release, should be called right before releasing the lock.
+     */
+    ST_CPPEXPORT void onUnlock();
+
+};
+
+/**
+ * Lock contention profiler.
+ * Profiling is disabled by default and can be enabled by environment variable StMutexProfile=1
+ * (it should be set before process start, so that mutexes created at startup are also covered).
+ * When enabled, each mutex with assigned name (see StMutex::setName()) records acquisitions,
+ * contended acquisitions, total wait time and maximum hold time.
+ * Statistics of mutexes with the same name are accumulated together.
+ */
+class StMutexProfiler {
+
+        public:
+
+    /**
+     * Accumulated statistics of mutexes sharing the same name.
+     */
+    struct Entry {
+        StString Name;        //!< mutex name
+        size_t   NbMutexes;   //!< number of mutex instances
+        uint64_t NbLocks;     //!< number of acquisitions
+        uint64_t NbContended; //!< number of contended acquisitions
+        double   WaitUs;      //!< total wait time in microseconds
+        double   WaitMaxUs;   //!< maximum wait time in microseconds
+        double   HoldUs;      //!< total hold time in microseconds
+        double   HoldMaxUs;   //!< maximum hold time in microseconds
+    };
+
+        public:
+
+    /**
+     * @return true if profiling is enabled
+     */
+    ST_CPPEXPORT static bool isEnabled();
+
+    /**
+     * @return monotonic time in microseconds
+     */
+    ST_CPPEXPORT static double getTimeUs();
+
+    /**
+     * Create statistics record for the new mutex.
+     * @param theName mutex name, should be a string literal
+     */
+    ST_CPPEXPORT static StMutexStats* registerMutex(const char* theName);
+
+    /**
+     * Accumulate statistics of destroyed mutex and release the record.
+     */
+    ST_CPPEXPORT static void unregisterMutex(StMutexStats* theStats);
+
+    /**
+     * Retrieve statistics accumulated by names, sorted by total wait time in descending order.
+     */
+    ST_CPPEXPORT static void getEntries(std::vector<Entry>& theEntries);
+
+    /**
+     * Format statistics as JSON array.
+     */
+    ST_CPPEXPORT static StString toJson();
+
+    /**
+     * Format statistics as a table.
+     */
+    ST_CPPEXPORT static StString toText();
+
+    /**
+     * Put statistics table into the log when profiling is enabled.
+     */
+    ST_CPPEXPORT static void dump();
+
+};
+
+#endif // __StMutexProfiler_h_
@@ -10,6 +10,7 @@
 #define __StMutexSlim_h_
 
 #include "StMutex.h"
+#include "StMutexProfiler.h"
 
 #include <StTemplates/StAtomic.h>
 
@@ -39,7 +40,7 @@ class StMutexSlim {
      */
     inline StMutexSlim()
 #if (defined(_WIN32) || defined(__WIN32__))
-    {
+    : myStats(NULL) {
         // create the critical section with spin count 1024
         if(!InitializeCriticalSectionAndSpinCount(&myCritSection, 0x00000400)) {
             // error
@@ -54,6 +55,7 @@ class StMutexSlim {
      */
     inline ~StMutexSlim() {
     #if (defined(_WIN32) || defined(__WIN32__))
+        StMutexProfiler::unregisterMutex(myStats);
         DeleteCriticalSection(&myCritSection);
     #endif
     }
@@ -63,7 +65,18 @@ class StMutexSlim {
      */
     inline void lock() {
     #if (defined(_WIN32) || defined(__WIN32__))
-        EnterCriticalSection(&myCritSection);
+        if(myStats == NULL) {
+            EnterCriticalSection(&myCritSection);
+            return;
+        }
+
+        double aWaitUs = -1.0;
+        if(!TryEnterCriticalSection(&myCritSection)) {
+            const double aWaitFrom = StMutexProfiler::getTimeUs();
+            EnterCriticalSection(&myCritSection);
+            aWaitUs = StMutexProfiler::getTimeUs() - aWaitFrom;
+        }
+        myStats->onLocked(aWaitUs);
     #else
         myMutex.lock();
     #endif
@@ -74,16 +87,35 @@ class StMutexSlim {
      */
     inline void unlock() {
     #if (defined(_WIN32) || defined(__WIN32__))
+        if(myStats != NULL) {
+            myStats->onUnlock();
+        }
         LeaveCriticalSection(&myCritSection);
     #else
         myMutex.unlock();
     #endif
+    }
+
+    /**
+     * Assign the name to this mutex for lock contention profiling.
+     * @param theName mutex name, should be a string literal
+     */
+    inline void setName(const char* theName) {
+    #if (defined(_WIN32) || defined(__WIN32__))
+        if(myStats == NULL
+        && StMutexProfiler::isEnabled()) {
+            myStats = StMutexProfiler::registerMutex(theName);
+        }
+    #else
+        myMutex.setName(theName);
+    #endif
     }
 
         private:
 
 #if (defined(_WIN32) || defined(__WIN32__))
     CRITICAL_SECTION myCritSection;
+    StMutexStats*    myStats; //!< lock statistics, NULL when profiling is disabled
 #else
     StMutex myMutex;
 #endif
@@ -0,0 +1,390 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StTaskPool_h_
+#define __StTaskPool_h_
+
+#include <StThreads/StAtomicOp.h>
+#include <StThreads/StCondition.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StThread.h>
+#include <StTemplates/StHandle.h>
+
+#include <vector>
+
+/**
+ * Interface for the job executed by StTaskPool.
+ * Task is executed at most once; it might be cancelled before execution has been started.
+ */
+class StTask {
+
+        public:
+
+    enum State {
+        State_Pending,   //!< task is waiting for execution
+        State_Running,   //!< task is being executed
+        State_Done,      //!< task has been executed
+        State_Cancelled, //!< task has been cancelled before execution
+    };
+
+        public:
+
+    /**
+     * Default constructor.
+     */
+    ST_CPPEXPORT StTask();
+
+    /**
+     * Destructor.
+     */
+    ST_CPPEXPORT virtual ~StTask();
+
+    /**
+     * @return current state
+     */
+    State getState() const {
+        return (State )myState;
+    }
+
+    /**
+     * @return true if task has been executed or cancelled
+     */
+    bool isFinished() const {
+        return myState >= State_Done;
+    }
+
+    /**
+     * @return true if cancellation has been requested;
+     * long tasks may check this flag periodically to stop earlier
+     */
+    bool isCancelRequested() const {
+        return myToCancel != 0;
+    }
+
+    /**
+     * Request cancellation.
+     * @return true if task has not been started and will not be executed
+     */
+    ST_CPPEXPORT bool cancel();
+
+    /**
+     * Execute the task within the calling thread if it is still pending.
+     * @return false if task has been already started or cancelled
+     */
+    ST_CPPEXPORT bool execute();
+
+    /**
+     * Wait until the task is finished.
+     * If the task has not been started yet, it is executed within the calling thread,
+     * so that waiting from the pool thread never leads to deadlock.
+     */
+    ST_CPPEXPORT void wait();
+
+    /**
+     * Wait until the task is finished with the timeout.
+     * @return true if task has been finished
+     */
+    ST_CPPEXPORT bool wait(const size_t theTimeMilliseconds);
+
+        protected:
+
+    /**
+     * Perform the job.
+     */
+    virtual void run() = 0;
+
+        private:
+
+    StCondition      myIsFinished; //!< finish event
+    volatile int32_t myState;      //!< task state
+    volatile int32_t myToCancel;   //!< cancellation request
+
+        private:
+
+    StTask(const StTask& );
+    StTask& operator=(const StTask& );
+
+};
+
+/**
+ * Task computing the value.
+ */
+template<typename Result>
+class StTaskFuture : public StTask {
+
+        public:
+
+    /**
+     * Wait for the task and return computed value.
+     * Default value is returned if task has been cancelled.
+     */
+    const Result& getResult() {
+        wait();
+        return myResult;
+    }
+
+        protected:
+
+    /**
+     * Compute the value.
+     */
+    virtual Result compute() = 0;
+
+    virtual void run() ST_ATTR_OVERRIDE {
+        myResult = compute();
+    }
+
+        protected:
+
+    Result myResult; //!< computed value
+
+};
+
+/**
+ * Range of indices split into chunks, shared between threads of parallel loop.
+ */
+class StParallelRange {
+
+        public:
+
+    /**
+     * Main constructor.
+     */
+    StParallelRange(const size_t theBegin,
+                    const size_t theEnd,
+                    const size_t theGrain)
+    : myBegin(theBegin),
+      myEnd(theEnd),
+      myGrain(theGrain),
+      myNbChunks(int32_t((theEnd - theBegin + theGrain - 1) / theGrain)),
+      myNextChunk(0) {}
+
+    /**
+     * @return number of chunks
+     */
+    int32_t getNbChunks() const {
+        return myNbChunks;
+    }
+
+    /**
+     * Acquire the next chunk.
+     * @return false if the whole range has been already processed
+     */
+    bool next(size_t& theFrom,
+              size_t& theTo) {
+        const int32_t aChunk = StAtomicOp::Increment(myNextChunk) - 1;
+        if(aChunk >= myNbChunks) {
+            return false;
+        }
+        theFrom = myBegin + size_t(aChunk) * myGrain;
+        theTo   = stMin(theFrom + myGrain, myEnd);
+        return true;
+    }
+
+    /**
+     * Process chunks until the range is exhausted.
+     */
+    template<typename Functor>
+    void perform(const Functor& theFunctor) {
+        size_t aFrom = 0, aTo = 0;
+        while(next(aFrom, aTo)) {
+            for(size_t anIndex = aFrom; anIndex < aTo; ++anIndex) {
+                theFunctor(anIndex);
+            }
+        }
+    }
+
+        private:
+
+    size_t           myBegin;     //!< first index
+    size_t           myEnd;       //!< last index (exclusive)
+    size_t           myGrain;     //!< number of indices within chunk
+    int32_t          myNbChunks;  //!< number of chunks
+    volatile int32_t myNextChunk; //!< next chunk to process
+
+};
+
+/**
+ * Helper task processing chunks of parallel loop.
+ */
+template<typename Functor>
+class StParallelForTask : public StTask {
+
+        public:
+
+    StParallelForTask(StParallelRange& theRange,
+                      const Functor&   theFunctor)
+    : myRange(theRange),
+      myFunctor(theFunctor) {}
+
+        protected:
+
+    virtual void run() ST_ATTR_OVERRIDE {
+        myRange.perform(myFunctor);
+    }
+
+        private:
+
+    StParallelRange& myRange;
+    const Functor&   myFunctor;
+
+};
+
+/**
+ * Pool of worker threads executing short jobs.
+ * Each worker has its own queue for tasks submitted from this worker (e.g. nested loops),
+ * which it processes in LIFO order; idle workers steal the oldest tasks
+ * from the queues of other workers and from the shared queue of external submissions.
+ * Interactive tasks are always preferred over background ones.
+ */
+class StTaskPool {
+
+        public:
+
+    /**
+     * Task priority.
+     */
+    enum Priority {
+        Priority_Interactive = 0, //!< task blocking user interaction (e.g. displayed image decoding)
+        Priority_Background  = 1, //!< task which can be postponed (e.g. prefetching, folder scanning)
+        Priority_NB
+    };
+
+        public:
+
+    /**
+     * Process-wide pool sized from the number of logical processors
+     * (the calling thread participates in parallel loops, thus one thread less).
+     */
+    ST_CPPEXPORT static StTaskPool& GetDefault();
+
+    /**
+     * Create the pool.
+     * @param theNbThreads number of worker threads
+     */
+    ST_CPPEXPORT StTaskPool(const int theNbThreads);
+
+    /**
+     * Cancel pending tasks and stop worker threads.
+     */
+    ST_CPPEXPORT ~StTaskPool();
+
+    /**
+     * @return number of worker threads
+     */
+    int getNbThreads() const {
+        return (int )myWorkers.size();
+    }
+
+    /**
+     * Put the task into the queue.
+     */
+    ST_CPPEXPORT void submit(const StHandle<StTask>& theTask,
+                             const Priority          thePriority = Priority_Interactive);
+
+    /**
+     * Put the task of derived type (e.g. StTaskFuture) into the queue.
+     */
+    template<typename TaskType>
+    void submit(const StHandle<TaskType>& theTask,
+                const Priority            thePriority = Priority_Interactive) {
+        submit(StHandle<StTask>::downcast(theTask), thePriority);
+    }
+
+    /**
+     * Execute one pending task within the calling thread.
+     * @return false if there are no pending tasks
+     */
+    ST_CPPEXPORT bool executeOne();
+
+    /**
+     * Call the functor for each index within [theBegin, theEnd) range.
+     * The range is split into chunks processed by the calling thread and the pool threads;
+     * the method returns when all indices have been processed.
+     * @param theBegin    first index
+     * @param theEnd      last index (exclusive)
+     * @param theFunctor  functor with operator()(size_t ) const
+     * @param thePriority tasks priority
+     * @param theGrain    number of indices within single chunk, 0 means automatic
+     */
+    template<typename Functor>
+    void parallelFor(const size_t    theBegin,
+                     const size_t    theEnd,
+                     const Functor&  theFunctor,
+                     const Priority  thePriority = Priority_Interactive,
+                     size_t          theGrain    = 0) {
+        if(theEnd <= theBegin) {
+            return;
+        }
+
+        const size_t aNbItems = theEnd - theBegin;
+        if(theGrain == 0) {
+            theGrain = stMax(aNbItems / (size_t(getNbThreads() + 1) * 4), size_t(1));
+        }
+        theGrain = stMax(theGrain, aNbItems / size_t(0x40000000) + 1);
+
+        StParallelRange aRange(theBegin, theEnd, theGrain);
+        const int aNbHelpers = stMin(aRange.getNbChunks() - 1, getNbThreads());
+        std::vector< StHandle<StTask> > aHelpers;
+        aHelpers.reserve(stMax(aNbHelpers, 0));
+        for(int aHelperIter = 0; aHelperIter < aNbHelpers; ++aHelperIter) {
+            aHelpers.push_back(new StParallelForTask<Functor>(aRange, theFunctor));
+            submit(aHelpers.back(), thePriority);
+        }
+
+        aRange.perform(theFunctor);
+        for(size_t aHelperIter = 0; aHelperIter < aHelpers.size(); ++aHelperIter) {
+            if(!aHelpers[aHelperIter]->cancel()) {
+                aHelpers[aHelperIter]->wait();
+            }
+        }
+    }
+
+        public:
+
+    /**
+     * Worker thread with its task queues (internal structure).
+     */
+    struct Worker;
+
+        private:
+
+    /**
+     * Take the next task for the worker.
+     * @param theWorker worker index or -1 for external thread
+     */
+    ST_LOCAL StHandle<StTask> takeTask(const int theWorker);
+
+    /**
+     * Block the worker until new tasks are submitted.
+     */
+    ST_LOCAL void waitTasks();
+
+    /**
+     * Worker thread function.
+     */
+    ST_LOCAL static SV_THREAD_FUNCTION workerThread(void* theWorker);
+
+        private:
+
+    std::vector<Worker*> myWorkers;   //!< worker threads with their queues
+    Worker*              myShared;    //!< queue for tasks submitted from external threads
+    StMutex              myIdleLock;  //!< lock for sleeping workers
+    StCondition          myWakeUp;    //!< event to wake up sleeping workers
+    volatile int32_t     myNbQueued;  //!< number of queued tasks
+    volatile int32_t     myNbIdle;    //!< number of sleeping workers
+    volatile bool        myToStop;    //!< stop flag
+
+        private:
+
+    StTaskPool(const StTaskPool& );
+    StTaskPool& operator=(const StTaskPool& );
+
+};
+
+#endif // __StTaskPool_h_
@@ -0,0 +1,260 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StTelemetry_h_
+#define __StTelemetry_h_
+
+#include <StStrings/StString.h>
+#include <StTemplates/StHandle.h>
+#include <StThreads/StAtomicOp.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StTimer.h>
+
+#include <vector>
+
+/**
+ * Monotonic counter of events.
+ * Updates are lock-free and can be done from any thread.
+ */
+class StTelemetryCounter {
+
+        public:
+
+    ST_LOCAL StTelemetryCounter(const StString& theName)
+    : myName(theName),
+      myValue(0) {}
+
+    /**
+     * @return counter name
+     */
+    ST_LOCAL const StString& getName() const {
+        return myName;
+    }
+
+    /**
+     * @return current value
+     */
+    ST_LOCAL int32_t getValue() const {
+        return myValue;
+    }
+
+    /**
+     * Increment the counter.
+     */
+    ST_LOCAL void increment() {
+        StAtomicOp::Increment(myValue);
+    }
+
+    /**
+     * Add the value to the counter.
+     */
+    ST_LOCAL void add(const int32_t theDelta) {
+        StAtomicOp::Add(myValue, theDelta);
+    }
+
+        private:
+
+    const StString   myName;  //!< counter name
+    volatile int32_t myValue; //!< current value
+
+};
+
+/**
+ * Instant value (like queue depth) overridden by the producer.
+ */
+class StTelemetryGauge {
+
+        public:
+
+    ST_LOCAL StTelemetryGauge(const StString& theName)
+    : myName(theName),
+      myValue(0) {}
+
+    /**
+     * @return gauge name
+     */
+    ST_LOCAL const StString& getName() const {
+        return myName;
+    }
+
+    /**
+     * @return last value
+     */
+    ST_LOCAL int32_t getValue() const {
+        return myValue;
+    }
+
+    /**
+     * Set new value.
+     */
+    ST_LOCAL void setValue(const int32_t theValue) {
+        myValue = theValue;
+    }
+
+        private:
+
+    const StString   myName;  //!< gauge name
+    volatile int32_t myValue; //!< last value
+
+};
+
+/**
+ * Latency histogram with fixed exponential buckets.
+ * The first bucket covers durations up to 0.125 ms and each next bucket doubles the limit,
+ * the last bucket collects everything longer than 4 seconds.
+ * Updates are lock-free and can be done from any thread,
+ * percentiles are estimated from bucket counters.
+ */
+class StTelemetryHistogram {
+
+        public:
+
+    enum {
+        BucketsNb = 17 //!< number of buckets
+    };
+
+        public:
+
+    ST_LOCAL StTelemetryHistogram(const StString& theName)
+    : myName(theName) {
+        for(int aBucket = 0; aBucket < BucketsNb; ++aBucket) {
+            myBuckets[aBucket] = 0;
+        }
+    }
+
+    /**
+     * @return histogram name
+     */
+    ST_LOCAL const StString& getName() const {
+        return myName;
+    }
+
+    /**
+     * Register measured duration.
+     * @param theSeconds duration in seconds
+     */
+    ST_CPPEXPORT void addSeconds(const double theSeconds);
+
+    /**
+     * Copy current bucket counters.
+     * @param theCounts array of BucketsNb elements to fill
+     */
+    ST_CPPEXPORT void getCounts(int32_t* theCounts) const;
+
+    /**
+     * @return upper limit of specified bucket in milliseconds
+     */
+    ST_CPPEXPORT static double getBucketLimitMs(const int theBucket);
+
+    /**
+     * Estimate percentile from bucket counters.
+     * @param theCounts array of BucketsNb counters
+     * @param theRatio  requested percentile within 0..1 range
+     * @return duration in milliseconds or 0 if counters are empty
+     */
+    ST_CPPEXPORT static double getPercentileMs(const int32_t* theCounts,
+                                               const double   theRatio);
+
+        private:
+
+    const StString   myName;               //!< histogram name
+    volatile int32_t myBuckets[BucketsNb]; //!< bucket counters
+
+};
+
+/**
+ * Scoped timer putting elapsed time into the histogram on destruction.
+ */
+class StTelemetryTimer {
+
+        public:
+
+    /**
+     * Start the timer.
+     * @param theHistogram histogram to fill, may be NULL
+     */
+    ST_LOCAL StTelemetryTimer(StTelemetryHistogram* theHistogram)
+    : myHistogram(theHistogram),
+      myTimer(theHistogram != NULL) {}
+
+    /**
+     * Stop the timer.
+     */
+    ST_LOCAL ~StTelemetryTimer() {
+        if(myHistogram != NULL) {
+            myHistogram->addSeconds(myTimer.getElapsedTimeInSec());
+        }
+    }
+
+        private:
+
+    StTelemetryHistogram* myHistogram; //!< histogram to fill
+    StTimer               myTimer;     //!< timer
+
+};
+
+/**
+ * Registry of telemetry metrics.
+ * Metrics are created on first request and are never destroyed,
+ * so that instrumented code should retrieve pointers once (e.g. within constructor)
+ * and update them without any locks later.
+ * Requesting the metric with the same name returns the same instance,
+ * thus similar objects (like video queues of left and right views) accumulate into common metric.
+ */
+class StTelemetry {
+
+        public:
+
+    /**
+     * Access global registry.
+     */
+    ST_CPPEXPORT static StTelemetry& GetDefault();
+
+    /**
+     * Find or create the counter.
+     */
+    ST_CPPEXPORT StTelemetryCounter* getCounter(const StString& theName);
+
+    /**
+     * Find or create the gauge.
+     */
+    ST_CPPEXPORT StTelemetryGauge* getGauge(const StString& theName);
+
+    /**
+     * Find or create the histogram.
+     */
+    ST_CPPEXPORT StTelemetryHistogram* getHistogram(const StString& theName);
+
+    /**
+     * Format all metrics as JSON object.
+     * Histograms are exported with cumulative bucket counters and estimated percentiles.
+     * Lock contention statistics are appended when StMutexProfiler is enabled.
+     */
+    ST_CPPEXPORT StString toJson();
+
+    /**
+     * Format metrics as short human-readable text (one line per metric, histograms with 50 and 95 percentiles).
+     * Histograms percentiles are computed over period since previous call.
+     * @param thePrevCounts histogram counters from previous call, updated by this method
+     */
+    ST_CPPEXPORT StString toText(std::vector<int32_t>& thePrevCounts);
+
+        private:
+
+    ST_LOCAL StTelemetry() {}
+
+        private:
+
+    StMutex                                       myMutex;      //!< lock for registration
+    std::vector< StHandle<StTelemetryCounter> >   myCounters;   //!< registered counters
+    std::vector< StHandle<StTelemetryGauge> >     myGauges;     //!< registered gauges
+    std::vector< StHandle<StTelemetryHistogram> > myHistograms; //!< registered histograms
+
+};
+
+#endif // __StTelemetry_h_
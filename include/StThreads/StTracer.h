@@ -0,0 +1,167 @@
+/**
+ * Copyright © 2026 Kirill Gavrilov <kirill@sview.ru>
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * See accompanying file license-boost.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt
+ */
+
+#ifndef __StTracer_h_
+#define __StTracer_h_
+
+#include <StStrings/StString.h>
+#include <StTemplates/StHandle.h>
+#include <StThreads/StMutex.h>
+#include <StThreads/StTimer.h>
+
+#include <string>
+#include <vector>
+
+class StTraceBuffer;
+
+/**
+ * Lightweight profiler recording time spans of named scopes within all threads.
+ * Events are stored into per-thread ring buffers (the most recent events are kept)
+ * and can be exported into Chrome trace-event JSON format,
+ * which can be opened by chrome://tracing or Perfetto UI.
+ * The tracer is disabled by default, so that disabled scopes cost a single flag check.
+ */
+class StTracer {
+
+        public:
+
+    /**
+     * Access global instance.
+     */
+    ST_CPPEXPORT static StTracer& GetDefault();
+
+    /**
+     * @return true if events recording is enabled
+     */
+    ST_LOCAL bool isEnabled() const {
+        return myIsEnabled;
+    }
+
+    /**
+     * Enable or disable events recording.
+     */
+    ST_CPPEXPORT void setEnabled(const bool theToEnable);
+
+    /**
+     * @return path to the file for saving trace on exit
+     */
+    ST_CPPEXPORT StString getFilePath();
+
+    /**
+     * Setup path to the file for saving trace on exit.
+     */
+    ST_CPPEXPORT void setFilePath(const StString& thePath);
+
+    /**
+     * @return time since tracer creation in microseconds
+     */
+    ST_LOCAL double getTimeUs() const {
+        return myTimer.getElapsedTimeInMicroSec();
+    }
+
+    /**
+     * Record the span into buffer of the current thread.
+     * @param theName  span name, should be a string literal
+     * @param theBegin start time in microseconds
+     */
+    ST_CPPEXPORT void addSpan(const char*  theName,
+                              const double theBegin);
+
+    /**
+     * Record the instant event into buffer of the current thread.
+     * @param theName event name, should be a string literal
+     */
+    ST_CPPEXPORT void addInstant(const char* theName);
+
+    /**
+     * Format recorded events as Chrome trace-event JSON.
+     */
+    ST_CPPEXPORT void toJson(std::string& theJson);
+
+    /**
+     * Save recorded events into the file.
+     * @param thePath file path, when empty the path specified by setFilePath() is used
+     * @return true on success
+     */
+    ST_CPPEXPORT bool save(const StString& thePath = StString());
+
+        private:
+
+    /**
+     * Find or create the buffer for the current thread.
+     */
+    ST_LOCAL StTraceBuffer* getThreadBuffer();
+
+    ST_LOCAL StTracer();
+
+        private:
+
+    StTimer                                myTimer;     //!< timer defining time origin
+    StMutex                                myMutex;     //!< lock for buffers list and file path
+    std::vector< StHandle<StTraceBuffer> > myBuffers;   //!< per-thread buffers
+    StString                               myFilePath;  //!< file to save trace on exit
+    volatile bool                          myIsEnabled; //!< recording flag
+
+};
+
+/**
+ * Scope recording its duration when tracer is enabled.
+ */
+class StTraceScope {
+
+        public:
+
+    /**
+     * Start the span.
+     * @param theName span name, should be a string literal
+     */
+    ST_LOCAL StTraceScope(const char* theName)
+    : myName(NULL),
+      myBegin(0.0) {
+        StTracer& aTracer = StTracer::GetDefault();
+        if(aTracer.isEnabled()) {
+            myName  = theName;
+            myBegin = aTracer.getTimeUs();
+        }
+    }
+
+    /**
+     * End the span.
+     */
+    ST_LOCAL ~StTraceScope() {
+        if(myName != NULL) {
+            StTracer::GetDefault().addSpan(myName, myBegin);
+        }
+    }
+
+        private:
+
+    const char* myName;  //!< span name or NULL if tracer is disabled
+    double      myBegin; //!< start time in microseconds
+
+};
+
+#define ST_TRACE_CONCAT2(theA, theB) theA##theB
+#define ST_TRACE_CONCAT(theA, theB)  ST_TRACE_CONCAT2(theA, theB)
+
+/**
+ * Record duration of the current scope.
+ */
+#define ST_TRACE_SCOPE(theName) StTraceScope ST_TRACE_CONCAT(aTraceScope, __LINE__)(theName)
+
+/**
+ * Record the instant event.
+ */
+#define ST_TRACE_INSTANT(theName) \
+    do { \
+        if(StTracer::GetDefault().isEnabled()) { \
+            StTracer::GetDefault().addInstant(theName); \
+        } \
+    } while(false)
+
+#endif // __StTracer_h_